@@ -0,0 +1,107 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Macro.cpp
+// This file is part of the Garamon for c2ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Macro.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Macro benchmarks of c2ga: workloads of applications, with their throughput and the latency of their requests.
+///
+/// The scenario, on data of a fixed seed:
+///  - circleFitting: 10k circles fitted to 32 noisy points of an arc each. The circle is the vector S of c2ga that
+///    minimizes sum (P_i . S)^2 with |S| = 1, P_i the conformal points: the eigenvector of the smallest eigenvalue of
+///    A^T A, A(i, j) = P_i . e_j. A request is a circle, an item a point.
+/// The centers and radii of each pass are checked against the circles of the points, the program returns 1 if they are wrong.
+///
+/// Usage: c2ga_macro_benchmark [--repetitions <passes>] [--counters] [--filter <text>] [--output <path>] [--scale <factor>],
+/// the scale multiplies the number of circles. See Benchmark.hpp for the report.
+
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <Eigen/Eigenvalues>
+
+#include "c2ga/Mvec.hpp"
+#include "c2ga/Conformal.hpp"
+
+#include "Benchmark.hpp"
+
+
+namespace {
+
+    using Mvec = c2ga::Mvec<double>;
+    using c2ga::benchmark::ScenarioCase;
+
+    constexpr unsigned int dimension = c2ga::euclideanDimension;
+
+    struct Circle {
+        double center[dimension];
+        double radius;
+        std::vector<double> points;
+        double fittedCenter[dimension];
+        double fittedRadius;
+    };
+
+    ScenarioCase circleFitting(const double scale) {
+        const std::size_t pointCount = 32;
+        const std::size_t circleCount = std::max<std::size_t>(1, std::size_t(10000 * scale));
+        auto circles = std::make_shared<std::vector<Circle>>(circleCount);
+        std::mt19937 randomEngine(4);
+        std::uniform_real_distribution<double> position(-10.0, 10.0), radius(0.5, 5.0), angle(0.0, 6.283185307179586);
+        std::normal_distribution<double> noise(0.0, 1e-3);
+        for(Circle& circle : *circles){
+            for(double& coordinate : circle.center) coordinate = position(randomEngine);
+            circle.radius = radius(randomEngine);
+            const double start = angle(randomEngine);
+            for(std::size_t i=0; i<pointCount; ++i){
+                const double theta = start + 2.0 * double(i) / double(pointCount);  // an arc of 2 radians
+                circle.points.push_back(circle.center[0] + circle.radius * std::cos(theta) + noise(randomEngine));
+                circle.points.push_back(circle.center[1] + circle.radius * std::sin(theta) + noise(randomEngine));
+            }
+        }
+        auto basis = std::make_shared<std::vector<Mvec>>(std::vector<Mvec>{c2ga::e0<double>(), c2ga::e1<double>(), c2ga::e2<double>(), c2ga::ei<double>()});
+
+        return {"circleFitting", circleCount, pointCount, [=](const std::size_t request){
+            Circle& circle = (*circles)[request];
+            Eigen::Matrix<double, Eigen::Dynamic, 4> constraints(pointCount, 4);
+            for(std::size_t i=0; i<pointCount; ++i){
+                const Mvec point = c2ga::up(&circle.points[i*dimension]);
+                for(unsigned int j=0; j<4; ++j)
+                    constraints(i, j) = (point | (*basis)[j])[c2ga::scalar];
+            }
+            const Eigen::SelfAdjointEigenSolver<Eigen::Matrix4d> solver(constraints.transpose() * constraints);
+            Mvec sphere;
+            for(unsigned int j=0; j<4; ++j)
+                sphere += solver.eigenvectors()(j, 0) * (*basis)[j];
+
+            // S = up(center) - 0.5 radius^2 ei once normalized by S . ei = -1
+            sphere = sphere / -(sphere | c2ga::ei<double>())[c2ga::scalar];
+            c2ga::down(sphere, circle.fittedCenter);
+            circle.fittedRadius = std::sqrt(std::abs((sphere | sphere)[c2ga::scalar]));
+        }, [=](){
+            for(const Circle& circle : *circles){
+                if(!(std::abs(circle.fittedRadius - circle.radius) < 1e-2)) return false;
+                for(unsigned int k=0; k<dimension; ++k)
+                    if(!(std::abs(circle.fittedCenter[k] - circle.center[k]) < 1e-2)) return false;
+            }
+            return true;
+        }};
+    }
+}
+
+
+int main(int argc, char** argv) {
+    c2ga::benchmark::BenchmarkOptions options;
+    if(!c2ga::benchmark::parseBenchmarkOptions(argc, argv, options)) return 2;
+
+    const std::vector<ScenarioCase> scenarios = {circleFitting(options.scale)};
+    return c2ga::benchmark::runScenarios("macro", scenarios, options);
+}
@@ -0,0 +1,222 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// CApi.cpp
+// This file is part of the Garamon for c2ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file CApi.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief C interface of the c2ga library, implemented on top of Mvec<double> and the batch functions.
+
+
+#include "c2ga/CApi.h"
+
+#include <new>
+
+#include "c2ga/Mvec.hpp"
+#include "c2ga/Batch.hpp"
+#include "c2ga/KernelDispatch.hpp"
+#include "c2ga/Conformal.hpp"
+
+
+/// \brief the multivector behind an opaque handle
+struct c2ga_mvec {
+    c2ga::Mvec<double> mv;
+};
+
+
+/// \cond DEV
+// no exception may cross the C interface: the functions returning a status catch them all
+#define C2GA_CAPI_TRY(statements) \
+    try { statements; return 0; } \
+    catch(...) { return -1; }
+
+namespace {
+
+    /// \brief view on the operand of a batch function, stored as multivectors of multivectorSize coefficients
+    inline c2ga::BatchView<const double> operandBatch(const double* data, const ptrdiff_t itemStride) {
+        return {data, itemStride, 1};
+    }
+
+    /// \brief new handle on mv, NULL if the allocation fails
+    inline c2ga_mvec* newHandle(c2ga::Mvec<double>&& mv) {
+        return new (std::nothrow) c2ga_mvec{std::move(mv)};
+    }
+}
+/// \endcond
+
+
+extern "C" {
+
+int c2ga_api_version(void) {
+    return C2GA_CAPI_VERSION;
+}
+
+unsigned int c2ga_algebra_dimension(void) {
+    return c2ga::algebraDimension;
+}
+
+unsigned int c2ga_multivector_size(void) {
+    return c2ga::multivectorSize;
+}
+
+unsigned int c2ga_dense_index(const unsigned int xor_index) {
+    if(xor_index >= c2ga::multivectorSize) return c2ga::multivectorSize;
+    return c2ga::perGradeStartingIndex[c2ga::xorIndexToGrade[xor_index]] + c2ga::xorIndexToHomogeneousIndex[xor_index];
+}
+
+
+c2ga_mvec* c2ga_mvec_new(void) {
+    try { return newHandle(c2ga::Mvec<double>()); }
+    catch(...) { return nullptr; }
+}
+
+c2ga_mvec* c2ga_mvec_from_dense(const double* dense) {
+    try {
+        c2ga::Mvec<double> mv;
+        mv.fromDense(dense);
+        return newHandle(std::move(mv));
+    }
+    catch(...) { return nullptr; }
+}
+
+c2ga_mvec* c2ga_mvec_clone(const c2ga_mvec* mv) {
+    try { return newHandle(c2ga::Mvec<double>(mv->mv)); }
+    catch(...) { return nullptr; }
+}
+
+void c2ga_mvec_free(c2ga_mvec* mv) {
+    delete mv;
+}
+
+void c2ga_mvec_to_dense(const c2ga_mvec* mv, double* dense) {
+    mv->mv.toDense(dense);
+}
+
+double c2ga_mvec_get(const c2ga_mvec* mv, const unsigned int xor_index) {
+    if(xor_index >= c2ga::multivectorSize) return 0.0;
+    double dense[c2ga::multivectorSize];
+    mv->mv.toDense(dense);
+    return dense[c2ga_dense_index(xor_index)];
+}
+
+int c2ga_mvec_set(c2ga_mvec* mv, const unsigned int xor_index, const double value) {
+    if(xor_index >= c2ga::multivectorSize) return -1;
+    C2GA_CAPI_TRY(mv->mv[xor_index] = value)
+}
+
+
+int c2ga_mvec_add(const c2ga_mvec* a, const c2ga_mvec* b, c2ga_mvec* result) {
+    C2GA_CAPI_TRY(result->mv = a->mv + b->mv)
+}
+
+int c2ga_mvec_sub(const c2ga_mvec* a, const c2ga_mvec* b, c2ga_mvec* result) {
+    C2GA_CAPI_TRY(result->mv = a->mv - b->mv)
+}
+
+int c2ga_mvec_scale(const c2ga_mvec* a, const double value, c2ga_mvec* result) {
+    C2GA_CAPI_TRY(result->mv = a->mv * value)
+}
+
+int c2ga_mvec_geometric_product(const c2ga_mvec* a, const c2ga_mvec* b, c2ga_mvec* result) {
+    C2GA_CAPI_TRY(result->mv = a->mv * b->mv)
+}
+
+int c2ga_mvec_outer_product(const c2ga_mvec* a, const c2ga_mvec* b, c2ga_mvec* result) {
+    C2GA_CAPI_TRY(result->mv = a->mv ^ b->mv)
+}
+
+int c2ga_mvec_inner_product(const c2ga_mvec* a, const c2ga_mvec* b, c2ga_mvec* result) {
+    C2GA_CAPI_TRY(result->mv = a->mv | b->mv)
+}
+
+int c2ga_mvec_left_contraction(const c2ga_mvec* a, const c2ga_mvec* b, c2ga_mvec* result) {
+    C2GA_CAPI_TRY(result->mv = a->mv < b->mv)
+}
+
+int c2ga_mvec_right_contraction(const c2ga_mvec* a, const c2ga_mvec* b, c2ga_mvec* result) {
+    C2GA_CAPI_TRY(result->mv = a->mv > b->mv)
+}
+
+int c2ga_mvec_dual(const c2ga_mvec* a, c2ga_mvec* result) {
+    C2GA_CAPI_TRY(result->mv = a->mv.dual())
+}
+
+int c2ga_mvec_reverse(const c2ga_mvec* a, c2ga_mvec* result) {
+    C2GA_CAPI_TRY(result->mv = a->mv.reverse())
+}
+
+int c2ga_mvec_inverse(const c2ga_mvec* a, c2ga_mvec* result) {
+    C2GA_CAPI_TRY(result->mv = a->mv.inv())
+}
+
+double c2ga_mvec_norm(const c2ga_mvec* a) {
+    return a->mv.norm();
+}
+
+
+int c2ga_geometric_product_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    C2GA_CAPI_TRY(c2ga::geometricProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), c2ga::aosBatch(result), count))
+}
+
+int c2ga_outer_product_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    C2GA_CAPI_TRY(c2ga::outerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), c2ga::aosBatch(result), count))
+}
+
+int c2ga_inner_product_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    C2GA_CAPI_TRY(c2ga::innerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), c2ga::aosBatch(result), count, c2ga::InnerKind::inner))
+}
+
+int c2ga_left_contraction_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    C2GA_CAPI_TRY(c2ga::innerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), c2ga::aosBatch(result), count, c2ga::InnerKind::leftContraction))
+}
+
+int c2ga_right_contraction_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    C2GA_CAPI_TRY(c2ga::innerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), c2ga::aosBatch(result), count, c2ga::InnerKind::rightContraction))
+}
+
+int c2ga_apply_versor_batch(const double* versor, const ptrdiff_t versor_stride, const double* mv, const ptrdiff_t mv_stride, double* result, const size_t count) {
+    C2GA_CAPI_TRY(c2ga::applyVersorBatch(operandBatch(versor, versor_stride), operandBatch(mv, mv_stride), c2ga::aosBatch(result), count))
+}
+
+int c2ga_dual_batch(const double* a, const ptrdiff_t a_stride, double* result, const size_t count) {
+    C2GA_CAPI_TRY(c2ga::dualBatch(operandBatch(a, a_stride), c2ga::aosBatch(result), count))
+}
+
+int c2ga_reverse_batch(const double* a, const ptrdiff_t a_stride, double* result, const size_t count) {
+    C2GA_CAPI_TRY(c2ga::reverseBatch(operandBatch(a, a_stride), c2ga::aosBatch(result), count))
+}
+
+int c2ga_norm_batch(const double* a, const ptrdiff_t a_stride, double* norms, const size_t count) {
+    C2GA_CAPI_TRY(c2ga::normBatch(operandBatch(a, a_stride), norms, count))
+}
+
+const char* c2ga_kernel_isa(void) {
+    return c2ga::kernelIsaName(c2ga::activeKernelIsa());
+}
+
+int c2ga_select_kernel_isa(const char* name) {
+    if(name == nullptr) return -1;
+    return c2ga::selectKernelIsa(name) ? 0 : -1;
+}
+
+int c2ga_autotune_kernels(const char* path) {
+    C2GA_CAPI_TRY(if(!c2ga::autotuneKernels(path)) return -1)
+}
+
+unsigned int c2ga_euclidean_dimension(void) {
+    return c2ga::euclideanDimension;
+}
+
+int c2ga_up_batch(const double* points, double* result, const size_t count) {
+    C2GA_CAPI_TRY(c2ga::upBatch(points, c2ga::aosBatch(result), count))
+}
+
+int c2ga_down_batch(const double* mv, const ptrdiff_t mv_stride, double* points, const size_t count) {
+    C2GA_CAPI_TRY(c2ga::downBatch(operandBatch(mv, mv_stride), points, count))
+}
+
+} // extern "C"
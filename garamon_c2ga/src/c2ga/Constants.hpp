@@ -57,6 +57,8 @@ namespace c2ga{
 
     constexpr unsigned int algebraDimension = 4; /*!< dimension of the algebra (number of  basis vectors of grade 1) */
 
+    constexpr unsigned int multivectorSize = 16; /*!< number of coefficients of a full multivector (2^dimension) */
+
     constexpr unsigned int perGradeStartingIndex[5] = {0,1,5,11,15};  /*!< array specifying the index of each first element of grade k in the full multivector */
 
     constexpr unsigned int binomialArray[5] = {1,4,6,4,1};  /*!< array of the (dimension + 1) first binomial coefficients */
@@ -65,20 +67,22 @@ namespace c2ga{
 
     constexpr unsigned int xorIndexToHomogeneousIndex[] = {0,0,1,0,2,1,3,0,3,2,4,1,5,2,3,0}; /*!< given a Xor index in a multivector, this array indicates the corresponding index in the whole homogeneous vector*/
 
-    const std::array<std::vector<unsigned int>, 5> dualPermutations = {{ { 0}, {{ 0,2,1,3}}, {{ 1,0,3,2,5,4}}, {{ 0,2,1,3}}, {0} }}; /*!< array referring to some permutations required to compute the dual. */
+    constexpr unsigned int dualPermutations[5][6] = {{0}, {0,2,1,3}, {1,0,3,2,5,4}, {0,2,1,3}, {0}}; /*!< array referring to some permutations required to compute the dual. */
 
-    const std::array<Eigen::Matrix<double, Eigen::Dynamic,1>, 5> dualCoefficients = loadFastDualArray<double>(); /*!< array containing some basis change coefficients required to compute the dual */
+    constexpr double dualCoefficients[5][6] = {{1.000000}, {1.000000,1.000000,-1.000000,-1.000000}, {-1.000000,1.000000,-1.000000,1.000000,1.000000,-1.000000}, {-1.000000,1.000000,-1.000000,1.000000}, {-1.000000}}; /*!< array containing some basis change coefficients required to compute the dual */
     
     template<typename T>
-    std::array<T, 16> recursiveDualCoefficients = {{ 1.000000,1.000000,1.000000,-1.000000,-1.000000,1.000000,1.000000,-1.000000,-1.000000,-1.000000,1.000000,1.000000,-1.000000,-1.000000,1.000000,1.000000}}; /*!< array containing the coefficients needed to compute the recursive product like (primal^dual) */
+    constexpr std::array<T, 16> recursiveDualCoefficients = {{ 1.000000,1.000000,1.000000,-1.000000,-1.000000,1.000000,1.000000,-1.000000,-1.000000,-1.000000,1.000000,1.000000,-1.000000,-1.000000,1.000000,1.000000}}; /*!< array containing the coefficients needed to compute the recursive product like (primal^dual) */
 
     constexpr double pseudoScalarInverse = -1.000000; /*!< compute the inverse of the pseudo scalar */
 
-    const int signReversePerGrade[5] = {1,1,-1,-1,1}; /*!< array of signs to avoid the computation of (-1)^k*(k-1)/2 during the reverse operation */
+    constexpr int signReversePerGrade[5] = {1,1,-1,-1,1}; /*!< array of signs to avoid the computation of (-1)^k*(k-1)/2 during the reverse operation */
 
-    const std::vector<std::string> basisVectors = {"0", "1", "2", "i"}; /*!< name of the basis vectors (of grade 1) */
+    constexpr const char* basisVectors[] = {"0", "1", "2", "i"}; /*!< name of the basis vectors (of grade 1) */
+    constexpr const char* basisBladeNames[16] = {"", "0", "1", "2", "i", "01", "02", "0i", "12", "1i", "2i", "012", "01i", "02i", "12i", "012i"}; /*!< name of the basis blade of each coefficient of a dense multivector (see Mvec::toDense), written after "e" by operator<< */
+    constexpr unsigned int basisBladeIndices[16] = {0,1,2,5,3,6,8,11,4,7,9,12,10,13,14,15}; /*!< index in a dense multivector of the basis blade whose basis vectors are the bits of the index (bit i for basisVectors[i]) */
 
-    const std::string metric =
+    constexpr const char* metric =
 "\
 	e0	e1	e2	ei	\n\
 e0	0	0	0	-1	\n\
@@ -89,34 +93,42 @@ ei	-1	0	0	0	\n\
 
 
     template<class T>
-    const T zero = 0;
-
-    const unsigned int scalar = 0;
-    const unsigned int E0 = 1;
-    const unsigned int E1 = 2;
-    const unsigned int E2 = 4;
-    const unsigned int Ei = 8;
-    const unsigned int E01 = 3;
-    const unsigned int E02 = 5;
-    const unsigned int E0i = 9;
-    const unsigned int E12 = 6;
-    const unsigned int E1i = 10;
-    const unsigned int E2i = 12;
-    const unsigned int E012 = 7;
-    const unsigned int E01i = 11;
-    const unsigned int E02i = 13;
-    const unsigned int E12i = 14;
-    const unsigned int E012i = 15;
+    constexpr T zero = 0;
+
+    constexpr unsigned int scalar = 0;
+    constexpr unsigned int E0 = 1;
+    constexpr unsigned int E1 = 2;
+    constexpr unsigned int E2 = 4;
+    constexpr unsigned int Ei = 8;
+    constexpr unsigned int E01 = 3;
+    constexpr unsigned int E02 = 5;
+    constexpr unsigned int E0i = 9;
+    constexpr unsigned int E12 = 6;
+    constexpr unsigned int E1i = 10;
+    constexpr unsigned int E2i = 12;
+    constexpr unsigned int E012 = 7;
+    constexpr unsigned int E01i = 11;
+    constexpr unsigned int E02i = 13;
+    constexpr unsigned int E12i = 14;
+    constexpr unsigned int E012i = 15;
     /*!< defines the constants for the cga */
 
+    /// \brief transformation matrices of the k-vectors from the orthogonal basis to the original basis, built on first use (thread-safe)
     template<typename T>
-    const std::array<Eigen::SparseMatrix<T, Eigen::ColMajor>,5> transformationMatrices = loadMatrices<T>(); /*!< set transformation matrices to transform a k-vector from the orhogonal basis to the original basis */
+    const std::array<Eigen::SparseMatrix<T, Eigen::ColMajor>,5>& transformationMatrices() {
+        static const std::array<Eigen::SparseMatrix<T, Eigen::ColMajor>,5> matrices = loadMatrices<T>();
+        return matrices;
+    }
+    /// \brief transformation matrices of the k-vectors from the original basis to the orthogonal basis, built on first use (thread-safe)
     template<typename T>
-    const std::array<Eigen::SparseMatrix<T, Eigen::ColMajor>,5> transformationMatricesInverse = loadMatricesInverse<T>(); /*!< set transformation matrices to transform a k-vector from the original basis to the orhogonal basis */
+    const std::array<Eigen::SparseMatrix<T, Eigen::ColMajor>,5>& transformationMatricesInverse() {
+        static const std::array<Eigen::SparseMatrix<T, Eigen::ColMajor>,5> matrices = loadMatricesInverse<T>();
+        return matrices;
+    }
 
 
     template<typename T>
-    Eigen::Matrix<T, Eigen::Dynamic, 1> diagonalMetric = []()->Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic>{Eigen::Matrix<T, Eigen::Dynamic, 1> tmp(4);tmp<<2.000000,-2.000000,1.000000,1.000000; return tmp;}();   /*!< defines the diagonal metric (stored as a vector) */
+    constexpr std::array<T, 4> diagonalMetric = {{2.000000,-2.000000,1.000000,1.000000}};   /*!< defines the diagonal metric (stored as a vector) */
 
 
 }  // namespace
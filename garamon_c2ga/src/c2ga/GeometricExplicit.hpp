@@ -20,6 +20,7 @@
 
 #include "c2ga/Mvec.hpp"
 #include "c2ga/Constants.hpp"
+#include "c2ga/KernelDispatch.hpp"
 
 
 /*!
@@ -89,9 +90,10 @@ namespace c2ga {
 
 
 	
+    /// \brief kernels of the geometric product per grades: geometricFunctionsContainer<T>[grade mv1 * mv2][grade mv1][grade mv2], constant-initialized
+    /// with the explicit kernels, that the kernel dispatch (KernelDispatch.hpp) replaces when the library is loaded.
     template<typename T>
-	std::array<std::array<std::array<std::function<void(const Eigen::Matrix<T, Eigen::Dynamic, 1> & , const Eigen::Matrix<T, Eigen::Dynamic, 1> & , Eigen::Matrix<T, Eigen::Dynamic, 1>&)>, 5>, 5>, 5> geometricFunctionsContainer =
-	{{
+	std::array<std::array<std::array<KernelEntry<T>, 5>, 5>, 5> geometricFunctionsContainer = {{
 		{{
 			{{{},{},{},{},{}}},
 			{{{},{},{},{},{}}},
@@ -74,7 +74,7 @@ namespace c2ga {
                                                currentGradeMv1 + 1, currentGradeMv2 +1 , currentGradeMv3 ,
                                                tmpSign, -complement,
                                                i, i << 1, indexLastVector_mv2,
-                                                         diagonalMetric<T>(depth)*currentMetricCoefficient, depth+1);
+                                                         diagonalMetric<T>[depth]*currentMetricCoefficient, depth+1);
                 }
 
                 // if we do not reach the grade of mv3 AND if the child of the node of mv3 lead to at least one node whose grade is grade_mv3
@@ -144,7 +144,7 @@ namespace c2ga {
                                                          currentGradeMv1 + 1, currentGradeMv2 +1 , currentGradeMv3 ,
                                                          tmpSign, -complement,
                                                           i << 1,i, indexLastVector_mv3,
-                                                         diagonalMetric<T>(depth)*currentMetricCoefficient,depth+1);
+                                                         diagonalMetric<T>[depth]*currentMetricCoefficient,depth+1);
                 }
 
                 // if we do not reach the grade of mv3 AND if the child of the node of mv3 lead to at least one node whose grade is grade_mv3
@@ -0,0 +1,658 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// OuterDualExplicit.hpp
+// This file is part of the Garamon for c2ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file OuterDualExplicit.hpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Explicit precomputed per grades outer products where one or both multivectors are dualized (see Outer.hpp).
+
+
+#ifndef C2GA_OUTER_DUAL_PRODUCT_EXPLICIT_HPP__
+#define C2GA_OUTER_DUAL_PRODUCT_EXPLICIT_HPP__
+#pragma once
+
+#include <Eigen/Core>
+
+#include "c2ga/Mvec.hpp"
+#include "c2ga/Outer.hpp"
+#include "c2ga/KernelDispatch.hpp"
+
+
+/*!
+ * @namespace c2ga
+ */
+namespace c2ga {
+    template<typename T> class Mvec;
+
+    /// \brief Compute the outer product between the homogeneous multivector mv1 (grade 0) and the dual of the homogeneous multivector mv2 (grade 0).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 0 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 0 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of mv1^dual(mv2), which is also a homogeneous multivector of grade 4
+	template<typename T>
+	void outerPrimalDual_0_0(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the homogeneous multivector mv1 (grade 0) and the dual of the homogeneous multivector mv2 (grade 1).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 0 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 1 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of mv1^dual(mv2), which is also a homogeneous multivector of grade 3
+	template<typename T>
+	void outerPrimalDual_0_1(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) += -mv1.coeff(0)*mv2.coeff(3);
+		mv3.coeffRef(1) += -mv1.coeff(0)*mv2.coeff(2);
+		mv3.coeffRef(2) +=  mv1.coeff(0)*mv2.coeff(1);
+		mv3.coeffRef(3) +=  mv1.coeff(0)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the homogeneous multivector mv1 (grade 0) and the dual of the homogeneous multivector mv2 (grade 2).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 0 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 2 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of mv1^dual(mv2), which is also a homogeneous multivector of grade 2
+	template<typename T>
+	void outerPrimalDual_0_2(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) += -mv1.coeff(0)*mv2.coeff(5);
+		mv3.coeffRef(1) +=  mv1.coeff(0)*mv2.coeff(4);
+		mv3.coeffRef(2) +=  mv1.coeff(0)*mv2.coeff(3);
+		mv3.coeffRef(3) += -mv1.coeff(0)*mv2.coeff(2);
+		mv3.coeffRef(4) +=  mv1.coeff(0)*mv2.coeff(1);
+		mv3.coeffRef(5) += -mv1.coeff(0)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the homogeneous multivector mv1 (grade 0) and the dual of the homogeneous multivector mv2 (grade 3).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 0 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 3 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of mv1^dual(mv2), which is also a homogeneous multivector of grade 1
+	template<typename T>
+	void outerPrimalDual_0_3(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(3);
+		mv3.coeffRef(1) += -mv1.coeff(0)*mv2.coeff(2);
+		mv3.coeffRef(2) +=  mv1.coeff(0)*mv2.coeff(1);
+		mv3.coeffRef(3) += -mv1.coeff(0)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the homogeneous multivector mv1 (grade 0) and the dual of the homogeneous multivector mv2 (grade 4).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 0 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 4 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of mv1^dual(mv2), which is also a homogeneous multivector of grade 0
+	template<typename T>
+	void outerPrimalDual_0_4(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the homogeneous multivector mv1 (grade 1) and the dual of the homogeneous multivector mv2 (grade 1).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 1 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 1 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of mv1^dual(mv2), which is also a homogeneous multivector of grade 4
+	template<typename T>
+	void outerPrimalDual_1_1(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(0) - mv1.coeff(1)*mv2.coeff(1) - mv1.coeff(2)*mv2.coeff(2) + mv1.coeff(3)*mv2.coeff(3);
+	}
+
+
+	/// \brief Compute the outer product between the homogeneous multivector mv1 (grade 1) and the dual of the homogeneous multivector mv2 (grade 2).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 1 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 2 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of mv1^dual(mv2), which is also a homogeneous multivector of grade 3
+	template<typename T>
+	void outerPrimalDual_1_2(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) += -mv1.coeff(0)*mv2.coeff(2) - mv1.coeff(1)*mv2.coeff(4) - mv1.coeff(2)*mv2.coeff(5);
+		mv3.coeffRef(1) +=  mv1.coeff(0)*mv2.coeff(1) - mv1.coeff(1)*mv2.coeff(3) + mv1.coeff(3)*mv2.coeff(5);
+		mv3.coeffRef(2) += -mv1.coeff(0)*mv2.coeff(0) - mv1.coeff(2)*mv2.coeff(3) + mv1.coeff(3)*mv2.coeff(4);
+		mv3.coeffRef(3) +=  mv1.coeff(1)*mv2.coeff(0) + mv1.coeff(2)*mv2.coeff(1) + mv1.coeff(3)*mv2.coeff(2);
+	}
+
+
+	/// \brief Compute the outer product between the homogeneous multivector mv1 (grade 1) and the dual of the homogeneous multivector mv2 (grade 3).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 1 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 3 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of mv1^dual(mv2), which is also a homogeneous multivector of grade 2
+	template<typename T>
+	void outerPrimalDual_1_3(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) += -mv1.coeff(0)*mv2.coeff(2) - mv1.coeff(1)*mv2.coeff(3);
+		mv3.coeffRef(1) +=  mv1.coeff(0)*mv2.coeff(1) - mv1.coeff(2)*mv2.coeff(3);
+		mv3.coeffRef(2) += -mv1.coeff(0)*mv2.coeff(0) + mv1.coeff(3)*mv2.coeff(3);
+		mv3.coeffRef(3) += -mv1.coeff(1)*mv2.coeff(1) - mv1.coeff(2)*mv2.coeff(2);
+		mv3.coeffRef(4) +=  mv1.coeff(1)*mv2.coeff(0) - mv1.coeff(3)*mv2.coeff(2);
+		mv3.coeffRef(5) += -mv1.coeff(2)*mv2.coeff(0) - mv1.coeff(3)*mv2.coeff(1);
+	}
+
+
+	/// \brief Compute the outer product between the homogeneous multivector mv1 (grade 1) and the dual of the homogeneous multivector mv2 (grade 4).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 1 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 4 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of mv1^dual(mv2), which is also a homogeneous multivector of grade 1
+	template<typename T>
+	void outerPrimalDual_1_4(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(0);
+		mv3.coeffRef(1) += -mv1.coeff(1)*mv2.coeff(0);
+		mv3.coeffRef(2) +=  mv1.coeff(2)*mv2.coeff(0);
+		mv3.coeffRef(3) += -mv1.coeff(3)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the homogeneous multivector mv1 (grade 2) and the dual of the homogeneous multivector mv2 (grade 2).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 2 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 2 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of mv1^dual(mv2), which is also a homogeneous multivector of grade 4
+	template<typename T>
+	void outerPrimalDual_2_2(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) += -mv1.coeff(0)*mv2.coeff(0) - mv1.coeff(1)*mv2.coeff(1) - mv1.coeff(2)*mv2.coeff(2) - mv1.coeff(3)*mv2.coeff(3) + mv1.coeff(4)*mv2.coeff(4) - mv1.coeff(5)*mv2.coeff(5);
+	}
+
+
+	/// \brief Compute the outer product between the homogeneous multivector mv1 (grade 2) and the dual of the homogeneous multivector mv2 (grade 3).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 2 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 3 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of mv1^dual(mv2), which is also a homogeneous multivector of grade 3
+	template<typename T>
+	void outerPrimalDual_2_3(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(1) + mv1.coeff(1)*mv2.coeff(2) - mv1.coeff(3)*mv2.coeff(3);
+		mv3.coeffRef(1) += -mv1.coeff(0)*mv2.coeff(0) + mv1.coeff(2)*mv2.coeff(2) + mv1.coeff(4)*mv2.coeff(3);
+		mv3.coeffRef(2) +=  mv1.coeff(1)*mv2.coeff(0) + mv1.coeff(2)*mv2.coeff(1) + mv1.coeff(5)*mv2.coeff(3);
+		mv3.coeffRef(3) += -mv1.coeff(3)*mv2.coeff(0) - mv1.coeff(4)*mv2.coeff(1) + mv1.coeff(5)*mv2.coeff(2);
+	}
+
+
+	/// \brief Compute the outer product between the homogeneous multivector mv1 (grade 2) and the dual of the homogeneous multivector mv2 (grade 4).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 2 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 4 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of mv1^dual(mv2), which is also a homogeneous multivector of grade 2
+	template<typename T>
+	void outerPrimalDual_2_4(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(0);
+		mv3.coeffRef(1) += -mv1.coeff(1)*mv2.coeff(0);
+		mv3.coeffRef(2) +=  mv1.coeff(2)*mv2.coeff(0);
+		mv3.coeffRef(3) +=  mv1.coeff(3)*mv2.coeff(0);
+		mv3.coeffRef(4) += -mv1.coeff(4)*mv2.coeff(0);
+		mv3.coeffRef(5) +=  mv1.coeff(5)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the homogeneous multivector mv1 (grade 3) and the dual of the homogeneous multivector mv2 (grade 3).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 3 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 3 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of mv1^dual(mv2), which is also a homogeneous multivector of grade 4
+	template<typename T>
+	void outerPrimalDual_3_3(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) += -mv1.coeff(0)*mv2.coeff(0) - mv1.coeff(1)*mv2.coeff(1) + mv1.coeff(2)*mv2.coeff(2) - mv1.coeff(3)*mv2.coeff(3);
+	}
+
+
+	/// \brief Compute the outer product between the homogeneous multivector mv1 (grade 3) and the dual of the homogeneous multivector mv2 (grade 4).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 3 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 4 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of mv1^dual(mv2), which is also a homogeneous multivector of grade 3
+	template<typename T>
+	void outerPrimalDual_3_4(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(0);
+		mv3.coeffRef(1) += -mv1.coeff(1)*mv2.coeff(0);
+		mv3.coeffRef(2) +=  mv1.coeff(2)*mv2.coeff(0);
+		mv3.coeffRef(3) += -mv1.coeff(3)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the homogeneous multivector mv1 (grade 4) and the dual of the homogeneous multivector mv2 (grade 4).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 4 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 4 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of mv1^dual(mv2), which is also a homogeneous multivector of grade 4
+	template<typename T>
+	void outerPrimalDual_4_4(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the dual of the homogeneous multivector mv1 (grade 0) and the homogeneous multivector mv2 (grade 0).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 0 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 0 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^mv2, which is also a homogeneous multivector of grade 4
+	template<typename T>
+	void outerDualPrimal_0_0(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the dual of the homogeneous multivector mv1 (grade 0) and the homogeneous multivector mv2 (grade 1).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 0 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 1 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^mv2, which is also a homogeneous multivector of grade 3
+	template<typename T>
+	void outerDualPrimal_0_1(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) += -mv1.coeff(0)*mv2.coeff(3);
+		mv3.coeffRef(1) += -mv1.coeff(0)*mv2.coeff(2);
+		mv3.coeffRef(2) +=  mv1.coeff(0)*mv2.coeff(1);
+		mv3.coeffRef(3) +=  mv1.coeff(0)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the dual of the homogeneous multivector mv1 (grade 0) and the homogeneous multivector mv2 (grade 2).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 0 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 2 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^mv2, which is also a homogeneous multivector of grade 2
+	template<typename T>
+	void outerDualPrimal_0_2(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) += -mv1.coeff(0)*mv2.coeff(5);
+		mv3.coeffRef(1) +=  mv1.coeff(0)*mv2.coeff(4);
+		mv3.coeffRef(2) +=  mv1.coeff(0)*mv2.coeff(3);
+		mv3.coeffRef(3) += -mv1.coeff(0)*mv2.coeff(2);
+		mv3.coeffRef(4) +=  mv1.coeff(0)*mv2.coeff(1);
+		mv3.coeffRef(5) += -mv1.coeff(0)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the dual of the homogeneous multivector mv1 (grade 0) and the homogeneous multivector mv2 (grade 3).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 0 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 3 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^mv2, which is also a homogeneous multivector of grade 1
+	template<typename T>
+	void outerDualPrimal_0_3(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(3);
+		mv3.coeffRef(1) += -mv1.coeff(0)*mv2.coeff(2);
+		mv3.coeffRef(2) +=  mv1.coeff(0)*mv2.coeff(1);
+		mv3.coeffRef(3) += -mv1.coeff(0)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the dual of the homogeneous multivector mv1 (grade 0) and the homogeneous multivector mv2 (grade 4).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 0 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 4 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^mv2, which is also a homogeneous multivector of grade 0
+	template<typename T>
+	void outerDualPrimal_0_4(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the dual of the homogeneous multivector mv1 (grade 1) and the homogeneous multivector mv2 (grade 1).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 1 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 1 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^mv2, which is also a homogeneous multivector of grade 4
+	template<typename T>
+	void outerDualPrimal_1_1(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(0) - mv1.coeff(1)*mv2.coeff(1) - mv1.coeff(2)*mv2.coeff(2) + mv1.coeff(3)*mv2.coeff(3);
+	}
+
+
+	/// \brief Compute the outer product between the dual of the homogeneous multivector mv1 (grade 1) and the homogeneous multivector mv2 (grade 2).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 1 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 2 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^mv2, which is also a homogeneous multivector of grade 3
+	template<typename T>
+	void outerDualPrimal_1_2(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) += -mv1.coeff(0)*mv2.coeff(2) - mv1.coeff(1)*mv2.coeff(4) - mv1.coeff(2)*mv2.coeff(5);
+		mv3.coeffRef(1) +=  mv1.coeff(0)*mv2.coeff(1) - mv1.coeff(1)*mv2.coeff(3) + mv1.coeff(3)*mv2.coeff(5);
+		mv3.coeffRef(2) += -mv1.coeff(0)*mv2.coeff(0) - mv1.coeff(2)*mv2.coeff(3) + mv1.coeff(3)*mv2.coeff(4);
+		mv3.coeffRef(3) +=  mv1.coeff(1)*mv2.coeff(0) + mv1.coeff(2)*mv2.coeff(1) + mv1.coeff(3)*mv2.coeff(2);
+	}
+
+
+	/// \brief Compute the outer product between the dual of the homogeneous multivector mv1 (grade 1) and the homogeneous multivector mv2 (grade 3).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 1 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 3 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^mv2, which is also a homogeneous multivector of grade 2
+	template<typename T>
+	void outerDualPrimal_1_3(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) += -mv1.coeff(0)*mv2.coeff(2) - mv1.coeff(1)*mv2.coeff(3);
+		mv3.coeffRef(1) +=  mv1.coeff(0)*mv2.coeff(1) - mv1.coeff(2)*mv2.coeff(3);
+		mv3.coeffRef(2) += -mv1.coeff(0)*mv2.coeff(0) + mv1.coeff(3)*mv2.coeff(3);
+		mv3.coeffRef(3) += -mv1.coeff(1)*mv2.coeff(1) - mv1.coeff(2)*mv2.coeff(2);
+		mv3.coeffRef(4) +=  mv1.coeff(1)*mv2.coeff(0) - mv1.coeff(3)*mv2.coeff(2);
+		mv3.coeffRef(5) += -mv1.coeff(2)*mv2.coeff(0) - mv1.coeff(3)*mv2.coeff(1);
+	}
+
+
+	/// \brief Compute the outer product between the dual of the homogeneous multivector mv1 (grade 1) and the homogeneous multivector mv2 (grade 4).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 1 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 4 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^mv2, which is also a homogeneous multivector of grade 1
+	template<typename T>
+	void outerDualPrimal_1_4(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(0);
+		mv3.coeffRef(1) += -mv1.coeff(1)*mv2.coeff(0);
+		mv3.coeffRef(2) +=  mv1.coeff(2)*mv2.coeff(0);
+		mv3.coeffRef(3) += -mv1.coeff(3)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the dual of the homogeneous multivector mv1 (grade 2) and the homogeneous multivector mv2 (grade 2).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 2 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 2 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^mv2, which is also a homogeneous multivector of grade 4
+	template<typename T>
+	void outerDualPrimal_2_2(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) += -mv1.coeff(0)*mv2.coeff(0) - mv1.coeff(1)*mv2.coeff(1) - mv1.coeff(2)*mv2.coeff(2) - mv1.coeff(3)*mv2.coeff(3) + mv1.coeff(4)*mv2.coeff(4) - mv1.coeff(5)*mv2.coeff(5);
+	}
+
+
+	/// \brief Compute the outer product between the dual of the homogeneous multivector mv1 (grade 2) and the homogeneous multivector mv2 (grade 3).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 2 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 3 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^mv2, which is also a homogeneous multivector of grade 3
+	template<typename T>
+	void outerDualPrimal_2_3(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(1) + mv1.coeff(1)*mv2.coeff(2) - mv1.coeff(3)*mv2.coeff(3);
+		mv3.coeffRef(1) += -mv1.coeff(0)*mv2.coeff(0) + mv1.coeff(2)*mv2.coeff(2) + mv1.coeff(4)*mv2.coeff(3);
+		mv3.coeffRef(2) +=  mv1.coeff(1)*mv2.coeff(0) + mv1.coeff(2)*mv2.coeff(1) + mv1.coeff(5)*mv2.coeff(3);
+		mv3.coeffRef(3) += -mv1.coeff(3)*mv2.coeff(0) - mv1.coeff(4)*mv2.coeff(1) + mv1.coeff(5)*mv2.coeff(2);
+	}
+
+
+	/// \brief Compute the outer product between the dual of the homogeneous multivector mv1 (grade 2) and the homogeneous multivector mv2 (grade 4).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 2 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 4 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^mv2, which is also a homogeneous multivector of grade 2
+	template<typename T>
+	void outerDualPrimal_2_4(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(0);
+		mv3.coeffRef(1) += -mv1.coeff(1)*mv2.coeff(0);
+		mv3.coeffRef(2) +=  mv1.coeff(2)*mv2.coeff(0);
+		mv3.coeffRef(3) +=  mv1.coeff(3)*mv2.coeff(0);
+		mv3.coeffRef(4) += -mv1.coeff(4)*mv2.coeff(0);
+		mv3.coeffRef(5) +=  mv1.coeff(5)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the dual of the homogeneous multivector mv1 (grade 3) and the homogeneous multivector mv2 (grade 3).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 3 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 3 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^mv2, which is also a homogeneous multivector of grade 4
+	template<typename T>
+	void outerDualPrimal_3_3(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) += -mv1.coeff(0)*mv2.coeff(0) - mv1.coeff(1)*mv2.coeff(1) + mv1.coeff(2)*mv2.coeff(2) - mv1.coeff(3)*mv2.coeff(3);
+	}
+
+
+	/// \brief Compute the outer product between the dual of the homogeneous multivector mv1 (grade 3) and the homogeneous multivector mv2 (grade 4).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 3 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 4 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^mv2, which is also a homogeneous multivector of grade 3
+	template<typename T>
+	void outerDualPrimal_3_4(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(0);
+		mv3.coeffRef(1) += -mv1.coeff(1)*mv2.coeff(0);
+		mv3.coeffRef(2) +=  mv1.coeff(2)*mv2.coeff(0);
+		mv3.coeffRef(3) += -mv1.coeff(3)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the dual of the homogeneous multivector mv1 (grade 4) and the homogeneous multivector mv2 (grade 4).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 4 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 4 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^mv2, which is also a homogeneous multivector of grade 4
+	template<typename T>
+	void outerDualPrimal_4_4(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the duals of the homogeneous multivectors mv1 (grade 0) and mv2 (grade 0).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 0 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 0 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^dual(mv2), which is also a homogeneous multivector of grade 4
+	template<typename T>
+	void outerDualDual_0_0(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the duals of the homogeneous multivectors mv1 (grade 0) and mv2 (grade 1).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 0 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 1 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^dual(mv2), which is also a homogeneous multivector of grade 3
+	template<typename T>
+	void outerDualDual_0_1(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) += -mv1.coeff(0)*mv2.coeff(0);
+		mv3.coeffRef(1) +=  mv1.coeff(0)*mv2.coeff(1);
+		mv3.coeffRef(2) += -mv1.coeff(0)*mv2.coeff(2);
+		mv3.coeffRef(3) +=  mv1.coeff(0)*mv2.coeff(3);
+	}
+
+
+	/// \brief Compute the outer product between the duals of the homogeneous multivectors mv1 (grade 0) and mv2 (grade 2).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 0 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 2 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^dual(mv2), which is also a homogeneous multivector of grade 2
+	template<typename T>
+	void outerDualDual_0_2(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) += -mv1.coeff(0)*mv2.coeff(0);
+		mv3.coeffRef(1) +=  mv1.coeff(0)*mv2.coeff(1);
+		mv3.coeffRef(2) += -mv1.coeff(0)*mv2.coeff(2);
+		mv3.coeffRef(3) +=  mv1.coeff(0)*mv2.coeff(3);
+		mv3.coeffRef(4) +=  mv1.coeff(0)*mv2.coeff(4);
+		mv3.coeffRef(5) += -mv1.coeff(0)*mv2.coeff(5);
+	}
+
+
+	/// \brief Compute the outer product between the duals of the homogeneous multivectors mv1 (grade 0) and mv2 (grade 3).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 0 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 3 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^dual(mv2), which is also a homogeneous multivector of grade 1
+	template<typename T>
+	void outerDualDual_0_3(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(0);
+		mv3.coeffRef(1) +=  mv1.coeff(0)*mv2.coeff(1);
+		mv3.coeffRef(2) += -mv1.coeff(0)*mv2.coeff(2);
+		mv3.coeffRef(3) += -mv1.coeff(0)*mv2.coeff(3);
+	}
+
+
+	/// \brief Compute the outer product between the duals of the homogeneous multivectors mv1 (grade 0) and mv2 (grade 4).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 0 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 4 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^dual(mv2), which is also a homogeneous multivector of grade 0
+	template<typename T>
+	void outerDualDual_0_4(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the duals of the homogeneous multivectors mv1 (grade 1) and mv2 (grade 1).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 1 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 1 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^dual(mv2), which is also a homogeneous multivector of grade 4
+	template<typename T>
+	void outerDualDual_1_1(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(0) + mv1.coeff(1)*mv2.coeff(1) + mv1.coeff(2)*mv2.coeff(2) + mv1.coeff(3)*mv2.coeff(3);
+	}
+
+
+	/// \brief Compute the outer product between the duals of the homogeneous multivectors mv1 (grade 1) and mv2 (grade 2).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 1 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 2 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^dual(mv2), which is also a homogeneous multivector of grade 3
+	template<typename T>
+	void outerDualDual_1_2(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) += -mv1.coeff(1)*mv2.coeff(0) - mv1.coeff(2)*mv2.coeff(1) + mv1.coeff(3)*mv2.coeff(3);
+		mv3.coeffRef(1) +=  mv1.coeff(0)*mv2.coeff(0) + mv1.coeff(2)*mv2.coeff(2) + mv1.coeff(3)*mv2.coeff(4);
+		mv3.coeffRef(2) +=  mv1.coeff(0)*mv2.coeff(1) + mv1.coeff(1)*mv2.coeff(2) - mv1.coeff(3)*mv2.coeff(5);
+		mv3.coeffRef(3) += -mv1.coeff(0)*mv2.coeff(3) + mv1.coeff(1)*mv2.coeff(4) + mv1.coeff(2)*mv2.coeff(5);
+	}
+
+
+	/// \brief Compute the outer product between the duals of the homogeneous multivectors mv1 (grade 1) and mv2 (grade 3).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 1 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 3 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^dual(mv2), which is also a homogeneous multivector of grade 2
+	template<typename T>
+	void outerDualDual_1_3(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) += -mv1.coeff(2)*mv2.coeff(0) + mv1.coeff(3)*mv2.coeff(1);
+		mv3.coeffRef(1) += -mv1.coeff(1)*mv2.coeff(0) - mv1.coeff(3)*mv2.coeff(2);
+		mv3.coeffRef(2) +=  mv1.coeff(0)*mv2.coeff(0) - mv1.coeff(3)*mv2.coeff(3);
+		mv3.coeffRef(3) +=  mv1.coeff(1)*mv2.coeff(1) + mv1.coeff(2)*mv2.coeff(2);
+		mv3.coeffRef(4) +=  mv1.coeff(0)*mv2.coeff(1) + mv1.coeff(2)*mv2.coeff(3);
+		mv3.coeffRef(5) +=  mv1.coeff(0)*mv2.coeff(2) - mv1.coeff(1)*mv2.coeff(3);
+	}
+
+
+	/// \brief Compute the outer product between the duals of the homogeneous multivectors mv1 (grade 1) and mv2 (grade 4).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 1 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 4 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^dual(mv2), which is also a homogeneous multivector of grade 1
+	template<typename T>
+	void outerDualDual_1_4(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(3)*mv2.coeff(0);
+		mv3.coeffRef(1) += -mv1.coeff(2)*mv2.coeff(0);
+		mv3.coeffRef(2) +=  mv1.coeff(1)*mv2.coeff(0);
+		mv3.coeffRef(3) += -mv1.coeff(0)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the duals of the homogeneous multivectors mv1 (grade 2) and mv2 (grade 2).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 2 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 2 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^dual(mv2), which is also a homogeneous multivector of grade 4
+	template<typename T>
+	void outerDualDual_2_2(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) += -mv1.coeff(0)*mv2.coeff(0) + mv1.coeff(1)*mv2.coeff(1) + mv1.coeff(2)*mv2.coeff(2) + mv1.coeff(3)*mv2.coeff(3) - mv1.coeff(4)*mv2.coeff(4) - mv1.coeff(5)*mv2.coeff(5);
+	}
+
+
+	/// \brief Compute the outer product between the duals of the homogeneous multivectors mv1 (grade 2) and mv2 (grade 3).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 2 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 3 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^dual(mv2), which is also a homogeneous multivector of grade 3
+	template<typename T>
+	void outerDualDual_2_3(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) += -mv1.coeff(2)*mv2.coeff(0) - mv1.coeff(4)*mv2.coeff(1) - mv1.coeff(5)*mv2.coeff(2);
+		mv3.coeffRef(1) +=  mv1.coeff(1)*mv2.coeff(0) - mv1.coeff(3)*mv2.coeff(1) - mv1.coeff(5)*mv2.coeff(3);
+		mv3.coeffRef(2) +=  mv1.coeff(0)*mv2.coeff(0) - mv1.coeff(3)*mv2.coeff(2) + mv1.coeff(4)*mv2.coeff(3);
+		mv3.coeffRef(3) += -mv1.coeff(0)*mv2.coeff(1) + mv1.coeff(1)*mv2.coeff(2) - mv1.coeff(2)*mv2.coeff(3);
+	}
+
+
+	/// \brief Compute the outer product between the duals of the homogeneous multivectors mv1 (grade 2) and mv2 (grade 4).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 2 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 4 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^dual(mv2), which is also a homogeneous multivector of grade 2
+	template<typename T>
+	void outerDualDual_2_4(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(5)*mv2.coeff(0);
+		mv3.coeffRef(1) += -mv1.coeff(4)*mv2.coeff(0);
+		mv3.coeffRef(2) +=  mv1.coeff(3)*mv2.coeff(0);
+		mv3.coeffRef(3) +=  mv1.coeff(2)*mv2.coeff(0);
+		mv3.coeffRef(4) += -mv1.coeff(1)*mv2.coeff(0);
+		mv3.coeffRef(5) +=  mv1.coeff(0)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the duals of the homogeneous multivectors mv1 (grade 3) and mv2 (grade 3).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 3 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 3 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^dual(mv2), which is also a homogeneous multivector of grade 4
+	template<typename T>
+	void outerDualDual_3_3(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) += -mv1.coeff(0)*mv2.coeff(0) - mv1.coeff(1)*mv2.coeff(1) + mv1.coeff(2)*mv2.coeff(2) - mv1.coeff(3)*mv2.coeff(3);
+	}
+
+
+	/// \brief Compute the outer product between the duals of the homogeneous multivectors mv1 (grade 3) and mv2 (grade 4).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 3 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 4 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^dual(mv2), which is also a homogeneous multivector of grade 3
+	template<typename T>
+	void outerDualDual_3_4(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(3)*mv2.coeff(0);
+		mv3.coeffRef(1) += -mv1.coeff(2)*mv2.coeff(0);
+		mv3.coeffRef(2) +=  mv1.coeff(1)*mv2.coeff(0);
+		mv3.coeffRef(3) += -mv1.coeff(0)*mv2.coeff(0);
+	}
+
+
+	/// \brief Compute the outer product between the duals of the homogeneous multivectors mv1 (grade 4) and mv2 (grade 4).
+	/// \tparam the type of value that we manipulate, either float or double or something.
+	/// \param mv1 - the first homogeneous multivector of grade 4 represented as an Eigen::VectorXd
+	/// \param mv2 - the second homogeneous multivector of grade 4 represented as a Eigen::VectorXd
+	/// \param mv3 - the result of dual(mv1)^dual(mv2), which is also a homogeneous multivector of grade 4
+	template<typename T>
+	void outerDualDual_4_4(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3){
+		mv3.coeffRef(0) +=  mv1.coeff(0)*mv2.coeff(0);
+	}
+
+
+    /// \brief kernels of outerPrimalDual per grades: outerPrimalDualFunctionsContainer<T>[grade mv1][grade mv2], nullptr when grade mv1 > grade mv2 (constant data)
+    template<typename T>
+	constexpr std::array<std::array<ProductKernel<T>*, 5>, 5> outerPrimalDualFunctionsContainer = {{
+		{{outerPrimalDual_0_0<T>,outerPrimalDual_0_1<T>,outerPrimalDual_0_2<T>,outerPrimalDual_0_3<T>,outerPrimalDual_0_4<T>}},
+		{{{},outerPrimalDual_1_1<T>,outerPrimalDual_1_2<T>,outerPrimalDual_1_3<T>,outerPrimalDual_1_4<T>}},
+		{{{},{},outerPrimalDual_2_2<T>,outerPrimalDual_2_3<T>,outerPrimalDual_2_4<T>}},
+		{{{},{},{},outerPrimalDual_3_3<T>,outerPrimalDual_3_4<T>}},
+		{{{},{},{},{},outerPrimalDual_4_4<T>}}
+	}};
+
+    /// \brief kernels of outerDualPrimal per grades: outerDualPrimalFunctionsContainer<T>[grade mv1][grade mv2], nullptr when grade mv1 > grade mv2 (constant data)
+    template<typename T>
+	constexpr std::array<std::array<ProductKernel<T>*, 5>, 5> outerDualPrimalFunctionsContainer = {{
+		{{outerDualPrimal_0_0<T>,outerDualPrimal_0_1<T>,outerDualPrimal_0_2<T>,outerDualPrimal_0_3<T>,outerDualPrimal_0_4<T>}},
+		{{{},outerDualPrimal_1_1<T>,outerDualPrimal_1_2<T>,outerDualPrimal_1_3<T>,outerDualPrimal_1_4<T>}},
+		{{{},{},outerDualPrimal_2_2<T>,outerDualPrimal_2_3<T>,outerDualPrimal_2_4<T>}},
+		{{{},{},{},outerDualPrimal_3_3<T>,outerDualPrimal_3_4<T>}},
+		{{{},{},{},{},outerDualPrimal_4_4<T>}}
+	}};
+
+    /// \brief kernels of outerDualDual per grades: outerDualDualFunctionsContainer<T>[grade mv1][grade mv2], nullptr when grade mv1 > grade mv2 (constant data)
+    template<typename T>
+	constexpr std::array<std::array<ProductKernel<T>*, 5>, 5> outerDualDualFunctionsContainer = {{
+		{{outerDualDual_0_0<T>,outerDualDual_0_1<T>,outerDualDual_0_2<T>,outerDualDual_0_3<T>,outerDualDual_0_4<T>}},
+		{{{},outerDualDual_1_1<T>,outerDualDual_1_2<T>,outerDualDual_1_3<T>,outerDualDual_1_4<T>}},
+		{{{},{},outerDualDual_2_2<T>,outerDualDual_2_3<T>,outerDualDual_2_4<T>}},
+		{{{},{},{},outerDualDual_3_3<T>,outerDualDual_3_4<T>}},
+		{{{},{},{},{},outerDualDual_4_4<T>}}
+	}};
+
+}/// End of Namespace
+
+#endif // C2GA_OUTER_DUAL_PRODUCT_EXPLICIT_HPP__
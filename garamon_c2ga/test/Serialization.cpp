@@ -0,0 +1,117 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Serialization.cpp
+// This file is part of the Garamon for c2ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Serialization.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Test of the binary encoding of multivectors and arrays of multivectors (Serialization.hpp), for float and double:
+///  - the round trips of random multivectors of each set of grades, of 0, and of arrays of them,
+///  - an array of zeros keeps its size, and is encoded with the coefficients of its grade 0,
+///  - the malformed encodings are rejected, before any allocation, and leave the decoded value unchanged: a huge array
+///    without coefficients, sizes that wrap, truncated buffers, another type of coefficients, grades above the dimension.
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "c2ga/Mvec.hpp"
+#include "c2ga/MvecArray.hpp"
+#include "c2ga/MvecFile.hpp"
+#include "c2ga/Serialization.hpp"
+
+#include "RandomMvec.hpp"
+#include "Test.hpp"
+
+
+namespace {
+
+    using c2ga::test::check;
+    using c2ga::test::randomMvec;
+    using c2ga::test::sameMvec;
+    using c2ga::test::typeName;
+
+    /// \brief encoding of an array of double: coefficient size, count and grade bitmap, then size bytes of coefficients
+    std::string arrayEncoding(const std::uint64_t count, const std::uint32_t gradeBitmap, const std::size_t size) {
+        std::string buffer;
+        c2ga::appendBytes(buffer, (std::uint8_t)sizeof(double));
+        c2ga::appendBytes(buffer, count);
+        c2ga::appendBytes(buffer, gradeBitmap);
+        return buffer + std::string(size, '\0');
+    }
+
+    template<typename T>
+    void testRoundTrips(std::mt19937& randomEngine) {
+        bool multivectors = true, arrays = true;
+        for(std::uint32_t gradeBitmap=0; gradeBitmap<=c2ga::allGradesBitmap; ++gradeBitmap){
+            const c2ga::Mvec<T> mv = randomMvec<T>(randomEngine, gradeBitmap);
+            const std::string buffer = c2ga::serialize(mv);
+            c2ga::Mvec<T> decoded;
+            multivectors = multivectors && buffer.size() == 1 + sizeof(std::uint32_t) + c2ga::serializedCoefficientCount(gradeBitmap)*sizeof(T)
+                && c2ga::deserialize(buffer, decoded) && sameMvec(decoded, mv);
+
+            // an array whose multivectors have some of the grades of gradeBitmap
+            std::vector<c2ga::Mvec<T>> mvs;
+            for(std::uint32_t grades=0; grades<=gradeBitmap; ++grades)
+                if((grades & gradeBitmap) == grades) mvs.push_back(randomMvec<T>(randomEngine, grades));
+            c2ga::MvecArray<T> array;
+            arrays = arrays && c2ga::deserialize(c2ga::serialize(c2ga::MvecArray<T>(mvs)), array) && array.size() == mvs.size();
+            for(std::size_t i=0; arrays && i<mvs.size(); ++i)
+                arrays = sameMvec(array.at(i), mvs[i]);
+        }
+        check(multivectors, "round trip of multivectors of each set of grades, " + typeName<T>());
+        check(arrays, "round trip of arrays of multivectors, " + typeName<T>());
+
+        c2ga::MvecArray<T> empty(std::vector<c2ga::Mvec<T>>{}), decoded(3);
+        check(c2ga::deserialize(c2ga::serialize(empty), decoded) && decoded.size() == 0, "round trip of an empty array, " + typeName<T>());
+
+        const std::string zeros = c2ga::serialize(c2ga::MvecArray<T>(4));
+        check(zeros.size() == 1 + sizeof(std::uint64_t) + sizeof(std::uint32_t) + 4*sizeof(T)
+              && c2ga::deserialize(zeros, decoded) && decoded.size() == 4 && sameMvec(decoded.at(3), c2ga::Mvec<T>()),
+              "array of zeros encoded with its grade 0, " + typeName<T>());
+    }
+
+    void testMalformedArrays() {
+        c2ga::MvecArray<double> array(2);
+        array.set(1, c2ga::Mvec<double>() + 2.0);
+        const std::string truncated = c2ga::serialize(c2ga::MvecArray<double>(std::vector<c2ga::Mvec<double>>(3, c2ga::Mvec<double>() + 1.0)));
+        check(!c2ga::deserialize(arrayEncoding(std::uint64_t(1) << 59, 0, 0), array), "huge array without coefficients rejected");
+        check(!c2ga::deserialize(arrayEncoding(3, 0, 0), array), "array without coefficients rejected");
+        check(!c2ga::deserialize(arrayEncoding(std::uint64_t(1) << 62, 1, 0), array), "array whose size wraps rejected");
+        check(!c2ga::deserialize(arrayEncoding(~std::uint64_t(0), c2ga::allGradesBitmap, 8), array), "array of the largest count rejected");
+        check(!c2ga::deserialize(truncated.substr(0, truncated.size() - 1), array), "truncated array rejected");
+        check(!c2ga::deserialize(arrayEncoding(2, 1, 8), array), "array with too few coefficients rejected");
+        check(!c2ga::deserialize(arrayEncoding(1, c2ga::allGradesBitmap + 1, 0), array), "array of a grade above the dimension rejected");
+        check(!c2ga::deserialize(truncated.substr(0, 5), array), "truncated header rejected");
+
+        c2ga::MvecArray<float> floats;
+        check(!c2ga::deserialize(truncated, floats), "array of double rejected as float");
+        check(array.size() == 2 && sameMvec(array.at(1), c2ga::Mvec<double>() + 2.0), "array unchanged by the rejected encodings");
+
+        c2ga::Mvec<double> mv = c2ga::Mvec<double>() + 3.0;
+        const std::string encoded = c2ga::serialize(c2ga::Mvec<double>() + 1.0);
+        std::string aboveDimension = encoded;
+        const std::uint32_t gradeAboveDimension = 1u << (c2ga::algebraDimension+1);
+        std::memcpy(&aboveDimension[1], &gradeAboveDimension, sizeof(gradeAboveDimension));
+        check(!c2ga::deserialize(encoded.substr(0, encoded.size() - 1), mv) && !c2ga::deserialize(encoded + '\0', mv)
+              && !c2ga::deserialize(aboveDimension, mv) && sameMvec(mv, c2ga::Mvec<double>() + 3.0),
+              "malformed multivectors rejected, the multivector unchanged");
+    }
+}
+
+
+int main() {
+    std::mt19937 randomEngine(11);
+    testRoundTrips<float>(randomEngine);
+    testRoundTrips<double>(randomEngine);
+    testMalformedArrays();
+    return c2ga::test::testResult();
+}
@@ -0,0 +1,430 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Benchmark.hpp
+// This file is part of the Garamon for c3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Benchmark.hpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Timing of the benchmarks of c3ga and their report in JSON. Included by a single source file of a program
+/// (see AllocationCounter.hpp).
+///
+/// Each benchmark is run n times, n being doubled until a run lasts at least the minimum time, then the best of several
+/// runs of n gives the time per operation. The allocations per operation are counted during the first of these runs, the
+/// hardware counters (optional) are those of the best run.
+///
+/// A scenario of the macro benchmarks is run in several passes over its requests, each request being timed: the best
+/// pass gives the time per item, all the requests give the latency percentiles.
+///
+/// The report is a JSON object {"algebra", "suite", "isa", "benchmarks": [{"name", "operation", "engine", "grades",
+/// "nsPerOp", "allocsPerOp", "iterations", "counters"}]}, counters being null when they are not measured; the scenarios
+/// add "itemsPerSecond" and "latencyNs": {"p50", "p90", "p99", "max"} of a request. The names of the benchmarks are
+/// stable, they identify the benchmarks of two reports (see CompareBenchmarks.cpp).
+///
+/// The cases of the kernels and of the products of Mvec, on random operands, are shared by the benchmark programs
+/// (addKernels, addMvecProducts): they are added to a vector of BenchmarkCase, or of the cases of another program.
+
+
+#ifndef C3GA_BENCHMARK_HPP__
+#define C3GA_BENCHMARK_HPP__
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "c3ga/Mvec.hpp"
+#include "c3ga/KernelDispatch.hpp"
+
+#include "AllocationCounter.hpp"
+#include "HardwareCounters.hpp"
+
+
+namespace c3ga {
+namespace benchmark {
+
+    /// \brief prevent the compiler from removing the computation of value
+    template<typename T>
+    inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    /// \brief a benchmark: run(n) computes the operation n times
+    struct BenchmarkCase {
+        std::string name;                     /*!< unique and stable name */
+        std::string operation;                /*!< operation, e.g. outer, geometric, dual */
+        std::string engine;                   /*!< implementation, e.g. kernel, recursive, Mvec */
+        std::vector<unsigned int> grades;     /*!< grades of the operands, then of the result when it is fixed */
+        std::function<void(std::size_t)> run;
+    };
+
+    /// \brief a scenario of the macro benchmarks: a workload of requests (e.g. transform 4096 points), each of
+    /// itemsPerRequest items (points). A pass computes all the requests, run(r) computes the request r.
+    struct ScenarioCase {
+        std::string name;
+        std::size_t requests;
+        std::size_t itemsPerRequest;
+        std::function<void(std::size_t)> run;
+        std::function<bool()> check;          /*!< true if the results of the last pass are right, optional */
+        std::function<void()> setup;          /*!< called before each pass, not timed, optional */
+    };
+
+    /// \brief options of the benchmark programs, given on the command line
+    struct BenchmarkOptions {
+        double minTime = 1e-3;                /*!< seconds of a run: --min-time <milliseconds> */
+        unsigned int repetitions = 5;         /*!< runs (passes of a scenario) whose best is kept: --repetitions <count> */
+        bool counters = false;                /*!< measure the hardware counters: --counters */
+        std::string filter;                   /*!< only the benchmarks whose name contains it: --filter <text> */
+        std::string output;                   /*!< file of the report, standard output when empty: --output <path> */
+        double scale = 1.0;                   /*!< factor of the size of the scenarios: --scale <factor> */
+        unsigned int threads = 0;             /*!< maximum number of threads, 0 for the hardware threads: --threads <count> */
+        int mallocArenas = 0;                 /*!< arenas of the glibc allocator, 0 for its default: --malloc-arenas <count> */
+    };
+
+    /// \brief measure of a benchmark
+    struct BenchmarkResult {
+        double nsPerOp = 0.0;
+        double allocsPerOp = 0.0;
+        std::size_t iterations = 0;
+        bool hasCounters = false;
+        HardwareCounterValues counters;
+        bool hasLatency = false;              /*!< scenarios only: throughput and latencies of the requests */
+        double itemsPerSecond = 0.0;
+        double latency[4] = {};               /*!< nanoseconds: median, 90th and 99th percentiles, maximum */
+        std::string members;                  /*!< additional members of the report, e.g. "\"threads\": 4", optional */
+    };
+
+    /// \brief read the options of argv
+    /// \return false, after writing the usage, if an argument is not an option
+    inline bool parseBenchmarkOptions(const int argc, char** argv, BenchmarkOptions& options) {
+        for(int a=1; a<argc; ++a){
+            const bool hasValue = a+1 < argc;
+            if(std::strcmp(argv[a], "--counters") == 0) options.counters = true;
+            else if(std::strcmp(argv[a], "--min-time") == 0 && hasValue) options.minTime = std::atof(argv[++a]) * 1e-3;
+            else if(std::strcmp(argv[a], "--repetitions") == 0 && hasValue) options.repetitions = std::max(1, std::atoi(argv[++a]));
+            else if(std::strcmp(argv[a], "--filter") == 0 && hasValue) options.filter = argv[++a];
+            else if(std::strcmp(argv[a], "--output") == 0 && hasValue) options.output = argv[++a];
+            else if(std::strcmp(argv[a], "--scale") == 0 && hasValue) options.scale = std::max(1e-6, std::atof(argv[++a]));
+            else if(std::strcmp(argv[a], "--threads") == 0 && hasValue) options.threads = (unsigned int)std::max(1, std::atoi(argv[++a]));
+            else if(std::strcmp(argv[a], "--malloc-arenas") == 0 && hasValue) options.mallocArenas = std::max(0, std::atoi(argv[++a]));
+            else {
+                std::fprintf(stderr, "usage: %s [--min-time <milliseconds>] [--repetitions <count>] [--counters] [--filter <text>] [--output <path>] [--scale <factor>] [--threads <count>] [--malloc-arenas <count>]\n", argv[0]);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// \brief time run (see the description of the file)
+    inline BenchmarkResult measure(const std::function<void(std::size_t)>& run, const BenchmarkOptions& options, HardwareCounters* counters) {
+        using Clock = std::chrono::steady_clock;
+        const auto seconds = [&run](const std::size_t n){
+            const Clock::time_point start = Clock::now();
+            run(n);
+            return std::chrono::duration<double>(Clock::now() - start).count();
+        };
+
+        run(1); // initialization of the function containers and of the static data
+        std::size_t n = 1;
+        while(seconds(n) < options.minTime && n < (std::numeric_limits<std::size_t>::max() >> 1))
+            n *= 2;
+
+        BenchmarkResult result;
+        result.iterations = n;
+        result.nsPerOp = std::numeric_limits<double>::max();
+        for(unsigned int r=0; r<options.repetitions; ++r){
+            const std::size_t allocations = allocationCount();
+            if(counters) counters->start();
+            const double time = seconds(n);
+            const HardwareCounterValues values = counters ? counters->stop() : HardwareCounterValues();
+            if(r == 0) result.allocsPerOp = double(allocationCount() - allocations) / double(n);
+            if(time * 1e9 / double(n) < result.nsPerOp){
+                result.nsPerOp = time * 1e9 / double(n);
+                result.counters = values;
+            }
+        }
+        result.hasCounters = counters != nullptr;
+        return result;
+    }
+
+    /// \brief the report of a benchmark program, written in the output of the options
+    class BenchmarkReport {
+    public:
+        BenchmarkReport(const char* suite, const BenchmarkOptions& options) : suite(suite), options(options) {
+            if(options.counters && !hardwareCounters.available())
+                std::fprintf(stderr, "%s: the hardware counters are unavailable\n", suite);
+            if(!options.output.empty()) file.open(options.output);
+        }
+
+        /// \brief false if the output cannot be written
+        bool open() {
+            if(!options.output.empty() && !file){
+                std::fprintf(stderr, "%s: cannot write %s\n", suite, options.output.c_str());
+                return false;
+            }
+            stream().precision(6);
+            stream() << "{\"algebra\": \"c3ga\", \"suite\": \"" << suite << "\", \"isa\": \"" << kernelIsaName(activeKernelIsa()) << "\", \"benchmarks\": [";
+            return true;
+        }
+
+        /// \brief the hardware counters to measure, nullptr if they are not measured
+        HardwareCounters* counters() {
+            return options.counters && hardwareCounters.available() ? &hardwareCounters : nullptr;
+        }
+
+        /// \brief true if the benchmark name is selected by the options
+        bool selected(const std::string& name) const {
+            return name.find(options.filter) != std::string::npos;
+        }
+
+        void write(const std::string& name, const std::string& operation, const std::string& engine,
+                   const std::vector<unsigned int>& grades, const BenchmarkResult& result) {
+            std::ostream& out = stream();
+            out << separator << "{\"name\": \"" << name << "\", \"operation\": \"" << operation
+                << "\", \"engine\": \"" << engine << "\", \"grades\": [";
+            for(std::size_t g=0; g<grades.size(); ++g)
+                out << (g ? ", " : "") << grades[g];
+            out << "], \"nsPerOp\": " << result.nsPerOp << ", \"allocsPerOp\": " << result.allocsPerOp
+                << ", \"iterations\": " << result.iterations;
+            if(result.hasLatency)
+                out << ", \"itemsPerSecond\": " << result.itemsPerSecond << ", \"latencyNs\": {\"p50\": " << result.latency[0]
+                    << ", \"p90\": " << result.latency[1] << ", \"p99\": " << result.latency[2] << ", \"max\": " << result.latency[3] << "}";
+            if(!result.members.empty())
+                out << ", " << result.members;
+            out << ", \"counters\": ";
+            if(result.hasCounters) writeHardwareCountersJson(out, result.counters, double(result.iterations));
+            else out << "null";
+            out << "}";
+            separator = ",\n";
+            if(!options.output.empty())
+                std::printf("%-40s %12.2f ns/op %8.2f allocs/op\n", name.c_str(), result.nsPerOp, result.allocsPerOp);
+        }
+
+        /// \brief end the report
+        /// \return the exit code of the program: 1 if the report cannot be written
+        int close() {
+            stream() << "\n]}\n";
+            stream().flush();
+            return stream() ? 0 : 1;
+        }
+
+    private:
+        std::ostream& stream() {
+            return options.output.empty() ? std::cout : file;
+        }
+
+        const char* suite;
+        const BenchmarkOptions& options;
+        HardwareCounters hardwareCounters;
+        std::ofstream file;
+        const char* separator = "\n";
+    };
+
+    /// \brief run the benchmarks selected by the options and write their report
+    /// \return the exit code of the program: 1 if the report cannot be written
+    inline int runBenchmarks(const char* suite, const std::vector<BenchmarkCase>& benchmarks, const BenchmarkOptions& options) {
+        BenchmarkReport report(suite, options);
+        if(!report.open()) return 1;
+        for(const BenchmarkCase& benchmark : benchmarks)
+            if(report.selected(benchmark.name))
+                report.write(benchmark.name, benchmark.operation, benchmark.engine, benchmark.grades, measure(benchmark.run, options, report.counters()));
+        return report.close();
+    }
+
+    /// \brief time the passes of a scenario (see ScenarioCase)
+    /// \return false in valid when the check of a pass fails
+    inline BenchmarkResult measureScenario(const ScenarioCase& scenario, const BenchmarkOptions& options, HardwareCounters* counters, bool& valid) {
+        using Clock = std::chrono::steady_clock;
+        const double items = double(scenario.requests * scenario.itemsPerRequest);
+        std::vector<double> latencies;
+        latencies.reserve(scenario.requests * options.repetitions);
+
+        BenchmarkResult result;
+        result.iterations = scenario.requests * scenario.itemsPerRequest;
+        result.nsPerOp = std::numeric_limits<double>::max();
+        valid = true;
+        for(unsigned int pass=0; pass<options.repetitions; ++pass){
+            if(scenario.setup) scenario.setup();
+            const std::size_t allocations = allocationCount();
+            if(counters) counters->start();
+            double passNanoseconds = 0.0;
+            for(std::size_t request=0; request<scenario.requests; ++request){
+                const Clock::time_point start = Clock::now();
+                scenario.run(request);
+                const double nanoseconds = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+                latencies.push_back(nanoseconds);
+                passNanoseconds += nanoseconds;
+            }
+            const HardwareCounterValues values = counters ? counters->stop() : HardwareCounterValues();
+            if(pass == 0) result.allocsPerOp = double(allocationCount() - allocations) / items;
+            if(passNanoseconds / items < result.nsPerOp){
+                result.nsPerOp = passNanoseconds / items;
+                result.counters = values;
+            }
+            valid = valid && (!scenario.check || scenario.check());
+        }
+        result.hasCounters = counters != nullptr;
+
+        std::sort(latencies.begin(), latencies.end());
+        const double quantiles[3] = {0.5, 0.9, 0.99};
+        for(unsigned int q=0; q<3; ++q)
+            result.latency[q] = latencies[std::min(latencies.size()-1, std::size_t(quantiles[q] * double(latencies.size())))];
+        result.latency[3] = latencies.back();
+        result.itemsPerSecond = 1e9 / result.nsPerOp;
+        result.hasLatency = true;
+        return result;
+    }
+
+    /// \brief run the scenarios selected by the options and write their report
+    /// \return the exit code of the program: 1 if the report cannot be written or if the results of a scenario are wrong
+    inline int runScenarios(const char* suite, const std::vector<ScenarioCase>& scenarios, const BenchmarkOptions& options) {
+        BenchmarkReport report(suite, options);
+        if(!report.open()) return 1;
+        bool valid = true;
+        for(const ScenarioCase& scenario : scenarios){
+            if(!report.selected(scenario.name)) continue;
+            bool scenarioValid;
+            const BenchmarkResult result = measureScenario(scenario, options, report.counters(), scenarioValid);
+            if(!scenarioValid) std::fprintf(stderr, "%s: wrong results of the scenario %s\n", suite, scenario.name.c_str());
+            valid = valid && scenarioValid;
+            report.write(scenario.name, scenario.name, "scenario", {}, result);
+        }
+        return std::max(report.close(), valid ? 0 : 1);
+    }
+
+    /// \brief name of a benchmark: engine, operation and grades
+    inline std::string benchmarkName(const std::string& engine, const std::string& operation, const std::vector<unsigned int>& grades) {
+        std::string name = engine + " " + operation;
+        for(std::size_t g=0; g<grades.size(); ++g)
+            name += (g == 0 ? " " : (g == 2 ? "->" : ",")) + std::to_string(grades[g]);
+        return name;
+    }
+
+
+    /// \brief k-vector of the per grades kernels
+    using Vector = Eigen::Matrix<double, Eigen::Dynamic, 1>;
+
+    /// \brief a per grades kernel: computes k-vectors of grades (grade1, grade2) into a k-vector of grade grade3
+    using Kernel = std::function<void(const Vector&, const Vector&, Vector&)>;
+
+    /// \brief random generator of the operands, of a fixed seed: the operands are the same in all the runs
+    inline std::mt19937& randomEngine() {
+        static std::mt19937 engine(42);
+        return engine;
+    }
+
+    inline Vector randomVector(const unsigned int size) {
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+        Vector vector(size);
+        for(unsigned int i=0; i<size; ++i) vector[i] = distribution(randomEngine());
+        return vector;
+    }
+
+    /// \brief multivector of random coefficients for the grades of gradeBitmap
+    inline Mvec<double> randomMvec(const unsigned int gradeBitmap) {
+        std::vector<double> dense(multivectorSize, 0.0);
+        for(unsigned int grade=0; grade<=algebraDimension; ++grade)
+            if(gradeBitmap & (1u << grade)){
+                const Vector kvector = randomVector(binomialArray[grade]);
+                std::copy(kvector.data(), kvector.data() + kvector.size(), dense.begin() + perGradeStartingIndex[grade]);
+            }
+        Mvec<double> mv;
+        mv.fromDense(dense.data());
+        return mv;
+    }
+
+    /// \brief add the case of an operation to cases: Case is BenchmarkCase, or the case of another program constructed
+    /// from the same members (name, operation, engine, grades, run)
+    template<typename Case>
+    inline void addCase(std::vector<Case>& cases, const std::string& engine, const std::string& operation,
+                        const std::vector<unsigned int>& grades, std::function<void(std::size_t)> run) {
+        cases.push_back(Case{benchmarkName(engine, operation, grades), operation, engine, grades, std::move(run)});
+    }
+
+    /// \brief add the case of a kernel of engine, on random k-vectors of grades (grade1, grade2), if there is a kernel
+    template<typename Case>
+    inline void addKernel(std::vector<Case>& cases, const std::string& engine, const std::string& operation, const Kernel& kernel,
+                          const unsigned int grade1, const unsigned int grade2, const unsigned int grade3) {
+        if(!kernel) return;
+        auto mv1 = std::make_shared<Vector>(randomVector(binomialArray[grade1]));
+        auto mv2 = std::make_shared<Vector>(randomVector(binomialArray[grade2]));
+        auto mv3 = std::make_shared<Vector>(Vector::Zero(binomialArray[grade3]));
+        addCase(cases, engine, operation, {grade1, grade2, grade3}, [kernel, mv1, mv2, mv3](const std::size_t n){
+            for(std::size_t i=0; i<n; ++i){
+                kernel(*mv1, *mv2, *mv3);
+                doNotOptimize(mv3->data()[0]);
+            }
+        });
+    }
+
+    /// \brief add the cases of the kernels of the function containers (engine "kernel"), for all the grades
+    template<typename Case>
+    inline void addKernels(std::vector<Case>& cases) {
+        for(unsigned int grade1=0; grade1<=algebraDimension; ++grade1)
+            for(unsigned int grade2=0; grade2<=algebraDimension; ++grade2){
+                if(grade1 + grade2 <= algebraDimension)
+                    addKernel(cases, "kernel", "outer", outerFunctionsContainer<double>[grade1][grade2].load(), grade1, grade2, grade1 + grade2);
+                addKernel(cases, "kernel", "inner", innerFunctionsContainer<double>[grade1][grade2].load(),
+                          grade1, grade2, grade1 > grade2 ? grade1 - grade2 : grade2 - grade1);
+                for(unsigned int grade3=0; grade3<=algebraDimension; ++grade3)
+                    addKernel(cases, "kernel", "geometric", geometricFunctionsContainer<double>[grade3][grade1][grade2].load(), grade1, grade2, grade3);
+                if(grade1 <= grade2){
+                    const unsigned int grade3 = grade1 + algebraDimension - grade2;
+                    addKernel(cases, "kernel", "outerPrimalDual", outerPrimalDualFunctionsContainer<double>[grade1][grade2], grade1, grade2, grade3);
+                    addKernel(cases, "kernel", "outerDualPrimal", outerDualPrimalFunctionsContainer<double>[grade1][grade2], grade1, grade2, grade3);
+                    addKernel(cases, "kernel", "outerDualDual", outerDualDualFunctionsContainer<double>[grade1][grade2], grade1, grade2, grade3);
+                }
+            }
+    }
+
+    /// \brief add the cases of the products of homogeneous multivectors of Mvec (engine "Mvec"), for all the grades
+    template<typename Case>
+    inline void addMvecProducts(std::vector<Case>& cases) {
+        using Mvec = c3ga::Mvec<double>;
+        const std::pair<const char*, std::function<Mvec(const Mvec&, const Mvec&)>> products[] = {
+            {"outer", [](const Mvec& mv1, const Mvec& mv2){ return mv1 ^ mv2; }},
+            {"inner", [](const Mvec& mv1, const Mvec& mv2){ return mv1 | mv2; }},
+            {"leftContraction", [](const Mvec& mv1, const Mvec& mv2){ return mv1 < mv2; }},
+            {"rightContraction", [](const Mvec& mv1, const Mvec& mv2){ return mv1 > mv2; }},
+            {"scalar", [](const Mvec& mv1, const Mvec& mv2){ return mv1.scalarProduct(mv2); }},
+            {"dot", [](const Mvec& mv1, const Mvec& mv2){ return mv1.dotProduct(mv2); }},
+            {"geometric", [](const Mvec& mv1, const Mvec& mv2){ return mv1 * mv2; }},
+            {"geometricPruned", [](const Mvec& mv1, const Mvec& mv2){ return mv1.geometricProduct(mv2, 1e-12); }},
+            {"outerPrimalDual", [](const Mvec& mv1, const Mvec& mv2){ return mv1.outerPrimalDual(mv2); }},
+            {"outerDualPrimal", [](const Mvec& mv1, const Mvec& mv2){ return mv1.outerDualPrimal(mv2); }},
+            {"outerDualDual", [](const Mvec& mv1, const Mvec& mv2){ return mv1.outerDualDual(mv2); }}};
+        for(const auto& product : products)
+            for(unsigned int grade1=0; grade1<=algebraDimension; ++grade1)
+                for(unsigned int grade2=0; grade2<=algebraDimension; ++grade2){
+                    const Mvec mv1 = randomMvec(1u << grade1), mv2 = randomMvec(1u << grade2);
+                    const auto function = product.second;
+                    addCase(cases, "Mvec", product.first, {grade1, grade2}, [function, mv1, mv2](const std::size_t n){
+                        for(std::size_t i=0; i<n; ++i) doNotOptimize(function(mv1, mv2));
+                    });
+                }
+    }
+
+}/// End of Namespace benchmark
+}/// End of Namespace
+
+#endif // C3GA_BENCHMARK_HPP__
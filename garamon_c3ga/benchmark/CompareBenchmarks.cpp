@@ -0,0 +1,261 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// CompareBenchmarks.cpp
+// This file is part of the Garamon for c3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file CompareBenchmarks.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Compare a report of the benchmarks of c3ga (see Benchmark.hpp) to a baseline report, and flag the regressions.
+///
+/// The benchmarks of both reports are matched by name. A benchmark regresses when its time per operation, or the 99th
+/// percentile of its latency for the scenarios, exceeds the baseline by more than the threshold, or when it allocates
+/// more per operation (by more than 1%). The benchmarks of a single report are listed, they do not fail the comparison.
+///
+/// Usage: c3ga_compare_benchmarks <baseline.json> <current.json> [--threshold <percent>] (10 by default)
+/// Returns 0 without regression, 1 with a regression, 2 if a report cannot be read.
+
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+    /// \brief a JSON value, enough for the reports of the benchmarks
+    struct JsonValue {
+        enum class Type { null, boolean, number, string, array, object } type = Type::null;
+        double number = 0.0;
+        std::string string;
+        std::vector<JsonValue> array;
+        std::map<std::string, JsonValue> object;
+
+        /// \brief the member key of an object, nullptr if it has none
+        const JsonValue* find(const std::string& key) const {
+            const auto it = object.find(key);
+            return it == object.end() ? nullptr : &it->second;
+        }
+    };
+
+    /// \brief recursive descent parser of JSON, throws std::runtime_error on a syntax error
+    class JsonParser {
+    public:
+        explicit JsonParser(const std::string& text) : text(text) {}
+
+        JsonValue parse() {
+            JsonValue value = parseValue();
+            skipSpaces();
+            if(position != text.size()) fail("unexpected characters after the value");
+            return value;
+        }
+
+    private:
+        [[noreturn]] void fail(const char* message) const {
+            throw std::runtime_error(std::string(message) + " at offset " + std::to_string(position));
+        }
+
+        void skipSpaces() {
+            while(position < text.size() && std::isspace((unsigned char)text[position])) ++position;
+        }
+
+        bool consume(const char* token) {
+            const std::size_t length = std::strlen(token);
+            if(text.compare(position, length, token) != 0) return false;
+            position += length;
+            return true;
+        }
+
+        void expect(const char character) {
+            skipSpaces();
+            if(position >= text.size() || text[position] != character) fail("unexpected character");
+            ++position;
+        }
+
+        std::string parseString() {
+            expect('"');
+            std::string result;
+            while(position < text.size() && text[position] != '"'){
+                if(text[position] == '\\'){
+                    if(++position >= text.size()) break;
+                    const char escaped = text[position];
+                    result += escaped == 'n' ? '\n' : (escaped == 't' ? '\t' : escaped);
+                } else {
+                    result += text[position];
+                }
+                ++position;
+            }
+            expect('"');
+            return result;
+        }
+
+        JsonValue parseValue() {
+            skipSpaces();
+            if(position >= text.size()) fail("unexpected end");
+            JsonValue value;
+            const char character = text[position];
+            if(character == '{'){
+                value.type = JsonValue::Type::object;
+                ++position;
+                skipSpaces();
+                if(position < text.size() && text[position] == '}'){ ++position; return value; }
+                do {
+                    const std::string key = parseString();
+                    expect(':');
+                    value.object[key] = parseValue();
+                    skipSpaces();
+                } while(position < text.size() && text[position] == ',' && ++position);
+                expect('}');
+            } else if(character == '['){
+                value.type = JsonValue::Type::array;
+                ++position;
+                skipSpaces();
+                if(position < text.size() && text[position] == ']'){ ++position; return value; }
+                do {
+                    value.array.push_back(parseValue());
+                    skipSpaces();
+                } while(position < text.size() && text[position] == ',' && ++position);
+                expect(']');
+            } else if(character == '"'){
+                value.type = JsonValue::Type::string;
+                value.string = parseString();
+            } else if(consume("null")){
+                value.type = JsonValue::Type::null;
+            } else if(consume("true")){
+                value.type = JsonValue::Type::boolean;
+                value.number = 1.0;
+            } else if(consume("false")){
+                value.type = JsonValue::Type::boolean;
+            } else {
+                value.type = JsonValue::Type::number;
+                const char* begin = text.c_str() + position;
+                char* end = nullptr;
+                value.number = std::strtod(begin, &end);
+                if(end == begin) fail("invalid value");
+                position += std::size_t(end - begin);
+            }
+            return value;
+        }
+
+        const std::string& text;
+        std::size_t position = 0;
+    };
+
+    /// \brief the measures of a benchmark used by the comparison
+    struct Measure {
+        double nsPerOp = 0.0;
+        double allocsPerOp = 0.0;
+        double latencyP99 = -1.0;   // negative for the microbenchmarks
+    };
+
+    struct Report {
+        std::string algebra, suite, isa;
+        std::vector<std::string> names;   // in the order of the report
+        std::map<std::string, Measure> measures;
+    };
+
+    double numberMember(const JsonValue& object, const char* key, const double missing) {
+        const JsonValue* value = object.find(key);
+        return value && value->type == JsonValue::Type::number ? value->number : missing;
+    }
+
+    std::string stringMember(const JsonValue& object, const char* key) {
+        const JsonValue* value = object.find(key);
+        return value && value->type == JsonValue::Type::string ? value->string : std::string();
+    }
+
+    /// \brief read a report, false after writing the error if it cannot be read
+    bool readReport(const char* path, Report& report) {
+        std::ifstream file(path);
+        if(!file){
+            std::fprintf(stderr, "cannot read %s\n", path);
+            return false;
+        }
+        std::stringstream content;
+        content << file.rdbuf();
+        const std::string text = content.str();
+        try {
+            const JsonValue root = JsonParser(text).parse();
+            const JsonValue* benchmarks = root.find("benchmarks");
+            if(!benchmarks || benchmarks->type != JsonValue::Type::array) throw std::runtime_error("no benchmarks array");
+            report.algebra = stringMember(root, "algebra");
+            report.suite = stringMember(root, "suite");
+            report.isa = stringMember(root, "isa");
+            for(const JsonValue& benchmark : benchmarks->array){
+                const std::string name = stringMember(benchmark, "name");
+                Measure measure;
+                measure.nsPerOp = numberMember(benchmark, "nsPerOp", 0.0);
+                measure.allocsPerOp = numberMember(benchmark, "allocsPerOp", 0.0);
+                if(const JsonValue* latency = benchmark.find("latencyNs"))
+                    measure.latencyP99 = numberMember(*latency, "p99", -1.0);
+                if(!report.measures.count(name)) report.names.push_back(name);
+                report.measures[name] = measure;
+            }
+        } catch(const std::exception& error) {
+            std::fprintf(stderr, "%s is not a report of benchmarks: %s\n", path, error.what());
+            return false;
+        }
+        return true;
+    }
+}
+
+
+int main(int argc, char** argv) {
+    double threshold = 0.10;
+    std::vector<const char*> paths;
+    for(int a=1; a<argc; ++a){
+        if(std::strcmp(argv[a], "--threshold") == 0 && a+1 < argc) threshold = std::atof(argv[++a]) / 100.0;
+        else paths.push_back(argv[a]);
+    }
+    if(paths.size() != 2){
+        std::fprintf(stderr, "usage: %s <baseline.json> <current.json> [--threshold <percent>]\n", argv[0]);
+        return 2;
+    }
+
+    Report baseline, current;
+    if(!readReport(paths[0], baseline) || !readReport(paths[1], current)) return 2;
+    if(baseline.algebra != current.algebra || baseline.suite != current.suite)
+        std::fprintf(stderr, "warning: the reports are of different programs (%s %s, %s %s)\n", baseline.algebra.c_str(),
+                     baseline.suite.c_str(), current.algebra.c_str(), current.suite.c_str());
+    if(baseline.isa != current.isa)
+        std::fprintf(stderr, "warning: the reports use different instruction sets (%s, %s)\n", baseline.isa.c_str(), current.isa.c_str());
+
+    unsigned int regressions = 0, improvements = 0;
+    std::printf("%-40s %12s %12s %8s\n", "benchmark", "baseline ns", "current ns", "ratio");
+    for(const std::string& name : current.names){
+        const auto base = baseline.measures.find(name);
+        const Measure& measure = current.measures[name];
+        if(base == baseline.measures.end()){
+            std::printf("%-40s %12s %12.2f %8s  new\n", name.c_str(), "-", measure.nsPerOp, "-");
+            continue;
+        }
+        const double ratio = base->second.nsPerOp > 0.0 ? measure.nsPerOp / base->second.nsPerOp : 1.0;
+        const double latencyRatio = base->second.latencyP99 > 0.0 && measure.latencyP99 >= 0.0 ? measure.latencyP99 / base->second.latencyP99 : 1.0;
+        std::string status;
+        if(ratio > 1.0 + threshold) status += "  REGRESSION: time";
+        if(latencyRatio > 1.0 + threshold) status += "  REGRESSION: p99 latency x" + std::to_string(latencyRatio).substr(0, 4);
+        if(measure.allocsPerOp > base->second.allocsPerOp * 1.01 + 1e-3) status += "  REGRESSION: allocations " + std::to_string(measure.allocsPerOp);
+        if(!status.empty()) ++regressions;
+        else if(ratio < 1.0 - threshold){
+            status = "  improvement";
+            ++improvements;
+        }
+        std::printf("%-40s %12.2f %12.2f %8.3f%s\n", name.c_str(), base->second.nsPerOp, measure.nsPerOp, ratio, status.c_str());
+    }
+    for(const std::string& name : baseline.names)
+        if(!current.measures.count(name))
+            std::printf("%-40s %12.2f %12s %8s  missing\n", name.c_str(), baseline.measures[name].nsPerOp, "-", "-");
+
+    std::printf("%u regressions, %u improvements (threshold %.1f%%)\n", regressions, improvements, threshold * 100.0);
+    return regressions ? 1 : 0;
+}
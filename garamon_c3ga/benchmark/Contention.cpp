@@ -0,0 +1,252 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Contention.cpp
+// This file is part of the Garamon for c3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Contention.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Scaling of c3ga with the number of threads: the same workload run by 1, 2, 4... threads at once.
+///
+/// Each thread applies a versor to its own copy of 20k vectors (V * X * V.inv(), fixed seed), with each storage of the
+/// multivectors: "Mvec" (a product per multivector, each allocating its k-vectors), "MvecArray" (element-wise products of
+/// arrays of 128 multivectors) and "batch" (applyVersorBatch on arrays of 128 multivectors, below the threshold of the
+/// OpenMP threads of the batch functions). For each storage and number of threads, the report gives:
+///  - nsPerOp: the time of the slowest thread over the multivectors of all the threads, allocsPerOp: the allocations of
+///    all the threads per multivector,
+///  - scalingEfficiency: the throughput of all the threads over (threads x the throughput of one thread), and
+///    threadEfficiency: the throughput of each thread over the throughput of one thread,
+///  - allocatorTime: the fraction of the time of the threads spent in the allocator, waits on its locks included,
+///    measured by a second run (the timing of the allocator slows the threads down),
+///  - counters: the hardware counters of all the threads (cache misses...) per multivector, with --counters.
+/// The allocator is the one of the program: glibc malloc, whose number of arenas is set by --malloc-arenas (1 makes all
+/// the threads share a lock), or another allocator loaded with LD_PRELOAD; the report names it.
+///
+/// Usage: c3ga_contention_benchmark [--threads <max>] [--malloc-arenas <count>] [--repetitions <count>] [--counters]
+/// [--filter <text>] [--output <path>] [--scale <factor>], the scale multiplies the number of multivectors per thread.
+
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "c3ga/Mvec.hpp"
+#include "c3ga/Batch.hpp"
+#include "c3ga/MvecArray.hpp"
+
+#include "Benchmark.hpp"
+
+
+namespace {
+
+    using Mvec = c3ga::Mvec<double>;
+    using Clock = std::chrono::steady_clock;
+    using c3ga::benchmark::BenchmarkOptions;
+    using c3ga::benchmark::BenchmarkResult;
+    using c3ga::benchmark::HardwareCounterValues;
+
+    constexpr std::size_t chunk = 128;
+
+    /// \brief vector of random coordinates
+    Mvec randomVector(std::mt19937& randomEngine) {
+        std::uniform_real_distribution<double> coordinate(-1.0, 1.0);
+        std::vector<double> coordinates(c3ga::algebraDimension);
+        for(double& value : coordinates) value = coordinate(randomEngine);
+        return c3ga::MvecArray<double>::fromVectors(coordinates.data(), 1).at(0);
+    }
+
+    /// \brief the data of a thread: run(c) transforms the chunk c of its multivectors
+    using ThreadWorkload = std::function<void(std::size_t)>;
+
+    /// \brief a storage of the multivectors: prepare(versor, vectors) builds the workload of a thread, in this thread
+    struct Storage {
+        const char* name;
+        std::function<ThreadWorkload(const Mvec&, const std::vector<Mvec>&)> prepare;
+    };
+
+    std::vector<Storage> storages() {
+        return {
+            {"Mvec", [](const Mvec& versor, const std::vector<Mvec>& vectors){
+                auto data = std::make_shared<std::pair<std::vector<Mvec>, std::vector<Mvec>>>(vectors, vectors);
+                const Mvec inverse = versor.inv();
+                return ThreadWorkload([versor, inverse, data](const std::size_t c){
+                    for(std::size_t i=c*chunk; i<(c+1)*chunk; ++i)
+                        data->second[i] = versor * data->first[i] * inverse;
+                });
+            }},
+            {"MvecArray", [](const Mvec& versor, const std::vector<Mvec>& vectors){
+                using Array = c3ga::MvecArray<double>;
+                auto arrays = std::make_shared<std::vector<Array>>();
+                for(std::size_t c=0; c<vectors.size()/chunk; ++c)
+                    arrays->emplace_back(std::vector<Mvec>(vectors.begin() + c*chunk, vectors.begin() + (c+1)*chunk));
+                auto results = std::make_shared<std::vector<Array>>(arrays->size());
+                const Array left(versor), right(versor.inv());
+                return ThreadWorkload([left, right, arrays, results](const std::size_t c){
+                    (*results)[c] = left * (*arrays)[c] * right;
+                });
+            }},
+            {"batch", [](const Mvec& versor, const std::vector<Mvec>& vectors){
+                auto dense = std::make_shared<std::vector<double>>(2 * vectors.size() * c3ga::multivectorSize + c3ga::multivectorSize);
+                for(std::size_t i=0; i<vectors.size(); ++i)
+                    vectors[i].toDense(dense->data() + i * c3ga::multivectorSize);
+                double* const versorDense = dense->data() + 2 * vectors.size() * c3ga::multivectorSize;
+                versor.toDense(versorDense);
+                const std::size_t count = vectors.size();
+                return ThreadWorkload([dense, versorDense, count](const std::size_t c){
+                    const double* mv = dense->data() + c * chunk * c3ga::multivectorSize;
+                    double* result = dense->data() + (count + c * chunk) * c3ga::multivectorSize;
+                    c3ga::applyVersorBatch(c3ga::broadcastBatch<const double>(versorDense), c3ga::aosBatch(mv), c3ga::aosBatch(result), chunk);
+                });
+            }}};
+    }
+
+    /// \brief measures of a thread during a run
+    struct ThreadMeasure {
+        double seconds = 0.0;
+        std::size_t allocations = 0;
+        std::uint64_t allocatorNanoseconds = 0;
+        HardwareCounterValues counters;
+    };
+
+    /// \brief run the workload of storage by threads threads at once
+    std::vector<ThreadMeasure> runThreads(const Storage& storage, const unsigned int threads, const std::size_t vectorCount,
+                                          const bool counters, const bool allocatorTiming) {
+        std::vector<ThreadMeasure> measures(threads);
+        std::atomic<unsigned int> ready(0);
+        std::atomic<bool> start(false);
+        std::vector<std::thread> workers;
+        for(unsigned int t=0; t<threads; ++t)
+            workers.emplace_back([&, t](){
+                // identical data for all the threads
+                std::mt19937 randomEngine(7);
+                const Mvec versor = randomVector(randomEngine) * randomVector(randomEngine);
+                std::vector<Mvec> vectors;
+                for(std::size_t i=0; i<vectorCount; ++i) vectors.push_back(randomVector(randomEngine));
+                const ThreadWorkload workload = storage.prepare(versor, vectors);
+                workload(0); // initialization of the static data
+
+                c3ga::benchmark::HardwareCounters hardwareCounters;
+                ++ready;
+                while(!start.load()) std::this_thread::yield();
+
+                const std::size_t allocationStart = c3ga::benchmark::allocationCount();
+                const std::uint64_t allocatorStart = c3ga::benchmark::allocatorNanoseconds();
+                if(counters) hardwareCounters.start();
+                const Clock::time_point begin = Clock::now();
+                for(std::size_t c=0; c<vectorCount/chunk; ++c)
+                    workload(c);
+                measures[t].seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+                if(counters) measures[t].counters = hardwareCounters.stop();
+                measures[t].allocations = c3ga::benchmark::allocationCount() - allocationStart;
+                measures[t].allocatorNanoseconds = c3ga::benchmark::allocatorNanoseconds() - allocatorStart;
+            });
+        while(ready.load() < threads) std::this_thread::yield();
+        c3ga::benchmark::setAllocatorTiming(allocatorTiming);
+        start.store(true);
+        for(std::thread& worker : workers) worker.join();
+        c3ga::benchmark::setAllocatorTiming(false);
+        return measures;
+    }
+
+    double slowest(const std::vector<ThreadMeasure>& measures) {
+        double seconds = 0.0;
+        for(const ThreadMeasure& measure : measures) seconds = std::max(seconds, measure.seconds);
+        return seconds;
+    }
+
+    /// \brief name of the allocator of the program
+    std::string allocatorName(const BenchmarkOptions& options) {
+        const char* preload = std::getenv("LD_PRELOAD");
+        if(preload && *preload) return std::string("LD_PRELOAD ") + preload;
+#if defined(__GLIBC__)
+        return options.mallocArenas ? "glibc malloc, " + std::to_string(options.mallocArenas) + " arenas" : std::string("glibc malloc");
+#else
+        return "system";
+#endif
+    }
+
+    /// \brief 1, 2, 4... then maxThreads
+    std::vector<unsigned int> threadCounts(const unsigned int maxThreads) {
+        std::vector<unsigned int> counts;
+        for(unsigned int threads=1; threads<maxThreads; threads*=2) counts.push_back(threads);
+        counts.push_back(maxThreads);
+        return counts;
+    }
+}
+
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if(!c3ga::benchmark::parseBenchmarkOptions(argc, argv, options)) return 2;
+#if defined(__GLIBC__)
+    if(options.mallocArenas) mallopt(M_ARENA_MAX, options.mallocArenas);
+#endif
+    const unsigned int maxThreads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t vectorCount = std::max<std::size_t>(1, std::size_t(20000 * options.scale) / chunk) * chunk;
+    const std::string allocator = allocatorName(options);
+
+    c3ga::benchmark::BenchmarkReport report("contention", options);
+    if(!report.open()) return 1;
+    const bool counters = report.counters() != nullptr;
+    for(const Storage& storage : storages()){
+        double singleThreadSeconds = 0.0;
+        for(const unsigned int threads : threadCounts(maxThreads)){
+            const std::string name = std::string(storage.name) + " threads " + std::to_string(threads);
+            if(!report.selected(name) && threads > 1) continue;
+
+            // best of the repetitions, by the slowest thread
+            std::vector<ThreadMeasure> best;
+            for(unsigned int r=0; r<options.repetitions; ++r){
+                std::vector<ThreadMeasure> measures = runThreads(storage, threads, vectorCount, counters, false);
+                if(best.empty() || slowest(measures) < slowest(best)) best = std::move(measures);
+            }
+            if(threads == 1) singleThreadSeconds = slowest(best);
+            if(!report.selected(name)) continue;
+
+            const std::vector<ThreadMeasure> timed = runThreads(storage, threads, vectorCount, false, true);
+            double threadSeconds = 0.0, allocatorSeconds = 0.0;
+            for(const ThreadMeasure& measure : timed){
+                threadSeconds += measure.seconds;
+                allocatorSeconds += double(measure.allocatorNanoseconds) * 1e-9;
+            }
+
+            BenchmarkResult result;
+            result.iterations = vectorCount * threads;
+            result.nsPerOp = slowest(best) * 1e9 / double(result.iterations);
+            result.hasCounters = counters;
+            for(const ThreadMeasure& measure : best){
+                result.allocsPerOp += double(measure.allocations) / double(result.iterations);
+                result.counters.cycles += measure.counters.cycles;
+                result.counters.instructions += measure.counters.instructions;
+                result.counters.cacheMisses += measure.counters.cacheMisses;
+                result.counters.branchMisses += measure.counters.branchMisses;
+            }
+            std::ostringstream members;
+            members << "\"threads\": " << threads << ", \"allocator\": \"" << allocator << "\", \"itemsPerSecond\": " << 1e9 / result.nsPerOp
+                    << ", \"scalingEfficiency\": " << singleThreadSeconds / slowest(best) << ", \"threadEfficiency\": [";
+            for(unsigned int t=0; t<threads; ++t)
+                members << (t ? ", " : "") << singleThreadSeconds / best[t].seconds;
+            members << "], \"allocatorTime\": " << (threadSeconds > 0.0 ? allocatorSeconds / threadSeconds : 0.0);
+            result.members = members.str();
+            report.write(name, "versor", storage.name, {}, result);
+        }
+    }
+    return report.close();
+}
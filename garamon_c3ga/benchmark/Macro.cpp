@@ -0,0 +1,459 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Macro.cpp
+// This file is part of the Garamon for c3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Macro.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Macro benchmarks of c3ga: workloads of applications, with their throughput and the latency of their requests.
+///
+/// The scenarios, on data of fixed seeds:
+///  - pointCloudMotor: a cloud of 1M points transformed by a motor with the batch functions (upBatch, applyVersorBatch,
+///    downBatch), by requests of 4096 points,
+///  - pointCloudMotorMvec: the same transformation of 100k points with Mvec (up, M * X * ~M, down), requests of 256 points,
+///  - sphereLineMeet: the intersections of 100k spheres and lines, the point pair sphere < line and one of its points,
+///    requests of 64 pairs,
+///  - textRoundTrip: the text export of 200k spheres and motors, one per line, with formatText (Text.hpp), then their
+///    import with parseText, requests of 1024 objects,
+///  - textRoundTripStream: the same export with operator<< (17 digits) to a std::ostringstream, imported with parseText,
+///  - binaryFileRoundTrip: the same export to a file of multivectors (MvecFile.hpp), a block per request, imported from
+///    the mapping of the file by MvecFileReader::at,
+///  - serializationRoundTrip: the same export by serialize (Serialization.hpp), an MvecArray per request, imported by
+///    deserialize,
+///  - xyzIngestion: the reading of 1M points from an XYZ file (17 digits) as conformal points by PointCloudReader
+///    (PointCloud.hpp), requests of 4096 points,
+///  - plyIngestion: the same reading from a binary PLY file of float coordinates,
+///  - motorStreamEncode: the encoding of 64 trajectories of 4096 motors (smooth rigid motions sampled at 1 kHz) by
+///    MotorStreamEncoder (MotorStream.hpp), steps of 1e-6, a trajectory per request,
+///  - motorStreamDecode: the decoding of these streams to arrays of motors by MotorStreamDecoder.
+/// The results of each pass are checked against the Euclidean computation; the program returns 1 if they are wrong.
+/// The text, the files of multivectors, the serialization, the point cloud files and the motor streams are checked by
+/// their tests (test/Text.cpp, test/MvecFile.cpp, test/Serialization.cpp, test/PointCloud.cpp, test/MotorStream.cpp).
+///
+/// Usage: c3ga_macro_benchmark [--repetitions <passes>] [--counters] [--filter <text>] [--output <path>] [--scale <factor>],
+/// the scale multiplies the number of points and pairs. See Benchmark.hpp for the report.
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "c3ga/Mvec.hpp"
+#include "c3ga/Batch.hpp"
+#include "c3ga/Conformal.hpp"
+#include "c3ga/MvecArray.hpp"
+#include "c3ga/MvecFile.hpp"
+#include "c3ga/MotorStream.hpp"
+#include "c3ga/PointCloud.hpp"
+#include "c3ga/Serialization.hpp"
+#include "c3ga/Text.hpp"
+
+#include "Benchmark.hpp"
+
+
+namespace {
+
+    using Mvec = c3ga::Mvec<double>;
+    using c3ga::benchmark::ScenarioCase;
+
+    constexpr unsigned int dimension = c3ga::euclideanDimension;
+
+    /// \brief the motor of the point cloud scenarios: a rotation of angle about e3, then a translation
+    struct RigidMotion {
+        double angle = 0.7;
+        double translation[dimension] = {1.5, -2.0, 0.25};
+
+        Mvec motor() const {
+            const Mvec rotor = std::cos(0.5*angle) - std::sin(0.5*angle) * c3ga::e12<double>();
+            Mvec t;
+            for(unsigned int k=0; k<dimension; ++k) t[1u << (k+1)] = translation[k];
+            const Mvec translator = 1.0 - 0.5 * (t * c3ga::ei<double>());
+            return translator * rotor;
+        }
+
+        void apply(const double* x, double* y) const {
+            y[0] = std::cos(angle)*x[0] - std::sin(angle)*x[1] + translation[0];
+            y[1] = std::sin(angle)*x[0] + std::cos(angle)*x[1] + translation[1];
+            y[2] = x[2] + translation[2];
+        }
+    };
+
+    std::vector<double> randomPoints(const std::size_t count, const double extent, const unsigned int seed) {
+        std::mt19937 randomEngine(seed);
+        std::uniform_real_distribution<double> distribution(-extent, extent);
+        std::vector<double> points(count * dimension);
+        for(double& coordinate : points) coordinate = distribution(randomEngine);
+        return points;
+    }
+
+    /// \brief true if the points 0, step, 2 step... of result are the points of the cloud moved by motion
+    bool checkPointCloud(const std::vector<double>& points, const std::vector<double>& result, const RigidMotion& motion) {
+        const std::size_t count = points.size() / dimension;
+        for(std::size_t i=0; i<count; i+=std::max<std::size_t>(1, count / 1000)){
+            double expected[dimension];
+            motion.apply(&points[i*dimension], expected);
+            for(unsigned int k=0; k<dimension; ++k)
+                if(!(std::abs(result[i*dimension+k] - expected[k]) < 1e-9)) return false;
+        }
+        return true;
+    }
+
+    ScenarioCase pointCloudMotor(const double scale) {
+        const std::size_t chunk = 4096;
+        const std::size_t requests = std::max<std::size_t>(1, std::size_t(1000000 * scale) / chunk);
+        auto points = std::make_shared<std::vector<double>>(randomPoints(requests * chunk, 10.0, 1));
+        auto result = std::make_shared<std::vector<double>>(points->size());
+        auto conformal = std::make_shared<std::vector<double>>(2 * chunk * c3ga::multivectorSize);
+        auto motor = std::make_shared<std::vector<double>>(c3ga::multivectorSize);
+        const RigidMotion motion;
+        motion.motor().toDense(motor->data());
+
+        return {"pointCloudMotor", requests, chunk, [=](const std::size_t request){
+            const double* x = points->data() + request * chunk * dimension;
+            double* const mv = conformal->data();
+            double* const moved = conformal->data() + chunk * c3ga::multivectorSize;
+            c3ga::upBatch(x, c3ga::aosBatch(mv), chunk);
+            c3ga::applyVersorBatch(c3ga::broadcastBatch<const double>(motor->data()), c3ga::aosBatch<const double>(mv), c3ga::aosBatch(moved), chunk);
+            c3ga::downBatch(c3ga::aosBatch<const double>(moved), result->data() + request * chunk * dimension, chunk);
+        }, [=](){ return checkPointCloud(*points, *result, motion); }};
+    }
+
+    ScenarioCase pointCloudMotorMvec(const double scale) {
+        const std::size_t chunk = 256;
+        const std::size_t requests = std::max<std::size_t>(1, std::size_t(100000 * scale) / chunk);
+        auto points = std::make_shared<std::vector<double>>(randomPoints(requests * chunk, 10.0, 1));
+        auto result = std::make_shared<std::vector<double>>(points->size());
+        const RigidMotion motion;
+        const Mvec motor = motion.motor();
+        const Mvec reverse = ~motor;
+
+        return {"pointCloudMotorMvec", requests, chunk, [=](const std::size_t request){
+            for(std::size_t i=request*chunk; i<(request+1)*chunk; ++i)
+                c3ga::down(motor * c3ga::up(&(*points)[i*dimension]) * reverse, &(*result)[i*dimension]);
+        }, [=](){ return checkPointCloud(*points, *result, motion); }};
+    }
+
+    /// \brief a sphere and a line, and the first point of their intersection
+    struct SphereLine {
+        double center[dimension];
+        double radius;
+        double origin[dimension];      // a point of the line
+        double direction[dimension];   // unit vector
+        bool hit;
+        double intersection[dimension];
+    };
+
+    ScenarioCase sphereLineMeet(const double scale) {
+        const std::size_t chunk = 64;
+        const std::size_t requests = std::max<std::size_t>(1, std::size_t(100000 * scale) / chunk);
+        auto pairs = std::make_shared<std::vector<SphereLine>>(requests * chunk);
+        auto spheres = std::make_shared<std::vector<Mvec>>();
+        auto lines = std::make_shared<std::vector<Mvec>>();
+        std::mt19937 randomEngine(2);
+        std::uniform_real_distribution<double> position(-5.0, 5.0), offset(-3.0, 3.0), radius(0.5, 3.0);
+        std::normal_distribution<double> normal;
+        for(SphereLine& pair : *pairs){
+            double squaredNorm = 0.0;
+            for(unsigned int k=0; k<dimension; ++k){
+                pair.center[k] = position(randomEngine);
+                pair.origin[k] = pair.center[k] + offset(randomEngine);
+                pair.direction[k] = normal(randomEngine);
+                squaredNorm += pair.direction[k] * pair.direction[k];
+            }
+            for(double& coordinate : pair.direction) coordinate /= std::sqrt(squaredNorm);
+            pair.radius = radius(randomEngine);
+
+            double end[dimension];
+            for(unsigned int k=0; k<dimension; ++k) end[k] = pair.origin[k] + pair.direction[k];
+            spheres->push_back(c3ga::up(pair.center) - 0.5 * pair.radius * pair.radius * c3ga::ei<double>());
+            lines->push_back(c3ga::up(pair.origin) ^ c3ga::up(end) ^ c3ga::ei<double>());
+        }
+        const Mvec ei = c3ga::ei<double>();
+
+        return {"sphereLineMeet", requests, chunk, [=](const std::size_t request){
+            for(std::size_t i=request*chunk; i<(request+1)*chunk; ++i){
+                SphereLine& pair = (*pairs)[i];
+                const Mvec pointPair = (*spheres)[i] < (*lines)[i];
+                const double square = (pointPair | pointPair)[c3ga::scalar];
+                pair.hit = square >= 0.0;
+                if(pair.hit)
+                    c3ga::down(((pointPair - std::sqrt(square)) * (ei < pointPair)).grade(1), pair.intersection);
+            }
+        }, [=](){
+            // the intersection is on the sphere and on the line, a line that misses the sphere is farther than the radius
+            for(const SphereLine& pair : *pairs){
+                double toCenter[dimension], along = 0.0, distance = 0.0;
+                for(unsigned int k=0; k<dimension; ++k){
+                    toCenter[k] = pair.center[k] - pair.origin[k];
+                    along += toCenter[k] * pair.direction[k];
+                }
+                for(unsigned int k=0; k<dimension; ++k)
+                    distance += std::pow(toCenter[k] - along * pair.direction[k], 2);
+                if(std::abs(std::sqrt(distance) - pair.radius) < 1e-9) continue; // tangent lines
+                if(pair.hit != (std::sqrt(distance) < pair.radius)) return false;
+                if(!pair.hit) continue;
+                double onSphere = 0.0, alongLine = 0.0, offLine = 0.0;
+                for(unsigned int k=0; k<dimension; ++k){
+                    onSphere += std::pow(pair.intersection[k] - pair.center[k], 2);
+                    alongLine += (pair.intersection[k] - pair.origin[k]) * pair.direction[k];
+                }
+                for(unsigned int k=0; k<dimension; ++k)
+                    offLine += std::pow(pair.intersection[k] - pair.origin[k] - alongLine * pair.direction[k], 2);
+                if(!(std::abs(std::sqrt(onSphere) - pair.radius) < 1e-6 && std::sqrt(offLine) < 1e-6)) return false;
+            }
+            return true;
+        }};
+    }
+
+    /// \brief the objects of the text scenarios: spheres and motors of random parameters, in turn
+    std::shared_ptr<std::vector<Mvec>> conformalObjects(const std::size_t count) {
+        auto objects = std::make_shared<std::vector<Mvec>>();
+        std::mt19937 randomEngine(6);
+        std::uniform_real_distribution<double> position(-10.0, 10.0), radius(0.5, 5.0), angle(-3.0, 3.0);
+        for(std::size_t i=0; i<count; ++i){
+            double center[dimension];
+            for(double& coordinate : center) coordinate = position(randomEngine);
+            if(i % 2 == 0){
+                objects->push_back(c3ga::up(center) - 0.5 * std::pow(radius(randomEngine), 2) * c3ga::ei<double>());
+            } else {
+                const double halfAngle = 0.5 * angle(randomEngine);
+                const Mvec rotor = std::cos(halfAngle) - std::sin(halfAngle) * c3ga::e12<double>();
+                Mvec translation;
+                for(unsigned int k=0; k<dimension; ++k) translation[1u << (k+1)] = center[k];
+                objects->push_back((1.0 - 0.5 * (translation * c3ga::ei<double>())) * rotor);
+            }
+        }
+        return objects;
+    }
+
+    /// \brief the text export of the objects of a request, one per line, then their import with parseText
+    /// \param format - append the text of an object to a buffer
+    template<typename Format>
+    ScenarioCase textRoundTripScenario(const char* name, const double scale, Format format) {
+        const std::size_t chunk = 1024;
+        const std::size_t requests = std::max<std::size_t>(1, std::size_t(200000 * scale) / chunk);
+        auto objects = conformalObjects(requests * chunk);
+        auto texts = std::make_shared<std::vector<std::string>>(requests);
+        auto parsed = std::make_shared<std::vector<Mvec>>(objects->size());
+
+        return {name, requests, chunk, [=](const std::size_t request){
+            std::string& text = (*texts)[request];
+            text.clear();
+            for(std::size_t i=request*chunk; i<(request+1)*chunk; ++i){
+                format(text, (*objects)[i]);
+                text += '\n';
+            }
+            const char* it = text.data();
+            for(std::size_t i=request*chunk; i<(request+1)*chunk && it; ++i)
+                it = c3ga::parseText(it, text.data() + text.size(), (*parsed)[i]);
+        }, {}, [=](){
+            for(Mvec& mv : *parsed) mv = Mvec();
+        }};
+    }
+
+    ScenarioCase textRoundTrip(const double scale) {
+        return textRoundTripScenario("textRoundTrip", scale, [](std::string& text, const Mvec& mv){
+            c3ga::appendText(text, mv);
+        });
+    }
+
+    ScenarioCase textRoundTripStream(const double scale) {
+        return textRoundTripScenario("textRoundTripStream", scale, [](std::string& text, const Mvec& mv){
+            std::ostringstream stream;
+            stream.precision(17);
+            stream << mv;
+            text += stream.str();
+        });
+    }
+
+    /// \brief the file of binaryFileRoundTrip, removed with the scenario
+    struct TemporaryMvecFile {
+        std::string path = "c3ga_macro_benchmark.mvec";
+        c3ga::MvecFileWriter<double> writer;
+        c3ga::MvecFileReader<double> reader;
+
+        ~TemporaryMvecFile() {
+            writer.close();
+            reader.close();
+            std::remove(path.c_str());
+        }
+    };
+
+    ScenarioCase binaryFileRoundTrip(const double scale) {
+        const std::size_t chunk = 1024;
+        const std::size_t requests = std::max<std::size_t>(1, std::size_t(200000 * scale) / chunk);
+        auto objects = conformalObjects(requests * chunk);
+        auto arrays = std::make_shared<std::vector<c3ga::MvecArray<double>>>();
+        for(std::size_t request=0; request<requests; ++request)
+            arrays->emplace_back(std::vector<Mvec>(objects->begin() + request*chunk, objects->begin() + (request+1)*chunk));
+        auto parsed = std::make_shared<std::vector<Mvec>>(objects->size());
+        auto file = std::make_shared<TemporaryMvecFile>();
+
+        return {"binaryFileRoundTrip", requests, chunk, [=](const std::size_t request){
+            file->writer.append((*arrays)[request]);
+            file->writer.flush();
+            file->reader.refresh();
+            for(std::size_t i=request*chunk; i<(request+1)*chunk; ++i)
+                (*parsed)[i] = file->reader.at(i);
+        }, {}, [=](){
+            for(Mvec& mv : *parsed) mv = Mvec();
+            file->writer.close();
+            std::remove(file->path.c_str());
+            file->writer.open(file->path);
+            file->writer.flush();
+            file->reader.open(file->path);
+        }};
+    }
+
+    ScenarioCase serializationRoundTrip(const double scale) {
+        const std::size_t chunk = 1024;
+        const std::size_t requests = std::max<std::size_t>(1, std::size_t(200000 * scale) / chunk);
+        auto objects = conformalObjects(requests * chunk);
+        auto arrays = std::make_shared<std::vector<c3ga::MvecArray<double>>>();
+        for(std::size_t request=0; request<requests; ++request)
+            arrays->emplace_back(std::vector<Mvec>(objects->begin() + request*chunk, objects->begin() + (request+1)*chunk));
+        auto decoded = std::make_shared<std::vector<c3ga::MvecArray<double>>>(requests);
+
+        return {"serializationRoundTrip", requests, chunk, [=](const std::size_t request){
+            c3ga::deserialize(c3ga::serialize((*arrays)[request]), (*decoded)[request]);
+        }, {}, [=](){
+            for(c3ga::MvecArray<double>& array : *decoded) array = c3ga::MvecArray<double>();
+        }};
+    }
+
+    /// \brief the file of an ingestion scenario, written at its first pass, removed with the scenario
+    struct PointCloudFile {
+        std::string path;
+        bool written = false;
+
+        ~PointCloudFile() {
+            if(written) std::remove(path.c_str());
+        }
+    };
+
+    /// \brief write points to path as an XYZ file with 17 digits, or as a binary PLY file of float coordinates
+    bool writePointCloud(const std::string& path, const std::vector<double>& points, const bool ply) {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if(!file) return false;
+        const std::size_t count = points.size() / dimension;
+        if(ply)
+            std::fprintf(file, "ply\nformat %s 1.0\nelement vertex %zu\nproperty float x\nproperty float y\nproperty float z\nend_header\n",
+                         c3ga::littleEndianMachine() ? "binary_little_endian" : "binary_big_endian", count);
+        for(std::size_t i=0; i<count; ++i){
+            if(ply){
+                const float x[dimension] = {float(points[i*dimension]), float(points[i*dimension+1]), float(points[i*dimension+2])};
+                std::fwrite(x, sizeof(float), dimension, file);
+            } else
+                std::fprintf(file, "%.17g %.17g %.17g\n", points[i*dimension], points[i*dimension+1], points[i*dimension+2]);
+        }
+        return std::fclose(file) == 0;
+    }
+
+    /// \brief the reading of a point cloud file as conformal points, by requests of 4096 points
+    ScenarioCase pointCloudIngestion(const char* name, const double scale, const bool ply) {
+        const std::size_t chunk = 4096;
+        const std::size_t requests = std::max<std::size_t>(1, std::size_t(1000000 * scale) / chunk);
+        auto points = std::make_shared<std::vector<double>>(randomPoints(requests * chunk, 10.0, 4));
+        auto file = std::make_shared<PointCloudFile>();
+        file->path = std::string("c3ga_macro_benchmark") + (ply ? ".ply" : ".xyz");
+        auto reader = std::make_shared<c3ga::PointCloudReader<double>>();
+        auto conformal = std::make_shared<c3ga::MvecArray<double>>(chunk);
+
+        return {name, requests, chunk, [=](const std::size_t){
+            reader->read(conformal->view(), chunk);
+        }, {}, [=](){
+            if(!file->written) file->written = writePointCloud(file->path, *points, ply);
+            reader->open(file->path);
+        }};
+    }
+
+    /// \brief trajectories of the motor stream scenarios: rotations about a fixed axis and translations along a curve,
+    /// with smoothly varying speeds, sampled at 1 kHz
+    std::shared_ptr<std::vector<c3ga::MvecArray<double>>> motorTrajectories(const std::size_t count, const std::size_t frames) {
+        const double dt = 1e-3;
+        std::mt19937 randomEngine(5);
+        std::normal_distribution<double> normal;
+        std::uniform_real_distribution<double> speed(0.5, 5.0), frequency(0.1, 3.0);
+        auto trajectories = std::make_shared<std::vector<c3ga::MvecArray<double>>>();
+        for(std::size_t k=0; k<count; ++k){
+            double axis[dimension], squaredNorm = 0.0;
+            for(double& coordinate : axis){
+                coordinate = normal(randomEngine);
+                squaredNorm += coordinate * coordinate;
+            }
+            for(double& coordinate : axis) coordinate /= std::sqrt(squaredNorm);
+            const Mvec bivector = axis[0] * c3ga::e23<double>() - axis[1] * c3ga::e13<double>() + axis[2] * c3ga::e12<double>();
+            const double angularSpeed = speed(randomEngine), angularFrequency = frequency(randomEngine);
+            double amplitude[dimension], pathFrequency[dimension];
+            for(unsigned int c=0; c<dimension; ++c){
+                amplitude[c] = 10.0 * normal(randomEngine);
+                pathFrequency[c] = frequency(randomEngine);
+            }
+
+            c3ga::MvecArray<double> trajectory(frames);
+            for(std::size_t f=0; f<frames; ++f){
+                const double time = double(f) * dt;
+                const double angle = angularSpeed * time + 0.5 * std::sin(angularFrequency * time);
+                Mvec t;
+                for(unsigned int c=0; c<dimension; ++c) t[1u << (c+1)] = amplitude[c] * std::sin(pathFrequency[c] * time);
+                trajectory.set(f, (1.0 - 0.5 * (t * c3ga::ei<double>())) * (std::cos(0.5*angle) - std::sin(0.5*angle) * bivector));
+            }
+            trajectories->push_back(std::move(trajectory));
+        }
+        return trajectories;
+    }
+
+    /// \brief the encoding of trajectories of motors, or the decoding of their streams, a trajectory per request
+    ScenarioCase motorStream(const char* name, const double scale, const bool decode) {
+        const std::size_t frames = 4096;
+        const double step = 1e-6;
+        const std::size_t requests = std::max<std::size_t>(1, std::size_t(64 * scale));
+        auto trajectories = motorTrajectories(requests, frames);
+        auto streams = std::make_shared<std::vector<std::string>>(requests);
+        auto decoded = std::make_shared<std::vector<c3ga::MvecArray<double>>>(requests, c3ga::MvecArray<double>(frames));
+        auto encode = [=](const std::size_t request){
+            c3ga::MotorStreamEncoder<double> encoder(step, step);
+            encoder.append((*trajectories)[request]);
+            encoder.flush();
+            (*streams)[request] = encoder.bytes();
+        };
+
+        return {name, requests, frames, [=](const std::size_t request){
+            if(!decode){
+                encode(request);
+                return;
+            }
+            c3ga::MotorStreamDecoder<double> decoder;
+            if(decoder.open((*streams)[request]))
+                decoder.decode(0, frames, (*decoded)[request].view());
+        }, {}, [=](){
+            if(decode && (*streams)[0].empty())
+                for(std::size_t request=0; request<requests; ++request) encode(request);
+            if(!decode)
+                for(std::string& stream : *streams) stream.clear();
+        }};
+    }
+}
+
+
+int main(int argc, char** argv) {
+    c3ga::benchmark::BenchmarkOptions options;
+    if(!c3ga::benchmark::parseBenchmarkOptions(argc, argv, options)) return 2;
+
+    const std::vector<ScenarioCase> scenarios = {pointCloudMotor(options.scale), pointCloudMotorMvec(options.scale), sphereLineMeet(options.scale),
+                                                 textRoundTrip(options.scale), textRoundTripStream(options.scale), binaryFileRoundTrip(options.scale),
+                                                 serializationRoundTrip(options.scale),
+                                                 pointCloudIngestion("xyzIngestion", options.scale, false), pointCloudIngestion("plyIngestion", options.scale, true),
+                                                 motorStream("motorStreamEncode", options.scale, false), motorStream("motorStreamDecode", options.scale, true)};
+    return c3ga::benchmark::runScenarios("macro", scenarios, options);
+}
@@ -0,0 +1,222 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// CApi.cpp
+// This file is part of the Garamon for c3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file CApi.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief C interface of the c3ga library, implemented on top of Mvec<double> and the batch functions.
+
+
+#include "c3ga/CApi.h"
+
+#include <new>
+
+#include "c3ga/Mvec.hpp"
+#include "c3ga/Batch.hpp"
+#include "c3ga/KernelDispatch.hpp"
+#include "c3ga/Conformal.hpp"
+
+
+/// \brief the multivector behind an opaque handle
+struct c3ga_mvec {
+    c3ga::Mvec<double> mv;
+};
+
+
+/// \cond DEV
+// no exception may cross the C interface: the functions returning a status catch them all
+#define C3GA_CAPI_TRY(statements) \
+    try { statements; return 0; } \
+    catch(...) { return -1; }
+
+namespace {
+
+    /// \brief view on the operand of a batch function, stored as multivectors of multivectorSize coefficients
+    inline c3ga::BatchView<const double> operandBatch(const double* data, const ptrdiff_t itemStride) {
+        return {data, itemStride, 1};
+    }
+
+    /// \brief new handle on mv, NULL if the allocation fails
+    inline c3ga_mvec* newHandle(c3ga::Mvec<double>&& mv) {
+        return new (std::nothrow) c3ga_mvec{std::move(mv)};
+    }
+}
+/// \endcond
+
+
+extern "C" {
+
+int c3ga_api_version(void) {
+    return C3GA_CAPI_VERSION;
+}
+
+unsigned int c3ga_algebra_dimension(void) {
+    return c3ga::algebraDimension;
+}
+
+unsigned int c3ga_multivector_size(void) {
+    return c3ga::multivectorSize;
+}
+
+unsigned int c3ga_dense_index(const unsigned int xor_index) {
+    if(xor_index >= c3ga::multivectorSize) return c3ga::multivectorSize;
+    return c3ga::perGradeStartingIndex[c3ga::xorIndexToGrade[xor_index]] + c3ga::xorIndexToHomogeneousIndex[xor_index];
+}
+
+
+c3ga_mvec* c3ga_mvec_new(void) {
+    try { return newHandle(c3ga::Mvec<double>()); }
+    catch(...) { return nullptr; }
+}
+
+c3ga_mvec* c3ga_mvec_from_dense(const double* dense) {
+    try {
+        c3ga::Mvec<double> mv;
+        mv.fromDense(dense);
+        return newHandle(std::move(mv));
+    }
+    catch(...) { return nullptr; }
+}
+
+c3ga_mvec* c3ga_mvec_clone(const c3ga_mvec* mv) {
+    try { return newHandle(c3ga::Mvec<double>(mv->mv)); }
+    catch(...) { return nullptr; }
+}
+
+void c3ga_mvec_free(c3ga_mvec* mv) {
+    delete mv;
+}
+
+void c3ga_mvec_to_dense(const c3ga_mvec* mv, double* dense) {
+    mv->mv.toDense(dense);
+}
+
+double c3ga_mvec_get(const c3ga_mvec* mv, const unsigned int xor_index) {
+    if(xor_index >= c3ga::multivectorSize) return 0.0;
+    double dense[c3ga::multivectorSize];
+    mv->mv.toDense(dense);
+    return dense[c3ga_dense_index(xor_index)];
+}
+
+int c3ga_mvec_set(c3ga_mvec* mv, const unsigned int xor_index, const double value) {
+    if(xor_index >= c3ga::multivectorSize) return -1;
+    C3GA_CAPI_TRY(mv->mv[xor_index] = value)
+}
+
+
+int c3ga_mvec_add(const c3ga_mvec* a, const c3ga_mvec* b, c3ga_mvec* result) {
+    C3GA_CAPI_TRY(result->mv = a->mv + b->mv)
+}
+
+int c3ga_mvec_sub(const c3ga_mvec* a, const c3ga_mvec* b, c3ga_mvec* result) {
+    C3GA_CAPI_TRY(result->mv = a->mv - b->mv)
+}
+
+int c3ga_mvec_scale(const c3ga_mvec* a, const double value, c3ga_mvec* result) {
+    C3GA_CAPI_TRY(result->mv = a->mv * value)
+}
+
+int c3ga_mvec_geometric_product(const c3ga_mvec* a, const c3ga_mvec* b, c3ga_mvec* result) {
+    C3GA_CAPI_TRY(result->mv = a->mv * b->mv)
+}
+
+int c3ga_mvec_outer_product(const c3ga_mvec* a, const c3ga_mvec* b, c3ga_mvec* result) {
+    C3GA_CAPI_TRY(result->mv = a->mv ^ b->mv)
+}
+
+int c3ga_mvec_inner_product(const c3ga_mvec* a, const c3ga_mvec* b, c3ga_mvec* result) {
+    C3GA_CAPI_TRY(result->mv = a->mv | b->mv)
+}
+
+int c3ga_mvec_left_contraction(const c3ga_mvec* a, const c3ga_mvec* b, c3ga_mvec* result) {
+    C3GA_CAPI_TRY(result->mv = a->mv < b->mv)
+}
+
+int c3ga_mvec_right_contraction(const c3ga_mvec* a, const c3ga_mvec* b, c3ga_mvec* result) {
+    C3GA_CAPI_TRY(result->mv = a->mv > b->mv)
+}
+
+int c3ga_mvec_dual(const c3ga_mvec* a, c3ga_mvec* result) {
+    C3GA_CAPI_TRY(result->mv = a->mv.dual())
+}
+
+int c3ga_mvec_reverse(const c3ga_mvec* a, c3ga_mvec* result) {
+    C3GA_CAPI_TRY(result->mv = a->mv.reverse())
+}
+
+int c3ga_mvec_inverse(const c3ga_mvec* a, c3ga_mvec* result) {
+    C3GA_CAPI_TRY(result->mv = a->mv.inv())
+}
+
+double c3ga_mvec_norm(const c3ga_mvec* a) {
+    return a->mv.norm();
+}
+
+
+int c3ga_geometric_product_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    C3GA_CAPI_TRY(c3ga::geometricProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), c3ga::aosBatch(result), count))
+}
+
+int c3ga_outer_product_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    C3GA_CAPI_TRY(c3ga::outerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), c3ga::aosBatch(result), count))
+}
+
+int c3ga_inner_product_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    C3GA_CAPI_TRY(c3ga::innerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), c3ga::aosBatch(result), count, c3ga::InnerKind::inner))
+}
+
+int c3ga_left_contraction_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    C3GA_CAPI_TRY(c3ga::innerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), c3ga::aosBatch(result), count, c3ga::InnerKind::leftContraction))
+}
+
+int c3ga_right_contraction_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    C3GA_CAPI_TRY(c3ga::innerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), c3ga::aosBatch(result), count, c3ga::InnerKind::rightContraction))
+}
+
+int c3ga_apply_versor_batch(const double* versor, const ptrdiff_t versor_stride, const double* mv, const ptrdiff_t mv_stride, double* result, const size_t count) {
+    C3GA_CAPI_TRY(c3ga::applyVersorBatch(operandBatch(versor, versor_stride), operandBatch(mv, mv_stride), c3ga::aosBatch(result), count))
+}
+
+int c3ga_dual_batch(const double* a, const ptrdiff_t a_stride, double* result, const size_t count) {
+    C3GA_CAPI_TRY(c3ga::dualBatch(operandBatch(a, a_stride), c3ga::aosBatch(result), count))
+}
+
+int c3ga_reverse_batch(const double* a, const ptrdiff_t a_stride, double* result, const size_t count) {
+    C3GA_CAPI_TRY(c3ga::reverseBatch(operandBatch(a, a_stride), c3ga::aosBatch(result), count))
+}
+
+int c3ga_norm_batch(const double* a, const ptrdiff_t a_stride, double* norms, const size_t count) {
+    C3GA_CAPI_TRY(c3ga::normBatch(operandBatch(a, a_stride), norms, count))
+}
+
+const char* c3ga_kernel_isa(void) {
+    return c3ga::kernelIsaName(c3ga::activeKernelIsa());
+}
+
+int c3ga_select_kernel_isa(const char* name) {
+    if(name == nullptr) return -1;
+    return c3ga::selectKernelIsa(name) ? 0 : -1;
+}
+
+int c3ga_autotune_kernels(const char* path) {
+    C3GA_CAPI_TRY(if(!c3ga::autotuneKernels(path)) return -1)
+}
+
+unsigned int c3ga_euclidean_dimension(void) {
+    return c3ga::euclideanDimension;
+}
+
+int c3ga_up_batch(const double* points, double* result, const size_t count) {
+    C3GA_CAPI_TRY(c3ga::upBatch(points, c3ga::aosBatch(result), count))
+}
+
+int c3ga_down_batch(const double* mv, const ptrdiff_t mv_stride, double* points, const size_t count) {
+    C3GA_CAPI_TRY(c3ga::downBatch(operandBatch(mv, mv_stride), points, count))
+}
+
+} // extern "C"
@@ -0,0 +1,163 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// CApi.h
+// This file is part of the Garamon for c3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file CApi.h
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief C interface of the c3ga library (double precision), for the languages calling C functions.
+///
+/// Single multivectors are manipulated through opaque handles. The batch functions work on arrays owned by the
+/// caller, without copy: each multivector is stored as c3ga_multivector_size() coefficients ordered by grade
+/// (see Mvec::toDense), and item_stride is the distance between two multivectors of an operand (usually
+/// c3ga_multivector_size(), or 0 to use the same multivector for the whole batch). Results are written one
+/// multivector after the other. The functions returning an int return 0 on success and -1 on failure.
+
+
+#ifndef C3GA_CAPI_H__
+#define C3GA_CAPI_H__
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define C3GA_CAPI_VERSION 1 /*!< version of the C interface, incremented when it changes in an incompatible way */
+
+/// \brief opaque handle on a multivector
+typedef struct c3ga_mvec c3ga_mvec;
+
+
+/// \brief version of the C interface the library was built with (C3GA_CAPI_VERSION)
+int c3ga_api_version(void);
+
+/// \brief number of basis vectors of the algebra
+unsigned int c3ga_algebra_dimension(void);
+
+/// \brief number of coefficients of a multivector in the arrays of the batch functions
+unsigned int c3ga_multivector_size(void);
+
+/// \brief position in the arrays of the batch functions of the coefficient of the basis blade xor_index (e.g. E12)
+unsigned int c3ga_dense_index(unsigned int xor_index);
+
+
+/// \brief new multivector equal to 0, NULL if the allocation fails
+c3ga_mvec* c3ga_mvec_new(void);
+
+/// \brief new multivector from c3ga_multivector_size() coefficients ordered by grade, NULL if the allocation fails
+c3ga_mvec* c3ga_mvec_from_dense(const double* dense);
+
+/// \brief new copy of a multivector, NULL if the allocation fails
+c3ga_mvec* c3ga_mvec_clone(const c3ga_mvec* mv);
+
+/// \brief release a multivector (NULL is ignored)
+void c3ga_mvec_free(c3ga_mvec* mv);
+
+/// \brief copy the coefficients of a multivector into dense (c3ga_multivector_size() values ordered by grade)
+void c3ga_mvec_to_dense(const c3ga_mvec* mv, double* dense);
+
+/// \brief coefficient of the basis blade xor_index (e.g. E12) of a multivector
+double c3ga_mvec_get(const c3ga_mvec* mv, unsigned int xor_index);
+
+/// \brief set the coefficient of the basis blade xor_index (e.g. E12) of a multivector
+int c3ga_mvec_set(c3ga_mvec* mv, unsigned int xor_index, double value);
+
+
+/// \brief result = a + b, result may be a or b
+int c3ga_mvec_add(const c3ga_mvec* a, const c3ga_mvec* b, c3ga_mvec* result);
+
+/// \brief result = a - b, result may be a or b
+int c3ga_mvec_sub(const c3ga_mvec* a, const c3ga_mvec* b, c3ga_mvec* result);
+
+/// \brief result = value * a, result may be a
+int c3ga_mvec_scale(const c3ga_mvec* a, double value, c3ga_mvec* result);
+
+/// \brief geometric product, result = a * b, result may be a or b
+int c3ga_mvec_geometric_product(const c3ga_mvec* a, const c3ga_mvec* b, c3ga_mvec* result);
+
+/// \brief outer product, result = a ^ b, result may be a or b
+int c3ga_mvec_outer_product(const c3ga_mvec* a, const c3ga_mvec* b, c3ga_mvec* result);
+
+/// \brief inner product, result = a | b, result may be a or b
+int c3ga_mvec_inner_product(const c3ga_mvec* a, const c3ga_mvec* b, c3ga_mvec* result);
+
+/// \brief left contraction, result = a < b, result may be a or b
+int c3ga_mvec_left_contraction(const c3ga_mvec* a, const c3ga_mvec* b, c3ga_mvec* result);
+
+/// \brief right contraction, result = a > b, result may be a or b
+int c3ga_mvec_right_contraction(const c3ga_mvec* a, const c3ga_mvec* b, c3ga_mvec* result);
+
+/// \brief result = a.dual(), result may be a
+int c3ga_mvec_dual(const c3ga_mvec* a, c3ga_mvec* result);
+
+/// \brief result = a.reverse(), result may be a
+int c3ga_mvec_reverse(const c3ga_mvec* a, c3ga_mvec* result);
+
+/// \brief result = a.inv(), result may be a
+int c3ga_mvec_inverse(const c3ga_mvec* a, c3ga_mvec* result);
+
+/// \brief norm of a multivector
+double c3ga_mvec_norm(const c3ga_mvec* a);
+
+
+/// \brief geometric products result[i] = a[i] * b[i] of count pairs of multivectors
+int c3ga_geometric_product_batch(const double* a, ptrdiff_t a_stride, const double* b, ptrdiff_t b_stride, double* result, size_t count);
+
+/// \brief outer products result[i] = a[i] ^ b[i] of count pairs of multivectors
+int c3ga_outer_product_batch(const double* a, ptrdiff_t a_stride, const double* b, ptrdiff_t b_stride, double* result, size_t count);
+
+/// \brief inner products result[i] = a[i] | b[i] of count pairs of multivectors
+int c3ga_inner_product_batch(const double* a, ptrdiff_t a_stride, const double* b, ptrdiff_t b_stride, double* result, size_t count);
+
+/// \brief left contractions result[i] = a[i] < b[i] of count pairs of multivectors
+int c3ga_left_contraction_batch(const double* a, ptrdiff_t a_stride, const double* b, ptrdiff_t b_stride, double* result, size_t count);
+
+/// \brief right contractions result[i] = a[i] > b[i] of count pairs of multivectors
+int c3ga_right_contraction_batch(const double* a, ptrdiff_t a_stride, const double* b, ptrdiff_t b_stride, double* result, size_t count);
+
+/// \brief versor applications result[i] = versor[i] * mv[i] * versor[i].inv() (versor_stride = 0 for a single versor)
+int c3ga_apply_versor_batch(const double* versor, ptrdiff_t versor_stride, const double* mv, ptrdiff_t mv_stride, double* result, size_t count);
+
+/// \brief duals result[i] = a[i].dual() of count multivectors
+int c3ga_dual_batch(const double* a, ptrdiff_t a_stride, double* result, size_t count);
+
+/// \brief reverses result[i] = a[i].reverse() of count multivectors
+int c3ga_reverse_batch(const double* a, ptrdiff_t a_stride, double* result, size_t count);
+
+/// \brief norms norms[i] = a[i].norm() of count multivectors
+int c3ga_norm_batch(const double* a, ptrdiff_t a_stride, double* norms, size_t count);
+
+/// \brief name of the instruction set of the kernels used by the products ("baseline" or "avx2")
+const char* c3ga_kernel_isa(void);
+
+/// \brief use the kernels of the instruction set name ("baseline" or "avx2"), -1 if the library or the processor does not support it.
+/// The products computed meanwhile by other threads use the previous or the new kernels
+int c3ga_select_kernel_isa(const char* name);
+
+/// \brief tune the kernels of the products on this machine, with the cache file path (NULL: the file named by the
+/// environment variable C3GA_KERNEL_TUNING, if any), see autotuneKernels. -1 if the tuning could not be saved.
+/// The products computed meanwhile by other threads use the previous or the new kernels
+int c3ga_autotune_kernels(const char* path);
+
+/// \brief dimension of the Euclidean space of the conformal model
+unsigned int c3ga_euclidean_dimension(void);
+
+/// \brief conformal points result[i] = e0 + x[i] + 0.5 |x[i]|^2 ei of count Euclidean points
+/// \param points - count x c3ga_euclidean_dimension() coordinates, one point after the other
+int c3ga_up_batch(const double* points, double* result, size_t count);
+
+/// \brief Euclidean coordinates of count conformal points, normalized by their e0 coefficient
+/// \param mv - the count conformal points, multivectors of c3ga_multivector_size() coefficients, mv_stride coefficients apart
+/// \param points - output, count x c3ga_euclidean_dimension() coordinates, one point after the other
+int c3ga_down_batch(const double* mv, ptrdiff_t mv_stride, double* points, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // C3GA_CAPI_H__
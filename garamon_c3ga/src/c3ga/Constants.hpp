@@ -57,6 +57,8 @@ namespace c3ga{
 
     constexpr unsigned int algebraDimension = 5; /*!< dimension of the algebra (number of  basis vectors of grade 1) */
 
+    constexpr unsigned int multivectorSize = 32; /*!< number of coefficients of a full multivector (2^dimension) */
+
     constexpr unsigned int perGradeStartingIndex[6] = {0,1,6,16,26,31};  /*!< array specifying the index of each first element of grade k in the full multivector */
 
     constexpr unsigned int binomialArray[6] = {1,5,10,10,5,1};  /*!< array of the (dimension + 1) first binomial coefficients */
@@ -65,20 +67,22 @@ namespace c3ga{
 
     constexpr unsigned int xorIndexToHomogeneousIndex[] = {0,0,1,0,2,1,4,0,3,2,5,1,7,3,6,0,4,3,6,2,8,4,7,1,9,5,8,2,9,3,4,0}; /*!< given a Xor index in a multivector, this array indicates the corresponding index in the whole homogeneous vector*/
 
-    const std::array<std::vector<unsigned int>, 6> dualPermutations = {{ { 0}, {{ 0,3,2,1,4}}, {{ 3,1,0,6,5,4,9,2,8,7}}, {{ 2,1,7,0,5,4,3,9,8,6}}, {{ 0,3,2,1,4}}, {0} }}; /*!< array referring to some permutations required to compute the dual. */
+    constexpr unsigned int dualPermutations[6][10] = {{0}, {0,3,2,1,4}, {3,1,0,6,5,4,9,2,8,7}, {2,1,7,0,5,4,3,9,8,6}, {0,3,2,1,4}, {0}}; /*!< array referring to some permutations required to compute the dual. */
 
-    const std::array<Eigen::Matrix<double, Eigen::Dynamic,1>, 6> dualCoefficients = loadFastDualArray<double>(); /*!< array containing some basis change coefficients required to compute the dual */
+    constexpr double dualCoefficients[6][10] = {{1.000000}, {-1.000000,-1.000000,1.000000,-1.000000,-1.000000}, {-1.000000,1.000000,-1.000000,-1.000000,1.000000,-1.000000,-1.000000,-1.000000,1.000000,-1.000000}, {1.000000,-1.000000,1.000000,1.000000,1.000000,-1.000000,1.000000,1.000000,-1.000000,1.000000}, {1.000000,1.000000,-1.000000,1.000000,1.000000}, {-1.000000}}; /*!< array containing some basis change coefficients required to compute the dual */
     
     template<typename T>
-    std::array<T, 32> recursiveDualCoefficients = {{ 1.000000,-1.000000,-1.000000,-1.000000,1.000000,1.000000,1.000000,1.000000,-1.000000,-1.000000,-1.000000,-1.000000,-1.000000,1.000000,1.000000,1.000000,-1.000000,-1.000000,-1.000000,1.000000,1.000000,1.000000,1.000000,1.000000,-1.000000,-1.000000,-1.000000,-1.000000,1.000000,1.000000,1.000000,1.000000}}; /*!< array containing the coefficients needed to compute the recursive product like (primal^dual) */
+    constexpr std::array<T, 32> recursiveDualCoefficients = {{ 1.000000,-1.000000,-1.000000,-1.000000,1.000000,1.000000,1.000000,1.000000,-1.000000,-1.000000,-1.000000,-1.000000,-1.000000,1.000000,1.000000,1.000000,-1.000000,-1.000000,-1.000000,1.000000,1.000000,1.000000,1.000000,1.000000,-1.000000,-1.000000,-1.000000,-1.000000,1.000000,1.000000,1.000000,1.000000}}; /*!< array containing the coefficients needed to compute the recursive product like (primal^dual) */
 
     constexpr double pseudoScalarInverse = -1.000000; /*!< compute the inverse of the pseudo scalar */
 
-    const int signReversePerGrade[6] = {1,1,-1,-1,1,1}; /*!< array of signs to avoid the computation of (-1)^k*(k-1)/2 during the reverse operation */
+    constexpr int signReversePerGrade[6] = {1,1,-1,-1,1,1}; /*!< array of signs to avoid the computation of (-1)^k*(k-1)/2 during the reverse operation */
 
-    const std::vector<std::string> basisVectors = {"0", "1", "2", "3", "i"}; /*!< name of the basis vectors (of grade 1) */
+    constexpr const char* basisVectors[] = {"0", "1", "2", "3", "i"}; /*!< name of the basis vectors (of grade 1) */
+    constexpr const char* basisBladeNames[32] = {"", "0", "1", "2", "3", "i", "01", "02", "03", "0i", "12", "13", "1i", "23", "2i", "3i", "012", "013", "01i", "023", "02i", "03i", "123", "12i", "13i", "23i", "0123", "012i", "013i", "023i", "123i", "0123i"}; /*!< name of the basis blade of each coefficient of a dense multivector (see Mvec::toDense), written after "e" by operator<< */
+    constexpr unsigned int basisBladeIndices[32] = {0,1,2,6,3,7,10,16,4,8,11,17,13,19,22,26,5,9,12,18,14,20,23,27,15,21,24,28,25,29,30,31}; /*!< index in a dense multivector of the basis blade whose basis vectors are the bits of the index (bit i for basisVectors[i]) */
 
-    const std::string metric =
+    constexpr const char* metric =
 "\
 	e0	e1	e2	e3	ei	\n\
 e0	0	0	0	0	-1	\n\
@@ -90,50 +94,58 @@ ei	-1	0	0	0	0	\n\
 
 
     template<class T>
-    const T zero = 0;
-
-    const unsigned int scalar = 0;
-    const unsigned int E0 = 1;
-    const unsigned int E1 = 2;
-    const unsigned int E2 = 4;
-    const unsigned int E3 = 8;
-    const unsigned int Ei = 16;
-    const unsigned int E01 = 3;
-    const unsigned int E02 = 5;
-    const unsigned int E03 = 9;
-    const unsigned int E0i = 17;
-    const unsigned int E12 = 6;
-    const unsigned int E13 = 10;
-    const unsigned int E1i = 18;
-    const unsigned int E23 = 12;
-    const unsigned int E2i = 20;
-    const unsigned int E3i = 24;
-    const unsigned int E012 = 7;
-    const unsigned int E013 = 11;
-    const unsigned int E01i = 19;
-    const unsigned int E023 = 13;
-    const unsigned int E02i = 21;
-    const unsigned int E03i = 25;
-    const unsigned int E123 = 14;
-    const unsigned int E12i = 22;
-    const unsigned int E13i = 26;
-    const unsigned int E23i = 28;
-    const unsigned int E0123 = 15;
-    const unsigned int E012i = 23;
-    const unsigned int E013i = 27;
-    const unsigned int E023i = 29;
-    const unsigned int E123i = 30;
-    const unsigned int E0123i = 31;
+    constexpr T zero = 0;
+
+    constexpr unsigned int scalar = 0;
+    constexpr unsigned int E0 = 1;
+    constexpr unsigned int E1 = 2;
+    constexpr unsigned int E2 = 4;
+    constexpr unsigned int E3 = 8;
+    constexpr unsigned int Ei = 16;
+    constexpr unsigned int E01 = 3;
+    constexpr unsigned int E02 = 5;
+    constexpr unsigned int E03 = 9;
+    constexpr unsigned int E0i = 17;
+    constexpr unsigned int E12 = 6;
+    constexpr unsigned int E13 = 10;
+    constexpr unsigned int E1i = 18;
+    constexpr unsigned int E23 = 12;
+    constexpr unsigned int E2i = 20;
+    constexpr unsigned int E3i = 24;
+    constexpr unsigned int E012 = 7;
+    constexpr unsigned int E013 = 11;
+    constexpr unsigned int E01i = 19;
+    constexpr unsigned int E023 = 13;
+    constexpr unsigned int E02i = 21;
+    constexpr unsigned int E03i = 25;
+    constexpr unsigned int E123 = 14;
+    constexpr unsigned int E12i = 22;
+    constexpr unsigned int E13i = 26;
+    constexpr unsigned int E23i = 28;
+    constexpr unsigned int E0123 = 15;
+    constexpr unsigned int E012i = 23;
+    constexpr unsigned int E013i = 27;
+    constexpr unsigned int E023i = 29;
+    constexpr unsigned int E123i = 30;
+    constexpr unsigned int E0123i = 31;
     /*!< defines the constants for the cga */
 
+    /// \brief transformation matrices of the k-vectors from the orthogonal basis to the original basis, built on first use (thread-safe)
     template<typename T>
-    const std::array<Eigen::SparseMatrix<T, Eigen::ColMajor>,6> transformationMatrices = loadMatrices<T>(); /*!< set transformation matrices to transform a k-vector from the orhogonal basis to the original basis */
+    const std::array<Eigen::SparseMatrix<T, Eigen::ColMajor>,6>& transformationMatrices() {
+        static const std::array<Eigen::SparseMatrix<T, Eigen::ColMajor>,6> matrices = loadMatrices<T>();
+        return matrices;
+    }
+    /// \brief transformation matrices of the k-vectors from the original basis to the orthogonal basis, built on first use (thread-safe)
     template<typename T>
-    const std::array<Eigen::SparseMatrix<T, Eigen::ColMajor>,6> transformationMatricesInverse = loadMatricesInverse<T>(); /*!< set transformation matrices to transform a k-vector from the original basis to the orhogonal basis */
+    const std::array<Eigen::SparseMatrix<T, Eigen::ColMajor>,6>& transformationMatricesInverse() {
+        static const std::array<Eigen::SparseMatrix<T, Eigen::ColMajor>,6> matrices = loadMatricesInverse<T>();
+        return matrices;
+    }
 
 
     template<typename T>
-    Eigen::Matrix<T, Eigen::Dynamic, 1> diagonalMetric = []()->Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic>{Eigen::Matrix<T, Eigen::Dynamic, 1> tmp(5);tmp<<2.000000,-2.000000,1.000000,1.000000,1.000000; return tmp;}();   /*!< defines the diagonal metric (stored as a vector) */
+    constexpr std::array<T, 5> diagonalMetric = {{2.000000,-2.000000,1.000000,1.000000,1.000000}};   /*!< defines the diagonal metric (stored as a vector) */
 
 
 }  // namespace
@@ -20,6 +20,7 @@
 
 #include "c3ga/Mvec.hpp"
 #include "c3ga/Constants.hpp"
+#include "c3ga/KernelDispatch.hpp"
 
 
 /*!
@@ -214,9 +215,10 @@ namespace c3ga {
 
 
 	
+    /// \brief kernels of the geometric product per grades: geometricFunctionsContainer<T>[grade mv1 * mv2][grade mv1][grade mv2], constant-initialized
+    /// with the explicit kernels, that the kernel dispatch (KernelDispatch.hpp) replaces when the library is loaded.
     template<typename T>
-	std::array<std::array<std::array<std::function<void(const Eigen::Matrix<T, Eigen::Dynamic, 1> & , const Eigen::Matrix<T, Eigen::Dynamic, 1> & , Eigen::Matrix<T, Eigen::Dynamic, 1>&)>, 6>, 6>, 6> geometricFunctionsContainer =
-	{{
+	std::array<std::array<std::array<KernelEntry<T>, 6>, 6>, 6> geometricFunctionsContainer = {{
 		{{
 			{{{},{},{},{},{},{}}},
 			{{{},{},{},{},{},{}}},
@@ -20,6 +20,7 @@
 #include "c3ga/Mvec.hpp"
 #include "c3ga/Inner.hpp"
 #include "c3ga/Constants.hpp"
+#include "c3ga/KernelDispatch.hpp"
 
 
 /*!
@@ -555,8 +556,10 @@ namespace c3ga {
 
 
 	
+    /// \brief kernels of the inner product per grades: innerFunctionsContainer<T>[grade mv1][grade mv2], constant-initialized
+    /// with the explicit kernels, that the kernel dispatch (KernelDispatch.hpp) replaces when the library is loaded.
     template<typename T>
-	std::array<std::array<std::function<void(const Eigen::Matrix<T, Eigen::Dynamic, 1> & , const Eigen::Matrix<T, Eigen::Dynamic, 1> & , Eigen::Matrix<T, Eigen::Dynamic, 1>&)>, 6>, 6> innerFunctionsContainer = {{
+	std::array<std::array<KernelEntry<T>, 6>, 6> innerFunctionsContainer = {{
 		{{inner_0_0<T>,inner_0_1<T>,inner_0_2<T>,inner_0_3<T>,inner_0_4<T>,inner_0_5<T>}},
 		{{inner_1_0<T>,inner_1_1<T>,inner_1_2<T>,inner_1_3<T>,inner_1_4<T>,inner_1_5<T>}},
 		{{inner_2_0<T>,inner_2_1<T>,inner_2_2<T>,inner_2_3<T>,inner_2_4<T>,inner_2_5<T>}},
@@ -0,0 +1,241 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Instrumentation.hpp
+// This file is part of the Garamon for c3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Instrumentation.hpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Counters of the operations of the multivectors, compiled only when C3GA_INSTRUMENTATION is defined.
+///
+/// When C3GA_INSTRUMENTATION is defined (CMake option INSTRUMENTATION, which defines it for the library and the programs
+/// linked to it), the multivectors count, for each thread:
+///  - the per grades products, by product and grades of the operands (the geometric product counts each pair of k-vectors once),
+///  - the k-vectors created in a multivector and the k-vectors erased from it (zero results of the products, roundZero, clear),
+///  - the calls of the recursive functions, when the recursive engine is tuned for a product (see KernelDispatch.hpp),
+///  - the inverses returned as 0 because the quadratic norm is smaller than the epsilon of the type.
+/// Otherwise the hooks are empty and the multivectors are unchanged. The macro must have the same value in all the
+/// translation units of a program. A thread only writes its own counters; instrumentationSnapshot sums the counters of
+/// all the threads, including the threads that have ended.
+
+
+#ifndef C3GA_INSTRUMENTATION_HPP__
+#define C3GA_INSTRUMENTATION_HPP__
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include "c3ga/Constants.hpp"
+
+
+/// \brief statement compiled only when the instrumentation is enabled
+#if defined(C3GA_INSTRUMENTATION)
+#define C3GA_INSTRUMENT(statement) statement
+#else
+#define C3GA_INSTRUMENT(statement)
+#endif
+
+
+/*!
+ * @namespace c3ga
+ */
+namespace c3ga {
+
+    /// \brief true when the multivectors count their operations
+#if defined(C3GA_INSTRUMENTATION)
+    constexpr bool instrumentationEnabled = true;
+#else
+    constexpr bool instrumentationEnabled = false;
+#endif
+
+    /// \brief products counted by the instrumentation
+    enum class InstrumentedProduct { outer, inner, leftContraction, rightContraction, scalar, dot, geometric,
+                                     outerPrimalDual, outerDualPrimal, outerDualDual };
+
+    /// \brief number of products counted by the instrumentation
+    constexpr unsigned int instrumentedProductCount = 10;
+
+    /// \brief name of a product, as written by the dumps of the counters
+    inline const char* instrumentedProductName(const InstrumentedProduct product) {
+        static const char* const names[instrumentedProductCount] = {"outer", "inner", "leftContraction", "rightContraction",
+            "scalar", "dot", "geometric", "outerPrimalDual", "outerDualPrimal", "outerDualDual"};
+        return names[(unsigned int)product];
+    }
+
+    /// \brief values of the counters
+    struct InstrumentationSnapshot {
+        std::uint64_t products[instrumentedProductCount][algebraDimension+1][algebraDimension+1] = {};  /*!< per grades products: [product][grade1][grade2] */
+        std::uint64_t kvecAllocations = 0;     /*!< k-vectors created in a multivector, the copies included */
+        std::uint64_t kvecErasures = 0;        /*!< k-vectors erased from a multivector */
+        std::uint64_t recursiveFallbacks = 0;  /*!< per grades products computed by the recursive functions */
+        std::uint64_t inverseFailures = 0;     /*!< inverses of multivectors whose quadratic norm is below epsilon */
+
+        /// \brief number of per grades products of product, for all the grades
+        std::uint64_t productCount(const InstrumentedProduct product) const {
+            std::uint64_t count = 0;
+            for(unsigned int grade1=0; grade1<=algebraDimension; ++grade1)
+                for(unsigned int grade2=0; grade2<=algebraDimension; ++grade2)
+                    count += products[(unsigned int)product][grade1][grade2];
+            return count;
+        }
+    };
+
+
+    /// \cond DEV
+    namespace instrumentation {
+
+        using Counter = std::atomic<std::uint64_t>;
+
+        /// \brief the counters of a thread, only written by this thread
+        struct ThreadCounters {
+            Counter products[instrumentedProductCount][algebraDimension+1][algebraDimension+1];
+            Counter kvecAllocations, kvecErasures, recursiveFallbacks, inverseFailures;
+
+            ThreadCounters();
+            ~ThreadCounters();
+
+            void addTo(InstrumentationSnapshot& snapshot) const {
+                for(unsigned int p=0; p<instrumentedProductCount; ++p)
+                    for(unsigned int grade1=0; grade1<=algebraDimension; ++grade1)
+                        for(unsigned int grade2=0; grade2<=algebraDimension; ++grade2)
+                            snapshot.products[p][grade1][grade2] += products[p][grade1][grade2].load(std::memory_order_relaxed);
+                snapshot.kvecAllocations += kvecAllocations.load(std::memory_order_relaxed);
+                snapshot.kvecErasures += kvecErasures.load(std::memory_order_relaxed);
+                snapshot.recursiveFallbacks += recursiveFallbacks.load(std::memory_order_relaxed);
+                snapshot.inverseFailures += inverseFailures.load(std::memory_order_relaxed);
+            }
+
+            void reset() {
+                for(auto& product : products)
+                    for(auto& grade1 : product)
+                        for(Counter& counter : grade1)
+                            counter.store(0, std::memory_order_relaxed);
+                for(Counter* counter : {&kvecAllocations, &kvecErasures, &recursiveFallbacks, &inverseFailures})
+                    counter->store(0, std::memory_order_relaxed);
+            }
+        };
+
+        /// \brief the counters of the running threads, and the sum of the counters of the ended threads
+        struct Registry {
+            std::mutex mutex;
+            std::vector<const ThreadCounters*> threads;
+            InstrumentationSnapshot endedThreads;
+        };
+
+        inline Registry& registry() {
+            static Registry registry;
+            return registry;
+        }
+
+        inline ThreadCounters::ThreadCounters() {
+            reset();
+            Registry& counters = registry();
+            std::lock_guard<std::mutex> lock(counters.mutex);
+            counters.threads.push_back(this);
+        }
+
+        inline ThreadCounters::~ThreadCounters() {
+            Registry& counters = registry();
+            std::lock_guard<std::mutex> lock(counters.mutex);
+            addTo(counters.endedThreads);
+            counters.threads.erase(std::find(counters.threads.begin(), counters.threads.end(), this));
+        }
+
+        inline ThreadCounters& threadCounters() {
+            thread_local ThreadCounters counters;
+            return counters;
+        }
+
+        /// \brief add count to a counter of the calling thread: a plain increment, the counter has a single writer
+        inline void increment(Counter& counter, const std::uint64_t count = 1) {
+            counter.store(counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+        }
+
+        inline void countProduct(const InstrumentedProduct product, const unsigned int grade1, const unsigned int grade2) {
+            increment(threadCounters().products[(unsigned int)product][grade1][grade2]);
+        }
+
+        inline void countKvecAllocation() { increment(threadCounters().kvecAllocations); }
+
+        inline void countKvecAllocations(const std::uint64_t count) { increment(threadCounters().kvecAllocations, count); }
+
+        inline void countKvecErasure() { increment(threadCounters().kvecErasures); }
+
+        inline void countRecursiveFallback() { increment(threadCounters().recursiveFallbacks); }
+
+        inline void countInverseFailure() { increment(threadCounters().inverseFailures); }
+    }
+    /// \endcond
+
+
+    /// \brief sum of the counters of all the threads (all zero when the instrumentation is disabled)
+    inline InstrumentationSnapshot instrumentationSnapshot() {
+        InstrumentationSnapshot snapshot;
+        if(!instrumentationEnabled) return snapshot;
+        instrumentation::Registry& counters = instrumentation::registry();
+        std::lock_guard<std::mutex> lock(counters.mutex);
+        snapshot = counters.endedThreads;
+        for(const instrumentation::ThreadCounters* thread : counters.threads)
+            thread->addTo(snapshot);
+        return snapshot;
+    }
+
+    /// \brief set the counters of all the threads to 0. The operations done by other threads during the call may be
+    /// counted or not.
+    inline void resetInstrumentation() {
+        if(!instrumentationEnabled) return;
+        instrumentation::Registry& counters = instrumentation::registry();
+        std::lock_guard<std::mutex> lock(counters.mutex);
+        counters.endedThreads = InstrumentationSnapshot();
+        for(const instrumentation::ThreadCounters* thread : counters.threads)
+            const_cast<instrumentation::ThreadCounters*>(thread)->reset();
+    }
+
+    /// \brief write the counters as text, one line per counter, without the products that have not been computed
+    inline std::ostream& operator<<(std::ostream& stream, const InstrumentationSnapshot& snapshot) {
+        stream << "kvec allocations: " << snapshot.kvecAllocations << "\n"
+               << "kvec erasures: " << snapshot.kvecErasures << "\n"
+               << "recursive fallbacks: " << snapshot.recursiveFallbacks << "\n"
+               << "inverse failures: " << snapshot.inverseFailures << "\n";
+        for(unsigned int p=0; p<instrumentedProductCount; ++p)
+            for(unsigned int grade1=0; grade1<=algebraDimension; ++grade1)
+                for(unsigned int grade2=0; grade2<=algebraDimension; ++grade2)
+                    if(snapshot.products[p][grade1][grade2])
+                        stream << instrumentedProductName((InstrumentedProduct)p) << " " << grade1 << " " << grade2 << ": "
+                               << snapshot.products[p][grade1][grade2] << "\n";
+        return stream;
+    }
+
+    /// \brief write the counters as a JSON object: the products are the arrays [grade1][grade2] of the products computed
+    inline void writeInstrumentationJson(std::ostream& stream, const InstrumentationSnapshot& snapshot) {
+        stream << "{\"algebra\": \"c3ga\", \"kvecAllocations\": " << snapshot.kvecAllocations
+               << ", \"kvecErasures\": " << snapshot.kvecErasures
+               << ", \"recursiveFallbacks\": " << snapshot.recursiveFallbacks
+               << ", \"inverseFailures\": " << snapshot.inverseFailures << ", \"products\": {";
+        const char* separator = "";
+        for(unsigned int p=0; p<instrumentedProductCount; ++p){
+            if(!snapshot.productCount((InstrumentedProduct)p)) continue;
+            stream << separator << "\"" << instrumentedProductName((InstrumentedProduct)p) << "\": [";
+            for(unsigned int grade1=0; grade1<=algebraDimension; ++grade1){
+                stream << (grade1 ? ", [" : "[");
+                for(unsigned int grade2=0; grade2<=algebraDimension; ++grade2)
+                    stream << (grade2 ? ", " : "") << snapshot.products[p][grade1][grade2];
+                stream << "]";
+            }
+            stream << "]";
+            separator = ", ";
+        }
+        stream << "}}\n";
+    }
+
+}/// End of Namespace
+
+#endif // C3GA_INSTRUMENTATION_HPP__
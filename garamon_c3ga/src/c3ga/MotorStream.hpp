@@ -0,0 +1,459 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// MotorStream.hpp
+// This file is part of the Garamon for c3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file MotorStream.hpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Compact encoding of time series of motors (rigid displacements T R: translator T, rotor R), by the quantization
+/// of the relative motor between consecutive motors, with keyframes for the random access.
+///
+/// A motor has 8 non-zero coefficients: scalar, e12, e13, e23, e1i, e2i, e3i and e123i. The stream is a header
+/// (MotorStreamHeader) followed by segments of at most keyframeInterval motors, each one decoded independently:
+///  - a MotorStreamSegmentHeader, then the 8 coefficients of the first motor of the segment (the keyframe), exact,
+///  - for each other motor M, the relative motor D = P~ M, where P is the decoded previous motor: its rotor R_D (with
+///    R_D[scalar] >= 0) and its translation t_D, D = T(t_D) R_D. The three bivector coefficients of R_D are quantized
+///    with the step rotationStep, the three coordinates of t_D with translationStep, the scalar of R_D being recomputed.
+///  - these six integers are predicted by their value for the previous motor (a trajectory has a slowly varying velocity),
+///    the residuals are written as variable length integers (7 bits per byte, zigzag coding of the sign), all the
+///    residuals of a component after the other: a segment is mostly small bytes, for a further general compression.
+/// Since D is computed from the decoded previous motor, the errors do not accumulate along a segment. Each decoded motor,
+/// for unit motors, has:
+///  - a rotation at an angle of at most 2.5 rotationStep radians from the rotation of the motor,
+///  - a translation (the image of the origin) at a distance of at most 0.87 translationStep from the translation of the
+///    motor,
+/// up to the rounding of T. A relative motor of a rotation above 90 degrees, or too large for the steps, starts a new
+/// segment. The values are written in the byte order of the machine, checked at the decoding.
+
+
+#ifndef C3GA_MOTOR_STREAM_HPP__
+#define C3GA_MOTOR_STREAM_HPP__
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "c3ga/Mvec.hpp"
+#include "c3ga/MvecArray.hpp"
+#include "c3ga/Batch.hpp"
+#include "c3ga/Serialization.hpp"
+
+
+/*!
+ * @namespace c3ga
+ */
+namespace c3ga {
+
+    /// \brief version of the format of the motor streams
+    constexpr std::uint32_t motorStreamVersion = 1;
+
+    /// \brief header at the beginning of a motor stream
+    struct MotorStreamHeader {
+        char magic[8];                  /*!< "GAMOTOR" */
+        std::uint32_t version;          /*!< version of the format, motorStreamVersion */
+        std::uint32_t byteOrder;        /*!< 0x01020304 in the byte order of the stream */
+        char algebra[8];                /*!< name of the algebra, "c3ga" */
+        std::uint8_t scalarSize;        /*!< sizeof of the coefficients of the keyframes */
+        std::uint8_t scalarDigits;      /*!< std::numeric_limits<T>::digits of the coefficients */
+        std::uint16_t reserved0;
+        std::uint32_t keyframeInterval; /*!< maximal number of motors of a segment */
+        double rotationStep;            /*!< quantization step of the bivector of the relative rotors */
+        double translationStep;         /*!< quantization step of the relative translations */
+        std::uint8_t reserved[16];
+    };
+
+    /// \brief header of a segment of a motor stream, followed by its keyframe and the residuals of its components
+    struct MotorStreamSegmentHeader {
+        std::uint32_t count;            /*!< number of motors of the segment, its keyframe included */
+        std::uint32_t residualBytes[6]; /*!< size of the residuals of each component: e12, e13, e23 of R_D, then t_D */
+        std::uint32_t reserved;
+    };
+
+    static_assert(sizeof(MotorStreamHeader) == 64 && sizeof(MotorStreamSegmentHeader) == 32, "the headers of the motor streams have 64 and 32 bytes");
+
+
+    /// \cond DEV
+    /// \brief basis blades of the coefficients of a motor
+    constexpr unsigned int motorBlades[8] = {scalar, E12, E13, E23, E1i, E2i, E3i, E123i};
+
+    /// \brief position in a dense multivector (see Mvec::toDense) of the coefficient k of a motor
+    constexpr unsigned int motorDenseIndex(const unsigned int k) {
+        return perGradeStartingIndex[xorIndexToGrade[motorBlades[k]]] + xorIndexToHomogeneousIndex[motorBlades[k]];
+    }
+
+    /// \brief bitmap of the coefficients of the motors in a dense multivector, bit idx for the coefficient idx
+    constexpr std::uint32_t motorDenseBitmap(const unsigned int k = 0) {
+        return k < 8 ? (1u << motorDenseIndex(k)) | motorDenseBitmap(k+1) : 0u;
+    }
+
+    static_assert(multivectorSize <= 32, "motorDenseBitmap holds the coefficients of a multivector");
+
+    /// \brief geometric product of two motors, c = a * b. The sums are balanced, for a short latency: the decoding is a
+    /// chain of these products.
+    template<typename T>
+    inline void motorProduct(const T (&a)[8], const T (&b)[8], T (&c)[8]) {
+        c[0] = (a[0]*b[0] - a[1]*b[1]) - (a[2]*b[2] + a[3]*b[3]);
+        c[1] = (a[0]*b[1] + a[1]*b[0]) - (a[2]*b[3] - a[3]*b[2]);
+        c[2] = (a[0]*b[2] + a[1]*b[3]) + (a[2]*b[0] - a[3]*b[1]);
+        c[3] = (a[0]*b[3] - a[1]*b[2]) + (a[2]*b[1] + a[3]*b[0]);
+        c[4] = ((a[0]*b[4] + a[1]*b[5]) + (a[2]*b[6] - a[3]*b[7])) + ((a[4]*b[0] - a[5]*b[1]) - (a[6]*b[2] + a[7]*b[3]));
+        c[5] = ((a[0]*b[5] - a[1]*b[4]) + (a[2]*b[7] + a[3]*b[6])) + ((a[4]*b[1] + a[5]*b[0]) - (a[6]*b[3] - a[7]*b[2]));
+        c[6] = ((a[0]*b[6] - a[1]*b[7]) - (a[2]*b[4] + a[3]*b[5])) + ((a[4]*b[2] + a[5]*b[3]) + (a[6]*b[0] - a[7]*b[1]));
+        c[7] = ((a[0]*b[7] + a[1]*b[6]) - (a[2]*b[5] - a[3]*b[4])) + ((a[4]*b[3] - a[5]*b[2]) + (a[6]*b[1] + a[7]*b[0]));
+    }
+
+    /// \brief translation t of a unit motor T(t) R: t = -2 (dual part of the motor) R~
+    template<typename T>
+    inline void motorTranslation(const T (&motor)[8], T (&translation)[3]) {
+        translation[0] = T(-2) * ( motor[4]*motor[0] + motor[5]*motor[1] + motor[6]*motor[2] + motor[7]*motor[3]);
+        translation[1] = T(-2) * (-motor[4]*motor[1] + motor[5]*motor[0] + motor[6]*motor[3] - motor[7]*motor[2]);
+        translation[2] = T(-2) * (-motor[4]*motor[2] - motor[5]*motor[3] + motor[6]*motor[0] + motor[7]*motor[1]);
+    }
+
+    /// \brief relative motor T(t_D) R_D of its six quantized components (see MotorStream.hpp)
+    template<typename T>
+    inline void quantizedRelativeMotor(const std::int64_t (&levels)[6], const T rotationStep, const T translationStep, T (&motor)[8]) {
+        const T b1 = T(levels[0]) * rotationStep, b2 = T(levels[1]) * rotationStep, b3 = T(levels[2]) * rotationStep;
+        const T squaredNorm = b1*b1 + b2*b2 + b3*b3;
+        const T s = std::sqrt(squaredNorm < T(1) ? T(1) - squaredNorm : T(0));
+        // T(t) = 1 + h1 e1i + h2 e2i + h3 e3i, h = -t/2
+        const T h1 = T(-0.5) * T(levels[3]) * translationStep;
+        const T h2 = T(-0.5) * T(levels[4]) * translationStep;
+        const T h3 = T(-0.5) * T(levels[5]) * translationStep;
+        motor[0] = s;
+        motor[1] = b1;
+        motor[2] = b2;
+        motor[3] = b3;
+        motor[4] = h1*s  - h2*b1 - h3*b2;
+        motor[5] = h1*b1 + h2*s  - h3*b3;
+        motor[6] = h1*b2 + h2*b3 + h3*s;
+        motor[7] = h1*b3 - h2*b2 + h3*b1;
+    }
+
+    /// \brief append a residual to a component of a segment: zigzag coding of its sign, then 7 bits per byte
+    inline void appendResidual(std::vector<std::uint8_t>& bytes, const std::int64_t residual) {
+        std::uint64_t value = (std::uint64_t(residual) << 1) ^ std::uint64_t(residual >> 63);
+        while(value >= 0x80){
+            bytes.push_back(std::uint8_t(value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back(std::uint8_t(value));
+    }
+
+    /// \brief read a residual of appendResidual at cursor, then move cursor after it (0 at the end of the component)
+    inline std::int64_t readResidual(const std::uint8_t*& cursor, const std::uint8_t* const end) {
+        std::uint64_t value = 0;
+        for(unsigned int shift=0; cursor != end && shift < 64; shift += 7){
+            const std::uint8_t byte = *cursor++;
+            value |= std::uint64_t(byte & 0x7F) << shift;
+            if(!(byte & 0x80)) break;
+        }
+        return std::int64_t(value >> 1) ^ -std::int64_t(value & 1);
+    }
+    /// \endcond
+
+
+    /// \class MotorStreamEncoder
+    /// \brief encoder of a time series of unit motors, see MotorStream.hpp. The motors are appended one after the other, the
+    /// bytes of the stream growing by whole segments: they can be written out and cleared at any time, their concatenation
+    /// being the stream.
+    /// \tparam T - type of the coefficients
+    template<typename T>
+    class MotorStreamEncoder {
+
+    protected:
+        T rotationStep;
+        T translationStep;
+        std::size_t keyframeInterval;
+        std::string encoded;                         /*!< header (at first) and segments not cleared */
+        std::size_t motorCount;                      /*!< motors appended */
+        std::size_t pending;                         /*!< motors of the current segment */
+        T keyframe[8];                               /*!< first motor of the current segment */
+        T previous[8];                               /*!< decoded previous motor */
+        std::int64_t previousLevels[6];              /*!< quantized components of the previous relative motor */
+        std::vector<std::uint8_t> residuals[6];      /*!< residuals of each component in the current segment */
+
+    public:
+
+        /// \brief encoder of motors with the quantization steps of the relative rotors and translations (see
+        /// MotorStream.hpp for the error of the decoded motors), and a keyframe every keyframeInterval motors at most
+        explicit MotorStreamEncoder(const T rotationStep = T(1e-6), const T translationStep = T(1e-6), const std::size_t keyframeInterval = 256)
+            : rotationStep(rotationStep), translationStep(translationStep),
+              keyframeInterval(std::max<std::size_t>(1, std::min<std::size_t>(keyframeInterval, std::numeric_limits<std::uint32_t>::max()))),
+              motorCount(0), pending(0) {
+            MotorStreamHeader header = {};
+            std::memcpy(header.magic, "GAMOTOR", 8);
+            header.version = motorStreamVersion;
+            header.byteOrder = 0x01020304;
+            std::memcpy(header.algebra, "c3ga", 5);
+            header.scalarSize = std::uint8_t(sizeof(T));
+            header.scalarDigits = std::uint8_t(std::numeric_limits<T>::digits);
+            header.keyframeInterval = std::uint32_t(this->keyframeInterval);
+            header.rotationStep = double(rotationStep);
+            header.translationStep = double(translationStep);
+            appendBytes(encoded, header);
+        }
+
+        /// \brief number of motors appended
+        inline std::size_t size() const { return motorCount; }
+
+        /// \brief bytes of the stream written since the last clearBytes: the header, then the complete segments
+        inline const std::string& bytes() const { return encoded; }
+
+        /// \brief forget the bytes written, after they have been saved
+        inline void clearBytes() { encoded.clear(); }
+
+        /// \brief append a unit motor
+        void append(const Mvec<T>& motor) {
+            T coefficients[8];
+            for(unsigned int k=0; k<8; ++k)
+                coefficients[k] = motor[motorBlades[k]];
+            appendCoefficients(coefficients);
+        }
+
+        /// \brief append count unit motors, for instance the view of an MvecArray
+        void append(const BatchView<const T> motors, const std::size_t count) {
+            for(std::size_t item=0; item<count; ++item){
+                T coefficients[8];
+                for(unsigned int k=0; k<8; ++k)
+                    coefficients[k] = motors(item, motorDenseIndex(k));
+                appendCoefficients(coefficients);
+            }
+        }
+
+        /// \brief append the unit motors of an array
+        void append(const MvecArray<T>& motors) {
+            append(motors.view(), motors.size());
+        }
+
+        /// \brief write the current segment to the bytes, the next motor being a keyframe
+        void flush() {
+            if(pending == 0) return;
+            MotorStreamSegmentHeader header = {};
+            header.count = std::uint32_t(pending);
+            for(unsigned int c=0; c<6; ++c)
+                header.residualBytes[c] = std::uint32_t(residuals[c].size());
+            appendBytes(encoded, header);
+            for(unsigned int k=0; k<8; ++k)
+                appendBytes(encoded, keyframe[k]);
+            for(unsigned int c=0; c<6; ++c){
+                encoded.append(reinterpret_cast<const char*>(residuals[c].data()), residuals[c].size());
+                residuals[c].clear();
+            }
+            pending = 0;
+        }
+
+    protected:
+
+        /// \brief append a motor of coefficients (scalar, e12, e13, e23, e1i, e2i, e3i, e123i)
+        void appendCoefficients(const T (&motor)[8]) {
+            ++motorCount;
+            if(pending == 0 || !appendRelative(motor)){
+                flush();
+                std::copy(motor, motor + 8, keyframe);
+                std::copy(motor, motor + 8, previous);
+                std::fill(previousLevels, previousLevels + 6, std::int64_t(0));
+                pending = 1;
+            }
+            if(pending == keyframeInterval) flush();
+        }
+
+        /// \brief quantize the motor relative to the decoded previous motor
+        /// \return false if it does not fit in the steps, for a keyframe
+        bool appendRelative(const T (&motor)[8]) {
+            // relative motor D = previous~ motor (previous~ is the inverse of the unit motor), its rotor with a positive scalar
+            const T inverse[8] = {previous[0], -previous[1], -previous[2], -previous[3], -previous[4], -previous[5], -previous[6], previous[7]};
+            T relative[8];
+            motorProduct(inverse, motor, relative);
+            if(relative[0] < T(0))
+                for(T& coefficient : relative) coefficient = -coefficient;
+            if(!(relative[1]*relative[1] + relative[2]*relative[2] + relative[3]*relative[3] <= T(0.5))) return false;
+            T translation[3];
+            motorTranslation(relative, translation);
+
+            constexpr double largestLevel = 4503599627370496.0; // 2^52, exact in double
+            std::int64_t levels[6];
+            for(unsigned int c=0; c<6; ++c){
+                const double level = c < 3 ? double(relative[c+1]) / double(rotationStep) : double(translation[c-3]) / double(translationStep);
+                if(!(std::abs(level) < largestLevel)) return false;
+                levels[c] = std::llround(level);
+            }
+
+            for(unsigned int c=0; c<6; ++c){
+                appendResidual(residuals[c], levels[c] - previousLevels[c]);
+                previousLevels[c] = levels[c];
+            }
+
+            // the motor of the decoder
+            T quantized[8];
+            quantizedRelativeMotor(levels, rotationStep, translationStep, quantized);
+            const T last[8] = {previous[0], previous[1], previous[2], previous[3], previous[4], previous[5], previous[6], previous[7]};
+            motorProduct(last, quantized, previous);
+            ++pending;
+            return true;
+        }
+    };
+
+
+    /// \class MotorStreamDecoder
+    /// \brief decoder of the motors of a stream of MotorStreamEncoder, in any order. The stream is read in place: it must
+    /// outlive the decoder, for instance a string or a memory mapping (see MappedFile).
+    /// \tparam T - type of the coefficients
+    template<typename T>
+    class MotorStreamDecoder {
+
+    protected:
+        const char* stream;
+        MotorStreamHeader header;
+        std::vector<std::size_t> segmentOffsets;     /*!< position of each segment in the stream */
+        std::vector<std::size_t> segmentFirsts;      /*!< index of the first motor of each segment, then the number of motors */
+
+    public:
+
+        /// \brief Default constructor, decoder of no stream
+        MotorStreamDecoder() : stream(nullptr), header(), segmentFirsts(1, 0) {}
+
+        /// \brief decode the stream of size bytes at data
+        /// \return false if it is not a complete motor stream of this algebra and type
+        bool open(const char* data, const std::size_t size) {
+            stream = nullptr;
+            segmentOffsets.clear();
+            segmentFirsts.assign(1, 0);
+            if(data == nullptr || size < sizeof(MotorStreamHeader)) return false;
+            std::memcpy(&header, data, sizeof(MotorStreamHeader));
+            if(std::memcmp(header.magic, "GAMOTOR", 8) != 0 || header.version != motorStreamVersion || header.byteOrder != 0x01020304
+               || std::strncmp(header.algebra, "c3ga", sizeof(header.algebra)) != 0 || header.scalarSize != sizeof(T)
+               || header.scalarDigits != std::numeric_limits<T>::digits || header.keyframeInterval == 0)
+                return false;
+
+            // the segments, one after the other
+            std::size_t offset = sizeof(MotorStreamHeader);
+            while(offset < size){
+                MotorStreamSegmentHeader segment;
+                if(size - offset < sizeof(MotorStreamSegmentHeader) + 8*sizeof(T)) return false;
+                std::memcpy(&segment, data + offset, sizeof(MotorStreamSegmentHeader));
+                std::size_t segmentSize = sizeof(MotorStreamSegmentHeader) + 8*sizeof(T);
+                for(const std::uint32_t residualBytes : segment.residualBytes)
+                    segmentSize += residualBytes;
+                if(segment.count == 0 || segment.count > header.keyframeInterval || segmentSize > size - offset) return false;
+                segmentOffsets.push_back(offset);
+                segmentFirsts.push_back(segmentFirsts.back() + segment.count);
+                offset += segmentSize;
+            }
+            stream = data;
+            return true;
+        }
+
+        /// \brief decode a stream held in a string, see open(data, size)
+        bool open(const std::string& encoded) {
+            return open(encoded.data(), encoded.size());
+        }
+
+        /// \brief number of motors of the stream
+        inline std::size_t size() const { return segmentFirsts.back(); }
+
+        /// \brief number of segments of the stream, each one starting with a keyframe
+        inline std::size_t segmentCount() const { return segmentOffsets.size(); }
+
+        /// \brief quantization step of the relative rotors
+        inline double rotationStep() const { return header.rotationStep; }
+
+        /// \brief quantization step of the relative translations
+        inline double translationStep() const { return header.translationStep; }
+
+        /// \brief decode the motors first to first+count-1, from the keyframe before first, in parallel per segment
+        /// \param motors - the count motors, their other coefficients are set to 0
+        /// \return false if the stream has less than first+count motors
+        bool decode(const std::size_t first, const std::size_t count, const BatchView<T> motors) const {
+            if(first > size() || count > size() - first) return false;
+            if(count == 0) return true;
+            const std::ptrdiff_t firstSegment = std::upper_bound(segmentFirsts.begin(), segmentFirsts.end(), first) - segmentFirsts.begin() - 1;
+            const std::ptrdiff_t lastSegment = std::upper_bound(segmentFirsts.begin(), segmentFirsts.end(), first + count - 1) - segmentFirsts.begin() - 1;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if(count >= batchParallelThreshold)
+#endif
+            for(std::ptrdiff_t s=firstSegment; s<=lastSegment; ++s){
+                const std::size_t segmentFirst = std::max(first, segmentFirsts[s]);
+                const std::size_t segmentEnd = std::min(first + count, segmentFirsts[s+1]);
+                decodeSegment((std::size_t)s, segmentFirst - segmentFirsts[s], segmentEnd - segmentFirsts[s], motors, segmentFirst - first);
+            }
+            return true;
+        }
+
+        /// \brief array of the motors first to first+count-1, see decode(first, count, motors)
+        MvecArray<T> decode(const std::size_t first, const std::size_t count) const {
+            MvecArray<T> motors(count);
+            if(!decode(first, count, motors.view())) throw std::out_of_range("MotorStreamDecoder index out of range");
+            return motors;
+        }
+
+        /// \brief copy of the motor i
+        Mvec<T> at(const std::size_t i) const {
+            return decode(i, 1).at(0);
+        }
+
+    protected:
+
+        /// \brief decode the motors localFirst to localEnd-1 of the segment s to motors, from the item output
+        void decodeSegment(const std::size_t s, const std::size_t localFirst, const std::size_t localEnd, const BatchView<T> motors, const std::size_t output) const {
+            const char* data = stream + segmentOffsets[s];
+            MotorStreamSegmentHeader segment;
+            std::memcpy(&segment, data, sizeof(MotorStreamSegmentHeader));
+            T motor[8];
+            std::memcpy(motor, data + sizeof(MotorStreamSegmentHeader), 8*sizeof(T));
+            const std::uint8_t* cursors[6];
+            const std::uint8_t* ends[6];
+            const std::uint8_t* residualData = reinterpret_cast<const std::uint8_t*>(data + sizeof(MotorStreamSegmentHeader) + 8*sizeof(T));
+            for(unsigned int c=0; c<6; ++c){
+                cursors[c] = residualData;
+                ends[c] = residualData + segment.residualBytes[c];
+                residualData = ends[c];
+            }
+
+            // the other coefficients to 0, coefficient per coefficient for motors stored as a structure of arrays
+            const std::size_t decodedCount = localEnd - localFirst;
+            constexpr std::uint32_t motorCoefficients = motorDenseBitmap();
+            if(motors.itemStride == 1 && motors.coeffStride != 1){
+                for(unsigned int idx=0; idx<multivectorSize; ++idx)
+                    if(!((motorCoefficients >> idx) & 1u))
+                        for(std::size_t i=0; i<decodedCount; ++i)
+                            motors(output + i, idx) = T(0);
+            }
+            else
+                for(std::size_t i=0; i<decodedCount; ++i)
+                    for(unsigned int idx=0; idx<multivectorSize; ++idx)
+                        if(!((motorCoefficients >> idx) & 1u))
+                            motors(output + i, idx) = T(0);
+
+            const T rotationStep = T(header.rotationStep), translationStep = T(header.translationStep);
+            std::int64_t levels[6] = {0, 0, 0, 0, 0, 0};
+            for(std::size_t local=0; local<localEnd; ++local){
+                if(local > 0){
+                    for(unsigned int c=0; c<6; ++c)
+                        levels[c] += readResidual(cursors[c], ends[c]);
+                    T relative[8];
+                    quantizedRelativeMotor(levels, rotationStep, translationStep, relative);
+                    const T last[8] = {motor[0], motor[1], motor[2], motor[3], motor[4], motor[5], motor[6], motor[7]};
+                    motorProduct(last, relative, motor);
+                }
+                if(local >= localFirst)
+                    for(unsigned int k=0; k<8; ++k)
+                        motors(output + local - localFirst, motorDenseIndex(k)) = motor[k];
+            }
+        }
+    };
+
+}/// End of Namespace
+
+#endif // C3GA_MOTOR_STREAM_HPP__
@@ -0,0 +1,84 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// MvecFile.cpp
+// This file is part of the Garamon for c3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file MvecFile.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Memory mapping of the files of multivectors, for MvecFile.hpp: mmap on POSIX systems, file mappings on Windows.
+
+
+#include "c3ga/MvecFile.hpp"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace c3ga {
+
+#if defined(_WIN32)
+    bool MappedFile::open(const std::string& path) {
+        close();
+        const HANDLE fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if(fileHandle == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER fileSize;
+        bool mapped = GetFileSizeEx(fileHandle, &fileSize) != 0;
+        if(mapped && fileSize.QuadPart > 0){
+            mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            mappedData = mappingHandle ? static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+            mappedSize = mappedData ? (std::size_t)fileSize.QuadPart : 0;
+            mapped = mappedData != nullptr;
+        }
+        CloseHandle(fileHandle);
+        if(!mapped) close();
+        return mapped;
+    }
+
+    void MappedFile::close() {
+        if(mappedData) UnmapViewOfFile(mappedData);
+        if(mappingHandle) CloseHandle(mappingHandle);
+        mappedData = nullptr;
+        mappingHandle = nullptr;
+        mappedSize = 0;
+    }
+#else
+    bool MappedFile::open(const std::string& path) {
+        close();
+        const int descriptor = ::open(path.c_str(), O_RDONLY);
+        if(descriptor < 0) return false;
+        struct stat status;
+        bool mapped = fstat(descriptor, &status) == 0;
+        if(mapped && status.st_size > 0){
+            void* const address = mmap(nullptr, (std::size_t)status.st_size, PROT_READ, MAP_SHARED, descriptor, 0);
+            mapped = address != MAP_FAILED;
+            if(mapped){
+                mappedData = static_cast<const char*>(address);
+                mappedSize = (std::size_t)status.st_size;
+            }
+        }
+        ::close(descriptor);
+        return mapped;
+    }
+
+    void MappedFile::close() {
+        if(mappedData) munmap(const_cast<char*>(mappedData), mappedSize);
+        mappedData = nullptr;
+        mappedSize = 0;
+    }
+#endif
+
+}/// End of Namespace
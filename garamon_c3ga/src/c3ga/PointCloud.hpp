@@ -0,0 +1,465 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// PointCloud.hpp
+// This file is part of the Garamon for c3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file PointCloud.hpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Streaming reading of point cloud files (PLY and XYZ) into batches of conformal points.
+///
+/// PointCloudReader reads the file through a buffer of fixed size and returns the points by chunks of the size chosen by
+/// the caller: the memory used does not depend on the size of the file. The lines of the text files are parsed on
+/// several threads when OpenMP is enabled, as the records of the binary files.
+///  - PLY: ascii, binary_little_endian and binary_big_endian, the properties x, y and z of the element vertex, of any
+///    scalar type. The elements before the vertices are skipped, they cannot have list properties in a binary file.
+///  - XYZ: a point per line, its first three numbers separated by spaces, tabs or commas, the other numbers of the line
+///    (color, normal...) are ignored. The empty lines and the lines starting with # are skipped.
+
+
+#ifndef C3GA_POINT_CLOUD_HPP__
+#define C3GA_POINT_CLOUD_HPP__
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "c3ga/Mvec.hpp"
+#include "c3ga/Batch.hpp"
+#include "c3ga/Conformal.hpp"
+#include "c3ga/Text.hpp"
+
+
+/*!
+ * @namespace c3ga
+ */
+namespace c3ga {
+
+    /// \brief format of a point cloud file
+    enum class PointCloudFormat { xyz, plyAscii, plyBinaryLittleEndian, plyBinaryBigEndian };
+
+    /// \cond DEV
+    /// \brief scalar types of the properties of a PLY file
+    enum class PlyType : unsigned char { int8, uint8, int16, uint16, int32, uint32, float32, float64 };
+
+    /// \brief type and size in bytes of the PLY scalar type name
+    /// \return false if name is not a PLY scalar type
+    inline bool plyType(const std::string& name, PlyType& type, std::size_t& size) {
+        static const struct { const char* name; PlyType type; std::size_t size; } types[] = {
+            {"char", PlyType::int8, 1}, {"int8", PlyType::int8, 1}, {"uchar", PlyType::uint8, 1}, {"uint8", PlyType::uint8, 1},
+            {"short", PlyType::int16, 2}, {"int16", PlyType::int16, 2}, {"ushort", PlyType::uint16, 2}, {"uint16", PlyType::uint16, 2},
+            {"int", PlyType::int32, 4}, {"int32", PlyType::int32, 4}, {"uint", PlyType::uint32, 4}, {"uint32", PlyType::uint32, 4},
+            {"float", PlyType::float32, 4}, {"float32", PlyType::float32, 4}, {"double", PlyType::float64, 8}, {"float64", PlyType::float64, 8}};
+        for(const auto& candidate : types)
+            if(name == candidate.name){
+                type = candidate.type;
+                size = candidate.size;
+                return true;
+            }
+        return false;
+    }
+
+    /// \brief values of a property of type S of count records of recordSize bytes of a binary PLY file, on several threads
+    /// \param bytes - the property in the first record
+    /// \param swap - the bytes of the values are in the other byte order than the machine
+    /// \param values - the values, valueStride apart
+    template<typename S, typename T>
+    void plyColumn(const char* bytes, const std::size_t recordSize, const std::size_t count, const bool swap, T* values, const std::size_t valueStride) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if(count >= 4096)
+#endif
+        for(std::ptrdiff_t i=0; i<(std::ptrdiff_t)count; ++i){
+            char value[sizeof(S)];
+            std::memcpy(value, bytes + i*recordSize, sizeof(S));
+            if(swap) std::reverse(value, value + sizeof(S));
+            S v;
+            std::memcpy(&v, value, sizeof(S));
+            values[i*valueStride] = T(v);
+        }
+    }
+
+    /// \brief values of a property of type type of count records of a binary PLY file, see plyColumn<S>
+    template<typename T>
+    void plyColumn(const PlyType type, const char* bytes, const std::size_t recordSize, const std::size_t count, const bool swap, T* values, const std::size_t valueStride) {
+        switch(type){
+            case PlyType::int8:    plyColumn<std::int8_t>(bytes, recordSize, count, swap, values, valueStride); break;
+            case PlyType::uint8:   plyColumn<std::uint8_t>(bytes, recordSize, count, swap, values, valueStride); break;
+            case PlyType::int16:   plyColumn<std::int16_t>(bytes, recordSize, count, swap, values, valueStride); break;
+            case PlyType::uint16:  plyColumn<std::uint16_t>(bytes, recordSize, count, swap, values, valueStride); break;
+            case PlyType::int32:   plyColumn<std::int32_t>(bytes, recordSize, count, swap, values, valueStride); break;
+            case PlyType::uint32:  plyColumn<std::uint32_t>(bytes, recordSize, count, swap, values, valueStride); break;
+            case PlyType::float32: plyColumn<float>(bytes, recordSize, count, swap, values, valueStride); break;
+            case PlyType::float64: plyColumn<double>(bytes, recordSize, count, swap, values, valueStride); break;
+        }
+    }
+
+    /// \brief true if the machine stores the integers with their least significant byte first
+    inline bool littleEndianMachine() {
+        const std::uint16_t probe = 1;
+        unsigned char first;
+        std::memcpy(&first, &probe, 1);
+        return first == 1;
+    }
+
+    /// \brief true for the characters between the numbers of a line of a text point cloud
+    inline bool isPointSeparator(const char c) {
+        return c == ' ' || c == '\t' || c == ',' || c == '\r';
+    }
+
+    /// \brief store count points in a batch: the conformal points of the Euclidean coordinates (see upBatch)
+    template<typename T>
+    void storePoints(const T* coordinates, const BatchView<T> points, const std::size_t count) {
+        upBatch(coordinates, points, count);
+    }
+    /// \endcond
+
+
+    /// \class PointCloudReader
+    /// \brief streaming reader of the points of a PLY or XYZ file (see PointCloud.hpp)
+    /// \tparam T - type of the coordinates
+    template<typename T>
+    class PointCloudReader {
+    public:
+        /// \brief number of coordinates of a point
+        static constexpr unsigned int pointDimension = euclideanDimension;
+
+        /// \brief reader with a buffer of bufferSize bytes, the longest line of a text file and the header of a PLY file must fit in it
+        explicit PointCloudReader(const std::size_t bufferSize = std::size_t(1) << 24) : buffer(std::max<std::size_t>(bufferSize, 1024)) {}
+        PointCloudReader(const PointCloudReader&) = delete;
+        PointCloudReader& operator=(const PointCloudReader&) = delete;
+        ~PointCloudReader() { close(); }
+
+        /// \brief open a point cloud file, PLY if it starts with the line "ply", XYZ otherwise
+        /// \return false if the file cannot be read, or if its PLY header is not valid or has no vertex coordinates x, y and z
+        bool open(const std::string& path) {
+            close();
+            if(!(file = std::fopen(path.c_str(), "rb"))) return false;
+            error = !fill() || (std::strncmp(buffer.data(), "ply\n", 4) == 0 || std::strncmp(buffer.data(), "ply\r\n", 5) == 0 ? !readPlyHeader() : !startXyz());
+            if(error) close();
+            return !error;
+        }
+
+        /// \brief close the file
+        void close() {
+            if(file) std::fclose(file);
+            file = nullptr;
+            begin = end = 0;
+            endOfFile = false;
+            pointsRead = pointTotal = 0;
+        }
+
+        /// \brief format of the file
+        inline PointCloudFormat format() const { return fileFormat; }
+
+        /// \brief number of points of a PLY file, 0 for an XYZ file (known at its end only)
+        inline std::size_t pointCount() const { return pointTotal; }
+
+        /// \brief number of points read since the opening of the file
+        inline std::size_t pointCountRead() const { return pointsRead; }
+
+        /// \brief true if a read failed: an error of the file, a line that is not a point, a truncated PLY file...
+        inline bool failed() const { return error; }
+
+        /// \brief read the coordinates of the next points of the file
+        /// \param coordinates - capacity x pointDimension coordinates, one point after the other
+        /// \return the number of points read, lower than capacity at the end of the file or on an error (see failed), 0 after them
+        std::size_t read(T* coordinates, const std::size_t capacity) {
+            std::size_t count = 0;
+            while(count < capacity && file && !error){
+                std::size_t wanted = capacity - count;
+                if(fileFormat != PointCloudFormat::xyz){
+                    wanted = std::min(wanted, pointTotal - pointsRead);
+                    if(wanted == 0) break;
+                }
+                const std::size_t n = fileFormat == PointCloudFormat::xyz || fileFormat == PointCloudFormat::plyAscii
+                                      ? readLines(coordinates + count*pointDimension, wanted)
+                                      : readRecords(coordinates + count*pointDimension, wanted);
+                if(n == 0){
+                    error = error || (fileFormat != PointCloudFormat::xyz && pointsRead < pointTotal); // truncated PLY file
+                    break;
+                }
+                count += n;
+                pointsRead += n;
+            }
+            return count;
+        }
+
+        /// \brief read the next points of the file as conformal points (see upBatch)
+        /// \param points - capacity multivectors, for instance the view of an MvecArray of capacity multivectors
+        /// \return the number of points read, see read(coordinates, capacity)
+        std::size_t read(const BatchView<T> points, const std::size_t capacity) {
+            coordinates.resize(capacity * pointDimension);
+            const std::size_t count = read(coordinates.data(), capacity);
+            storePoints(coordinates.data(), points, count);
+            return count;
+        }
+
+    private:
+        std::FILE* file = nullptr;
+        std::vector<char> buffer;
+        std::size_t begin = 0, end = 0;           /*!< bytes of the buffer not read yet */
+        bool endOfFile = false;                   /*!< the buffer holds the end of the file */
+        bool error = false;
+        PointCloudFormat fileFormat = PointCloudFormat::xyz;
+        std::size_t pointTotal = 0, pointsRead = 0;
+        unsigned int columns[pointDimension] = {};  /*!< text: numbers of the line that are the coordinates */
+        unsigned int lastColumn = 0;
+        std::size_t recordSize = 0;               /*!< binary: bytes of a vertex */
+        std::size_t offsets[pointDimension] = {}; /*!< binary: bytes of the coordinates in a vertex */
+        PlyType types[pointDimension] = {};       /*!< binary: types of the coordinates */
+        std::vector<T> coordinates;               /*!< coordinates of the points of read(points, capacity) */
+        std::vector<const char*> bounds;          /*!< text: segments of the lines parsed by a thread */
+        std::vector<std::size_t> lines, produced; /*!< text: lines before each segment, points of each segment */
+
+        /// \brief move the bytes not read to the beginning of the buffer, then fill it from the file
+        /// \return false on an error of the file
+        bool fill() {
+            std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+            end -= begin;
+            begin = 0;
+            end += std::fread(buffer.data() + end, 1, buffer.size() - end, file);
+            endOfFile = end < buffer.size();
+            return std::ferror(file) == 0;
+        }
+
+        /// \brief fill the buffer when more than half of it is read
+        bool fillIfHalfRead() {
+            return endOfFile || begin < buffer.size() / 2 || fill();
+        }
+
+        /// \brief the next line of the buffer, filled as needed, without its end of line
+        /// \return false at the end of the file, or if the line does not fit in the buffer
+        bool nextLine(std::string& line) {
+            while(true){
+                const char* first = buffer.data() + begin;
+                const char* const newline = static_cast<const char*>(std::memchr(first, '\n', end - begin));
+                if(newline || (endOfFile && begin != end)){
+                    const char* last = newline ? newline : buffer.data() + end;
+                    begin = newline ? (std::size_t)(newline + 1 - buffer.data()) : end;
+                    if(last != first && *(last-1) == '\r') --last;
+                    line.assign(first, last);
+                    return true;
+                }
+                if(endOfFile || begin == 0 || !fill()) return false;
+            }
+        }
+
+        bool startXyz() {
+            fileFormat = PointCloudFormat::xyz;
+            for(unsigned int k=0; k<pointDimension; ++k) columns[k] = k;
+            lastColumn = pointDimension - 1;
+            return true;
+        }
+
+        /// \brief read the header of a PLY file and skip the elements before the vertices
+        bool readPlyHeader() {
+            struct Element {
+                std::string name;
+                std::size_t count = 0, recordSize = 0;
+                bool hasList = false;
+                std::vector<std::string> properties;
+                std::vector<PlyType> types;
+                std::vector<std::size_t> sizes;
+            };
+            std::vector<Element> elements;
+            std::string line, word;
+            bool formatFound = false;
+            nextLine(line); // ply
+            while(true){
+                if(!nextLine(line)) return false;
+                char name[64], type[64], text[64];
+                unsigned long long count;
+                if(line == "end_header") break;
+                if(std::sscanf(line.c_str(), "format %63s", text) == 1){
+                    const std::string value(text);
+                    if(value == "ascii") fileFormat = PointCloudFormat::plyAscii;
+                    else if(value == "binary_little_endian") fileFormat = PointCloudFormat::plyBinaryLittleEndian;
+                    else if(value == "binary_big_endian") fileFormat = PointCloudFormat::plyBinaryBigEndian;
+                    else return false;
+                    formatFound = true;
+                } else if(std::sscanf(line.c_str(), "element %63s %llu", name, &count) == 2){
+                    elements.emplace_back();
+                    elements.back().name = name;
+                    elements.back().count = (std::size_t)count;
+                } else if(std::sscanf(line.c_str(), "property list %63s %63s %63s", text, type, name) == 3){
+                    if(elements.empty()) return false;
+                    elements.back().hasList = true;
+                    elements.back().properties.push_back(name);
+                    elements.back().types.push_back(PlyType::int8);
+                    elements.back().sizes.push_back(0);
+                } else if(std::sscanf(line.c_str(), "property %63s %63s", type, name) == 2){
+                    PlyType propertyType;
+                    std::size_t size;
+                    if(elements.empty() || !plyType(type, propertyType, size)) return false;
+                    elements.back().properties.push_back(name);
+                    elements.back().types.push_back(propertyType);
+                    elements.back().sizes.push_back(size);
+                    elements.back().recordSize += size;
+                } else if(line.compare(0, 7, "comment") != 0 && line.compare(0, 8, "obj_info") != 0)
+                    return false;
+            }
+            if(!formatFound) return false;
+
+            // the elements before the vertices
+            const bool binary = fileFormat != PointCloudFormat::plyAscii;
+            std::size_t e = 0;
+            for(; e<elements.size() && elements[e].name != "vertex"; ++e){
+                if(binary && elements[e].hasList) return false;
+                for(std::size_t skipped=0; skipped<elements[e].count; ++skipped)
+                    if(!(binary ? skipBytes(elements[e].recordSize) : nextLine(line))) return false;
+            }
+            if(e == elements.size() || elements[e].hasList) return false;
+
+            // the coordinates of the vertices
+            const Element& vertex = elements[e];
+            const char* const names[3] = {"x", "y", "z"};
+            for(unsigned int k=0; k<pointDimension; ++k){
+                const std::size_t p = std::find(vertex.properties.begin(), vertex.properties.end(), names[k]) - vertex.properties.begin();
+                if(p == vertex.properties.size()) return false;
+                columns[k] = (unsigned int)p;
+                types[k] = vertex.types[p];
+                offsets[k] = 0;
+                for(std::size_t q=0; q<p; ++q) offsets[k] += vertex.sizes[q];
+            }
+            lastColumn = *std::max_element(columns, columns + pointDimension);
+            recordSize = vertex.recordSize;
+            pointTotal = vertex.count;
+            return true;
+        }
+
+        /// \brief skip count bytes of the file
+        bool skipBytes(std::size_t count) {
+            while(count > end - begin){
+                count -= end - begin;
+                begin = end;
+                if(endOfFile || !fill()) return false;
+            }
+            begin += count;
+            return true;
+        }
+
+        /// \brief parse the line [first, last) of a text file
+        /// \param point - its coordinates
+        /// \return 1 for a point, 0 for a line without a point, -1 for a syntax error
+        int parseLine(const char* first, const char* last, T* point) const {
+            while(first != last && isPointSeparator(*first)) ++first;
+            if(first == last || (*first == '#' && fileFormat == PointCloudFormat::xyz)) return 0;
+            for(unsigned int column=0; column<=lastColumn; ++column){
+                while(first != last && isPointSeparator(*first)) ++first;
+                if(first == last) return -1;
+                const unsigned int* const k = std::find(columns, columns + pointDimension, column);
+                if(k == columns + pointDimension){
+                    while(first != last && !isPointSeparator(*first)) ++first;
+                } else if(!(first = parseCoefficient(first, last, point[k - columns])) || (first != last && !isPointSeparator(*first)))
+                    return -1;
+            }
+            return 1;
+        }
+
+        /// \brief read at most wanted points from the lines of a text file, on several threads
+        /// \return the number of points read, 0 at the end of the file
+        std::size_t readLines(T* points, const std::size_t wanted) {
+            if(!fillIfHalfRead()){
+                error = true;
+                return 0;
+            }
+            while(true){
+                // the complete lines of the buffer
+                const char* const first = buffer.data() + begin;
+                const char* stop = buffer.data() + end;
+                if(!endOfFile){
+                    while(stop != first && *(stop-1) != '\n') --stop;
+                    if(stop == first){
+                        // no complete line: fill the buffer, unless the line does not fit in it
+                        if(begin == 0 || !fill()){
+                            error = true;
+                            return 0;
+                        }
+                        continue;
+                    }
+                } else if(first == stop)
+                    return 0;
+
+                // at most wanted lines, in segments of about 64 KB that end with a line
+                bounds.assign(1, first);
+                lines.assign(1, 0);
+                while(bounds.back() != stop && lines.back() < wanted){
+                    const char* const last = bounds.back();
+                    const char* next = stop - last > 65536 ? static_cast<const char*>(std::memchr(last + 65536, '\n', stop - last - 65536)) : nullptr;
+                    next = next ? next + 1 : stop;
+                    std::size_t lineCount = lines.back() + (std::size_t)std::count(last, next, '\n') + (*(next-1) != '\n' ? 1 : 0);
+                    if(lineCount > wanted){
+                        // the end of the line wanted
+                        next = last;
+                        for(lineCount = lines.back(); lineCount < wanted; ++lineCount)
+                            next = static_cast<const char*>(std::memchr(next, '\n', stop - next)) + 1;
+                    }
+                    bounds.push_back(next);
+                    lines.push_back(lineCount);
+                }
+                const std::size_t segments = bounds.size() - 1;
+                produced.assign(segments, 0);
+
+                bool syntaxError = false;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if(segments > 1) reduction(||:syntaxError)
+#endif
+                for(std::ptrdiff_t s=0; s<(std::ptrdiff_t)segments; ++s){
+                    T* point = points + lines[s]*pointDimension;
+                    for(const char* line = bounds[s]; line != bounds[s+1] && !syntaxError; ){
+                        const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', bounds[s+1] - line));
+                        if(!lineEnd) lineEnd = bounds[s+1];
+                        const int result = parseLine(line, lineEnd, point);
+                        syntaxError = result < 0;
+                        point += result > 0 ? pointDimension : 0;
+                        produced[s] += result > 0 ? 1 : 0;
+                        line = lineEnd == bounds[s+1] ? lineEnd : lineEnd + 1;
+                    }
+                }
+                if(syntaxError){
+                    error = true;
+                    return 0;
+                }
+
+                // points of the segments one after the other, without the lines without a point
+                std::size_t count = produced[0];
+                for(std::size_t s=1; s<segments; ++s){
+                    if(count != lines[s]) std::memmove(points + count*pointDimension, points + lines[s]*pointDimension, produced[s]*pointDimension*sizeof(T));
+                    count += produced[s];
+                }
+                begin = (std::size_t)(bounds[segments] - buffer.data());
+                if(count != 0) return count;
+                if(!fillIfHalfRead()){
+                    error = true;
+                    return 0;
+                }
+            }
+        }
+
+        /// \brief read at most wanted vertices of a binary PLY file, on several threads
+        /// \return the number of points read, 0 at the end of the file
+        std::size_t readRecords(T* points, const std::size_t wanted) {
+            if(!fillIfHalfRead() || (end - begin < recordSize && !endOfFile && !fill())){
+                error = true;
+                return 0;
+            }
+            const std::size_t count = std::min(wanted, (end - begin) / recordSize);
+            const bool swap = (fileFormat == PointCloudFormat::plyBinaryLittleEndian) != littleEndianMachine();
+            for(unsigned int k=0; k<pointDimension; ++k)
+                plyColumn(types[k], buffer.data() + begin + offsets[k], recordSize, count, swap, points + k, pointDimension);
+            begin += count * recordSize;
+            return count;
+        }
+    };
+
+}/// End of Namespace
+
+#endif // C3GA_POINT_CLOUD_HPP__
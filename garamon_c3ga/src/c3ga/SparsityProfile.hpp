@@ -0,0 +1,370 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// SparsityProfile.hpp
+// This file is part of the Garamon for c3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file SparsityProfile.hpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Profile of the grades and of the zero coefficients of the multivectors used by a program, to choose how to
+/// store them. Recorded only when C3GA_SPARSITY_PROFILE is defined.
+///
+/// When C3GA_SPARSITY_PROFILE is defined (CMake option SPARSITY_PROFILE, which defines it for the library and the programs
+/// linked to it), the additions, the products and the dual of the multivectors record the grade bitmaps of their operands
+/// and of their result (see Mvec::sparsity), the number of coefficients they store, and among them the number of
+/// coefficients equal to 0 or nearly 0: those that roundZero(epsilon) would set to 0, with the epsilon of setSparsityEpsilon
+/// or by default the one of roundZero. writeSparsityReport summarizes the profile, with the grade triples (grades of the
+/// operands and of the result) computed the most often, and suggests a storage (see suggestStorage). The macro must have
+/// the same value in all the translation units of a program. The profile has a mutex per thread, it is slower than
+/// the instrumentation of Instrumentation.hpp.
+
+
+#ifndef C3GA_SPARSITY_PROFILE_HPP__
+#define C3GA_SPARSITY_PROFILE_HPP__
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+#include "c3ga/Constants.hpp"
+
+
+// C3GA_PROFILE_SPARSITY records the binary operation mv3 = operation(mv1, mv2), C3GA_PROFILE_SPARSITY_UNARY the unary
+// operation mv3 = operation(mv1)
+#if defined(C3GA_SPARSITY_PROFILE)
+#define C3GA_PROFILE_SPARSITY(operation, mv1, mv2, mv3) ::c3ga::profiling::record(::c3ga::ProfiledOperation::operation, mv1, &(mv2), mv3)
+#define C3GA_PROFILE_SPARSITY_UNARY(operation, mv1, mv3) ::c3ga::profiling::record(::c3ga::ProfiledOperation::operation, mv1, mv3)
+#else
+#define C3GA_PROFILE_SPARSITY(operation, mv1, mv2, mv3)
+#define C3GA_PROFILE_SPARSITY_UNARY(operation, mv1, mv3)
+#endif
+
+
+/*!
+ * @namespace c3ga
+ */
+namespace c3ga {
+
+    template<typename T> class Mvec;
+
+    /// \brief true when the multivectors record their sparsity profile
+#if defined(C3GA_SPARSITY_PROFILE)
+    constexpr bool sparsityProfileEnabled = true;
+#else
+    constexpr bool sparsityProfileEnabled = false;
+#endif
+
+    /// \brief grades and zero coefficients of a multivector (see Mvec::sparsity)
+    struct MvecSparsity {
+        unsigned int gradeBitmap = 0;  /*!< grades of the multivector */
+        unsigned int stored = 0;       /*!< number of coefficients stored, those of the k-vectors of gradeBitmap */
+        unsigned int exactZeros = 0;   /*!< number of coefficients stored that are equal to 0 */
+        unsigned int nearZeros = 0;    /*!< number of coefficients stored that are not 0 but that roundZero(epsilon) sets to 0 */
+    };
+
+    /// \brief operations recorded by the sparsity profile
+    enum class ProfiledOperation { add, subtract, outer, inner, leftContraction, rightContraction, scalarProduct, dotProduct,
+                                   geometric, outerPrimalDual, outerDualPrimal, outerDualDual, dual };
+
+    /// \brief number of operations recorded by the sparsity profile
+    constexpr unsigned int profiledOperationCount = 13;
+
+    /// \brief name of an operation, as written by the report
+    inline const char* profiledOperationName(const ProfiledOperation operation) {
+        static const char* const names[profiledOperationCount] = {"add", "subtract", "outer", "inner", "leftContraction",
+            "rightContraction", "scalarProduct", "dotProduct", "geometric", "outerPrimalDual", "outerDualPrimal", "outerDualDual", "dual"};
+        return names[(unsigned int)operation];
+    }
+
+    /// \brief coefficients of the operands and of the results of an operation, summed over its calls
+    struct OperationSparsity {
+        std::uint64_t calls = 0;
+        std::uint64_t operands = 0;          /*!< number of operands, 1 or 2 per call */
+        std::uint64_t operandStored = 0;
+        std::uint64_t operandExactZeros = 0;
+        std::uint64_t operandNearZeros = 0;
+        std::uint64_t resultStored = 0;
+        std::uint64_t resultExactZeros = 0;
+        std::uint64_t resultNearZeros = 0;
+
+        OperationSparsity& operator+=(const OperationSparsity& sparsity) {
+            calls += sparsity.calls;
+            operands += sparsity.operands;
+            operandStored += sparsity.operandStored;
+            operandExactZeros += sparsity.operandExactZeros;
+            operandNearZeros += sparsity.operandNearZeros;
+            resultStored += sparsity.resultStored;
+            resultExactZeros += sparsity.resultExactZeros;
+            resultNearZeros += sparsity.resultNearZeros;
+            return *this;
+        }
+    };
+
+    /// \brief grades of the operands and of the result of calls of an operation
+    struct GradeTriple {
+        ProfiledOperation operation;
+        unsigned int gradeBitmap1;
+        unsigned int gradeBitmap2;   /*!< 0 for the unary operations */
+        unsigned int gradeBitmap3;   /*!< grades of the result */
+        std::uint64_t calls;
+    };
+
+    /// \brief sparsity profile of the operations of all the threads
+    struct SparsityProfile {
+        OperationSparsity operations[profiledOperationCount];
+        std::vector<GradeTriple> gradeTriples;   /*!< by decreasing number of calls */
+
+        /// \brief sum of all the operations
+        OperationSparsity total() const {
+            OperationSparsity sum;
+            for(const OperationSparsity& operation : operations) sum += operation;
+            return sum;
+        }
+    };
+
+    /// \brief storages suggested by the sparsity profile
+    enum class StorageSuggestion {
+        dense,        /*!< arrays of multivectorSize coefficients (toDense, MvecArray.hpp, Batch.hpp): the multivectors are mostly full */
+        gradeTyped,   /*!< a few grade triples make most of the calls: types and kernels for their grades */
+        sparse        /*!< the k-vectors of the non-zero grades only (Mvec) */
+    };
+
+
+    /// \cond DEV
+    namespace profiling {
+
+        /// \brief the profile of a thread; its mutex is only contended when the profile is read
+        struct ThreadProfile {
+            std::mutex mutex;
+            OperationSparsity operations[profiledOperationCount];
+            std::unordered_map<std::uint64_t, std::uint64_t> gradeTriples;   // calls by operation and grade bitmaps, see tripleKey
+
+            ThreadProfile();
+            ~ThreadProfile();
+        };
+
+        /// \brief the profiles of the running threads, and the sum of the profiles of the ended threads
+        struct Registry {
+            std::mutex mutex;
+            std::vector<ThreadProfile*> threads;
+            OperationSparsity operations[profiledOperationCount];
+            std::unordered_map<std::uint64_t, std::uint64_t> gradeTriples;
+            std::atomic<double> epsilon{-1.0};
+        };
+
+        inline Registry& registry() {
+            static Registry registry;
+            return registry;
+        }
+
+        inline std::uint64_t tripleKey(const ProfiledOperation operation, const unsigned int gradeBitmap1, const unsigned int gradeBitmap2, const unsigned int gradeBitmap3) {
+            return (std::uint64_t(operation) << 48) | (std::uint64_t(gradeBitmap1) << 32) | (std::uint64_t(gradeBitmap2) << 16) | gradeBitmap3;
+        }
+
+        inline GradeTriple gradeTriple(const std::uint64_t key, const std::uint64_t calls) {
+            return {ProfiledOperation(key >> 48), (unsigned int)(key >> 32) & 0xffff, (unsigned int)(key >> 16) & 0xffff, (unsigned int)key & 0xffff, calls};
+        }
+
+        /// \brief add the profile of a thread to operations and gradeTriples
+        inline void addProfile(const OperationSparsity* threadOperations, const std::unordered_map<std::uint64_t, std::uint64_t>& threadTriples,
+                               OperationSparsity* operations, std::unordered_map<std::uint64_t, std::uint64_t>& gradeTriples) {
+            for(unsigned int o=0; o<profiledOperationCount; ++o) operations[o] += threadOperations[o];
+            for(const auto& triple : threadTriples) gradeTriples[triple.first] += triple.second;
+        }
+
+        inline ThreadProfile::ThreadProfile() {
+            Registry& profile = registry();
+            std::lock_guard<std::mutex> lock(profile.mutex);
+            profile.threads.push_back(this);
+        }
+
+        inline ThreadProfile::~ThreadProfile() {
+            Registry& profile = registry();
+            std::lock_guard<std::mutex> lock(profile.mutex);
+            addProfile(operations, gradeTriples, profile.operations, profile.gradeTriples);
+            profile.threads.erase(std::find(profile.threads.begin(), profile.threads.end(), this));
+        }
+
+        inline ThreadProfile& threadProfile() {
+            thread_local ThreadProfile profile;
+            return profile;
+        }
+
+        /// \brief threshold of the nearly zero coefficients for multivectors of T
+        template<typename T>
+        T epsilon() {
+            const double value = registry().epsilon.load(std::memory_order_relaxed);
+            return value < 0 ? std::numeric_limits<T>::epsilon() : T(value);
+        }
+
+        /// \brief record the operation mv3 = operation(mv1, mv2), mv2 is null for a unary operation
+        template<typename T>
+        void record(const ProfiledOperation operation, const Mvec<T>& mv1, const Mvec<T>* mv2, const Mvec<T>& mv3) {
+            const T epsilon = profiling::epsilon<T>();
+            const MvecSparsity sparsity1 = mv1.sparsity(epsilon);
+            const MvecSparsity sparsity2 = mv2 ? mv2->sparsity(epsilon) : MvecSparsity();
+            const MvecSparsity sparsity3 = mv3.sparsity(epsilon);
+
+            ThreadProfile& profile = threadProfile();
+            std::lock_guard<std::mutex> lock(profile.mutex);
+            OperationSparsity& counts = profile.operations[(unsigned int)operation];
+            counts.calls += 1;
+            counts.operands += mv2 ? 2 : 1;
+            counts.operandStored += sparsity1.stored + sparsity2.stored;
+            counts.operandExactZeros += sparsity1.exactZeros + sparsity2.exactZeros;
+            counts.operandNearZeros += sparsity1.nearZeros + sparsity2.nearZeros;
+            counts.resultStored += sparsity3.stored;
+            counts.resultExactZeros += sparsity3.exactZeros;
+            counts.resultNearZeros += sparsity3.nearZeros;
+            profile.gradeTriples[tripleKey(operation, sparsity1.gradeBitmap, sparsity2.gradeBitmap, sparsity3.gradeBitmap)] += 1;
+        }
+
+        template<typename T>
+        void record(const ProfiledOperation operation, const Mvec<T>& mv1, const Mvec<T>& mv3) {
+            record(operation, mv1, static_cast<const Mvec<T>*>(nullptr), mv3);
+        }
+
+        inline double ratio(const double numerator, const double denominator) {
+            return denominator > 0 ? numerator / denominator : 0.0;
+        }
+
+        /// \brief write the grades of gradeBitmap, e.g. {0,2}
+        inline void writeGrades(std::ostream& stream, const unsigned int gradeBitmap) {
+            stream << "{";
+            const char* separator = "";
+            for(unsigned int grade=0; grade<=algebraDimension; ++grade)
+                if(gradeBitmap & (1u << grade)){
+                    stream << separator << grade;
+                    separator = ",";
+                }
+            stream << "}";
+        }
+    }
+    /// \endcond
+
+
+    /// \brief threshold of the nearly zero coefficients: those whose absolute value is at most epsilon, as for roundZero.
+    /// A negative value selects the default epsilon of roundZero for each type.
+    inline void setSparsityEpsilon(const double epsilon) {
+        profiling::registry().epsilon.store(epsilon, std::memory_order_relaxed);
+    }
+
+    /// \brief the sparsity profile of all the threads (empty when it is disabled)
+    inline SparsityProfile sparsityProfile() {
+        SparsityProfile result;
+        profiling::Registry& profile = profiling::registry();
+        std::lock_guard<std::mutex> lock(profile.mutex);
+        std::unordered_map<std::uint64_t, std::uint64_t> gradeTriples = profile.gradeTriples;
+        std::copy(profile.operations, profile.operations + profiledOperationCount, result.operations);
+        for(profiling::ThreadProfile* thread : profile.threads){
+            std::lock_guard<std::mutex> threadLock(thread->mutex);
+            profiling::addProfile(thread->operations, thread->gradeTriples, result.operations, gradeTriples);
+        }
+        for(const auto& triple : gradeTriples)
+            result.gradeTriples.push_back(profiling::gradeTriple(triple.first, triple.second));
+        std::sort(result.gradeTriples.begin(), result.gradeTriples.end(), [](const GradeTriple& triple1, const GradeTriple& triple2){
+            return triple1.calls > triple2.calls;
+        });
+        return result;
+    }
+
+    /// \brief clear the sparsity profile of all the threads
+    inline void resetSparsityProfile() {
+        profiling::Registry& profile = profiling::registry();
+        std::lock_guard<std::mutex> lock(profile.mutex);
+        std::fill(profile.operations, profile.operations + profiledOperationCount, OperationSparsity());
+        profile.gradeTriples.clear();
+        for(profiling::ThreadProfile* thread : profile.threads){
+            std::lock_guard<std::mutex> threadLock(thread->mutex);
+            std::fill(thread->operations, thread->operations + profiledOperationCount, OperationSparsity());
+            thread->gradeTriples.clear();
+        }
+    }
+
+    /// \brief suggested storage for the multivectors of a profile:
+    ///  - dense when the non-zero coefficients fill at least half of the operands and results,
+    ///  - gradeTyped when the tripleCount hottest grade triples make at least 80% of the calls,
+    ///  - sparse otherwise.
+    inline StorageSuggestion suggestStorage(const SparsityProfile& profile, const std::size_t tripleCount = 10) {
+        const OperationSparsity total = profile.total();
+        const double nonZeros = double(total.operandStored + total.resultStored) - double(total.operandExactZeros + total.operandNearZeros + total.resultExactZeros + total.resultNearZeros);
+        if(profiling::ratio(nonZeros, double(total.operands + total.calls) * multivectorSize) >= 0.5)
+            return StorageSuggestion::dense;
+        std::uint64_t hotCalls = 0;
+        for(std::size_t t=0; t<std::min(tripleCount, profile.gradeTriples.size()); ++t)
+            hotCalls += profile.gradeTriples[t].calls;
+        if(total.calls && profiling::ratio(double(hotCalls), double(total.calls)) >= 0.8)
+            return StorageSuggestion::gradeTyped;
+        return StorageSuggestion::sparse;
+    }
+
+    /// \brief write a report of a profile: per operation, the fill of the operands and of the results (coefficients stored
+    /// over multivectorSize) and the share of their stored coefficients that are 0 or nearly 0; then the tripleCount
+    /// hottest grade triples and the suggested storage
+    inline void writeSparsityReport(std::ostream& stream, const SparsityProfile& profile, const std::size_t tripleCount = 10) {
+        using profiling::ratio;
+        const auto percent = [](const double value){ return int(100.0 * value + 0.5); };
+        stream << "c3ga sparsity profile (" << multivectorSize << " coefficients per multivector)\n"
+               << "operation           calls   operands: fill  zero  near   results: fill  zero  near\n";
+        const auto writeLine = [&](const char* name, const OperationSparsity& sparsity){
+            const double operandSize = double(sparsity.operands) * multivectorSize, resultSize = double(sparsity.calls) * multivectorSize;
+            stream.width(16); stream << std::left << name << std::right;
+            stream.width(10); stream << sparsity.calls;
+            stream.width(15); stream << percent(ratio(double(sparsity.operandStored), operandSize));
+            stream.width(6); stream << percent(ratio(double(sparsity.operandExactZeros), double(sparsity.operandStored)));
+            stream.width(6); stream << percent(ratio(double(sparsity.operandNearZeros), double(sparsity.operandStored)));
+            stream.width(15); stream << percent(ratio(double(sparsity.resultStored), resultSize));
+            stream.width(6); stream << percent(ratio(double(sparsity.resultExactZeros), double(sparsity.resultStored)));
+            stream.width(6); stream << percent(ratio(double(sparsity.resultNearZeros), double(sparsity.resultStored)));
+            stream << "\n";
+        };
+        for(unsigned int o=0; o<profiledOperationCount; ++o)
+            if(profile.operations[o].calls) writeLine(profiledOperationName((ProfiledOperation)o), profile.operations[o]);
+        const OperationSparsity total = profile.total();
+        writeLine("total", total);
+        stream << "(percentages; zero and near: share of the stored coefficients equal to 0 and nearly 0)\n";
+
+        stream << "\nhottest grade triples\n";
+        for(std::size_t t=0; t<std::min(tripleCount, profile.gradeTriples.size()); ++t){
+            const GradeTriple& triple = profile.gradeTriples[t];
+            stream << "  " << profiledOperationName(triple.operation) << " ";
+            profiling::writeGrades(stream, triple.gradeBitmap1);
+            if(triple.operation != ProfiledOperation::dual){
+                stream << " ";
+                profiling::writeGrades(stream, triple.gradeBitmap2);
+            }
+            stream << " -> ";
+            profiling::writeGrades(stream, triple.gradeBitmap3);
+            stream << ": " << triple.calls << " calls (" << percent(ratio(double(triple.calls), double(total.calls))) << "%)\n";
+        }
+
+        stream << "\nsuggested storage: ";
+        switch(suggestStorage(profile, tripleCount)){
+            case StorageSuggestion::dense:
+                stream << "dense, the non-zero coefficients fill at least half of the multivectors (toDense, MvecArray, batch functions)\n";
+                break;
+            case StorageSuggestion::gradeTyped:
+                stream << "grade-typed, the hottest grade triples make most of the calls and deserve specialized kernels\n";
+                break;
+            default:
+                stream << "sparse per grade (Mvec)\n";
+        }
+        const std::uint64_t zeros = total.resultExactZeros + total.resultNearZeros;
+        if(ratio(double(zeros), double(total.resultStored)) >= 0.25)
+            stream << percent(ratio(double(zeros), double(total.resultStored)))
+                   << "% of the stored coefficients of the results are 0 or nearly 0: roundZero removes the k-vectors that are entirely 0,\n"
+                   << "a storage per basis blade would skip the others\n";
+    }
+
+}/// End of Namespace
+
+#endif // C3GA_SPARSITY_PROFILE_HPP__
@@ -0,0 +1,271 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Tracing.hpp
+// This file is part of the Garamon for c3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Tracing.hpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Timing trace of the operations of the multivectors and of the batch functions, written in the Chrome trace
+/// format (chrome://tracing, ui.perfetto.dev). Compiled only when C3GA_TRACING is defined.
+///
+/// When C3GA_TRACING is defined (CMake option TRACING, which defines it for the library and the programs linked to it),
+/// the products, dual, reverse, inv and roundZero of the multivectors, and the batch functions, record an event with
+/// their start time, their duration, the grade bitmaps of their operands (or the size of the batch) and their thread.
+/// The recording starts with startTracing. Each thread writes its events in its own ring buffer of traceBufferCapacity
+/// events, without lock: when a buffer is full, the oldest events are replaced. When a thread ends, its buffer is given
+/// back, with its events, to the next thread that records an event: the memory of the trace is bounded by the number of
+/// threads running together, and the events of the successive threads of a buffer share its thread id. writeChromeTrace
+/// writes the events of all the threads, it can be called while threads record: it pauses the recording while it copies
+/// the buffers, the operations that end during the copy are not recorded. Otherwise the hooks are empty. The macro must
+/// have the same value in all the translation units of a program.
+
+
+#ifndef C3GA_TRACING_HPP__
+#define C3GA_TRACING_HPP__
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+
+// C3GA_TRACE_SCOPE records the enclosing scope as an operation on multivectors of grade bitmaps gradeBitmap1 and
+// gradeBitmap2, C3GA_TRACE_BATCH_SCOPE as a batch function on count multivectors
+#if defined(C3GA_TRACING)
+#define C3GA_TRACE_SCOPE(name, gradeBitmap1, gradeBitmap2) ::c3ga::TraceScope traceScope(name, gradeBitmap1, gradeBitmap2, 0)
+#define C3GA_TRACE_BATCH_SCOPE(name, count) ::c3ga::TraceScope traceScope(name, 0, 0, count)
+#else
+#define C3GA_TRACE_SCOPE(name, gradeBitmap1, gradeBitmap2)
+#define C3GA_TRACE_BATCH_SCOPE(name, count)
+#endif
+
+
+/*!
+ * @namespace c3ga
+ */
+namespace c3ga {
+
+    /// \brief true when the operations can be traced
+#if defined(C3GA_TRACING)
+    constexpr bool tracingEnabled = true;
+#else
+    constexpr bool tracingEnabled = false;
+#endif
+
+    /// \brief number of events kept per thread, a power of 2
+    constexpr std::size_t traceBufferCapacity = std::size_t(1) << 15;
+
+    /// \brief an operation recorded by the trace
+    struct TraceEvent {
+        const char* name;            /*!< name of the operation, a string literal */
+        std::int64_t start;          /*!< nanoseconds of the steady clock */
+        std::int64_t duration;       /*!< nanoseconds */
+        unsigned int gradeBitmap1;   /*!< grades of the first operand */
+        unsigned int gradeBitmap2;   /*!< grades of the second operand, 0 for the unary operations */
+        std::uint64_t count;         /*!< number of multivectors of a batch function, 0 for the other operations */
+    };
+
+
+    /// \cond DEV
+    namespace tracing {
+
+        using Clock = std::chrono::steady_clock;
+
+        /// \brief the events of a thread: written by this thread only, the last traceBufferCapacity events are kept
+        struct TraceBuffer {
+            unsigned int thread;
+            std::unique_ptr<TraceEvent[]> events;
+            std::atomic<std::uint64_t> head;   // number of events written
+            std::atomic<std::uint64_t> first;  // first event kept by clearTrace
+            std::atomic<bool> writing;         // true while the thread writes an event
+
+            explicit TraceBuffer(const unsigned int thread)
+                : thread(thread), events(new TraceEvent[traceBufferCapacity]), head(0), first(0), writing(false) {}
+
+            /// \brief write event, unless writeChromeTrace has paused the recording: either writeChromeTrace sees
+            /// writing and waits for the event, or the thread sees paused and drops the event (sequentially consistent)
+            void push(const TraceEvent& event, const std::atomic<bool>& paused) {
+                writing.store(true, std::memory_order_seq_cst);
+                if(!paused.load(std::memory_order_seq_cst)){
+                    const std::uint64_t position = head.load(std::memory_order_relaxed);
+                    events[position & (traceBufferCapacity-1)] = event;
+                    head.store(position + 1, std::memory_order_relaxed);
+                }
+                writing.store(false, std::memory_order_release);
+            }
+        };
+
+        /// \brief the buffers of all the threads that have recorded an event, kept after the end of the threads, and
+        /// the buffers of the ended threads, reused by the new threads
+        struct Registry {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<TraceBuffer>> buffers;
+            std::vector<TraceBuffer*> freeBuffers;
+            const Clock::time_point origin = Clock::now();
+            std::atomic<bool> active{false};
+            std::atomic<bool> paused{false};
+        };
+
+        inline Registry& registry() {
+            static Registry registry;
+            return registry;
+        }
+
+        /// \brief the buffer of the thread, taken from the free buffers or created, and given back at the end of the
+        /// thread (the registry, created before, is destroyed after)
+        class ThreadTraceBuffer {
+        public:
+            ThreadTraceBuffer() : buffer(acquire()) {}
+
+            ~ThreadTraceBuffer() {
+                Registry& trace = registry();
+                std::lock_guard<std::mutex> lock(trace.mutex);
+                trace.freeBuffers.push_back(buffer);
+            }
+
+            ThreadTraceBuffer(const ThreadTraceBuffer&) = delete;
+            ThreadTraceBuffer& operator=(const ThreadTraceBuffer&) = delete;
+
+            TraceBuffer* const buffer;
+
+        private:
+            static TraceBuffer* acquire() {
+                Registry& trace = registry();
+                std::lock_guard<std::mutex> lock(trace.mutex);
+                if(!trace.freeBuffers.empty()){
+                    TraceBuffer* const buffer = trace.freeBuffers.back();
+                    trace.freeBuffers.pop_back();
+                    return buffer;
+                }
+                trace.buffers.emplace_back(new TraceBuffer((unsigned int)trace.buffers.size() + 1));
+                return trace.buffers.back().get();
+            }
+        };
+
+        inline TraceBuffer& threadTraceBuffer() {
+            thread_local ThreadTraceBuffer threadBuffer;
+            return *threadBuffer.buffer;
+        }
+
+        /// \brief nanoseconds of the clock, the events are written relative to the creation of the trace
+        inline std::int64_t now() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+        }
+
+        inline void writeMicroseconds(std::ostream& stream, const std::int64_t nanoseconds) {
+            stream << nanoseconds / 1000 << "." << char('0' + nanoseconds / 100 % 10) << char('0' + nanoseconds / 10 % 10) << char('0' + nanoseconds % 10);
+        }
+    }
+    /// \endcond
+
+
+    /// \brief records an event for the lifetime of the object, when the trace is started (see C3GA_TRACE_SCOPE)
+    class TraceScope {
+    public:
+        TraceScope(const char* name, const unsigned int gradeBitmap1, const unsigned int gradeBitmap2, const std::uint64_t count)
+            : event{name, -1, 0, gradeBitmap1, gradeBitmap2, count} {
+            if(tracing::registry().active.load(std::memory_order_relaxed))
+                event.start = tracing::now();
+        }
+
+        ~TraceScope() {
+            if(event.start < 0) return;
+            event.duration = tracing::now() - event.start;
+            tracing::threadTraceBuffer().push(event, tracing::registry().paused);
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+    private:
+        TraceEvent event;
+    };
+
+
+    /// \brief start recording the operations of all the threads
+    inline void startTracing() {
+        tracing::registry().active.store(tracingEnabled, std::memory_order_relaxed);
+    }
+
+    /// \brief stop recording, the events already recorded are kept
+    inline void stopTracing() {
+        tracing::registry().active.store(false, std::memory_order_relaxed);
+    }
+
+    /// \brief remove the events recorded by all the threads
+    inline void clearTrace() {
+        tracing::Registry& trace = tracing::registry();
+        std::lock_guard<std::mutex> lock(trace.mutex);
+        for(const auto& buffer : trace.buffers)
+            buffer->first.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+
+    /// \brief write the recorded events as a Chrome trace (JSON object format), with the number of events replaced in
+    /// the full buffers in otherData.droppedEvents
+    inline void writeChromeTrace(std::ostream& stream) {
+        tracing::Registry& trace = tracing::registry();
+        std::lock_guard<std::mutex> lock(trace.mutex);
+        const std::int64_t origin = std::chrono::duration_cast<std::chrono::nanoseconds>(trace.origin.time_since_epoch()).count();
+
+        // copy the events while the recording is paused, each thread having finished the event it was writing
+        std::uint64_t droppedEvents = 0;
+        std::vector<std::vector<TraceEvent>> bufferEvents(trace.buffers.size());
+        trace.paused.store(true, std::memory_order_seq_cst);
+        for(std::size_t b=0; b<trace.buffers.size(); ++b){
+            const tracing::TraceBuffer& buffer = *trace.buffers[b];
+            while(buffer.writing.load(std::memory_order_seq_cst))
+                std::this_thread::yield();
+            const std::uint64_t head = buffer.head.load(std::memory_order_relaxed);
+            const std::uint64_t first = buffer.first.load(std::memory_order_relaxed);
+            const std::uint64_t oldest = head > traceBufferCapacity ? head - traceBufferCapacity : 0;
+            droppedEvents += oldest > first ? oldest - first : 0;
+            for(std::uint64_t position = std::max(first, oldest); position < head; ++position)
+                bufferEvents[b].push_back(buffer.events[position & (traceBufferCapacity-1)]);
+        }
+        trace.paused.store(false, std::memory_order_release);
+
+        const char* separator = "\n";
+        stream << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+        for(std::size_t b=0; b<trace.buffers.size(); ++b){
+            const unsigned int thread = trace.buffers[b]->thread;
+            stream << separator << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << thread
+                   << ", \"args\": {\"name\": \"c3ga thread " << thread << "\"}}";
+            separator = ",\n";
+
+            for(const TraceEvent& event : bufferEvents[b]){
+                stream << ",\n{\"name\": \"" << event.name << "\", \"cat\": \"c3ga\", \"ph\": \"X\", \"ts\": ";
+                tracing::writeMicroseconds(stream, std::max<std::int64_t>(event.start - origin, 0));
+                stream << ", \"dur\": ";
+                tracing::writeMicroseconds(stream, event.duration);
+                stream << ", \"pid\": 1, \"tid\": " << thread << ", \"args\": {";
+                if(event.count) stream << "\"count\": " << event.count;
+                else stream << "\"gradeBitmap1\": " << event.gradeBitmap1 << ", \"gradeBitmap2\": " << event.gradeBitmap2;
+                stream << "}}";
+            }
+        }
+        stream << "\n], \"otherData\": {\"algebra\": \"c3ga\", \"droppedEvents\": " << droppedEvents << "}}\n";
+    }
+
+    /// \brief write the recorded events as a Chrome trace in the file path
+    /// \return false if the file cannot be written
+    inline bool writeChromeTrace(const char* path) {
+        std::ofstream file(path);
+        if(!file) return false;
+        writeChromeTrace(file);
+        return bool(file);
+    }
+
+}/// End of Namespace
+
+#endif // C3GA_TRACING_HPP__
@@ -0,0 +1,202 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// MotorStream.cpp
+// This file is part of the Garamon for c3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file MotorStream.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Test of the motor streams (MotorStream.hpp), on smooth trajectories of motors sampled at 1 kHz:
+///  - the decoded motors within the error bounds of the angle and of the translation, for float and double and two steps,
+///    the stream of double with steps of 1e-6 being at most a tenth of the size of the arrays of the motors,
+///  - a segment per keyframeInterval motors, a new segment for a jump of the motor, the partial decodings and at equal
+///    to the whole decoding, the ranges beyond the motors rejected,
+///  - the bytes written in pieces with clearBytes are the stream written at once,
+///  - the invalid streams are rejected: empty, truncated, of another type, another magic or a segment of no motor.
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "c3ga/Mvec.hpp"
+#include "c3ga/MvecArray.hpp"
+#include "c3ga/MotorStream.hpp"
+
+#include "RandomMvec.hpp"
+#include "Test.hpp"
+
+
+namespace {
+
+    using c3ga::test::check;
+    using c3ga::test::typeName;
+
+    constexpr std::size_t frames = 1024;
+
+    /// \brief a trajectory: a rotation about a random axis and a translation along a curve, with smoothly varying
+    /// speeds, sampled at 1 kHz
+    template<typename T>
+    c3ga::MvecArray<T> motorTrajectory(std::mt19937& randomEngine) {
+        std::normal_distribution<double> normal;
+        std::uniform_real_distribution<double> speed(0.5, 5.0), frequency(0.1, 3.0);
+        double axis[3], squaredNorm = 0.0;
+        for(double& coordinate : axis){
+            coordinate = normal(randomEngine);
+            squaredNorm += coordinate * coordinate;
+        }
+        for(double& coordinate : axis) coordinate /= std::sqrt(squaredNorm);
+        const c3ga::Mvec<double> bivector = axis[0] * c3ga::e23<double>() - axis[1] * c3ga::e13<double>() + axis[2] * c3ga::e12<double>();
+        const double angularSpeed = speed(randomEngine), angularFrequency = frequency(randomEngine);
+        double amplitude[3], pathFrequency[3];
+        for(unsigned int c=0; c<3; ++c){
+            amplitude[c] = 10.0 * normal(randomEngine);
+            pathFrequency[c] = frequency(randomEngine);
+        }
+
+        c3ga::MvecArray<T> trajectory(frames);
+        for(std::size_t f=0; f<frames; ++f){
+            const double time = double(f) * 1e-3;
+            const double angle = angularSpeed * time + 0.5 * std::sin(angularFrequency * time);
+            c3ga::Mvec<double> t;
+            for(unsigned int c=0; c<3; ++c) t[1u << (c+1)] = amplitude[c] * std::sin(pathFrequency[c] * time);
+            const c3ga::Mvec<double> motor = (1.0 - 0.5 * (t * c3ga::ei<double>())) * (std::cos(0.5*angle) - std::sin(0.5*angle) * bivector);
+            for(unsigned int k=0; k<8; ++k)
+                trajectory.coefficientRow(c3ga::motorDenseIndex(k))[f] = T(motor[c3ga::motorBlades[k]]);
+        }
+        return trajectory;
+    }
+
+    /// \brief true if the decoded motors are within the error bounds of MotorStream.hpp from the motors, up to rounding
+    template<typename T>
+    bool withinErrorBounds(const c3ga::MvecArray<T>& motors, const c3ga::MvecArray<T>& decoded, const double step, const double rounding) {
+        if(decoded.size() != motors.size()) return false;
+        for(std::size_t i=0; i<motors.size(); ++i){
+            T motor[8], decodedMotor[8];
+            double dot = 0.0, rotorDifference = 0.0, translationDifference = 0.0;
+            for(unsigned int k=0; k<8; ++k){
+                motor[k] = motors.coefficientRow(c3ga::motorDenseIndex(k))[i];
+                decodedMotor[k] = decoded.coefficientRow(c3ga::motorDenseIndex(k))[i];
+            }
+            for(unsigned int k=0; k<4; ++k) dot += double(motor[k]) * double(decodedMotor[k]);
+            for(unsigned int k=0; k<4; ++k){
+                const double error = double(motor[k]) - (dot < 0.0 ? -double(decodedMotor[k]) : double(decodedMotor[k]));
+                rotorDifference += error * error;
+            }
+            T translation[3], decodedTranslation[3];
+            c3ga::motorTranslation(motor, translation);
+            c3ga::motorTranslation(decodedMotor, decodedTranslation);
+            for(unsigned int c=0; c<3; ++c)
+                translationDifference += double(translation[c] - decodedTranslation[c]) * double(translation[c] - decodedTranslation[c]);
+            if(!(4.0 * std::asin(std::min(1.0, 0.5 * std::sqrt(rotorDifference))) <= 2.5 * step + rounding)
+               || !(std::sqrt(translationDifference) <= 0.87 * step + rounding))
+                return false;
+        }
+        return true;
+    }
+
+    /// \brief the stream of the motors, written at once
+    template<typename T>
+    std::string encode(const c3ga::MvecArray<T>& motors, const double step, const std::size_t keyframeInterval = 256) {
+        c3ga::MotorStreamEncoder<T> encoder(static_cast<T>(step), static_cast<T>(step), keyframeInterval);
+        encoder.append(motors);
+        encoder.flush();
+        return encoder.bytes();
+    }
+
+    template<typename T>
+    void testErrorBounds(std::mt19937& randomEngine, const double step, const double rounding) {
+        bool bounds = true, sizes = true;
+        for(unsigned int k=0; k<4; ++k){
+            const c3ga::MvecArray<T> trajectory = motorTrajectory<T>(randomEngine);
+            const std::string stream = encode(trajectory, step);
+            c3ga::MotorStreamDecoder<T> decoder;
+            bounds = bounds && decoder.open(stream) && decoder.size() == frames && decoder.rotationStep() == double(T(step))
+                && decoder.translationStep() == double(T(step)) && withinErrorBounds(trajectory, decoder.decode(0, decoder.size()), step, rounding);
+            sizes = sizes && stream.size() * 10 <= frames * c3ga::multivectorSize * sizeof(T);
+        }
+        check(bounds, "decoded motors within the error bounds, steps of " + std::to_string(step) + ", " + typeName<T>());
+        if(sizeof(T) == sizeof(double) && step == 1e-6)
+            check(sizes, "stream of at most a tenth of the size of the arrays, " + typeName<T>());
+    }
+
+    void testSegments(std::mt19937& randomEngine) {
+        const double step = 1e-6;
+        c3ga::MvecArray<double> trajectory = motorTrajectory<double>(randomEngine);
+        const std::string stream = encode(trajectory, step, 100);
+        c3ga::MotorStreamDecoder<double> decoder;
+        check(decoder.open(stream) && decoder.segmentCount() == (frames + 99) / 100, "a segment per keyframeInterval motors");
+
+        // the decoding of a range of motors, starting in the middle of a segment
+        const c3ga::MvecArray<double> all = decoder.decode(0, frames);
+        const c3ga::MvecArray<double> range = decoder.decode(150, 321);
+        bool sameRange = true;
+        for(std::size_t i=0; i<range.size(); ++i)
+            sameRange = sameRange && c3ga::test::sameMvec(range.at(i), all.at(150 + i));
+        check(sameRange && c3ga::test::sameMvec(decoder.at(frames - 1), all.at(frames - 1)), "partial decodings equal to the whole decoding");
+
+        bool outOfRange = false;
+        try { decoder.decode(frames - 1, 2); } catch(const std::out_of_range&) { outOfRange = true; }
+        c3ga::MvecArray<double> motors(2);
+        check(outOfRange && !decoder.decode(frames + 1, 0, motors.view()) && decoder.decode(frames, 0, motors.view()),
+              "ranges beyond the motors rejected");
+
+        // a half turn between two motors starts a segment
+        const c3ga::Mvec<double> halfTurn = c3ga::e12<double>();
+        for(std::size_t f=frames/2 + 10; f<frames; ++f)
+            trajectory.set(f, trajectory.at(f) * halfTurn);
+        check(decoder.open(encode(trajectory, step, 256)) && decoder.segmentCount() == 5
+              && withinErrorBounds(trajectory, decoder.decode(0, frames), step, 1e-12), "jump of the motors in a new segment");
+    }
+
+    void testPieces(std::mt19937& randomEngine) {
+        const c3ga::MvecArray<double> trajectory = motorTrajectory<double>(randomEngine);
+        c3ga::MotorStreamEncoder<double> encoder(1e-6, 1e-6, 64);
+        std::string pieces;
+        for(std::size_t f=0; f<frames; ++f){
+            encoder.append(trajectory.at(f));
+            if(f % 300 == 0){
+                pieces += encoder.bytes();
+                encoder.clearBytes();
+            }
+        }
+        encoder.flush();
+        pieces += encoder.bytes();
+        check(encoder.size() == frames && pieces == encode(trajectory, 1e-6, 64), "stream written in pieces");
+    }
+
+    void testInvalidStreams(std::mt19937& randomEngine) {
+        const std::string stream = encode(motorTrajectory<double>(randomEngine), 1e-6);
+        c3ga::MotorStreamDecoder<double> decoder;
+        c3ga::MotorStreamDecoder<float> floatDecoder;
+        std::string magic = stream, noMotor = stream;
+        magic[0] = 'X';
+        const std::uint32_t zero = 0;
+        std::memcpy(&noMotor[sizeof(c3ga::MotorStreamHeader)], &zero, sizeof(zero));
+        check(!decoder.open(std::string()) && !decoder.open(stream.substr(0, sizeof(c3ga::MotorStreamHeader) - 1))
+              && !decoder.open(stream.substr(0, stream.size() - 1)) && !floatDecoder.open(stream) && !decoder.open(magic)
+              && !decoder.open(noMotor) && decoder.size() == 0 && decoder.segmentCount() == 0, "invalid streams rejected");
+        check(decoder.open(stream.substr(0, sizeof(c3ga::MotorStreamHeader))) && decoder.size() == 0, "stream of no motor");
+    }
+}
+
+
+int main() {
+    std::mt19937 randomEngine(5);
+    testErrorBounds<double>(randomEngine, 1e-6, 1e-12);
+    testErrorBounds<double>(randomEngine, 1e-3, 1e-12);
+    testErrorBounds<float>(randomEngine, 1e-3, 1e-4);
+    testSegments(randomEngine);
+    testPieces(randomEngine);
+    testInvalidStreams(randomEngine);
+    return c3ga::test::testResult();
+}
@@ -0,0 +1,199 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// PointCloud.cpp
+// This file is part of the Garamon for c3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file PointCloud.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Test of the reading of point cloud files (PointCloud.hpp):
+///  - XYZ files with comments, empty lines, separators and other columns, read exactly by chunks, with a buffer smaller
+///    than the file,
+///  - PLY files, ascii and binary of both byte orders, with coordinates of type float or double in any order among other
+///    properties, after another element,
+///  - the points read as conformal points,
+///  - the files that cannot be read, the invalid headers, the lines that are not points and the truncated files.
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "c3ga/Mvec.hpp"
+#include "c3ga/Conformal.hpp"
+#include "c3ga/MvecArray.hpp"
+#include "c3ga/PointCloud.hpp"
+
+#include "Test.hpp"
+
+
+namespace {
+
+    using c3ga::test::check;
+    using Reader = c3ga::PointCloudReader<double>;
+
+    constexpr unsigned int dimension = Reader::pointDimension;
+    const std::string path = "c3ga_point_cloud_test.cloud";
+
+    /// \brief the multivector of the point x read by PointCloudReader::read(points, capacity)
+    c3ga::Mvec<double> expectedPoint(const double* x) {
+        return c3ga::up(x);
+    }
+
+    std::vector<double> randomPoints(const std::size_t count) {
+        std::mt19937 randomEngine(19);
+        std::uniform_real_distribution<double> distribution(-100.0, 100.0);
+        std::vector<double> points(count * dimension);
+        for(double& coordinate : points) coordinate = distribution(randomEngine);
+        return points;
+    }
+
+    bool writeFile(const std::string& content) {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if(!file) return false;
+        const bool written = std::fwrite(content.data(), 1, content.size(), file) == content.size();
+        return std::fclose(file) == 0 && written;
+    }
+
+    /// \brief read the file by chunks of chunk points
+    /// \return false if the reading fails
+    bool readFile(Reader& reader, const std::size_t chunk, std::vector<double>& points) {
+        points.clear();
+        std::vector<double> coordinates(chunk * dimension);
+        std::size_t count;
+        while((count = reader.read(coordinates.data(), chunk)) != 0)
+            points.insert(points.end(), coordinates.begin(), coordinates.begin() + count * dimension);
+        return !reader.failed();
+    }
+
+    /// \brief text of a coordinate that reads back exactly
+    std::string coordinateText(const double value) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.17g", value);
+        return text;
+    }
+
+    /// \brief bytes of value in the byte order of the file
+    template<typename S>
+    std::string valueBytes(const S value, const bool bigEndian) {
+        char bytes[sizeof(S)];
+        std::memcpy(bytes, &value, sizeof(S));
+        if(bigEndian == c3ga::littleEndianMachine()) std::reverse(bytes, bytes + sizeof(S));
+        return std::string(bytes, sizeof(S));
+    }
+
+    void testXyz() {
+        const std::vector<double> points = randomPoints(5000);
+        std::string content = "# a comment\n\n";
+        for(std::size_t i=0; i<points.size()/dimension; ++i){
+            const char* separators[] = {" ", "\t", ", "};
+            for(unsigned int k=0; k<dimension; ++k)
+                content += (k ? separators[i % 3] : "") + coordinateText(points[i*dimension+k]);
+            content += i % 2 ? " 255 128 0\r\n" : "\n";
+        }
+        writeFile(content);
+
+        Reader reader(1024);
+        std::vector<double> read;
+        check(reader.open(path) && reader.format() == c3ga::PointCloudFormat::xyz && reader.pointCount() == 0,
+              "XYZ file opened");
+        check(readFile(reader, 7, read) && read == points && reader.pointCountRead() == points.size()/dimension,
+              "points of an XYZ file read exactly, by chunks, with a buffer smaller than the file");
+
+        // the points as conformal points
+        reader.open(path);
+        c3ga::MvecArray<double> conformal(64);
+        bool conformalPoints = true;
+        for(std::size_t first=0, count; (count = reader.read(conformal.view(), 64)) != 0; first += count)
+            for(std::size_t i=0; i<count && conformalPoints; ++i)
+                conformalPoints = (conformal.at(i) - expectedPoint(&points[(first+i)*dimension])).norm() <= 1e-12 * (1.0 + 1e4);
+        check(conformalPoints && reader.pointCountRead() == points.size()/dimension, "points of an XYZ file read as conformal points");
+
+        writeFile("1 2 3\n4 five 6\n7 8 9\n");
+        check(reader.open(path) && !readFile(reader, 10, read), "line that is not a point rejected");
+    }
+
+    /// \brief a PLY file of points, after an element of 2 records, the coordinates of type S among other properties
+    template<typename S>
+    std::string plyFile(const std::vector<double>& points, const char* format, const char* typeName) {
+        const bool ascii = std::strcmp(format, "ascii") == 0, bigEndian = std::strcmp(format, "binary_big_endian") == 0;
+        const std::size_t count = points.size() / dimension;
+        std::string content = std::string("ply\nformat ") + format + " 1.0\ncomment a comment\nelement camera 2\nproperty int id\n"
+            + "element vertex " + std::to_string(count) + "\nproperty uchar flag\n";
+        const char* names[] = {"z", "x", "y"};
+        const unsigned int order[] = {2, 0, 1};
+        for(unsigned int k=0; k<dimension; ++k)
+            content += std::string("property ") + typeName + " " + names[k] + "\n";
+        content += "end_header\n";
+        content += ascii ? "1\n2\n" : valueBytes<std::int32_t>(1, bigEndian) + valueBytes<std::int32_t>(2, bigEndian);
+        for(std::size_t i=0; i<count; ++i){
+            content += ascii ? "7" : valueBytes<std::uint8_t>(7, bigEndian);
+            for(const unsigned int k : order){
+                const S value = S(points[i*dimension+k]);
+                content += ascii ? " " + coordinateText(double(value)) : valueBytes<S>(value, bigEndian);
+            }
+            if(ascii) content += "\n";
+        }
+        return content;
+    }
+
+    template<typename S>
+    void testPly(const char* format, const char* typeName) {
+        const std::vector<double> points = randomPoints(3000);
+        std::vector<double> expected(points.size()), read;
+        for(std::size_t i=0; i<points.size(); ++i) expected[i] = double(S(points[i]));
+        const std::string content = plyFile<S>(points, format, typeName);
+        writeFile(content);
+        Reader reader(1024);
+        const std::string what = std::string("PLY ") + format + " of " + typeName;
+        check(reader.open(path) && reader.pointCount() == points.size()/dimension && readFile(reader, 100, read) && read == expected,
+              "points of a file " + what + " read exactly, by chunks, with a buffer smaller than the file");
+
+        if(std::strcmp(format, "ascii") != 0){
+            writeFile(content.substr(0, content.size() - 1));
+            check(reader.open(path) && !readFile(reader, 100, read) && read.size() == points.size() - dimension,
+                  "truncated file " + what + " rejected after its complete records");
+        }
+    }
+
+    void testInvalidFiles() {
+        Reader reader;
+        std::remove(path.c_str());
+        check(!reader.open(path), "missing file rejected");
+        const std::string headers[] = {
+            "ply\nformat ascii 1.0\nelement vertex 1\nproperty float x\nproperty float y\nend_header\n1 2\n",
+            "ply\nformat text 1.0\nelement vertex 1\nproperty float x\nproperty float y\nproperty float z\nend_header\n1 2 3\n",
+            "ply\nformat ascii 1.0\nelement vertex 1\nproperty float128 x\nproperty float y\nproperty float z\nend_header\n1 2 3\n",
+            "ply\nformat ascii 1.0\nelement vertex 1\nproperty float x\nproperty float y\nproperty float z\n",
+            "ply\nformat binary_little_endian 1.0\nelement face 1\nproperty list uchar int vertex_indices\nelement vertex 1\n"
+            "property float x\nproperty float y\nproperty float z\nend_header\n"};
+        bool rejected = true;
+        for(const std::string& header : headers){
+            writeFile(header);
+            rejected = rejected && !reader.open(path);
+        }
+        check(rejected, "invalid PLY headers rejected");
+        std::remove(path.c_str());
+    }
+}
+
+
+int main() {
+    testXyz();
+    testPly<float>("ascii", "float");
+    testPly<double>("binary_little_endian", "double");
+    testPly<float>("binary_big_endian", "float32");
+    testPly<double>("binary_big_endian", "float64");
+    testInvalidFiles();
+    std::remove(path.c_str());
+    return c3ga::test::testResult();
+}
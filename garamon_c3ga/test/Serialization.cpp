@@ -0,0 +1,117 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Serialization.cpp
+// This file is part of the Garamon for c3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Serialization.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Test of the binary encoding of multivectors and arrays of multivectors (Serialization.hpp), for float and double:
+///  - the round trips of random multivectors of each set of grades, of 0, and of arrays of them,
+///  - an array of zeros keeps its size, and is encoded with the coefficients of its grade 0,
+///  - the malformed encodings are rejected, before any allocation, and leave the decoded value unchanged: a huge array
+///    without coefficients, sizes that wrap, truncated buffers, another type of coefficients, grades above the dimension.
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "c3ga/Mvec.hpp"
+#include "c3ga/MvecArray.hpp"
+#include "c3ga/MvecFile.hpp"
+#include "c3ga/Serialization.hpp"
+
+#include "RandomMvec.hpp"
+#include "Test.hpp"
+
+
+namespace {
+
+    using c3ga::test::check;
+    using c3ga::test::randomMvec;
+    using c3ga::test::sameMvec;
+    using c3ga::test::typeName;
+
+    /// \brief encoding of an array of double: coefficient size, count and grade bitmap, then size bytes of coefficients
+    std::string arrayEncoding(const std::uint64_t count, const std::uint32_t gradeBitmap, const std::size_t size) {
+        std::string buffer;
+        c3ga::appendBytes(buffer, (std::uint8_t)sizeof(double));
+        c3ga::appendBytes(buffer, count);
+        c3ga::appendBytes(buffer, gradeBitmap);
+        return buffer + std::string(size, '\0');
+    }
+
+    template<typename T>
+    void testRoundTrips(std::mt19937& randomEngine) {
+        bool multivectors = true, arrays = true;
+        for(std::uint32_t gradeBitmap=0; gradeBitmap<=c3ga::allGradesBitmap; ++gradeBitmap){
+            const c3ga::Mvec<T> mv = randomMvec<T>(randomEngine, gradeBitmap);
+            const std::string buffer = c3ga::serialize(mv);
+            c3ga::Mvec<T> decoded;
+            multivectors = multivectors && buffer.size() == 1 + sizeof(std::uint32_t) + c3ga::serializedCoefficientCount(gradeBitmap)*sizeof(T)
+                && c3ga::deserialize(buffer, decoded) && sameMvec(decoded, mv);
+
+            // an array whose multivectors have some of the grades of gradeBitmap
+            std::vector<c3ga::Mvec<T>> mvs;
+            for(std::uint32_t grades=0; grades<=gradeBitmap; ++grades)
+                if((grades & gradeBitmap) == grades) mvs.push_back(randomMvec<T>(randomEngine, grades));
+            c3ga::MvecArray<T> array;
+            arrays = arrays && c3ga::deserialize(c3ga::serialize(c3ga::MvecArray<T>(mvs)), array) && array.size() == mvs.size();
+            for(std::size_t i=0; arrays && i<mvs.size(); ++i)
+                arrays = sameMvec(array.at(i), mvs[i]);
+        }
+        check(multivectors, "round trip of multivectors of each set of grades, " + typeName<T>());
+        check(arrays, "round trip of arrays of multivectors, " + typeName<T>());
+
+        c3ga::MvecArray<T> empty(std::vector<c3ga::Mvec<T>>{}), decoded(3);
+        check(c3ga::deserialize(c3ga::serialize(empty), decoded) && decoded.size() == 0, "round trip of an empty array, " + typeName<T>());
+
+        const std::string zeros = c3ga::serialize(c3ga::MvecArray<T>(4));
+        check(zeros.size() == 1 + sizeof(std::uint64_t) + sizeof(std::uint32_t) + 4*sizeof(T)
+              && c3ga::deserialize(zeros, decoded) && decoded.size() == 4 && sameMvec(decoded.at(3), c3ga::Mvec<T>()),
+              "array of zeros encoded with its grade 0, " + typeName<T>());
+    }
+
+    void testMalformedArrays() {
+        c3ga::MvecArray<double> array(2);
+        array.set(1, c3ga::Mvec<double>() + 2.0);
+        const std::string truncated = c3ga::serialize(c3ga::MvecArray<double>(std::vector<c3ga::Mvec<double>>(3, c3ga::Mvec<double>() + 1.0)));
+        check(!c3ga::deserialize(arrayEncoding(std::uint64_t(1) << 59, 0, 0), array), "huge array without coefficients rejected");
+        check(!c3ga::deserialize(arrayEncoding(3, 0, 0), array), "array without coefficients rejected");
+        check(!c3ga::deserialize(arrayEncoding(std::uint64_t(1) << 62, 1, 0), array), "array whose size wraps rejected");
+        check(!c3ga::deserialize(arrayEncoding(~std::uint64_t(0), c3ga::allGradesBitmap, 8), array), "array of the largest count rejected");
+        check(!c3ga::deserialize(truncated.substr(0, truncated.size() - 1), array), "truncated array rejected");
+        check(!c3ga::deserialize(arrayEncoding(2, 1, 8), array), "array with too few coefficients rejected");
+        check(!c3ga::deserialize(arrayEncoding(1, c3ga::allGradesBitmap + 1, 0), array), "array of a grade above the dimension rejected");
+        check(!c3ga::deserialize(truncated.substr(0, 5), array), "truncated header rejected");
+
+        c3ga::MvecArray<float> floats;
+        check(!c3ga::deserialize(truncated, floats), "array of double rejected as float");
+        check(array.size() == 2 && sameMvec(array.at(1), c3ga::Mvec<double>() + 2.0), "array unchanged by the rejected encodings");
+
+        c3ga::Mvec<double> mv = c3ga::Mvec<double>() + 3.0;
+        const std::string encoded = c3ga::serialize(c3ga::Mvec<double>() + 1.0);
+        std::string aboveDimension = encoded;
+        const std::uint32_t gradeAboveDimension = 1u << (c3ga::algebraDimension+1);
+        std::memcpy(&aboveDimension[1], &gradeAboveDimension, sizeof(gradeAboveDimension));
+        check(!c3ga::deserialize(encoded.substr(0, encoded.size() - 1), mv) && !c3ga::deserialize(encoded + '\0', mv)
+              && !c3ga::deserialize(aboveDimension, mv) && sameMvec(mv, c3ga::Mvec<double>() + 3.0),
+              "malformed multivectors rejected, the multivector unchanged");
+    }
+}
+
+
+int main() {
+    std::mt19937 randomEngine(11);
+    testRoundTrips<float>(randomEngine);
+    testRoundTrips<double>(randomEngine);
+    testMalformedArrays();
+    return c3ga::test::testResult();
+}
@@ -0,0 +1,169 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// AllocationCounter.hpp
+// This file is part of the Garamon for c4ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file AllocationCounter.hpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Count of the heap allocations of each thread, and optionally of the time spent in the allocator, for the benchmarks.
+///
+/// The allocation functions are replaced: malloc and its variants with glibc (they also count the allocations of operator
+/// new and of Eigen), operator new otherwise. This file defines them, it must be included by a single source file of a program.
+/// When the timing is enabled (setAllocatorTiming), each thread also sums the time spent in the allocation and release
+/// functions, including the waits on the locks of the allocator; the timing adds about two reads of the clock per call.
+
+
+#ifndef C4GA_ALLOCATION_COUNTER_HPP__
+#define C4GA_ALLOCATION_COUNTER_HPP__
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+
+namespace c4ga {
+namespace benchmark {
+
+    /// \cond DEV
+    inline std::size_t& threadAllocations() {
+        static thread_local std::size_t allocations = 0;
+        return allocations;
+    }
+
+    inline std::uint64_t& threadAllocatorNanoseconds() {
+        static thread_local std::uint64_t nanoseconds = 0;
+        return nanoseconds;
+    }
+
+    inline std::atomic<bool>& allocatorTiming() {
+        static std::atomic<bool> timing(false);
+        return timing;
+    }
+
+    /// \brief adds the duration of a call of the allocator to the time of the thread, when the timing is enabled
+    class AllocatorCall {
+    public:
+        AllocatorCall() : start(allocatorTiming().load(std::memory_order_relaxed) ? now() : -1) {}
+
+        ~AllocatorCall() {
+            if(start >= 0) threadAllocatorNanoseconds() += std::uint64_t(now() - start);
+        }
+
+    private:
+        static std::int64_t now() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        const std::int64_t start;
+    };
+    /// \endcond
+
+    /// \brief number of heap allocations of the calling thread since its start
+    inline std::size_t allocationCount() {
+        return threadAllocations();
+    }
+
+    /// \brief time the calls of the allocator of all the threads, or stop
+    inline void setAllocatorTiming(const bool timing) {
+        allocatorTiming().store(timing, std::memory_order_relaxed);
+    }
+
+    /// \brief nanoseconds spent in the allocator by the calling thread while the timing was enabled
+    inline std::uint64_t allocatorNanoseconds() {
+        return threadAllocatorNanoseconds();
+    }
+
+}/// End of Namespace benchmark
+}/// End of Namespace
+
+
+#if defined(__GLIBC__)
+extern "C" {
+    void* __libc_malloc(std::size_t size);
+    void* __libc_calloc(std::size_t count, std::size_t size);
+    void* __libc_realloc(void* pointer, std::size_t size);
+    void* __libc_memalign(std::size_t alignment, std::size_t size);
+    void __libc_free(void* pointer);
+
+    void* malloc(std::size_t size) {
+        ++c4ga::benchmark::threadAllocations();
+        c4ga::benchmark::AllocatorCall call;
+        return __libc_malloc(size);
+    }
+
+    void* calloc(std::size_t count, std::size_t size) {
+        ++c4ga::benchmark::threadAllocations();
+        c4ga::benchmark::AllocatorCall call;
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* pointer, std::size_t size) {
+        ++c4ga::benchmark::threadAllocations();
+        c4ga::benchmark::AllocatorCall call;
+        return __libc_realloc(pointer, size);
+    }
+
+    void* memalign(std::size_t alignment, std::size_t size) {
+        ++c4ga::benchmark::threadAllocations();
+        c4ga::benchmark::AllocatorCall call;
+        return __libc_memalign(alignment, size);
+    }
+
+    void* aligned_alloc(std::size_t alignment, std::size_t size) {
+        ++c4ga::benchmark::threadAllocations();
+        c4ga::benchmark::AllocatorCall call;
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** pointer, std::size_t alignment, std::size_t size) {
+        ++c4ga::benchmark::threadAllocations();
+        c4ga::benchmark::AllocatorCall call;
+        *pointer = __libc_memalign(alignment, size);
+        return (*pointer != nullptr || size == 0) ? 0 : ENOMEM;
+    }
+
+    void free(void* pointer) {
+        c4ga::benchmark::AllocatorCall call;
+        __libc_free(pointer);
+    }
+}
+#else
+void* operator new(std::size_t size) {
+    ++c4ga::benchmark::threadAllocations();
+    c4ga::benchmark::AllocatorCall call;
+    if(void* pointer = std::malloc(size ? size : 1)) return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    c4ga::benchmark::AllocatorCall call;
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    operator delete(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    operator delete(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    operator delete(pointer);
+}
+#endif
+
+#endif // C4GA_ALLOCATION_COUNTER_HPP__
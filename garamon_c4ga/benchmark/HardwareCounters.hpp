@@ -0,0 +1,131 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// HardwareCounters.hpp
+// This file is part of the Garamon for c4ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file HardwareCounters.hpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Hardware counters of the calling thread (cycles, instructions, cache misses, branch misses), for the benchmarks.
+///
+/// The counters are read with perf_event_open on Linux. They are unavailable on the other systems, and on Linux when the
+/// kernel refuses them (kernel.perf_event_paranoid, virtual machines without performance monitoring unit).
+
+
+#ifndef C4GA_HARDWARE_COUNTERS_HPP__
+#define C4GA_HARDWARE_COUNTERS_HPP__
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+namespace c4ga {
+namespace benchmark {
+
+    /// \brief values of the hardware counters over a measure
+    struct HardwareCounterValues {
+        std::uint64_t cycles = 0;
+        std::uint64_t instructions = 0;
+        std::uint64_t cacheMisses = 0;
+        std::uint64_t branchMisses = 0;
+    };
+
+    /// \brief the hardware counters of the calling thread: start and stop a measure
+    class HardwareCounters {
+    public:
+        static constexpr unsigned int counterCount = 4;
+
+        HardwareCounters() {
+#if defined(__linux__)
+            const std::uint64_t configs[counterCount] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                         PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+            for(unsigned int c=0; c<counterCount; ++c){
+                perf_event_attr attributes = {};
+                attributes.type = PERF_TYPE_HARDWARE;
+                attributes.size = sizeof(perf_event_attr);
+                attributes.config = configs[c];
+                attributes.disabled = c == 0;
+                attributes.exclude_kernel = 1;
+                attributes.exclude_hv = 1;
+                attributes.read_format = PERF_FORMAT_GROUP;
+                descriptors[c] = (int)syscall(SYS_perf_event_open, &attributes, 0, -1, c == 0 ? -1 : descriptors[0], 0);
+                if(descriptors[c] < 0){
+                    close();
+                    return;
+                }
+            }
+#endif
+        }
+
+        ~HardwareCounters() {
+            close();
+        }
+
+        HardwareCounters(const HardwareCounters&) = delete;
+        HardwareCounters& operator=(const HardwareCounters&) = delete;
+
+        /// \brief true if the counters can be read
+        bool available() const {
+            return descriptors[0] >= 0;
+        }
+
+        /// \brief reset the counters and start counting
+        void start() {
+#if defined(__linux__)
+            if(!available()) return;
+            ioctl(descriptors[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(descriptors[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+        }
+
+        /// \brief stop counting
+        /// \return the values counted since start, all 0 if the counters are unavailable
+        HardwareCounterValues stop() {
+            HardwareCounterValues values;
+#if defined(__linux__)
+            if(!available()) return values;
+            ioctl(descriptors[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            std::uint64_t group[1 + counterCount] = {};
+            if(read(descriptors[0], group, sizeof(group)) != (ssize_t)sizeof(group)) return values;
+            values.cycles = group[1];
+            values.instructions = group[2];
+            values.cacheMisses = group[3];
+            values.branchMisses = group[4];
+#endif
+            return values;
+        }
+
+    private:
+        void close() {
+#if defined(__linux__)
+            for(int& descriptor : descriptors){
+                if(descriptor >= 0) ::close(descriptor);
+                descriptor = -1;
+            }
+#endif
+        }
+
+        int descriptors[counterCount] = {-1, -1, -1, -1};
+    };
+
+    /// \brief write the values divided by count as a JSON object
+    inline void writeHardwareCountersJson(std::ostream& stream, const HardwareCounterValues& values, const double count) {
+        stream << "{\"cycles\": " << double(values.cycles) / count << ", \"instructions\": " << double(values.instructions) / count
+               << ", \"cacheMisses\": " << double(values.cacheMisses) / count << ", \"branchMisses\": " << double(values.branchMisses) / count << "}";
+    }
+
+}/// End of Namespace benchmark
+}/// End of Namespace
+
+#endif // C4GA_HARDWARE_COUNTERS_HPP__
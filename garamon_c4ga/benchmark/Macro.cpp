@@ -0,0 +1,117 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Macro.cpp
+// This file is part of the Garamon for c4ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Macro.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Macro benchmarks of c4ga: workloads of applications, with their throughput and the latency of their requests.
+///
+/// The scenario, on data of a fixed seed:
+///  - sparseProducts: 20k requests of 16 products (geometric, outer, inner in turn) between sparse multivectors drawn
+///    from a pool: vectors, rotors (scalar and bivector), trivectors and mixed grades 1 and 3, with a few non-zero
+///    coefficients per grade. An item is a product.
+/// The results of each pass are checked against those computed before the benchmark, the program returns 1 if they differ.
+///
+/// Usage: c4ga_macro_benchmark [--repetitions <passes>] [--counters] [--filter <text>] [--output <path>] [--scale <factor>],
+/// the scale multiplies the number of requests. See Benchmark.hpp for the report.
+
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "c4ga/Mvec.hpp"
+
+#include "Benchmark.hpp"
+
+
+namespace {
+
+    using Mvec = c4ga::Mvec<double>;
+    using c4ga::benchmark::ScenarioCase;
+
+    /// \brief multivector with nonZeros random coefficients in each grade of grades
+    Mvec sparseMvec(std::mt19937& randomEngine, const std::vector<unsigned int>& grades, const unsigned int nonZeros) {
+        std::uniform_real_distribution<double> coefficient(-1.0, 1.0);
+        std::vector<double> dense(c4ga::multivectorSize, 0.0);
+        for(const unsigned int grade : grades)
+            for(unsigned int k=0; k<nonZeros; ++k){
+                std::uniform_int_distribution<unsigned int> index(0, c4ga::binomialArray[grade] - 1);
+                dense[c4ga::perGradeStartingIndex[grade] + index(randomEngine)] = coefficient(randomEngine);
+            }
+        Mvec mv;
+        mv.fromDense(dense.data());
+        return mv;
+    }
+
+    /// \brief the operands and results of the sparse products
+    struct SparseProducts {
+        static constexpr std::size_t productsPerRequest = 16;
+        std::vector<Mvec> pool;
+        std::vector<unsigned int> operands;   // 2 indices in the pool per product
+        std::vector<Mvec> results;
+        std::vector<double> expected;         // sum of the coefficients of each result
+    };
+
+    Mvec sparseProduct(const SparseProducts& data, const std::size_t product) {
+        const Mvec& mv1 = data.pool[data.operands[2*product]];
+        const Mvec& mv2 = data.pool[data.operands[2*product+1]];
+        switch(product % 3){
+            case 0: return mv1 * mv2;
+            case 1: return mv1 ^ mv2;
+            default: return mv1 | mv2;
+        }
+    }
+
+    double coefficientSum(const Mvec& mv) {
+        double dense[c4ga::multivectorSize];
+        mv.toDense(dense);
+        double sum = 0.0;
+        for(const double coefficient : dense) sum += coefficient;
+        return sum;
+    }
+
+    std::shared_ptr<SparseProducts> sparseProducts(const double scale) {
+        auto data = std::make_shared<SparseProducts>();
+        const std::size_t requests = std::max<std::size_t>(1, std::size_t(20000 * scale));
+        std::mt19937 randomEngine(5);
+        const std::vector<std::vector<unsigned int>> kinds = {{1}, {0, 2}, {3}, {1, 3}};
+        for(unsigned int m=0; m<256; ++m)
+            data->pool.push_back(sparseMvec(randomEngine, kinds[m % kinds.size()], 3));
+        std::uniform_int_distribution<unsigned int> operand(0, (unsigned int)data->pool.size() - 1);
+        data->operands.resize(2 * requests * SparseProducts::productsPerRequest);
+        for(unsigned int& index : data->operands) index = operand(randomEngine);
+        data->results.resize(requests * SparseProducts::productsPerRequest);
+        for(std::size_t product=0; product<data->results.size(); ++product)
+            data->expected.push_back(coefficientSum(sparseProduct(*data, product)));
+        return data;
+    }
+
+    ScenarioCase sparseProductsScenario(const std::shared_ptr<SparseProducts>& data) {
+        const std::size_t perRequest = SparseProducts::productsPerRequest;
+        return {"sparseProducts", data->results.size() / perRequest, perRequest, [data, perRequest](const std::size_t request){
+            for(std::size_t product=request*perRequest; product<(request+1)*perRequest; ++product)
+                data->results[product] = sparseProduct(*data, product);
+        }, [data](){
+            for(std::size_t product=0; product<data->results.size(); ++product)
+                if(!(std::abs(coefficientSum(data->results[product]) - data->expected[product]) < 1e-9)) return false;
+            return true;
+        }};
+    }
+}
+
+
+int main(int argc, char** argv) {
+    c4ga::benchmark::BenchmarkOptions options;
+    if(!c4ga::benchmark::parseBenchmarkOptions(argc, argv, options)) return 2;
+
+    const std::vector<ScenarioCase> scenarios = {sparseProductsScenario(sparseProducts(options.scale))};
+    return c4ga::benchmark::runScenarios("macro", scenarios, options);
+}
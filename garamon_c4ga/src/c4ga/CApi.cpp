@@ -0,0 +1,222 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// CApi.cpp
+// This file is part of the Garamon for c4ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file CApi.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief C interface of the c4ga library, implemented on top of Mvec<double> and the batch functions.
+
+
+#include "c4ga/CApi.h"
+
+#include <new>
+
+#include "c4ga/Mvec.hpp"
+#include "c4ga/Batch.hpp"
+#include "c4ga/KernelDispatch.hpp"
+#include "c4ga/Conformal.hpp"
+
+
+/// \brief the multivector behind an opaque handle
+struct c4ga_mvec {
+    c4ga::Mvec<double> mv;
+};
+
+
+/// \cond DEV
+// no exception may cross the C interface: the functions returning a status catch them all
+#define C4GA_CAPI_TRY(statements) \
+    try { statements; return 0; } \
+    catch(...) { return -1; }
+
+namespace {
+
+    /// \brief view on the operand of a batch function, stored as multivectors of multivectorSize coefficients
+    inline c4ga::BatchView<const double> operandBatch(const double* data, const ptrdiff_t itemStride) {
+        return {data, itemStride, 1};
+    }
+
+    /// \brief new handle on mv, NULL if the allocation fails
+    inline c4ga_mvec* newHandle(c4ga::Mvec<double>&& mv) {
+        return new (std::nothrow) c4ga_mvec{std::move(mv)};
+    }
+}
+/// \endcond
+
+
+extern "C" {
+
+int c4ga_api_version(void) {
+    return C4GA_CAPI_VERSION;
+}
+
+unsigned int c4ga_algebra_dimension(void) {
+    return c4ga::algebraDimension;
+}
+
+unsigned int c4ga_multivector_size(void) {
+    return c4ga::multivectorSize;
+}
+
+unsigned int c4ga_dense_index(const unsigned int xor_index) {
+    if(xor_index >= c4ga::multivectorSize) return c4ga::multivectorSize;
+    return c4ga::perGradeStartingIndex[c4ga::xorIndexToGrade[xor_index]] + c4ga::xorIndexToHomogeneousIndex[xor_index];
+}
+
+
+c4ga_mvec* c4ga_mvec_new(void) {
+    try { return newHandle(c4ga::Mvec<double>()); }
+    catch(...) { return nullptr; }
+}
+
+c4ga_mvec* c4ga_mvec_from_dense(const double* dense) {
+    try {
+        c4ga::Mvec<double> mv;
+        mv.fromDense(dense);
+        return newHandle(std::move(mv));
+    }
+    catch(...) { return nullptr; }
+}
+
+c4ga_mvec* c4ga_mvec_clone(const c4ga_mvec* mv) {
+    try { return newHandle(c4ga::Mvec<double>(mv->mv)); }
+    catch(...) { return nullptr; }
+}
+
+void c4ga_mvec_free(c4ga_mvec* mv) {
+    delete mv;
+}
+
+void c4ga_mvec_to_dense(const c4ga_mvec* mv, double* dense) {
+    mv->mv.toDense(dense);
+}
+
+double c4ga_mvec_get(const c4ga_mvec* mv, const unsigned int xor_index) {
+    if(xor_index >= c4ga::multivectorSize) return 0.0;
+    double dense[c4ga::multivectorSize];
+    mv->mv.toDense(dense);
+    return dense[c4ga_dense_index(xor_index)];
+}
+
+int c4ga_mvec_set(c4ga_mvec* mv, const unsigned int xor_index, const double value) {
+    if(xor_index >= c4ga::multivectorSize) return -1;
+    C4GA_CAPI_TRY(mv->mv[xor_index] = value)
+}
+
+
+int c4ga_mvec_add(const c4ga_mvec* a, const c4ga_mvec* b, c4ga_mvec* result) {
+    C4GA_CAPI_TRY(result->mv = a->mv + b->mv)
+}
+
+int c4ga_mvec_sub(const c4ga_mvec* a, const c4ga_mvec* b, c4ga_mvec* result) {
+    C4GA_CAPI_TRY(result->mv = a->mv - b->mv)
+}
+
+int c4ga_mvec_scale(const c4ga_mvec* a, const double value, c4ga_mvec* result) {
+    C4GA_CAPI_TRY(result->mv = a->mv * value)
+}
+
+int c4ga_mvec_geometric_product(const c4ga_mvec* a, const c4ga_mvec* b, c4ga_mvec* result) {
+    C4GA_CAPI_TRY(result->mv = a->mv * b->mv)
+}
+
+int c4ga_mvec_outer_product(const c4ga_mvec* a, const c4ga_mvec* b, c4ga_mvec* result) {
+    C4GA_CAPI_TRY(result->mv = a->mv ^ b->mv)
+}
+
+int c4ga_mvec_inner_product(const c4ga_mvec* a, const c4ga_mvec* b, c4ga_mvec* result) {
+    C4GA_CAPI_TRY(result->mv = a->mv | b->mv)
+}
+
+int c4ga_mvec_left_contraction(const c4ga_mvec* a, const c4ga_mvec* b, c4ga_mvec* result) {
+    C4GA_CAPI_TRY(result->mv = a->mv < b->mv)
+}
+
+int c4ga_mvec_right_contraction(const c4ga_mvec* a, const c4ga_mvec* b, c4ga_mvec* result) {
+    C4GA_CAPI_TRY(result->mv = a->mv > b->mv)
+}
+
+int c4ga_mvec_dual(const c4ga_mvec* a, c4ga_mvec* result) {
+    C4GA_CAPI_TRY(result->mv = a->mv.dual())
+}
+
+int c4ga_mvec_reverse(const c4ga_mvec* a, c4ga_mvec* result) {
+    C4GA_CAPI_TRY(result->mv = a->mv.reverse())
+}
+
+int c4ga_mvec_inverse(const c4ga_mvec* a, c4ga_mvec* result) {
+    C4GA_CAPI_TRY(result->mv = a->mv.inv())
+}
+
+double c4ga_mvec_norm(const c4ga_mvec* a) {
+    return a->mv.norm();
+}
+
+
+int c4ga_geometric_product_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    C4GA_CAPI_TRY(c4ga::geometricProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), c4ga::aosBatch(result), count))
+}
+
+int c4ga_outer_product_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    C4GA_CAPI_TRY(c4ga::outerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), c4ga::aosBatch(result), count))
+}
+
+int c4ga_inner_product_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    C4GA_CAPI_TRY(c4ga::innerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), c4ga::aosBatch(result), count, c4ga::InnerKind::inner))
+}
+
+int c4ga_left_contraction_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    C4GA_CAPI_TRY(c4ga::innerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), c4ga::aosBatch(result), count, c4ga::InnerKind::leftContraction))
+}
+
+int c4ga_right_contraction_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    C4GA_CAPI_TRY(c4ga::innerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), c4ga::aosBatch(result), count, c4ga::InnerKind::rightContraction))
+}
+
+int c4ga_apply_versor_batch(const double* versor, const ptrdiff_t versor_stride, const double* mv, const ptrdiff_t mv_stride, double* result, const size_t count) {
+    C4GA_CAPI_TRY(c4ga::applyVersorBatch(operandBatch(versor, versor_stride), operandBatch(mv, mv_stride), c4ga::aosBatch(result), count))
+}
+
+int c4ga_dual_batch(const double* a, const ptrdiff_t a_stride, double* result, const size_t count) {
+    C4GA_CAPI_TRY(c4ga::dualBatch(operandBatch(a, a_stride), c4ga::aosBatch(result), count))
+}
+
+int c4ga_reverse_batch(const double* a, const ptrdiff_t a_stride, double* result, const size_t count) {
+    C4GA_CAPI_TRY(c4ga::reverseBatch(operandBatch(a, a_stride), c4ga::aosBatch(result), count))
+}
+
+int c4ga_norm_batch(const double* a, const ptrdiff_t a_stride, double* norms, const size_t count) {
+    C4GA_CAPI_TRY(c4ga::normBatch(operandBatch(a, a_stride), norms, count))
+}
+
+const char* c4ga_kernel_isa(void) {
+    return c4ga::kernelIsaName(c4ga::activeKernelIsa());
+}
+
+int c4ga_select_kernel_isa(const char* name) {
+    if(name == nullptr) return -1;
+    return c4ga::selectKernelIsa(name) ? 0 : -1;
+}
+
+int c4ga_autotune_kernels(const char* path) {
+    C4GA_CAPI_TRY(if(!c4ga::autotuneKernels(path)) return -1)
+}
+
+unsigned int c4ga_euclidean_dimension(void) {
+    return c4ga::euclideanDimension;
+}
+
+int c4ga_up_batch(const double* points, double* result, const size_t count) {
+    C4GA_CAPI_TRY(c4ga::upBatch(points, c4ga::aosBatch(result), count))
+}
+
+int c4ga_down_batch(const double* mv, const ptrdiff_t mv_stride, double* points, const size_t count) {
+    C4GA_CAPI_TRY(c4ga::downBatch(operandBatch(mv, mv_stride), points, count))
+}
+
+} // extern "C"
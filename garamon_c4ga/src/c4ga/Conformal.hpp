@@ -0,0 +1,103 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Conformal.hpp
+// This file is part of the Garamon for c4ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Conformal.hpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Conversions between Euclidean points and conformal points (basis vector e0 for the origin, ei for the infinity).
+
+
+#ifndef C4GA_CONFORMAL_HPP__
+#define C4GA_CONFORMAL_HPP__
+#pragma once
+
+#include <cstddef>
+
+#include "c4ga/Mvec.hpp"
+#include "c4ga/Batch.hpp"
+
+
+/*!
+ * @namespace c4ga
+ */
+namespace c4ga {
+
+    constexpr unsigned int euclideanDimension = algebraDimension - 2; /*!< dimension of the Euclidean space represented by the conformal model */
+
+    /// \cond DEV
+    /// \brief position in a dense multivector (see Mvec::toDense) of the coefficient of the basis vector k (0 for e0, algebraDimension-1 for ei)
+    constexpr unsigned int vectorDenseIndex(const unsigned int k) {
+        return perGradeStartingIndex[1] + xorIndexToHomogeneousIndex[1u << k];
+    }
+    /// \endcond
+
+
+    /// \brief conformal points of Euclidean points: result[i] = e0 + x + 0.5 |x|^2 ei
+    /// \param points - count x euclideanDimension coordinates, one point after the other
+    /// \param result - the conformal points, all their other coefficients are set to 0
+    /// \param count - number of points
+    template<typename T>
+    void upBatch(const T* points, const BatchView<T> result, const std::size_t count) {
+        // all the coefficients to 0, coefficient per coefficient for multivectors stored as a structure of arrays
+        if(result.itemStride == 1 && result.coeffStride != 1)
+            for(unsigned int idx=0; idx<multivectorSize; ++idx)
+                for(std::size_t i=0; i<count; ++i)
+                    result(i, idx) = T(0);
+        else
+            for(std::size_t i=0; i<count; ++i)
+                for(unsigned int idx=0; idx<multivectorSize; ++idx)
+                    result(i, idx) = T(0);
+
+        for(std::size_t i=0; i<count; ++i){
+            const T* x = points + i*euclideanDimension;
+            T squaredNorm = T(0);
+            for(unsigned int k=0; k<euclideanDimension; ++k){
+                result(i, vectorDenseIndex(k+1)) = x[k];
+                squaredNorm += x[k]*x[k];
+            }
+            result(i, vectorDenseIndex(0)) = T(1);
+            result(i, vectorDenseIndex(algebraDimension-1)) = T(0.5)*squaredNorm;
+        }
+    }
+
+    /// \brief Euclidean coordinates of conformal points, normalized by their e0 coefficient (inf or nan when it is 0)
+    /// \param mv - the conformal points
+    /// \param points - count x euclideanDimension coordinates, one point after the other
+    /// \param count - number of points
+    template<typename T>
+    void downBatch(const BatchView<const T> mv, T* points, const std::size_t count) {
+        for(std::size_t i=0; i<count; ++i){
+            const T weight = mv(i, vectorDenseIndex(0));
+            for(unsigned int k=0; k<euclideanDimension; ++k)
+                points[i*euclideanDimension+k] = mv(i, vectorDenseIndex(k+1)) / weight;
+        }
+    }
+
+    /// \brief conformal point of the Euclidean point x: e0 + x + 0.5 |x|^2 ei
+    /// \param x - euclideanDimension coordinates
+    template<typename T>
+    Mvec<T> up(const T* x) {
+        T dense[multivectorSize];
+        upBatch(x, aosBatch(dense), 1);
+        Mvec<T> mv;
+        mv.fromDense(dense);
+        return mv;
+    }
+
+    /// \brief Euclidean coordinates of the conformal point mv, normalized by its e0 coefficient
+    /// \param x - the euclideanDimension coordinates
+    template<typename T>
+    void down(const Mvec<T>& mv, T* x) {
+        T dense[multivectorSize];
+        mv.toDense(dense);
+        downBatch(aosBatch((const T*)dense), x, 1);
+    }
+
+}/// End of Namespace
+
+#endif // C4GA_CONFORMAL_HPP__
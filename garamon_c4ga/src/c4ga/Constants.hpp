@@ -57,6 +57,8 @@ namespace c4ga{
 
     constexpr unsigned int algebraDimension = 6; /*!< dimension of the algebra (number of  basis vectors of grade 1) */
 
+    constexpr unsigned int multivectorSize = 64; /*!< number of coefficients of a full multivector (2^dimension) */
+
     constexpr unsigned int perGradeStartingIndex[7] = {0,1,7,22,42,57,63};  /*!< array specifying the index of each first element of grade k in the full multivector */
 
     constexpr unsigned int binomialArray[7] = {1,6,15,20,15,6,1};  /*!< array of the (dimension + 1) first binomial coefficients */
@@ -65,20 +67,22 @@ namespace c4ga{
 
     constexpr unsigned int xorIndexToHomogeneousIndex[] = {0,0,1,0,2,1,5,0,3,2,6,1,9,4,10,0,4,3,7,2,10,5,11,1,12,7,13,3,16,6,10,0,5,4,8,3,11,6,12,2,13,8,14,4,17,7,11,1,14,9,15,5,18,8,12,2,19,9,13,3,14,4,5,0}; /*!< given a Xor index in a multivector, this array indicates the corresponding index in the whole homogeneous vector*/
 
-    const std::array<std::vector<unsigned int>, 7> dualPermutations = {{ { 0}, {{ 0,4,3,2,1,5}}, {{ 6,3,1,0,10,9,8,7,14,5,4,13,2,12,11}}, {{ 7,5,4,16,2,1,13,0,11,10,9,8,19,6,18,17,3,15,14,12}}, {{ 3,2,12,1,10,9,0,7,6,5,4,14,13,11,8}}, {{ 0,4,3,2,1,5}}, {0} }}; /*!< array referring to some permutations required to compute the dual. */
+    constexpr unsigned int dualPermutations[7][20] = {{0}, {0,4,3,2,1,5}, {6,3,1,0,10,9,8,7,14,5,4,13,2,12,11}, {7,5,4,16,2,1,13,0,11,10,9,8,19,6,18,17,3,15,14,12}, {3,2,12,1,10,9,0,7,6,5,4,14,13,11,8}, {0,4,3,2,1,5}, {0}}; /*!< array referring to some permutations required to compute the dual. */
 
-    const std::array<Eigen::Matrix<double, Eigen::Dynamic,1>, 7> dualCoefficients = loadFastDualArray<double>(); /*!< array containing some basis change coefficients required to compute the dual */
+    constexpr double dualCoefficients[7][20] = {{1.000000}, {1.000000,1.000000,-1.000000,1.000000,-1.000000,-1.000000}, {-1.000000,1.000000,-1.000000,-1.000000,1.000000,-1.000000,1.000000,-1.000000,1.000000,-1.000000,1.000000,1.000000,-1.000000,1.000000,-1.000000}, {-1.000000,1.000000,-1.000000,-1.000000,-1.000000,1.000000,1.000000,-1.000000,-1.000000,1.000000,1.000000,-1.000000,1.000000,1.000000,-1.000000,1.000000,-1.000000,1.000000,-1.000000,1.000000}, {1.000000,-1.000000,1.000000,-1.000000,1.000000,-1.000000,1.000000,-1.000000,-1.000000,-1.000000,1.000000,1.000000,-1.000000,-1.000000,1.000000}, {1.000000,-1.000000,1.000000,-1.000000,1.000000,-1.000000}, {1.000000}}; /*!< array containing some basis change coefficients required to compute the dual */
     
     template<typename T>
-    std::array<T, 64> recursiveDualCoefficients = {{ 1.000000,1.000000,1.000000,-1.000000,-1.000000,1.000000,-1.000000,-1.000000,1.000000,-1.000000,1.000000,1.000000,-1.000000,-1.000000,1.000000,1.000000,-1.000000,-1.000000,-1.000000,-1.000000,1.000000,1.000000,-1.000000,-1.000000,-1.000000,-1.000000,1.000000,-1.000000,-1.000000,1.000000,1.000000,1.000000,-1.000000,1.000000,1.000000,-1.000000,1.000000,1.000000,1.000000,1.000000,1.000000,-1.000000,-1.000000,1.000000,1.000000,-1.000000,1.000000,-1.000000,-1.000000,1.000000,1.000000,-1.000000,-1.000000,-1.000000,-1.000000,1.000000,1.000000,-1.000000,-1.000000,-1.000000,1.000000,1.000000,-1.000000,1.000000}}; /*!< array containing the coefficients needed to compute the recursive product like (primal^dual) */
+    constexpr std::array<T, 64> recursiveDualCoefficients = {{ 1.000000,1.000000,1.000000,-1.000000,-1.000000,1.000000,-1.000000,-1.000000,1.000000,-1.000000,1.000000,1.000000,-1.000000,-1.000000,1.000000,1.000000,-1.000000,-1.000000,-1.000000,-1.000000,1.000000,1.000000,-1.000000,-1.000000,-1.000000,-1.000000,1.000000,-1.000000,-1.000000,1.000000,1.000000,1.000000,-1.000000,1.000000,1.000000,-1.000000,1.000000,1.000000,1.000000,1.000000,1.000000,-1.000000,-1.000000,1.000000,1.000000,-1.000000,1.000000,-1.000000,-1.000000,1.000000,1.000000,-1.000000,-1.000000,-1.000000,-1.000000,1.000000,1.000000,-1.000000,-1.000000,-1.000000,1.000000,1.000000,-1.000000,1.000000}}; /*!< array containing the coefficients needed to compute the recursive product like (primal^dual) */
 
     constexpr double pseudoScalarInverse = 1.000000; /*!< compute the inverse of the pseudo scalar */
 
-    const int signReversePerGrade[7] = {1,1,-1,-1,1,1,-1}; /*!< array of signs to avoid the computation of (-1)^k*(k-1)/2 during the reverse operation */
+    constexpr int signReversePerGrade[7] = {1,1,-1,-1,1,1,-1}; /*!< array of signs to avoid the computation of (-1)^k*(k-1)/2 during the reverse operation */
 
-    const std::vector<std::string> basisVectors = {"0", "1", "2", "3", "4", "i"}; /*!< name of the basis vectors (of grade 1) */
+    constexpr const char* basisVectors[] = {"0", "1", "2", "3", "4", "i"}; /*!< name of the basis vectors (of grade 1) */
+    constexpr const char* basisBladeNames[64] = {"", "0", "1", "2", "3", "4", "i", "01", "02", "03", "04", "0i", "12", "13", "14", "1i", "23", "24", "2i", "34", "3i", "4i", "012", "013", "014", "01i", "023", "024", "02i", "034", "03i", "04i", "123", "124", "12i", "134", "13i", "14i", "234", "23i", "24i", "34i", "0123", "0124", "012i", "0134", "013i", "014i", "0234", "023i", "024i", "034i", "1234", "123i", "124i", "134i", "234i", "01234", "0123i", "0124i", "0134i", "0234i", "1234i", "01234i"}; /*!< name of the basis blade of each coefficient of a dense multivector (see Mvec::toDense), written after "e" by operator<< */
+    constexpr unsigned int basisBladeIndices[64] = {0,1,2,7,3,8,12,22,4,9,13,23,16,26,32,42,5,10,14,24,17,27,33,43,19,29,35,45,38,48,52,57,6,11,15,25,18,28,34,44,20,30,36,46,39,49,53,58,21,31,37,47,40,50,54,59,41,51,55,60,56,61,62,63}; /*!< index in a dense multivector of the basis blade whose basis vectors are the bits of the index (bit i for basisVectors[i]) */
 
-    const std::string metric =
+    constexpr const char* metric =
 "\
 	e0	e1	e2	e3	e4	ei	\n\
 e0	0	0	0	0	0	-1	\n\
@@ -91,82 +95,90 @@ ei	-1	0	0	0	0	0	\n\
 
 
     template<class T>
-    const T zero = 0;
-
-    const unsigned int scalar = 0;
-    const unsigned int E0 = 1;
-    const unsigned int E1 = 2;
-    const unsigned int E2 = 4;
-    const unsigned int E3 = 8;
-    const unsigned int E4 = 16;
-    const unsigned int Ei = 32;
-    const unsigned int E01 = 3;
-    const unsigned int E02 = 5;
-    const unsigned int E03 = 9;
-    const unsigned int E04 = 17;
-    const unsigned int E0i = 33;
-    const unsigned int E12 = 6;
-    const unsigned int E13 = 10;
-    const unsigned int E14 = 18;
-    const unsigned int E1i = 34;
-    const unsigned int E23 = 12;
-    const unsigned int E24 = 20;
-    const unsigned int E2i = 36;
-    const unsigned int E34 = 24;
-    const unsigned int E3i = 40;
-    const unsigned int E4i = 48;
-    const unsigned int E012 = 7;
-    const unsigned int E013 = 11;
-    const unsigned int E014 = 19;
-    const unsigned int E01i = 35;
-    const unsigned int E023 = 13;
-    const unsigned int E024 = 21;
-    const unsigned int E02i = 37;
-    const unsigned int E034 = 25;
-    const unsigned int E03i = 41;
-    const unsigned int E04i = 49;
-    const unsigned int E123 = 14;
-    const unsigned int E124 = 22;
-    const unsigned int E12i = 38;
-    const unsigned int E134 = 26;
-    const unsigned int E13i = 42;
-    const unsigned int E14i = 50;
-    const unsigned int E234 = 28;
-    const unsigned int E23i = 44;
-    const unsigned int E24i = 52;
-    const unsigned int E34i = 56;
-    const unsigned int E0123 = 15;
-    const unsigned int E0124 = 23;
-    const unsigned int E012i = 39;
-    const unsigned int E0134 = 27;
-    const unsigned int E013i = 43;
-    const unsigned int E014i = 51;
-    const unsigned int E0234 = 29;
-    const unsigned int E023i = 45;
-    const unsigned int E024i = 53;
-    const unsigned int E034i = 57;
-    const unsigned int E1234 = 30;
-    const unsigned int E123i = 46;
-    const unsigned int E124i = 54;
-    const unsigned int E134i = 58;
-    const unsigned int E234i = 60;
-    const unsigned int E01234 = 31;
-    const unsigned int E0123i = 47;
-    const unsigned int E0124i = 55;
-    const unsigned int E0134i = 59;
-    const unsigned int E0234i = 61;
-    const unsigned int E1234i = 62;
-    const unsigned int E01234i = 63;
+    constexpr T zero = 0;
+
+    constexpr unsigned int scalar = 0;
+    constexpr unsigned int E0 = 1;
+    constexpr unsigned int E1 = 2;
+    constexpr unsigned int E2 = 4;
+    constexpr unsigned int E3 = 8;
+    constexpr unsigned int E4 = 16;
+    constexpr unsigned int Ei = 32;
+    constexpr unsigned int E01 = 3;
+    constexpr unsigned int E02 = 5;
+    constexpr unsigned int E03 = 9;
+    constexpr unsigned int E04 = 17;
+    constexpr unsigned int E0i = 33;
+    constexpr unsigned int E12 = 6;
+    constexpr unsigned int E13 = 10;
+    constexpr unsigned int E14 = 18;
+    constexpr unsigned int E1i = 34;
+    constexpr unsigned int E23 = 12;
+    constexpr unsigned int E24 = 20;
+    constexpr unsigned int E2i = 36;
+    constexpr unsigned int E34 = 24;
+    constexpr unsigned int E3i = 40;
+    constexpr unsigned int E4i = 48;
+    constexpr unsigned int E012 = 7;
+    constexpr unsigned int E013 = 11;
+    constexpr unsigned int E014 = 19;
+    constexpr unsigned int E01i = 35;
+    constexpr unsigned int E023 = 13;
+    constexpr unsigned int E024 = 21;
+    constexpr unsigned int E02i = 37;
+    constexpr unsigned int E034 = 25;
+    constexpr unsigned int E03i = 41;
+    constexpr unsigned int E04i = 49;
+    constexpr unsigned int E123 = 14;
+    constexpr unsigned int E124 = 22;
+    constexpr unsigned int E12i = 38;
+    constexpr unsigned int E134 = 26;
+    constexpr unsigned int E13i = 42;
+    constexpr unsigned int E14i = 50;
+    constexpr unsigned int E234 = 28;
+    constexpr unsigned int E23i = 44;
+    constexpr unsigned int E24i = 52;
+    constexpr unsigned int E34i = 56;
+    constexpr unsigned int E0123 = 15;
+    constexpr unsigned int E0124 = 23;
+    constexpr unsigned int E012i = 39;
+    constexpr unsigned int E0134 = 27;
+    constexpr unsigned int E013i = 43;
+    constexpr unsigned int E014i = 51;
+    constexpr unsigned int E0234 = 29;
+    constexpr unsigned int E023i = 45;
+    constexpr unsigned int E024i = 53;
+    constexpr unsigned int E034i = 57;
+    constexpr unsigned int E1234 = 30;
+    constexpr unsigned int E123i = 46;
+    constexpr unsigned int E124i = 54;
+    constexpr unsigned int E134i = 58;
+    constexpr unsigned int E234i = 60;
+    constexpr unsigned int E01234 = 31;
+    constexpr unsigned int E0123i = 47;
+    constexpr unsigned int E0124i = 55;
+    constexpr unsigned int E0134i = 59;
+    constexpr unsigned int E0234i = 61;
+    constexpr unsigned int E1234i = 62;
+    constexpr unsigned int E01234i = 63;
     /*!< defines the constants for the cga */
 
+    /// \brief transformation matrices of the k-vectors from the orthogonal basis to the original basis, built on first use (thread-safe)
     template<typename T>
-    const std::array<Eigen::SparseMatrix<T, Eigen::ColMajor>,7> transformationMatrices = loadMatrices<T>(); /*!< set transformation matrices to transform a k-vector from the orhogonal basis to the original basis */
+    const std::array<Eigen::SparseMatrix<T, Eigen::ColMajor>,7>& transformationMatrices() {
+        static const std::array<Eigen::SparseMatrix<T, Eigen::ColMajor>,7> matrices = loadMatrices<T>();
+        return matrices;
+    }
+    /// \brief transformation matrices of the k-vectors from the original basis to the orthogonal basis, built on first use (thread-safe)
     template<typename T>
-    const std::array<Eigen::SparseMatrix<T, Eigen::ColMajor>,7> transformationMatricesInverse = loadMatricesInverse<T>(); /*!< set transformation matrices to transform a k-vector from the original basis to the orhogonal basis */
+    const std::array<Eigen::SparseMatrix<T, Eigen::ColMajor>,7>& transformationMatricesInverse() {
+        static const std::array<Eigen::SparseMatrix<T, Eigen::ColMajor>,7> matrices = loadMatricesInverse<T>();
+        return matrices;
+    }
 
 
     template<typename T>
-    Eigen::Matrix<T, Eigen::Dynamic, 1> diagonalMetric = []()->Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic>{Eigen::Matrix<T, Eigen::Dynamic, 1> tmp(6);tmp<<2.000000,-2.000000,1.000000,1.000000,1.000000,1.000000; return tmp;}();   /*!< defines the diagonal metric (stored as a vector) */
+    constexpr std::array<T, 6> diagonalMetric = {{2.000000,-2.000000,1.000000,1.000000,1.000000,1.000000}};   /*!< defines the diagonal metric (stored as a vector) */
 
 
 }  // namespace
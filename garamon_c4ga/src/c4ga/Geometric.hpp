@@ -92,7 +92,7 @@ namespace c4ga {
                                   currentGradeMv1 + 1, currentGradeMv2 + 1, currentGradeMv3,
                                   tmpSign, -complement,
                                   i, i << 1, indexLastVector_mv3,
-                                  diagonalMetric<T>(depth) * currentMetricCoefficient,
+                                  diagonalMetric<T>[depth] * currentMetricCoefficient,
                                   depth + 1); // scalar product part of the geometric product
                 }
 
@@ -20,6 +20,7 @@
 
 #include "c4ga/Mvec.hpp"
 #include "c4ga/Constants.hpp"
+#include "c4ga/KernelDispatch.hpp"
 
 
 /*!
@@ -523,9 +524,10 @@ namespace c4ga {
 
 
 	
+    /// \brief kernels of the geometric product per grades: geometricFunctionsContainer<T>[grade mv1 * mv2][grade mv1][grade mv2], constant-initialized
+    /// with the explicit kernels, that the kernel dispatch (KernelDispatch.hpp) replaces when the library is loaded.
     template<typename T>
-	std::array<std::array<std::array<std::function<void(const Eigen::Matrix<T, Eigen::Dynamic, 1> & , const Eigen::Matrix<T, Eigen::Dynamic, 1> & , Eigen::Matrix<T, Eigen::Dynamic, 1>&)>, 7>, 7>, 7> geometricFunctionsContainer =
-	{{
+	std::array<std::array<std::array<KernelEntry<T>, 7>, 7>, 7> geometricFunctionsContainer = {{
 		{{
 			{{{},{},{},{},{},{},{}}},
 			{{{},{},{},{},{},{},{}}},
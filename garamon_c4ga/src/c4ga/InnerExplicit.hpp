@@ -20,6 +20,7 @@
 #include "c4ga/Mvec.hpp"
 #include "c4ga/Inner.hpp"
 #include "c4ga/Constants.hpp"
+#include "c4ga/KernelDispatch.hpp"
 
 
 /*!
@@ -910,8 +911,10 @@ namespace c4ga {
 
 
 	
+    /// \brief kernels of the inner product per grades: innerFunctionsContainer<T>[grade mv1][grade mv2], constant-initialized
+    /// with the explicit kernels, that the kernel dispatch (KernelDispatch.hpp) replaces when the library is loaded.
     template<typename T>
-	std::array<std::array<std::function<void(const Eigen::Matrix<T, Eigen::Dynamic, 1> & , const Eigen::Matrix<T, Eigen::Dynamic, 1> & , Eigen::Matrix<T, Eigen::Dynamic, 1>&)>, 7>, 7> innerFunctionsContainer = {{
+	std::array<std::array<KernelEntry<T>, 7>, 7> innerFunctionsContainer = {{
 		{{inner_0_0<T>,inner_0_1<T>,inner_0_2<T>,inner_0_3<T>,inner_0_4<T>,inner_0_5<T>,inner_0_6<T>}},
 		{{inner_1_0<T>,inner_1_1<T>,inner_1_2<T>,inner_1_3<T>,inner_1_4<T>,inner_1_5<T>,inner_1_6<T>}},
 		{{inner_2_0<T>,inner_2_1<T>,inner_2_2<T>,inner_2_3<T>,inner_2_4<T>,inner_2_5<T>,inner_2_6<T>}},
@@ -0,0 +1,485 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// KernelDispatch.cpp
+// This file is part of the Garamon for c4ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file KernelDispatch.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Detection of the instruction sets of the processor and installation of the kernels in the function containers.
+
+
+#include "c4ga/KernelDispatch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+#include "c4ga/Mvec.hpp"
+
+
+namespace c4ga {
+
+    /// \cond DEV
+    namespace {
+
+        constexpr KernelIsa kernelIsas[] = {KernelIsa::baseline, KernelIsa::avx2};
+
+        /// \brief true if the processor (and the operating system) supports the instructions used by the kernels of isa
+        bool processorSupports(const KernelIsa isa) {
+            if(isa == KernelIsa::baseline) return true;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            int registers[4];
+            __cpuid(registers, 0);
+            if(registers[0] < 7) return false;
+            __cpuid(registers, 1);
+            const bool osxsave = registers[2] & (1 << 27), fma = registers[2] & (1 << 12);
+            if(!osxsave || !fma) return false;
+            const unsigned long long xcr0 = _xgetbv(0);
+            __cpuidex(registers, 7, 0);
+            return (registers[1] & (1 << 5)) && (xcr0 & 0x6) == 0x6;
+#else
+            return false;
+#endif
+        }
+
+        /// \brief the kernels of isa, the baseline has none
+        KernelTable kernelTable(const KernelIsa isa) {
+#ifdef C4GA_KERNEL_VARIANTS
+            if(isa == KernelIsa::avx2) return avx2KernelTable();
+#endif
+            return {nullptr, nullptr, 0};
+        }
+
+        const GradeKernel<float>* tableKernels(const KernelTable& table, float) { return table.floatKernels; }
+        const GradeKernel<double>* tableKernels(const KernelTable& table, double) { return table.doubleKernels; }
+
+        /// \brief the instruction set named by the environment variable C4GA_KERNEL_ISA if it is supported, the best one otherwise
+        KernelIsa initialKernelIsa() {
+            const char* name = std::getenv("C4GA_KERNEL_ISA");
+            if(name != nullptr)
+                for(const KernelIsa isa : kernelIsas)
+                    if(std::strcmp(name, kernelIsaName(isa)) == 0 && kernelIsaSupported(isa))
+                        return isa;
+            return bestKernelIsa();
+        }
+
+        /// \brief the active instruction set, initialized on first use (when the library is loaded)
+        std::atomic<KernelIsa>& activeIsa() {
+            static std::atomic<KernelIsa> isa(initialKernelIsa());
+            return isa;
+        }
+
+        /// \brief the kernel of the active instruction set for a product of grades (grade1, grade2, grade3), fallback if it has none
+        template<typename T>
+        ProductKernel<T>* activeKernel(const ProductKind product, const unsigned int grade1, const unsigned int grade2, const unsigned int grade3, ProductKernel<T>* fallback) {
+            const KernelTable table = kernelTable(activeIsa().load());
+            const GradeKernel<T>* kernels = tableKernels(table, T());
+            for(std::size_t k=0; k<table.size; ++k)
+                if(kernels[k].product == product && kernels[k].grade1 == grade1 && kernels[k].grade2 == grade2 && kernels[k].grade3 == grade3)
+                    return kernels[k].kernel;
+            return fallback;
+        }
+
+        template<typename T>
+        using Vector = Eigen::Matrix<T, Eigen::Dynamic, 1>;
+
+        constexpr KernelEngine kernelEngines[] = {KernelEngine::simd, KernelEngine::unrolled, KernelEngine::recursive};
+
+        const char* productName(const ProductKind product) {
+            switch(product){
+                case ProductKind::outer: return "outer";
+                case ProductKind::inner: return "inner";
+                default: return "geometric";
+            }
+        }
+
+        /// \brief a product of grades (grade1, grade2) with a result of grade grade3
+        struct ProductSlot {
+            ProductKind product;
+            unsigned int grade1;
+            unsigned int grade2;
+            unsigned int grade3;
+        };
+
+        /// \brief the entry of the function containers of T for a product
+        template<typename T>
+        KernelEntry<T>& containerEntry(const ProductSlot& slot) {
+            switch(slot.product){
+                case ProductKind::outer: return outerFunctionsContainer<T>[slot.grade1][slot.grade2];
+                case ProductKind::inner: return innerFunctionsContainer<T>[slot.grade1][slot.grade2];
+                default: return geometricFunctionsContainer<T>[slot.grade3][slot.grade1][slot.grade2];
+            }
+        }
+
+        /// \brief the products that have a kernel in the function containers
+        const std::vector<ProductSlot>& productSlots() {
+            static const std::vector<ProductSlot> slots = [](){
+                std::vector<ProductSlot> products;
+                for(unsigned int grade1=0; grade1<=algebraDimension; ++grade1)
+                    for(unsigned int grade2=0; grade2<=algebraDimension; ++grade2){
+                        if(grade1+grade2 <= algebraDimension)
+                            products.push_back({ProductKind::outer, grade1, grade2, grade1+grade2});
+                        products.push_back({ProductKind::inner, grade1, grade2, (unsigned int)std::abs((int)grade1-(int)grade2)});
+                        for(unsigned int grade3=0; grade3<=algebraDimension; ++grade3)
+                            if(geometricFunctionsContainer<double>[grade3][grade1][grade2])
+                                products.push_back({ProductKind::geometric, grade1, grade2, grade3});
+                    }
+                return products;
+            }();
+            return slots;
+        }
+
+        /// \brief the slot of a product, nullptr if it has no kernel
+        const ProductSlot* findSlot(const ProductKind product, const unsigned int grade1, const unsigned int grade2, const unsigned int grade3) {
+            for(const ProductSlot& slot : productSlots())
+                if(slot.product == product && slot.grade1 == grade1 && slot.grade2 == grade2 && slot.grade3 == grade3)
+                    return &slot;
+            return nullptr;
+        }
+
+        /// \brief engine of each product for T, simd (the explicit kernel when there is no SIMD kernel) until the products are tuned
+        template<typename T>
+        KernelEngine& productEngine(const ProductSlot& slot) {
+            static KernelEngine engines[3][algebraDimension+1][algebraDimension+1][algebraDimension+1] = {};
+            return engines[(int)slot.product][slot.grade1][slot.grade2][slot.grade3];
+        }
+
+        /// \brief the explicit kernel of a product: the initial entry of the function containers of T, which are copied when
+        /// this function is first called, by installKernel before it replaces any entry
+        template<typename T>
+        ProductKernel<T>* explicitKernel(const ProductSlot& slot) {
+            static const auto outerKernels = outerFunctionsContainer<T>;
+            static const auto innerKernels = innerFunctionsContainer<T>;
+            static const auto geometricKernels = geometricFunctionsContainer<T>;
+            switch(slot.product){
+                case ProductKind::outer: return outerKernels[slot.grade1][slot.grade2].load();
+                case ProductKind::inner: return innerKernels[slot.grade1][slot.grade2].load();
+                default: return geometricKernels[slot.grade3][slot.grade1][slot.grade2].load();
+            }
+        }
+
+        /// \brief the recursive function of the outer product of grades (grade1, grade2)
+        template<typename T, unsigned int grade1, unsigned int grade2>
+        void recursiveOuter(const Vector<T>& mv1, const Vector<T>& mv2, Vector<T>& mv3) {
+            C4GA_INSTRUMENT(instrumentation::countRecursiveFallback());
+            outerProductHomogeneous<T>(mv1, mv2, mv3, grade1, grade2, grade1 + grade2);
+        }
+
+        /// \brief the recursive function of the inner product of grades (grade1, grade2): a left or a right contraction
+        template<typename T, unsigned int grade1, unsigned int grade2>
+        void recursiveInner(const Vector<T>& mv1, const Vector<T>& mv2, Vector<T>& mv3) {
+            C4GA_INSTRUMENT(instrumentation::countRecursiveFallback());
+            if(grade1 <= grade2) leftContractionProductHomogeneous<T>(mv1, mv2, mv3, grade1, grade2, grade2 - grade1);
+            else rightContractionProductHomogeneous<T>(mv1, mv2, mv3, grade1, grade2, grade1 - grade2);
+        }
+
+        /// \brief the recursive function of a product, nullptr for the geometric product which has no per grades recursive
+        /// function. The functions of the grades (index / (algebraDimension+1), index % (algebraDimension+1)) are instantiated.
+        template<typename T, std::size_t... index>
+        ProductKernel<T>* recursiveKernel(const ProductSlot& slot, std::index_sequence<index...>) {
+            constexpr unsigned int grades = algebraDimension + 1;
+            ProductKernel<T>* const outerKernels[] = {recursiveOuter<T, index / grades, index % grades>...};
+            ProductKernel<T>* const innerKernels[] = {recursiveInner<T, index / grades, index % grades>...};
+            if(slot.product == ProductKind::outer) return outerKernels[slot.grade1 * grades + slot.grade2];
+            if(slot.product == ProductKind::inner) return innerKernels[slot.grade1 * grades + slot.grade2];
+            return nullptr;
+        }
+
+        /// \brief the kernel of a product computed by engine, nullptr if the engine has no kernel for this product
+        template<typename T>
+        ProductKernel<T>* engineKernel(const ProductSlot& slot, const KernelEngine engine) {
+            const unsigned int grade1 = slot.grade1, grade2 = slot.grade2, grade3 = slot.grade3;
+            ProductKernel<T>* const original = explicitKernel<T>(slot);
+            switch(engine){
+                case KernelEngine::unrolled:
+                    return original;
+                case KernelEngine::simd:
+                    if(activeKernel<T>(slot.product, grade1, grade2, grade3, original) == original) return nullptr;
+                    return activeKernel<T>(slot.product, grade1, grade2, grade3, original);
+                default:
+                    return recursiveKernel<T>(slot, std::make_index_sequence<(algebraDimension+1) * (algebraDimension+1)>());
+            }
+        }
+
+        /// \brief the engine whose kernel is used for a product: its engine, or unrolled when this engine has no kernel
+        template<typename T>
+        KernelEngine usedEngine(const ProductSlot& slot) {
+            const KernelEngine engine = productEngine<T>(slot);
+            if(engine != KernelEngine::unrolled && engineKernel<T>(slot, engine) == nullptr) return KernelEngine::unrolled;
+            return engine;
+        }
+
+        /// \brief put the kernel of the engine of a product in the function containers of T, in a single atomic store: the
+        /// products computed meanwhile by other threads use the previous or the new kernel
+        template<typename T>
+        void installKernel(const ProductSlot& slot) {
+            ProductKernel<T>* const kernel = engineKernel<T>(slot, productEngine<T>(slot));
+            containerEntry<T>(slot).store(kernel != nullptr ? kernel : explicitKernel<T>(slot));
+        }
+
+        /// \brief put the kernels of the active instruction set in the function containers of T
+        template<typename T>
+        void installKernels() {
+            for(const ProductSlot& slot : productSlots())
+                installKernel<T>(slot);
+        }
+
+        /// \brief nanoseconds per call of kernel, the best of several runs
+        template<typename T>
+        double kernelTime(ProductKernel<T>* const kernel, const Vector<T>& mv1, const Vector<T>& mv2, Vector<T>& mv3) {
+            constexpr unsigned int runs = 7, repetitions = 32;
+            double best = std::numeric_limits<double>::max();
+            for(unsigned int run=0; run<runs; ++run){
+                const auto start = std::chrono::steady_clock::now();
+                for(unsigned int r=0; r<repetitions; ++r) kernel(mv1, mv2, mv3);
+                best = std::min(best, std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+            }
+            return best / repetitions;
+        }
+
+        /// \brief true if kernel computes the same product as reference on (mv1, mv2)
+        template<typename T>
+        bool sameProduct(ProductKernel<T>* const kernel, ProductKernel<T>* const reference, const Vector<T>& mv1, const Vector<T>& mv2, const Eigen::Index size) {
+            Vector<T> result = Vector<T>::Zero(size), expected = Vector<T>::Zero(size);
+            kernel(mv1, mv2, result);
+            reference(mv1, mv2, expected);
+            return (result - expected).norm() <= T(1e-4) * (T(1) + expected.norm());
+        }
+
+        /// \brief time the engines of each product of T, and use the fastest one. The current engine is replaced only by a
+        /// kernel faster by 5%, the measures of close kernels are not reproducible.
+        template<typename T>
+        void tuneKernels() {
+            for(const ProductSlot& slot : productSlots()){
+                installKernel<T>(slot);
+                const Vector<T> mv1 = Vector<T>::Random(binomialArray[slot.grade1]);
+                const Vector<T> mv2 = Vector<T>::Random(binomialArray[slot.grade2]);
+                Vector<T> mv3 = Vector<T>::Zero(binomialArray[slot.grade3]);
+                ProductKernel<T>* const reference = explicitKernel<T>(slot);
+
+                KernelEngine bestEngine = usedEngine<T>(slot);
+                double bestTime = kernelTime<T>(engineKernel<T>(slot, bestEngine), mv1, mv2, mv3);
+                for(const KernelEngine engine : kernelEngines){
+                    ProductKernel<T>* const kernel = engineKernel<T>(slot, engine);
+                    if(engine == usedEngine<T>(slot) || kernel == nullptr || !sameProduct<T>(kernel, reference, mv1, mv2, mv3.size())) continue;
+                    const double time = kernelTime<T>(kernel, mv1, mv2, mv3);
+                    if(time < 0.95 * bestTime){
+                        bestEngine = engine;
+                        bestTime = time;
+                    }
+                }
+                productEngine<T>(slot) = bestEngine;
+                installKernel<T>(slot);
+            }
+        }
+
+        const char* typeName(float) { return "float"; }
+        const char* typeName(double) { return "double"; }
+
+        /// \brief append the engines of the products of T to a tuning file
+        template<typename T>
+        void writeEngines(std::ostream& file) {
+            for(const ProductSlot& slot : productSlots())
+                file << typeName(T()) << ' ' << productName(slot.product) << ' ' << slot.grade1 << ' ' << slot.grade2 << ' '
+                     << slot.grade3 << ' ' << kernelEngineName(usedEngine<T>(slot)) << '\n';
+        }
+
+        /// \brief an engine read from a tuning file
+        struct TunedEngine {
+            bool doublePrecision;
+            const ProductSlot* slot;
+            KernelEngine engine;
+        };
+
+        /// \brief true if engine has a kernel computing the product of slot for T, checked against the explicit kernel as
+        /// when the products are tuned: a tuning file can come from another build of the library
+        template<typename T>
+        bool verifiedEngine(const ProductSlot& slot, const KernelEngine engine) {
+            if(engine == KernelEngine::unrolled) return true;
+            ProductKernel<T>* const kernel = engineKernel<T>(slot, engine);
+            if(kernel == nullptr) return false;
+            ProductKernel<T>* const reference = explicitKernel<T>(slot);
+            const Vector<T> mv1 = Vector<T>::Random(binomialArray[slot.grade1]);
+            const Vector<T> mv2 = Vector<T>::Random(binomialArray[slot.grade2]);
+            return sameProduct<T>(kernel, reference, mv1, mv2, binomialArray[slot.grade3]);
+        }
+
+        /// \brief parse a line of a tuning file, false if it is not the engine of a product available for T
+        template<typename T>
+        bool readEngine(std::istringstream& line, const ProductSlot*& slot, KernelEngine& engine) {
+            std::string product, engineName;
+            unsigned int grade1, grade2, grade3;
+            if(!(line >> product >> grade1 >> grade2 >> grade3 >> engineName)) return false;
+            slot = nullptr;
+            for(const ProductKind kind : {ProductKind::outer, ProductKind::inner, ProductKind::geometric})
+                if(product == productName(kind)) slot = findSlot(kind, grade1, grade2, grade3);
+            if(slot == nullptr) return false;
+            for(const KernelEngine candidate : kernelEngines)
+                if(engineName == kernelEngineName(candidate)){
+                    engine = candidate;
+                    return verifiedEngine<T>(*slot, candidate);
+                }
+            return false;
+        }
+
+        constexpr const char* tuningFileHeader = "c4ga kernel tuning 1";
+
+        /// \brief serializes the functions that switch the kernels (the products do not take it)
+        std::mutex& dispatchMutex() {
+            static std::mutex mutex;
+            return mutex;
+        }
+    }
+    /// \endcond
+
+
+    const bool kernelsInstalled = [](){
+        std::lock_guard<std::mutex> lock(dispatchMutex());
+        installKernels<float>();
+        installKernels<double>();
+        return true;
+    }();
+
+
+    const char* kernelIsaName(const KernelIsa isa) {
+        switch(isa){
+            case KernelIsa::avx2: return "avx2";
+            default: return "baseline";
+        }
+    }
+
+    bool kernelIsaSupported(const KernelIsa isa) {
+#ifndef C4GA_KERNEL_VARIANTS
+        if(isa != KernelIsa::baseline) return false;
+#endif
+        return processorSupports(isa);
+    }
+
+    KernelIsa bestKernelIsa() {
+        KernelIsa best = KernelIsa::baseline;
+        for(const KernelIsa isa : kernelIsas)
+            if(kernelIsaSupported(isa)) best = isa;
+        return best;
+    }
+
+    KernelIsa activeKernelIsa() {
+        return activeIsa().load();
+    }
+
+    bool selectKernelIsa(const KernelIsa isa) {
+        if(!kernelIsaSupported(isa)) return false;
+        std::lock_guard<std::mutex> lock(dispatchMutex());
+        activeIsa().store(isa);
+        installKernels<float>();
+        installKernels<double>();
+        return true;
+    }
+
+    bool selectKernelIsa(const char* name) {
+        for(const KernelIsa isa : kernelIsas)
+            if(std::strcmp(name, kernelIsaName(isa)) == 0)
+                return selectKernelIsa(isa);
+        return false;
+    }
+
+
+    const char* kernelEngineName(const KernelEngine engine) {
+        switch(engine){
+            case KernelEngine::recursive: return "recursive";
+            case KernelEngine::simd: return "simd";
+            default: return "unrolled";
+        }
+    }
+
+    template<typename T>
+    KernelEngine kernelEngine(const ProductKind product, const unsigned int grade1, const unsigned int grade2, const unsigned int grade3) {
+        const ProductSlot* slot = findSlot(product, grade1, grade2, grade3);
+        if(slot == nullptr) return KernelEngine::unrolled;
+        std::lock_guard<std::mutex> lock(dispatchMutex());
+        return usedEngine<T>(*slot);
+    }
+
+    template KernelEngine kernelEngine<float>(ProductKind, unsigned int, unsigned int, unsigned int);
+    template KernelEngine kernelEngine<double>(ProductKind, unsigned int, unsigned int, unsigned int);
+
+    void tuneKernels() {
+        std::lock_guard<std::mutex> lock(dispatchMutex());
+        tuneKernels<float>();
+        tuneKernels<double>();
+    }
+
+    bool saveKernelTuning(const char* path) {
+        std::ofstream file(path);
+        if(!file) return false;
+        std::lock_guard<std::mutex> lock(dispatchMutex());
+        file << tuningFileHeader << '\n' << "isa " << kernelIsaName(activeKernelIsa()) << '\n';
+        writeEngines<float>(file);
+        writeEngines<double>(file);
+        return bool(file.flush());
+    }
+
+    bool loadKernelTuning(const char* path) {
+        std::ifstream file(path);
+        std::string header, isa;
+        std::lock_guard<std::mutex> lock(dispatchMutex());
+        if(!std::getline(file, header) || header != tuningFileHeader) return false;
+        if(!std::getline(file, isa) || isa != std::string("isa ") + kernelIsaName(activeKernelIsa())) return false;
+
+        // the whole file is checked before any kernel is changed
+        std::vector<TunedEngine> engines;
+        std::string text;
+        while(std::getline(file, text)){
+            if(text.empty()) continue;
+            std::istringstream line(text);
+            std::string type;
+            TunedEngine tuned;
+            line >> type;
+            tuned.doublePrecision = (type == "double");
+            if(type != "float" && type != "double") return false;
+            const bool valid = tuned.doublePrecision ? readEngine<double>(line, tuned.slot, tuned.engine) : readEngine<float>(line, tuned.slot, tuned.engine);
+            if(!valid) return false;
+            engines.push_back(tuned);
+        }
+        for(const TunedEngine& tuned : engines){
+            if(tuned.doublePrecision){
+                productEngine<double>(*tuned.slot) = tuned.engine;
+                installKernel<double>(*tuned.slot);
+            }else{
+                productEngine<float>(*tuned.slot) = tuned.engine;
+                installKernel<float>(*tuned.slot);
+            }
+        }
+        return true;
+    }
+
+    bool autotuneKernels(const char* path) {
+        if(path == nullptr) path = std::getenv("C4GA_KERNEL_TUNING");
+        if(path != nullptr && loadKernelTuning(path)) return true;
+        tuneKernels();
+        return path == nullptr || saveKernelTuning(path);
+    }
+
+
+}/// End of Namespace
@@ -0,0 +1,128 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// KernelDispatch.hpp
+// This file is part of the Garamon for c4ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file KernelDispatch.hpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Selection at run time of the instruction set of the product kernels.
+///
+/// The library contains the SIMD kernels (see SimdExplicit.hpp) compiled for several instruction sets. When the library is
+/// loaded, the kernels of the best instruction set supported by the processor replace the explicit kernels of the function
+/// containers for float and double, or those of the instruction set named by the environment variable C4GA_KERNEL_ISA
+/// (baseline or avx2) when the processor supports it. The baseline instruction set uses the explicit kernels.
+/// Switching the kernels (selectKernelIsa, and the tuning below) is thread-safe: each entry of the function containers is
+/// an atomic function pointer (KernelEntry), a product computed meanwhile by another thread uses the previous or the new
+/// kernel. The switching functions are serialized.
+///
+/// The kernel of each product can also be tuned on the host: autotuneKernels times the SIMD, explicit and recursive
+/// versions of each product and keeps the fastest one, with a cache file so that the tuning is done once per machine.
+
+
+#ifndef C4GA_KERNEL_DISPATCH_HPP__
+#define C4GA_KERNEL_DISPATCH_HPP__
+#pragma once
+
+#include <cstddef>
+
+#include "c4ga/SimdExplicit.hpp"
+
+
+/*!
+ * @namespace c4ga
+ */
+namespace c4ga {
+
+    /// \brief instruction sets the kernels of the library are compiled for
+    enum class KernelIsa { baseline, avx2 };
+
+    /// \brief name of an instruction set, as used by the environment variable C4GA_KERNEL_ISA
+    const char* kernelIsaName(KernelIsa isa);
+
+    /// \brief true if the library contains the kernels of isa and the processor supports it
+    bool kernelIsaSupported(KernelIsa isa);
+
+    /// \brief the fastest instruction set supported by the library and the processor
+    KernelIsa bestKernelIsa();
+
+    /// \brief the instruction set of the kernels currently used by the products
+    KernelIsa activeKernelIsa();
+
+    /// \brief use the kernels of isa in the products of float and double multivectors.
+    /// Each kernel of the function containers is replaced atomically: a product computed meanwhile by another thread uses the
+    /// previous or the new kernel.
+    /// \return false if isa is not supported (see kernelIsaSupported), the kernels are then unchanged
+    bool selectKernelIsa(KernelIsa isa);
+
+    /// \brief selectKernelIsa with the name of an instruction set (see kernelIsaName)
+    /// \return false if name is not an instruction set or if it is not supported
+    bool selectKernelIsa(const char* name);
+
+    /// \brief implementations of the per grades products: the SIMD kernel of the active instruction set (the explicit kernel
+    /// when the product has none), the explicit kernel, or the recursive function (outer product and contractions only)
+    enum class KernelEngine { simd, unrolled, recursive };
+
+    /// \brief name of an engine, as used in the tuning files
+    const char* kernelEngineName(KernelEngine engine);
+
+    /// \brief the engine used by the product of grades (grade1, grade2) with a result of grade grade3, for float or double
+    template<typename T>
+    KernelEngine kernelEngine(ProductKind product, unsigned int grade1, unsigned int grade2, unsigned int grade3);
+
+    /// \brief time every engine of every product, for float and double, and use the fastest one. A product keeps its engine
+    /// unless another one is faster by 5%. The recursive functions are checked against the explicit kernels before being timed.
+    /// The engines are kept by selectKernelIsa, a product whose engine has no kernel in the new instruction set uses its
+    /// explicit kernel. Like selectKernelIsa, it replaces each kernel atomically, the products of other threads are timed
+    /// with the kernels and make the measures less accurate.
+    void tuneKernels();
+
+    /// \brief write the engines of the products, and the active instruction set, to a text file
+    /// \return false if the file could not be written
+    bool saveKernelTuning(const char* path);
+
+    /// \brief use the engines of a file written by saveKernelTuning
+    /// \return false, without changing any kernel, if the file cannot be read, was written by another algebra or for another
+    /// instruction set, or names an engine that is not available or does not compute the product of its explicit kernel (each
+    /// engine read is checked as by tuneKernels). Like selectKernelIsa, it replaces each kernel atomically.
+    bool loadKernelTuning(const char* path);
+
+    /// \brief load the tuning file path, or tune the products and save the result to path when it cannot be loaded. When
+    /// path is nullptr, the file named by the environment variable C4GA_KERNEL_TUNING is used if it is set, otherwise the
+    /// products are tuned and nothing is saved. Meant to be called once at the start of a program, when the other threads do
+    /// not disturb the measures of tuneKernels.
+    /// \return false if the tuning could not be saved
+    bool autotuneKernels(const char* path = nullptr);
+
+
+    /// \cond DEV
+    /// \brief true once KernelDispatch.cpp, when the library is loaded, has put the kernels of the active instruction set in
+    /// the function containers. Every translation unit including the containers refers to it, so that the linker keeps the
+    /// kernel dispatch in the programs that only use the templates (static library, or --as-needed).
+    extern const bool kernelsInstalled;
+
+#if defined(__GNUC__)
+    namespace {
+        __attribute__((used)) const bool* const kernelDispatchLink = &kernelsInstalled;
+    }
+#elif defined(_MSC_VER)
+#pragma comment(linker, "/include:?kernelsInstalled@c4ga@@3_NB")
+#endif
+
+    /// \brief the SIMD kernels of an instruction set, in the order of simdKernels()
+    struct KernelTable {
+        const GradeKernel<float>* floatKernels;
+        const GradeKernel<double>* doubleKernels;
+        std::size_t size;
+    };
+
+    /// \brief kernels of the translation unit compiled for AVX2 (KernelsAvx2.cpp)
+    KernelTable avx2KernelTable();
+    /// \endcond
+
+}/// End of Namespace
+
+#endif // C4GA_KERNEL_DISPATCH_HPP__
@@ -13,10 +13,20 @@
 /// \brief Python bindings using pybind11.
 
 #include "c4ga/Mvec.hpp"
+#include "c4ga/Batch.hpp"
+#include "c4ga/MvecArray.hpp"
+#include "c4ga/Serialization.hpp"
+#include "c4ga/KernelDispatch.hpp"
+#include "c4ga/Conformal.hpp"
 
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/iostream.h>
+#include <pybind11/numpy.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
 
 namespace py = pybind11;
 
@@ -26,6 +36,444 @@ namespace py = pybind11;
  */
 namespace c4ga {
 
+/// NumPy array of coefficients, converted to a C-contiguous array of T if required
+template <typename T>
+using DenseArray = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+/// \brief copy the coefficients of a multivector into a new NumPy array of multivectorSize elements ordered by grade.
+template <typename T>
+py::array_t<T> mvecToArray(const Mvec<T>& mv) {
+  py::array_t<T> array((py::ssize_t)multivectorSize);
+  mv.toDense(array.mutable_data());
+  return array;
+}
+
+/// \brief check that the last dimension of a NumPy array holds the coefficients of full multivectors.
+void checkDenseArray(const py::array& array, const py::ssize_t ndim) {
+  if (array.ndim() != ndim || array.shape(ndim - 1) != (py::ssize_t)multivectorSize)
+    throw std::invalid_argument("expected an array of shape " +
+                                std::string(ndim == 2 ? "(N, " : "(") +
+                                std::to_string(multivectorSize) + ")");
+}
+
+/// \brief view on the multivectors of an array of shape (N, multivector_size), or
+/// (multivector_size,) for a single multivector repeated over the whole batch.
+template <typename T>
+BatchView<const T> batchView(const DenseArray<T>& array) {
+  if (array.ndim() == 1) {
+    checkDenseArray(array, 1);
+    return broadcastBatch(array.data());
+  }
+  checkDenseArray(array, 2);
+  return aosBatch(array.data());
+}
+
+/// \brief number of multivectors processed by a batch operation
+template <typename T>
+py::ssize_t batchCount(const DenseArray<T>& mv1, const DenseArray<T>& mv2) {
+  if (mv1.ndim() == 2 && mv2.ndim() == 2 && mv1.shape(0) != mv2.shape(0))
+    throw std::invalid_argument("the operands do not contain the same number of multivectors");
+  // the size of a batch operand, even 0: an empty batch with a single multivector gives an empty result
+  if (mv1.ndim() == 2) return mv1.shape(0);
+  if (mv2.ndim() == 2) return mv2.shape(0);
+  return 1;
+}
+
+/// \brief result of a batch operation: a single multivector when no operand is a batch
+template <typename T>
+py::array_t<T> batchResult(const py::ssize_t count, const bool single) {
+  if (single) return py::array_t<T>((py::ssize_t)multivectorSize);
+  return py::array_t<T>(std::vector<py::ssize_t>{count, (py::ssize_t)multivectorSize});
+}
+
+/// \brief run a batch function on two operands without holding the GIL
+template <typename T, typename Function>
+py::array_t<T> binaryBatch(const DenseArray<T>& mv1, const DenseArray<T>& mv2, Function function) {
+  const BatchView<const T> view1 = batchView(mv1), view2 = batchView(mv2);
+  const py::ssize_t count = batchCount(mv1, mv2);
+  py::array_t<T> result = batchResult<T>(count, mv1.ndim() == 1 && mv2.ndim() == 1);
+  const BatchView<T> view3 = aosBatch(result.mutable_data());
+  {
+    py::gil_scoped_release release;
+    function(view1, view2, view3, (std::size_t)count);
+  }
+  return result;
+}
+
+/// \brief run a batch function on one operand without holding the GIL
+template <typename T, typename Function>
+py::array_t<T> unaryBatch(const DenseArray<T>& mv, Function function) {
+  const BatchView<const T> view = batchView(mv);
+  const py::ssize_t count = mv.ndim() == 2 ? mv.shape(0) : 1;
+  py::array_t<T> result = batchResult<T>(count, mv.ndim() == 1);
+  const BatchView<T> resultView = aosBatch(result.mutable_data());
+  {
+    py::gil_scoped_release release;
+    function(view, resultView, (std::size_t)count);
+  }
+  return result;
+}
+
+/// \brief decode an object encoded by serialize (see Serialization.hpp)
+template <typename Object>
+Object deserializeBytes(const py::bytes& data) {
+  Object object;
+  if (!deserialize(std::string(data), object))
+    throw std::invalid_argument("the data is not a serialized " + std::string(py::type_id<Object>()));
+  return object;
+}
+
+/// \brief bind Mvec<T> as the Python class name
+template <typename T>
+py::class_<Mvec<T>> bindMvec(py::module& m, const char* name) {
+
+  // Class definition
+  auto mvec = py::class_<Mvec<T>>(m, name);
+  // Constructors
+  mvec.def(py::init<>());
+  // Get/Set
+  mvec.def("__setitem__",
+           [](Mvec<T>& mv, int idx, T value) { mv[idx] = value; });
+  mvec.def("__getitem__",
+           [](Mvec<T>& mv, int idx) { return mv[idx]; });
+  // Operators
+  mvec.def(py::self + py::self)
+      .def(py::self + float())
+      .def(float() + py::self)
+      .def(py::self += py::self)
+      .def(py::self - py::self)
+      .def(py::self - float())
+      .def(float() - py::self)
+      .def(py::self -= py::self)
+      .def(py::self * py::self)
+      .def(py::self * float())
+      .def(float() * py::self)
+      .def(py::self *= py::self)
+      .def(py::self / py::self)
+      .def(py::self / float())
+      .def(float() / py::self)
+      .def(py::self /= py::self)
+      .def(py::self < py::self)
+      .def(py::self < float())
+      .def(float() < py::self)
+      .def(py::self > py::self)
+      .def(py::self > float())
+      .def(float() > py::self)
+      .def("__invert__",
+           [](const Mvec<T>& a) { return ~a; })
+      .def("__eq__",
+           [](Mvec<T>& a, const Mvec<T>& b) { return a == b; })
+      .def("__neq__",
+           [](Mvec<T>& a, const Mvec<T>& b) { return a != b; })
+      .def("__or__",
+           [](const Mvec<T>& a, const Mvec<T>& b) { return a | b; })
+      .def("__or__",
+           [](const Mvec<T>& a, T b) { return a | b; })
+      .def("__ror__",
+           [](const Mvec<T>& a, T b) { return a | b; })
+      .def("__ior__",
+           [](Mvec<T>& a, const Mvec<T>& b) { a |= b; return a; })
+      .def("__xor__",
+           [](const Mvec<T>& a, const Mvec<T>& b) { return a ^ b; })
+      .def("__xor__",
+           [](const Mvec<T>& a, T b) { return a ^ b; })
+      .def("__rxor__",
+           [](const Mvec<T>& a, T b) { return a ^ b; })
+      .def("__ixor__",
+           [](Mvec<T>& a, const Mvec<T>& b) { a ^= b; return a; });
+
+  // Print
+  mvec.def("__repr__",
+           [](const Mvec<T>& mv) {
+             std::stringstream ss;
+             ss << mv;
+             return ss.str();
+           })
+      .def("norm", &Mvec<T>::norm)
+      .def("quadratic_norm", &Mvec<T>::quadraticNorm)
+      .def("reverse", &Mvec<T>::reverse)
+      .def("display", &Mvec<T>::display,
+        py::call_guard<py::scoped_ostream_redirect,
+                       py::scoped_estream_redirect>());
+
+
+  mvec.def("outer_primal_dual", &Mvec<T>::outerPrimalDual);
+  mvec.def("outer_dual_primal", &Mvec<T>::outerDualPrimal);
+  mvec.def("outer_dual_dual", &Mvec<T>::outerDualDual);
+  mvec.def("dual", &Mvec<T>::dual);
+
+
+  mvec.def("scalar_product", &Mvec<T>::scalarProduct);
+  mvec.def("dot_product", &Mvec<T>::dotProduct);
+  mvec.def("inv", &Mvec<T>::inv);
+
+  mvec.def("grades", &Mvec<T>::grades);
+  mvec.def("grade", [](const Mvec<T>& a){return a.grade();});
+  mvec.def("grade", [](const Mvec<T>& a, const int i){return a.grade(i);});
+  mvec.def("clear", &Mvec<T>::clear);
+
+
+  // NumPy interoperability: a multivector is exchanged as a dense array of
+  // multivector_size coefficients ordered by grade, the k-vector part
+  // starting at per_grade_starting_index[k].
+  mvec.def(py::init([](const DenseArray<T>& coefficients) {
+             checkDenseArray(coefficients, 1);
+             Mvec<T> mv;
+             mv.fromDense(coefficients.data());
+             return mv;
+           }), py::arg("coefficients"));
+  mvec.def("to_array", &mvecToArray<T>);
+  mvec.def("__array__",
+           [](const Mvec<T>& mv, py::object dtype, py::object copy) {
+             py::array array = mvecToArray(mv);
+             if (!dtype.is_none()) return array.attr("astype")(dtype).template cast<py::array>();
+             return array;
+           }, py::arg("dtype") = py::none(), py::arg("copy") = py::none());
+  mvec.def("grade_array",
+           [](const Mvec<T>& mv, const unsigned int k) {
+             if (k > algebraDimension) throw py::index_error("grade out of range");
+             // a copy: the k-vectors are list nodes that clear, the products and the assignments free
+             std::vector<T> dense(multivectorSize);
+             mv.toDense(dense.data());
+             return py::array_t<T>((py::ssize_t)binomialArray[k], dense.data() + perGradeStartingIndex[k]);
+           }, "copy of the k-vector part (zeros if the multivector has no such grade), "
+              "see set_grade_array to change it");
+  mvec.def("set_grade_array",
+           [](Mvec<T>& mv, const unsigned int k, const DenseArray<T>& kvector) {
+             if (k > algebraDimension) throw py::index_error("grade out of range");
+             if (kvector.size() != (py::ssize_t)binomialArray[k])
+               throw std::invalid_argument("expected " + std::to_string(binomialArray[k]) + " coefficients");
+             mv.clear(k);
+             if (std::any_of(kvector.data(), kvector.data() + kvector.size(), [](T v) { return v != T(0); })) {
+               auto it = mv.createVectorXdIfDoesNotExist(k);
+               std::copy(kvector.data(), kvector.data() + kvector.size(), it->vec.data());
+             }
+           });
+
+  // Serialization: pickling and compact binary encoding (grade bitmap and packed coefficients)
+  mvec.def("to_bytes", [](const Mvec<T>& mv) { return py::bytes(serialize(mv)); });
+  mvec.def_static("from_bytes", &deserializeBytes<Mvec<T>>, py::arg("data"));
+  mvec.def(py::pickle([](const Mvec<T>& mv) { return py::bytes(serialize(mv)); },
+                      &deserializeBytes<Mvec<T>>));
+
+  return mvec;
+}
+
+/// \brief bind the module functions working on arrays of T. The float and double
+/// overloads are chosen from the dtype of the arrays, other inputs are converted to float64.
+template <typename T>
+void bindArrayFunctions(py::module& m) {
+
+  // conversions between (N, multivector_size) arrays and lists of multivectors
+  m.def("array_to_mvecs", [](const DenseArray<T>& array) {
+    checkDenseArray(array, 2);
+    py::list mvecs(array.shape(0));
+    for (py::ssize_t i = 0; i < array.shape(0); ++i) {
+      Mvec<T> mv;
+      mv.fromDense(array.data(i, 0));
+      mvecs[(size_t)i] = py::cast(std::move(mv));
+    }
+    return mvecs;
+  });
+
+  // batch operations on (N, multivector_size) arrays, a (multivector_size,)
+  // array being broadcast over the batch. They release the GIL and use all
+  // the cores when the library is built with OpenMP.
+  using View = BatchView<const T>;
+  using ResultView = BatchView<T>;
+  m.def("geometric_product", [](const DenseArray<T>& a, const DenseArray<T>& b) {
+    return binaryBatch(a, b, [](View v1, View v2, ResultView v3, std::size_t n) {
+      geometricProductBatch(v1, v2, v3, n);
+    });
+  }, "batch version of a * b");
+  m.def("outer_product", [](const DenseArray<T>& a, const DenseArray<T>& b) {
+    return binaryBatch(a, b, [](View v1, View v2, ResultView v3, std::size_t n) {
+      outerProductBatch(v1, v2, v3, n);
+    });
+  }, "batch version of a ^ b");
+  m.def("inner_product", [](const DenseArray<T>& a, const DenseArray<T>& b) {
+    return binaryBatch(a, b, [](View v1, View v2, ResultView v3, std::size_t n) {
+      innerProductBatch(v1, v2, v3, n, InnerKind::inner);
+    });
+  }, "batch version of a | b");
+  m.def("left_contraction", [](const DenseArray<T>& a, const DenseArray<T>& b) {
+    return binaryBatch(a, b, [](View v1, View v2, ResultView v3, std::size_t n) {
+      innerProductBatch(v1, v2, v3, n, InnerKind::leftContraction);
+    });
+  }, "batch version of a < b");
+  m.def("right_contraction", [](const DenseArray<T>& a, const DenseArray<T>& b) {
+    return binaryBatch(a, b, [](View v1, View v2, ResultView v3, std::size_t n) {
+      innerProductBatch(v1, v2, v3, n, InnerKind::rightContraction);
+    });
+  }, "batch version of a > b");
+  m.def("apply_versor", [](const DenseArray<T>& versor, const DenseArray<T>& x) {
+    return binaryBatch(versor, x, [](View v1, View v2, ResultView v3, std::size_t n) {
+      applyVersorBatch(v1, v2, v3, n);
+    });
+  }, "batch version of versor * x * versor.inv()");
+  m.def("dual", [](const DenseArray<T>& a) {
+    return unaryBatch(a, [](View v1, ResultView v2, std::size_t n) {
+      dualBatch(v1, v2, n);
+    });
+  }, "batch version of a.dual()");
+  m.def("reverse", [](const DenseArray<T>& a) {
+    return unaryBatch(a, [](View v1, ResultView v2, std::size_t n) {
+      reverseBatch(v1, v2, n);
+    });
+  }, "batch version of a.reverse()");
+  m.def("norm", [](const DenseArray<T>& a) -> py::object {
+    const View view = batchView(a);
+    const py::ssize_t count = a.ndim() == 2 ? a.shape(0) : 1;
+    py::array_t<T> norms(count);
+    T* data = norms.mutable_data();
+    {
+      py::gil_scoped_release release;
+      normBatch(view, data, (std::size_t)count);
+    }
+    if (a.ndim() == 1) return py::float_(data[0]);
+    return std::move(norms);
+  }, "batch version of a.norm()");
+}
+
+/// \brief copy a sequence of multivectors of the same precision into an (N, multivector_size) array
+template <typename T>
+py::array mvecsToArray(const py::sequence& mvecs) {
+  const py::ssize_t count = (py::ssize_t)py::len(mvecs);
+  py::array_t<T> array(std::vector<py::ssize_t>{count, (py::ssize_t)multivectorSize});
+  T* data = array.mutable_data();
+  for (py::ssize_t i = 0; i < count; ++i)
+    mvecs[(size_t)i].template cast<const Mvec<T>&>().toDense(data + i * multivectorSize);
+  return std::move(array);
+}
+
+/// \brief define the operator name of MvecArray<T> between arrays, single multivectors (broadcast over
+/// the array) and scalars, together with its reflected version rname (if any) and the Mvec operator taking an array.
+template <typename T, typename Operation>
+void defArrayOperator(py::class_<MvecArray<T>>& array, py::class_<Mvec<T>>& mvec,
+                      const char* name, const char* rname, Operation operation) {
+  using Array = MvecArray<T>;
+  array.def(name, [operation](const Array& a, const Array& b) { return operation(a, b); },
+            py::is_operator(), py::call_guard<py::gil_scoped_release>());
+  array.def(name, [operation](const Array& a, const Mvec<T>& b) { return operation(a, Array(b)); },
+            py::is_operator(), py::call_guard<py::gil_scoped_release>());
+  array.def(name, [operation](const Array& a, const T b) { return operation(a, Array(Mvec<T>(b))); },
+            py::is_operator(), py::call_guard<py::gil_scoped_release>());
+  if (rname != nullptr)
+    array.def(rname, [operation](const Array& a, const T b) { return operation(Array(Mvec<T>(b)), a); },
+              py::is_operator(), py::call_guard<py::gil_scoped_release>());
+  mvec.def(name, [operation](const Mvec<T>& a, const Array& b) { return operation(Array(a), b); },
+           py::is_operator(), py::call_guard<py::gil_scoped_release>());
+}
+
+/// \brief bind MvecArray<T> as the Python class name, mvec being the binding of Mvec<T>
+template <typename T>
+py::class_<MvecArray<T>> bindMvecArray(py::module& m, const char* name, py::class_<Mvec<T>>& mvec) {
+  using Array = MvecArray<T>;
+
+  auto array = py::class_<Array>(m, name,
+      "multivectors stored as a structure of arrays. The operators work element-wise, "
+      "single multivectors (Mvec or arrays of one element) and scalars being broadcast.");
+  // Constructors
+  array.def(py::init<std::size_t>(), py::arg("count"));
+  array.def(py::init<const Mvec<T>&>(), py::arg("mv"));
+  array.def(py::init([](const py::list& mvecs) {
+              Array result((std::size_t)py::len(mvecs));
+              for (std::size_t i = 0; i < result.size(); ++i)
+                result.set(i, mvecs[i].template cast<const Mvec<T>&>());
+              return result;
+            }), py::arg("mvecs"));
+  array.def(py::init([](const DenseArray<T>& coefficients) {
+              checkDenseArray(coefficients, 2);
+              return Array::fromDense(coefficients.data(), (std::size_t)coefficients.shape(0));
+            }), py::arg("coefficients"), "from an array of shape (N, multivector_size)");
+  array.def_static("from_vectors", [](const DenseArray<T>& coordinates) {
+    if (coordinates.ndim() != 2 || coordinates.shape(1) != (py::ssize_t)algebraDimension)
+      throw std::invalid_argument("expected an array of shape (N, " + std::to_string(algebraDimension) + ")");
+    return Array::fromVectors(coordinates.data(), (std::size_t)coordinates.shape(0));
+  }, py::arg("coordinates"), "vectors from their coordinates on the basis vectors");
+
+  // Get/Set
+  array.def("__len__", &Array::size);
+  array.def("__getitem__", [](const Array& a, py::ssize_t i) {
+    if (i < 0) i += (py::ssize_t)a.size();
+    if (i < 0 || i >= (py::ssize_t)a.size()) throw py::index_error("MvecArray index out of range");
+    return a.at((std::size_t)i);
+  });
+  array.def("__setitem__", [](Array& a, py::ssize_t i, const Mvec<T>& mv) {
+    if (i < 0) i += (py::ssize_t)a.size();
+    if (i < 0 || i >= (py::ssize_t)a.size()) throw py::index_error("MvecArray index out of range");
+    a.set((std::size_t)i, mv);
+  });
+  array.def("to_array", [](const Array& a) {
+    py::array_t<T> result(std::vector<py::ssize_t>{(py::ssize_t)a.size(), (py::ssize_t)multivectorSize});
+    a.toDense(result.mutable_data());
+    return result;
+  }, "copy into an array of shape (N, multivector_size)");
+  array.def_property_readonly("coefficients", [](py::object self) {
+    Array& a = self.cast<Array&>();
+    // the array shares the memory of the MvecArray, self is kept alive by the array
+    return py::array_t<T>(std::vector<py::ssize_t>{(py::ssize_t)multivectorSize, (py::ssize_t)a.size()}, a.data(), self);
+  }, "view (without copy) of the coefficients, of shape (multivector_size, N)");
+  array.def("__repr__", [name](const Array& a) {
+    return std::string(name) + " of " + std::to_string(a.size()) + " multivectors";
+  });
+
+  // Operators
+  defArrayOperator(array, mvec, "__add__", "__radd__", [](const Array& a, const Array& b) { return a + b; });
+  defArrayOperator(array, mvec, "__sub__", "__rsub__", [](const Array& a, const Array& b) { return a - b; });
+  defArrayOperator(array, mvec, "__mul__", "__rmul__", [](const Array& a, const Array& b) { return a * b; });
+  defArrayOperator(array, mvec, "__xor__", "__rxor__", [](const Array& a, const Array& b) { return a ^ b; });
+  defArrayOperator(array, mvec, "__or__", "__ror__", [](const Array& a, const Array& b) { return a | b; });
+  // Python reflects a < b into b > a, which is not the same contraction: no reflected versions
+  defArrayOperator(array, mvec, "__lt__", nullptr, [](const Array& a, const Array& b) { return a < b; });
+  defArrayOperator(array, mvec, "__gt__", nullptr, [](const Array& a, const Array& b) { return a > b; });
+  array.def("__neg__", [](const Array& a) { return -a; }, py::call_guard<py::gil_scoped_release>());
+  array.def("__invert__", [](const Array& a) { return ~a; }, py::call_guard<py::gil_scoped_release>());
+  array.def("reverse", &Array::reverse, py::call_guard<py::gil_scoped_release>());
+  array.def("dual", &Array::dual, py::call_guard<py::gil_scoped_release>());
+  array.def("grade", &Array::grade, py::arg("k"), py::call_guard<py::gil_scoped_release>());
+  array.def("norm", [](const Array& a) {
+    py::array_t<T> norms((py::ssize_t)a.size());
+    T* data = norms.mutable_data();
+    {
+      py::gil_scoped_release release;
+      a.norm(data);
+    }
+    return norms;
+  });
+
+  // Serialization: pickling and compact binary encoding (grade bitmap and packed rows of coefficients)
+  array.def("to_bytes", [](const Array& a) { return py::bytes(serialize(a)); });
+  array.def_static("from_bytes", &deserializeBytes<Array>, py::arg("data"));
+  array.def(py::pickle([](const Array& a) { return py::bytes(serialize(a)); },
+                       &deserializeBytes<Array>));
+
+  return array;
+}
+
+/// \brief add the conversions between Euclidean points and conformal points to the binding of MvecArray<T>
+template <typename T>
+void bindConformalPoints(py::class_<MvecArray<T>>& array) {
+  array.def_static("from_points", [](const DenseArray<T>& points) {
+    if (points.ndim() != 2 || points.shape(1) != (py::ssize_t)euclideanDimension)
+      throw std::invalid_argument("expected an array of shape (N, " + std::to_string(euclideanDimension) + ")");
+    MvecArray<T> result((std::size_t)points.shape(0));
+    {
+      py::gil_scoped_release release;
+      upBatch(points.data(), result.view(), result.size());
+    }
+    return result;
+  }, py::arg("points"), "conformal points e0 + x + 0.5 |x|^2 ei of Euclidean points given as an array of shape (N, euclidean_dimension)");
+  array.def("to_points", [](const MvecArray<T>& a) {
+    py::array_t<T> points(std::vector<py::ssize_t>{(py::ssize_t)a.size(), (py::ssize_t)euclideanDimension});
+    {
+      py::gil_scoped_release release;
+      downBatch(a.view(), points.mutable_data(), a.size());
+    }
+    return points;
+  }, "Euclidean coordinates of conformal points, normalized by their e0 coefficient");
+}
+
 PYBIND11_MODULE(c4ga_py, m) {
 
   m.attr("E0") = 1;
@@ -163,90 +611,71 @@ m.def("e01234i", &e01234i<double>);
   m.def("I", &I<double>);
 
 
-  // Class definition
-  auto mvec = py::class_<Mvec<double>>(m, "Mvec");
-  // Constructors
-  mvec.def(py::init<>());
-  // Get/Set
-  mvec.def("__setitem__",
-           [](Mvec<double>& mv, int idx, double value) { mv[idx] = value; });
-  mvec.def("__getitem__",
-           [](Mvec<double>& mv, int idx) { return mv[idx]; });
-  // Operators
-  mvec.def(py::self + py::self)
-      .def(py::self + float())
-      .def(float() + py::self)
-      .def(py::self += py::self)
-      .def(py::self - py::self)
-      .def(py::self - float())
-      .def(float() - py::self)
-      .def(py::self -= py::self)
-      .def(py::self * py::self)
-      .def(py::self * float())
-      .def(float() * py::self)
-      .def(py::self *= py::self)
-      .def(py::self / py::self)
-      .def(py::self / float())
-      .def(float() / py::self)
-      .def(py::self /= py::self)
-      .def(py::self < py::self)
-      .def(py::self < float())
-      .def(float() < py::self)
-      .def(py::self > py::self)
-      .def(py::self > float())
-      .def(float() > py::self)
-      .def("__invert__",
-           [](const Mvec<double>& a) { return ~a; })
-      .def("__eq__",
-           [](Mvec<double>& a, const Mvec<double>& b) { return a == b; })
-      .def("__neq__",
-           [](Mvec<double>& a, const Mvec<double>& b) { return a != b; })
-      .def("__or__",
-           [](const Mvec<double>& a, const Mvec<double>& b) { return a | b; })
-      .def("__or__",
-           [](const Mvec<double>& a, double b) { return a | b; })
-      .def("__ror__",
-           [](const Mvec<double>& a, double b) { return a | b; })
-      .def("__ior__",
-           [](Mvec<double>& a, const Mvec<double>& b) { a |= b; return a; })
-      .def("__xor__",
-           [](const Mvec<double>& a, const Mvec<double>& b) { return a ^ b; })
-      .def("__xor__",
-           [](const Mvec<double>& a, double b) { return a ^ b; })
-      .def("__rxor__",
-           [](const Mvec<double>& a, double b) { return a ^ b; })
-      .def("__ixor__",
-           [](Mvec<double>& a, const Mvec<double>& b) { a ^= b; return a; });
-
-  // Print
-  mvec.def("__repr__",
-           [](const Mvec<double>& mv) {
-             std::stringstream ss;
-             ss << mv;
-             return ss.str();
-           })
-      .def("norm", &Mvec<double>::norm)
-      .def("quadratic_norm", &Mvec<double>::quadraticNorm)
-      .def("reverse", &Mvec<double>::reverse)
-      .def("display", &Mvec<double>::display,
-        py::call_guard<py::scoped_ostream_redirect,
-                       py::scoped_estream_redirect>());
+  // Mvec<double> and its single-precision counterpart MvecF
+  auto mvec = bindMvec<double>(m, "Mvec");
+  auto mvecf = bindMvec<float>(m, "MvecF");
 
+  // explicit conversions between precisions
+  mvec.def(py::init<const Mvec<float>&>(), py::arg("mv"));
+  mvecf.def(py::init<const Mvec<double>&>(), py::arg("mv"));
+  mvec.def("to_float32", [](const Mvec<double>& mv) { return Mvec<float>(mv); });
+  mvec.def("to_float64", [](const Mvec<double>& mv) { return mv; });
+  mvecf.def("to_float32", [](const Mvec<float>& mv) { return mv; });
+  mvecf.def("to_float64", [](const Mvec<float>& mv) { return Mvec<double>(mv); });
 
-  mvec.def("outer_primal_dual", &Mvec<double>::outerPrimalDual);
-  mvec.def("outer_dual_primal", &Mvec<double>::outerDualPrimal);
-  mvec.def("outer_dual_dual", &Mvec<double>::outerDualDual);
-  mvec.def("dual", &Mvec<double>::dual);
+  // arrays of multivectors with element-wise operators
+  auto mvecArray = bindMvecArray<double>(m, "MvecArray", mvec);
+  auto mvecArrayF = bindMvecArray<float>(m, "MvecArrayF", mvecf);
+  mvecArray.def(py::init([](const MvecArray<float>& array) {
+                  MvecArray<double> result(array.size());
+                  std::copy(array.data(), array.data() + multivectorSize * array.size(), result.data());
+                  return result;
+                }), py::arg("array"));
+  mvecArrayF.def(py::init([](const MvecArray<double>& array) {
+                   MvecArray<float> result(array.size());
+                   std::copy(array.data(), array.data() + multivectorSize * array.size(), result.data());
+                   return result;
+                 }), py::arg("array"));
+  bindConformalPoints(mvecArray);
+  bindConformalPoints(mvecArrayF);
+  m.attr("euclidean_dimension") = euclideanDimension;
+  m.def("up", [](const DenseArray<double>& x) {
+    if (x.ndim() != 1 || x.shape(0) != (py::ssize_t)euclideanDimension)
+      throw std::invalid_argument("expected an array of shape (" + std::to_string(euclideanDimension) + ",)");
+    return up(x.data());
+  }, py::arg("x"), "conformal point e0 + x + 0.5 |x|^2 ei of the Euclidean point x");
+  m.def("down", [](const Mvec<double>& mv) {
+    py::array_t<double> x((py::ssize_t)euclideanDimension);
+    down(mv, x.mutable_data());
+    return x;
+  }, py::arg("mv"), "Euclidean coordinates of a conformal point, normalized by its e0 coefficient");
 
+  m.attr("multivector_size") = multivectorSize;
+  m.attr("per_grade_starting_index") =
+      py::array_t<unsigned int>((py::ssize_t)algebraDimension + 1, perGradeStartingIndex);
+  m.def("dense_index", [](const unsigned int idx) {
+    if (idx >= multivectorSize) throw py::index_error("basis blade index out of range");
+    return perGradeStartingIndex[xorIndexToGrade[idx]] + xorIndexToHomogeneousIndex[idx];
+  }, "position of the basis blade idx (e.g. E12) in the dense arrays");
 
-  mvec.def("scalar_product", &Mvec<double>::scalarProduct);
-  mvec.def("dot_product", &Mvec<double>::dotProduct);
-  mvec.def("inv", &Mvec<double>::inv);
+  // the double overloads are registered first so that lists and integer
+  // arrays are converted to float64, float32 arrays use the float overloads.
+  bindArrayFunctions<double>(m);
+  bindArrayFunctions<float>(m);
+  m.def("mvecs_to_array", [](const py::sequence& mvecs) {
+    if (py::len(mvecs) > 0 && py::isinstance<Mvec<float>>(mvecs[0]))
+      return mvecsToArray<float>(mvecs);
+    return mvecsToArray<double>(mvecs);
+  }, "float32 array for a sequence of MvecF, float64 array otherwise");
 
-  mvec.def("grades", &Mvec<double>::grades);
-  mvec.def("grade", [](const Mvec<double>& a){return a.grade();});
-  mvec.def("grade", [](const Mvec<double>& a, const int i){return a.grade(i);});
-  mvec.def("clear", &Mvec<double>::clear);
+  // instruction set of the product kernels, chosen for the processor when the module is loaded
+  m.def("kernel_isa", []() { return std::string(kernelIsaName(activeKernelIsa())); },
+        "instruction set of the kernels used by the products: baseline or avx2");
+  m.def("select_kernel_isa", [](const std::string& name) { return selectKernelIsa(name.c_str()); }, py::arg("name"),
+        "use the kernels of an instruction set (baseline or avx2), False if the library or the processor does not support it; the products computed meanwhile by other threads use the previous or the new kernels");
+  m.def("autotune_kernels", [](const std::string& path) { return autotuneKernels(path.empty() ? nullptr : path.c_str()); },
+        py::arg("path") = std::string(),
+        "time the kernels of each product and use the fastest ones, cached in the file path (default: the environment variable C4GA_KERNEL_TUNING); False if the cache could not be saved; the products computed meanwhile by other threads use the previous or the new kernels");
 
 }
 
@@ -0,0 +1,214 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Text.hpp
+// This file is part of the Garamon for c4ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Text.hpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Fast text formatting and parsing of multivectors, in the syntax of operator<<: "1.5 + 2*e12 - 0.25*e0i".
+///
+/// The coefficients are written with a text that reads back to the same value, so that parseText(formatText(mv)) == mv:
+/// the shortest one, with std::to_chars and std::from_chars (Text.cpp, compiled as C++17 in the library). The names of the basis blades come from the tables of Constants.hpp. Neither the formatter nor
+/// the parser allocate: they work on buffers given by the caller, appendText reuses the capacity of its string.
+
+
+#ifndef C4GA_TEXT_HPP__
+#define C4GA_TEXT_HPP__
+#pragma once
+
+#include <cctype>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#include "c4ga/Mvec.hpp"
+
+
+/*!
+ * @namespace c4ga
+ */
+namespace c4ga {
+
+    /// \cond DEV
+    /// \brief length of the longest name of a basis vector
+    constexpr std::size_t longestBasisVectorName() {
+        std::size_t longest = 0;
+        for(const char* name : basisVectors){
+            std::size_t length = 0;
+            while(name[length]) ++length;
+            longest = length > longest ? length : longest;
+        }
+        return longest;
+    }
+
+    /// \brief maximal length of the text of a coefficient (sign, digits, point and exponent)
+    template<typename T>
+    constexpr std::size_t textCoefficientCapacity = std::numeric_limits<T>::max_digits10 + 10;
+
+    /// \brief write value in [first, last) with a text that reads back to value (see Text.cpp)
+    /// \return the end of the text, nullptr if it does not fit
+    char* formatCoefficient(char* first, char* last, const float value);
+    char* formatCoefficient(char* first, char* last, const double value);
+    char* formatCoefficient(char* first, char* last, const long double value);
+
+    /// \brief read a coefficient at the beginning of [first, last) (see Text.cpp)
+    /// \return the end of its text, nullptr if [first, last) does not start with a number
+    const char* parseCoefficient(const char* first, const char* last, float& value);
+    const char* parseCoefficient(const char* first, const char* last, double& value);
+    const char* parseCoefficient(const char* first, const char* last, long double& value);
+
+    inline const char* skipSpaces(const char* first, const char* last) {
+        while(first != last && (*first == ' ' || *first == '\t')) ++first;
+        return first;
+    }
+    /// \endcond
+
+
+    /// \brief maximal length of the text of a multivector with coefficients of type T
+    template<typename T>
+    constexpr std::size_t textCapacity = multivectorSize * (3 + textCoefficientCapacity<T> + 2 + algebraDimension*longestBasisVectorName());
+
+
+    /// \brief write the text of a dense multivector (see Mvec::toDense) in [first, last), as operator<< but with exact coefficients: the
+    /// non-zero coefficients by increasing grade, "0" for the multivector 0. Nothing is written after the text.
+    /// \return the end of the text, nullptr if it does not fit (at most textCapacity<T> characters)
+    template<typename T>
+    char* formatText(char* first, char* last, const T* dense) {
+        char* it = first;
+        for(unsigned int idx=0; idx<multivectorSize; ++idx){
+            T coefficient = dense[idx];
+            if(coefficient == T(0))
+                continue;
+            if(it != first){
+                if(last - it < 3) return nullptr;
+                std::memcpy(it, coefficient > T(0) ? " + " : " - ", 3);
+                it += 3;
+                if(coefficient < T(0)) coefficient = -coefficient;
+            }
+            if(!(it = formatCoefficient(it, last, coefficient))) return nullptr;
+            if(idx == 0)
+                continue;
+            const std::size_t length = std::strlen(basisBladeNames[idx]);
+            if((std::size_t)(last - it) < 2 + length) return nullptr;
+            *it++ = '*';
+            *it++ = 'e';
+            std::memcpy(it, basisBladeNames[idx], length);
+            it += length;
+        }
+        if(it == first){
+            if(first == last) return nullptr;
+            *it++ = '0';
+        }
+        return it;
+    }
+
+    /// \brief write the text of a multivector in [first, last), see formatText(first, last, dense)
+    template<typename T>
+    char* formatText(char* first, char* last, const Mvec<T>& mv) {
+        T dense[multivectorSize];
+        mv.toDense(dense);
+        return formatText(first, last, dense);
+    }
+
+    /// \brief append the text of a multivector to text, without allocation once text has the capacity of the longest text
+    template<typename T>
+    void appendText(std::string& text, const Mvec<T>& mv) {
+        const std::size_t size = text.size();
+        text.resize(size + textCapacity<T>);
+        char* const end = formatText(&text[size], &text[0] + text.size(), mv);
+        text.resize((std::size_t)(end - &text[0]));
+    }
+
+    /// \brief text of a multivector, see formatText
+    template<typename T>
+    std::string toText(const Mvec<T>& mv) {
+        std::string text;
+        appendText(text, mv);
+        return text;
+    }
+
+
+    /// \brief read the text of a multivector at the beginning of [first, last) into a dense multivector (see Mvec::toDense):
+    /// terms "c" or "c*e<basis vectors>" separated by " + " or " - ", as written by operator<< and formatText. The basis
+    /// vectors of a blade may be in any order (e21 is -e12), a term of a blade already read is added to it. Leading
+    /// whitespace is skipped, the text stops at the end of the line.
+    /// \param dense - the multivectorSize coefficients of the multivector, all written
+    /// \return the end of the text of the multivector, nullptr on a syntax error
+    template<typename T>
+    const char* parseText(const char* first, const char* last, T* dense) {
+        for(unsigned int idx=0; idx<multivectorSize; ++idx)
+            dense[idx] = T(0);
+        while(first != last && (*first == ' ' || *first == '\t' || *first == '\n' || *first == '\r')) ++first;
+        bool negative = false;
+        while(true){
+            first = skipSpaces(first, last);
+            T coefficient;
+            if(!(first = parseCoefficient(first, last, coefficient))) return nullptr;
+
+            // basis blade, bit i for basisVectors[i], and sign of the permutation to the order of basisVectors
+            unsigned int bladeBitmap = 0;
+            bool oddPermutation = false;
+            const char* it = skipSpaces(first, last);
+            if(it != last && *it == '*'){
+                it = skipSpaces(it + 1, last);
+                if(it == last || *it != 'e') return nullptr;
+                ++it;
+                for(bool found = true; found; ){
+                    found = false;
+                    for(unsigned int i=0; i<algebraDimension && !found; ++i){
+                        const std::size_t length = std::strlen(basisVectors[i]);
+                        if((std::size_t)(last - it) < length || std::memcmp(it, basisVectors[i], length) != 0) continue;
+                        if(bladeBitmap & (1u << i)) return nullptr;
+                        for(unsigned int j=i+1; j<algebraDimension; ++j)
+                            oddPermutation ^= (bladeBitmap >> j) & 1u;
+                        bladeBitmap |= 1u << i;
+                        it += length;
+                        found = true;
+                    }
+                }
+                if(bladeBitmap == 0) return nullptr;
+                first = it;
+            }
+            if(negative != oddPermutation) coefficient = -coefficient;
+            dense[basisBladeIndices[bladeBitmap]] += coefficient;
+
+            // operator of the next term
+            it = skipSpaces(first, last);
+            if(it == last || (*it != '+' && *it != '-'))
+                return first;
+            negative = *it == '-';
+            first = it + 1;
+        }
+    }
+
+    /// \brief read the text of a multivector at the beginning of [first, last), see parseText(first, last, dense)
+    /// \param mv - the multivector read, unchanged on a syntax error
+    template<typename T>
+    const char* parseText(const char* first, const char* last, Mvec<T>& mv) {
+        T dense[multivectorSize];
+        const char* const end = parseText(first, last, dense);
+        if(end) mv.fromDense(dense);
+        return end;
+    }
+
+    /// \brief read a multivector from its text, with nothing else but whitespace
+    /// \return false on a syntax error, mv is then unchanged
+    template<typename T>
+    bool fromText(const std::string& text, Mvec<T>& mv) {
+        const char* const last = text.data() + text.size();
+        T dense[multivectorSize];
+        const char* end = parseText(text.data(), last, dense);
+        while(end && end != last && std::isspace((unsigned char)*end)) ++end;
+        if(end != last) return false;
+        mv.fromDense(dense);
+        return true;
+    }
+
+}/// End of Namespace
+
+#endif // C4GA_TEXT_HPP__
@@ -0,0 +1,176 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// MvecFile.cpp
+// This file is part of the Garamon for c4ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file MvecFile.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Test of the binary files of multivectors (MvecFile.hpp), for float and double:
+///  - the round trip of multivectors appended one by one and by arrays, in blocks of blockCapacity multivectors, read
+///    by at, block and view, the rows aligned on 64 bytes,
+///  - a reader sees the blocks appended to its file after refresh, a writer appends to an existing file,
+///  - a file of some of the grades stores only them, and has no view,
+///  - the files of another type, the invalid files and the incomplete blocks are rejected.
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "c4ga/Mvec.hpp"
+#include "c4ga/MvecArray.hpp"
+#include "c4ga/MvecFile.hpp"
+
+#include "RandomMvec.hpp"
+#include "Test.hpp"
+
+
+namespace {
+
+    using c4ga::test::check;
+    using c4ga::test::randomMvec;
+    using c4ga::test::sameMvec;
+    using c4ga::test::typeName;
+
+    const std::string path = "c4ga_mvec_file_test.mvec";
+
+    /// \brief true if the multivectors of the file are mvs
+    template<typename T>
+    bool sameFile(const c4ga::MvecFileReader<T>& reader, const std::vector<c4ga::Mvec<T>>& mvs) {
+        if(reader.size() != mvs.size()) return false;
+        for(std::size_t i=0; i<mvs.size(); ++i)
+            if(!sameMvec(reader.at(i), mvs[i])) return false;
+        return true;
+    }
+
+    template<typename T>
+    void testRoundTrip(std::mt19937& randomEngine) {
+        std::vector<c4ga::Mvec<T>> mvs;
+        for(std::size_t i=0; i<30; ++i)
+            mvs.push_back(randomMvec<T>(randomEngine, std::uint32_t(i) % (c4ga::test::allGrades + 1)));
+
+        // blocks of 7, 3 (flush), 7, 7 and 6 (flush) multivectors
+        std::remove(path.c_str());
+        c4ga::MvecFileWriter<T> writer;
+        check(writer.open(path, c4ga::allGradesBitmap, 7), "file created, " + typeName<T>());
+        for(std::size_t i=0; i<10; ++i) writer.append(mvs[i]);
+        writer.flush();
+        writer.append(c4ga::MvecArray<T>(std::vector<c4ga::Mvec<T>>(mvs.begin() + 10, mvs.end())));
+        check(writer.close(), "file written, " + typeName<T>());
+
+        c4ga::MvecFileReader<T> reader;
+        check(reader.open(path) && reader.complete() && sameFile(reader, mvs), "round trip of the multivectors by at, " + typeName<T>());
+        const std::size_t sizes[] = {7, 3, 7, 7, 6};
+        bool blocks = reader.blockCount() == 5, views = blocks, aligned = blocks;
+        for(std::size_t b=0; b<reader.blockCount() && blocks; ++b){
+            const c4ga::MvecArray<T> block = reader.block(b);
+            const c4ga::BatchView<const T> view = reader.view(b);
+            blocks = reader.blockSize(b) == sizes[b] && block.size() == sizes[b];
+            for(std::size_t i=0; i<block.size() && blocks; ++i){
+                T dense[c4ga::multivectorSize];
+                mvs[reader.blockStart(b) + i].toDense(dense);
+                blocks = sameMvec(block.at(i), mvs[reader.blockStart(b) + i]);
+                for(unsigned int idx=0; idx<c4ga::multivectorSize; ++idx)
+                    views = views && view(i, idx) == dense[idx];
+            }
+            for(unsigned int idx=0; idx<c4ga::multivectorSize; ++idx)
+                aligned = aligned && reinterpret_cast<std::uintptr_t>(reader.coefficientRow(b, idx)) % 64 == 0;
+        }
+        check(blocks, "blocks of at most blockCapacity multivectors, copied by block, " + typeName<T>());
+        check(views, "views on the blocks in the mapping, " + typeName<T>());
+        check(aligned, "rows of the blocks aligned on 64 bytes, " + typeName<T>());
+
+        bool outOfRange = false;
+        try { reader.at(mvs.size()); } catch(const std::out_of_range&) { outOfRange = true; }
+        check(outOfRange, "multivector out of range rejected, " + typeName<T>());
+
+        // a writer appends to the file, its reader sees the new blocks after refresh
+        check(writer.open(path, 1u, 100), "writer opened on the existing file, " + typeName<T>());
+        const c4ga::Mvec<T> last = randomMvec<T>(randomEngine, c4ga::test::allGrades);
+        writer.append(last);
+        writer.flush();
+        const bool before = reader.size() == mvs.size();
+        mvs.push_back(last);
+        check(before && reader.refresh() && reader.blockCapacity() == 7 && reader.gradeBitmap() == c4ga::allGradesBitmap
+              && sameFile(reader, mvs), "blocks appended to an existing file, seen after refresh, " + typeName<T>());
+        writer.close();
+        reader.close();
+        std::remove(path.c_str());
+    }
+
+    template<typename T>
+    void testGrades(std::mt19937& randomEngine) {
+        const std::uint32_t grades = 6u; // grades 1 and 2
+        std::vector<c4ga::Mvec<T>> mvs, stored;
+        for(std::size_t i=0; i<5; ++i){
+            mvs.push_back(randomMvec<T>(randomEngine, c4ga::test::allGrades));
+            stored.push_back(mvs.back().grade(1) + mvs.back().grade(2));
+        }
+        std::remove(path.c_str());
+        {
+            c4ga::MvecFileWriter<T> writer;
+            writer.open(path, grades);
+            for(const c4ga::Mvec<T>& mv : mvs) writer.append(mv);
+        }
+        c4ga::MvecFileReader<T> reader;
+        check(reader.open(path) && reader.gradeBitmap() == grades && sameFile(reader, stored)
+              && reader.coefficientRow(0, 0) == nullptr && reader.coefficientRow(0, c4ga::perGradeStartingIndex[1]) != nullptr,
+              "file of some of the grades, the other coefficients 0, " + typeName<T>());
+        bool noView = false;
+        try { reader.view(0); } catch(const std::logic_error&) { noView = true; }
+        check(noView, "no view on a file without all the grades, " + typeName<T>());
+        reader.close();
+        std::remove(path.c_str());
+    }
+
+    void testInvalidFiles() {
+        std::remove(path.c_str());
+        c4ga::MvecFileReader<double> reader;
+        check(!reader.open(path), "missing file rejected");
+        c4ga::MvecFileWriter<double> writer;
+        check(!writer.open(path, 0) && !writer.open(path, c4ga::allGradesBitmap + 1) && !writer.open(path, c4ga::allGradesBitmap, 0),
+              "writer without grades, of a grade above the dimension or without capacity rejected");
+
+        check(writer.open(path, c4ga::allGradesBitmap, 4), "file of double created");
+        for(unsigned int i=0; i<6; ++i) writer.append(c4ga::Mvec<double>() + double(i));
+        writer.close();
+        c4ga::MvecFileReader<float> floats;
+        check(!floats.open(path), "file of double rejected as float");
+
+        // the file without its last byte: its last block is incomplete
+        std::string bytes;
+        {
+            std::ifstream input(path, std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+        }
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), std::streamsize(bytes.size() - 1));
+        check(reader.open(path) && !reader.complete() && reader.size() == 4 && reader.blockCount() == 1,
+              "incomplete block ignored by the reader");
+        reader.close();
+        check(!writer.open(path), "writer rejects a file ending with an incomplete block");
+
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << std::string(256, 'x');
+        check(!reader.open(path) && !writer.open(path), "file of another format rejected");
+        std::remove(path.c_str());
+    }
+}
+
+
+int main() {
+    std::mt19937 randomEngine(17);
+    testRoundTrip<float>(randomEngine);
+    testRoundTrip<double>(randomEngine);
+    testGrades<float>(randomEngine);
+    testGrades<double>(randomEngine);
+    testInvalidFiles();
+    return c4ga::test::testResult();
+}
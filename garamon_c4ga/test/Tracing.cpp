@@ -0,0 +1,107 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Tracing.cpp
+// This file is part of the Garamon for c4ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Tracing.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Test of the timing trace (Tracing.hpp), compiled with C4GA_TRACING whatever the option TRACING (it only
+/// includes Tracing.hpp, which is header-only):
+///  - the threads that end give their buffer to the next threads, which keep the events of the ended threads,
+///  - writeChromeTrace can be called while threads record, clearTrace removes the events.
+
+
+#define C4GA_TRACING
+
+#include <atomic>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "c4ga/Tracing.hpp"
+
+#include "Test.hpp"
+
+
+namespace {
+
+    using c4ga::test::check;
+
+    /// \brief number of occurrences of pattern in text
+    std::size_t occurrences(const std::string& text, const std::string& pattern) {
+        std::size_t count = 0;
+        for(std::size_t position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + 1))
+            ++count;
+        return count;
+    }
+
+    std::string chromeTrace() {
+        std::ostringstream stream;
+        c4ga::writeChromeTrace(stream);
+        return stream.str();
+    }
+
+    void record(const unsigned int count) {
+        for(unsigned int i=0; i<count; ++i)
+            C4GA_TRACE_BATCH_SCOPE("record", i + 1);
+    }
+
+    void testBufferReuse() {
+        // successive threads, each one ended before the next one starts
+        for(unsigned int t=0; t<8; ++t)
+            std::thread(record, 10).join();
+        const std::string trace = chromeTrace();
+        check(occurrences(trace, "\"thread_name\"") == 1, "buffer of the ended threads reused by the next threads");
+        check(occurrences(trace, "\"name\": \"record\"") == 80, "events of the ended threads kept");
+    }
+
+    void testConcurrentWrite() {
+        const unsigned int threadCount = 4;
+        std::atomic<bool> stop(false);
+        std::atomic<unsigned int> started(0);
+        std::vector<std::thread> threads;
+        for(unsigned int t=0; t<threadCount; ++t)
+            threads.emplace_back([&stop, &started](){
+                record(100);
+                ++started;
+                while(!stop.load(std::memory_order_relaxed)){
+                    record(100);
+                    std::this_thread::yield();
+                }
+            });
+        while(started.load() < threadCount)
+            std::this_thread::yield();
+
+        bool complete = true;
+        for(unsigned int w=0; w<4; ++w){
+            const std::string trace = chromeTrace();
+            complete = complete && trace.size() > 3 && trace.compare(trace.size() - 3, 3, "}}\n") == 0
+                && occurrences(trace, "\"thread_name\"") <= threadCount
+                && occurrences(trace, "\"name\": \"record\"") <= threadCount * c4ga::traceBufferCapacity;
+        }
+        stop.store(true);
+        for(std::thread& thread : threads)
+            thread.join();
+        check(complete, "trace written while threads record");
+
+        c4ga::clearTrace();
+        const std::string trace = chromeTrace();
+        check(occurrences(trace, "\"name\": \"record\"") == 0 && occurrences(trace, "\"thread_name\"") == threadCount,
+              "events removed by clearTrace, the buffers kept");
+    }
+}
+
+
+int main() {
+    c4ga::startTracing();
+    testBufferReuse();
+    testConcurrentWrite();
+    c4ga::stopTracing();
+    return c4ga::test::testResult();
+}
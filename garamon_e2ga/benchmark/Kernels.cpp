@@ -0,0 +1,110 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Kernels.cpp
+// This file is part of the Garamon for e2ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Kernels.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Microbenchmarks of the kernels of e2ga: time, allocations and hardware counters of each operation.
+///
+/// The benchmarks are, for every pair of grades:
+///  - "kernel": the per grades kernels of the function containers (outer, inner, geometric for each grade of the result,
+///    outerPrimalDual, outerDualPrimal, outerDualDual), i.e. the engine currently used by the products,
+///  - "recursive": the recursive functions of Outer.hpp, Inner.hpp and Geometric.hpp (outerProductHomogeneous, the
+///    contractions and geoProduct, which computes all the grades of the result in a multivector),
+///  - "Mvec": the products of homogeneous multivectors,
+/// and dual, reverse, inv, norm and roundZero of a multivector of all the grades. The recursive functions of the outer
+/// products of dual forms are not timed: their grades differ from those of the kernels and no engine uses them.
+/// The cases of the kernels and of the products of Mvec are those of Benchmark.hpp (addKernels, addMvecProducts), shared
+/// with the allocation audit.
+///
+/// Usage: e2ga_kernels_benchmark [--min-time <milliseconds>] [--repetitions <count>] [--counters] [--filter <text>]
+/// [--output <path>], see Benchmark.hpp for the report.
+
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "e2ga/Mvec.hpp"
+
+#include "Benchmark.hpp"
+
+
+namespace {
+
+    using Mvec = e2ga::Mvec<double>;
+    using e2ga::benchmark::BenchmarkCase;
+    using e2ga::benchmark::Vector;
+    using e2ga::benchmark::addCase;
+    using e2ga::benchmark::addKernel;
+    using e2ga::benchmark::doNotOptimize;
+    using e2ga::benchmark::randomMvec;
+    using e2ga::benchmark::randomVector;
+
+    constexpr unsigned int dimension = e2ga::algebraDimension;
+
+    /// \brief the recursive functions
+    void addRecursiveFunctions(std::vector<BenchmarkCase>& benchmarks) {
+        for(unsigned int grade1=0; grade1<=dimension; ++grade1)
+            for(unsigned int grade2=0; grade2<=dimension; ++grade2){
+                if(grade1 + grade2 <= dimension)
+                    addKernel(benchmarks, "recursive", "outer", [grade1, grade2](const Vector& mv1, const Vector& mv2, Vector& mv3){
+                        e2ga::outerProductHomogeneous<double>(mv1, mv2, mv3, grade1, grade2, grade1 + grade2);
+                    }, grade1, grade2, grade1 + grade2);
+                if(grade1 <= grade2)
+                    addKernel(benchmarks, "recursive", "leftContraction", [grade1, grade2](const Vector& mv1, const Vector& mv2, Vector& mv3){
+                        e2ga::leftContractionProductHomogeneous<double>(mv1, mv2, mv3, grade1, grade2, grade2 - grade1);
+                    }, grade1, grade2, grade2 - grade1);
+                if(grade1 >= grade2)
+                    addKernel(benchmarks, "recursive", "rightContraction", [grade1, grade2](const Vector& mv1, const Vector& mv2, Vector& mv3){
+                        e2ga::rightContractionProductHomogeneous<double>(mv1, mv2, mv3, grade1, grade2, grade1 - grade2);
+                    }, grade1, grade2, grade1 - grade2);
+
+                // geoProduct accumulates in a multivector, whose k-vectors are created by the first call
+                auto mv1 = std::make_shared<Vector>(randomVector(e2ga::binomialArray[grade1]));
+                auto mv2 = std::make_shared<Vector>(randomVector(e2ga::binomialArray[grade2]));
+                auto mv3 = std::make_shared<Mvec>();
+                addCase(benchmarks, "recursive", "geometric", {grade1, grade2}, [grade1, grade2, mv1, mv2, mv3](const std::size_t n){
+                    for(std::size_t i=0; i<n; ++i){
+                        e2ga::geoProduct<double>(*mv1, *mv2, *mv3, grade1, grade2, 0);
+                        doNotOptimize(*mv3);
+                    }
+                });
+            }
+    }
+
+    /// \brief the unary operations of Mvec, on a multivector of all the grades
+    void addMvecUnaryOperations(std::vector<BenchmarkCase>& benchmarks) {
+        auto mv = std::make_shared<Mvec>(randomMvec((1u << (dimension+1)) - 1));
+        addCase(benchmarks, "Mvec", "dual", {}, [mv](const std::size_t n){ for(std::size_t i=0; i<n; ++i) doNotOptimize(mv->dual()); });
+        addCase(benchmarks, "Mvec", "reverse", {}, [mv](const std::size_t n){ for(std::size_t i=0; i<n; ++i) doNotOptimize(mv->reverse()); });
+        addCase(benchmarks, "Mvec", "inv", {}, [mv](const std::size_t n){ for(std::size_t i=0; i<n; ++i) doNotOptimize(mv->inv()); });
+        addCase(benchmarks, "Mvec", "norm", {}, [mv](const std::size_t n){ for(std::size_t i=0; i<n; ++i) doNotOptimize(mv->norm()); });
+        addCase(benchmarks, "Mvec", "roundZero", {}, [mv](const std::size_t n){
+            for(std::size_t i=0; i<n; ++i){
+                mv->roundZero(1e-300);
+                doNotOptimize(*mv);
+            }
+        });
+    }
+}
+
+
+int main(int argc, char** argv) {
+    e2ga::benchmark::BenchmarkOptions options;
+    if(!e2ga::benchmark::parseBenchmarkOptions(argc, argv, options)) return 2;
+
+    std::vector<BenchmarkCase> benchmarks;
+    e2ga::benchmark::addKernels(benchmarks);
+    addRecursiveFunctions(benchmarks);
+    e2ga::benchmark::addMvecProducts(benchmarks);
+    addMvecUnaryOperations(benchmarks);
+    return e2ga::benchmark::runBenchmarks("kernels", benchmarks, options);
+}
@@ -0,0 +1,209 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// CApi.cpp
+// This file is part of the Garamon for e2ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file CApi.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief C interface of the e2ga library, implemented on top of Mvec<double> and the batch functions.
+
+
+#include "e2ga/CApi.h"
+
+#include <new>
+
+#include "e2ga/Mvec.hpp"
+#include "e2ga/Batch.hpp"
+#include "e2ga/KernelDispatch.hpp"
+
+
+/// \brief the multivector behind an opaque handle
+struct e2ga_mvec {
+    e2ga::Mvec<double> mv;
+};
+
+
+/// \cond DEV
+// no exception may cross the C interface: the functions returning a status catch them all
+#define E2GA_CAPI_TRY(statements) \
+    try { statements; return 0; } \
+    catch(...) { return -1; }
+
+namespace {
+
+    /// \brief view on the operand of a batch function, stored as multivectors of multivectorSize coefficients
+    inline e2ga::BatchView<const double> operandBatch(const double* data, const ptrdiff_t itemStride) {
+        return {data, itemStride, 1};
+    }
+
+    /// \brief new handle on mv, NULL if the allocation fails
+    inline e2ga_mvec* newHandle(e2ga::Mvec<double>&& mv) {
+        return new (std::nothrow) e2ga_mvec{std::move(mv)};
+    }
+}
+/// \endcond
+
+
+extern "C" {
+
+int e2ga_api_version(void) {
+    return E2GA_CAPI_VERSION;
+}
+
+unsigned int e2ga_algebra_dimension(void) {
+    return e2ga::algebraDimension;
+}
+
+unsigned int e2ga_multivector_size(void) {
+    return e2ga::multivectorSize;
+}
+
+unsigned int e2ga_dense_index(const unsigned int xor_index) {
+    if(xor_index >= e2ga::multivectorSize) return e2ga::multivectorSize;
+    return e2ga::perGradeStartingIndex[e2ga::xorIndexToGrade[xor_index]] + e2ga::xorIndexToHomogeneousIndex[xor_index];
+}
+
+
+e2ga_mvec* e2ga_mvec_new(void) {
+    try { return newHandle(e2ga::Mvec<double>()); }
+    catch(...) { return nullptr; }
+}
+
+e2ga_mvec* e2ga_mvec_from_dense(const double* dense) {
+    try {
+        e2ga::Mvec<double> mv;
+        mv.fromDense(dense);
+        return newHandle(std::move(mv));
+    }
+    catch(...) { return nullptr; }
+}
+
+e2ga_mvec* e2ga_mvec_clone(const e2ga_mvec* mv) {
+    try { return newHandle(e2ga::Mvec<double>(mv->mv)); }
+    catch(...) { return nullptr; }
+}
+
+void e2ga_mvec_free(e2ga_mvec* mv) {
+    delete mv;
+}
+
+void e2ga_mvec_to_dense(const e2ga_mvec* mv, double* dense) {
+    mv->mv.toDense(dense);
+}
+
+double e2ga_mvec_get(const e2ga_mvec* mv, const unsigned int xor_index) {
+    if(xor_index >= e2ga::multivectorSize) return 0.0;
+    double dense[e2ga::multivectorSize];
+    mv->mv.toDense(dense);
+    return dense[e2ga_dense_index(xor_index)];
+}
+
+int e2ga_mvec_set(e2ga_mvec* mv, const unsigned int xor_index, const double value) {
+    if(xor_index >= e2ga::multivectorSize) return -1;
+    E2GA_CAPI_TRY(mv->mv[xor_index] = value)
+}
+
+
+int e2ga_mvec_add(const e2ga_mvec* a, const e2ga_mvec* b, e2ga_mvec* result) {
+    E2GA_CAPI_TRY(result->mv = a->mv + b->mv)
+}
+
+int e2ga_mvec_sub(const e2ga_mvec* a, const e2ga_mvec* b, e2ga_mvec* result) {
+    E2GA_CAPI_TRY(result->mv = a->mv - b->mv)
+}
+
+int e2ga_mvec_scale(const e2ga_mvec* a, const double value, e2ga_mvec* result) {
+    E2GA_CAPI_TRY(result->mv = a->mv * value)
+}
+
+int e2ga_mvec_geometric_product(const e2ga_mvec* a, const e2ga_mvec* b, e2ga_mvec* result) {
+    E2GA_CAPI_TRY(result->mv = a->mv * b->mv)
+}
+
+int e2ga_mvec_outer_product(const e2ga_mvec* a, const e2ga_mvec* b, e2ga_mvec* result) {
+    E2GA_CAPI_TRY(result->mv = a->mv ^ b->mv)
+}
+
+int e2ga_mvec_inner_product(const e2ga_mvec* a, const e2ga_mvec* b, e2ga_mvec* result) {
+    E2GA_CAPI_TRY(result->mv = a->mv | b->mv)
+}
+
+int e2ga_mvec_left_contraction(const e2ga_mvec* a, const e2ga_mvec* b, e2ga_mvec* result) {
+    E2GA_CAPI_TRY(result->mv = a->mv < b->mv)
+}
+
+int e2ga_mvec_right_contraction(const e2ga_mvec* a, const e2ga_mvec* b, e2ga_mvec* result) {
+    E2GA_CAPI_TRY(result->mv = a->mv > b->mv)
+}
+
+int e2ga_mvec_dual(const e2ga_mvec* a, e2ga_mvec* result) {
+    E2GA_CAPI_TRY(result->mv = a->mv.dual())
+}
+
+int e2ga_mvec_reverse(const e2ga_mvec* a, e2ga_mvec* result) {
+    E2GA_CAPI_TRY(result->mv = a->mv.reverse())
+}
+
+int e2ga_mvec_inverse(const e2ga_mvec* a, e2ga_mvec* result) {
+    E2GA_CAPI_TRY(result->mv = a->mv.inv())
+}
+
+double e2ga_mvec_norm(const e2ga_mvec* a) {
+    return a->mv.norm();
+}
+
+
+int e2ga_geometric_product_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    E2GA_CAPI_TRY(e2ga::geometricProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), e2ga::aosBatch(result), count))
+}
+
+int e2ga_outer_product_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    E2GA_CAPI_TRY(e2ga::outerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), e2ga::aosBatch(result), count))
+}
+
+int e2ga_inner_product_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    E2GA_CAPI_TRY(e2ga::innerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), e2ga::aosBatch(result), count, e2ga::InnerKind::inner))
+}
+
+int e2ga_left_contraction_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    E2GA_CAPI_TRY(e2ga::innerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), e2ga::aosBatch(result), count, e2ga::InnerKind::leftContraction))
+}
+
+int e2ga_right_contraction_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    E2GA_CAPI_TRY(e2ga::innerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), e2ga::aosBatch(result), count, e2ga::InnerKind::rightContraction))
+}
+
+int e2ga_apply_versor_batch(const double* versor, const ptrdiff_t versor_stride, const double* mv, const ptrdiff_t mv_stride, double* result, const size_t count) {
+    E2GA_CAPI_TRY(e2ga::applyVersorBatch(operandBatch(versor, versor_stride), operandBatch(mv, mv_stride), e2ga::aosBatch(result), count))
+}
+
+int e2ga_dual_batch(const double* a, const ptrdiff_t a_stride, double* result, const size_t count) {
+    E2GA_CAPI_TRY(e2ga::dualBatch(operandBatch(a, a_stride), e2ga::aosBatch(result), count))
+}
+
+int e2ga_reverse_batch(const double* a, const ptrdiff_t a_stride, double* result, const size_t count) {
+    E2GA_CAPI_TRY(e2ga::reverseBatch(operandBatch(a, a_stride), e2ga::aosBatch(result), count))
+}
+
+int e2ga_norm_batch(const double* a, const ptrdiff_t a_stride, double* norms, const size_t count) {
+    E2GA_CAPI_TRY(e2ga::normBatch(operandBatch(a, a_stride), norms, count))
+}
+
+const char* e2ga_kernel_isa(void) {
+    return e2ga::kernelIsaName(e2ga::activeKernelIsa());
+}
+
+int e2ga_select_kernel_isa(const char* name) {
+    if(name == nullptr) return -1;
+    return e2ga::selectKernelIsa(name) ? 0 : -1;
+}
+
+int e2ga_autotune_kernels(const char* path) {
+    E2GA_CAPI_TRY(if(!e2ga::autotuneKernels(path)) return -1)
+}
+
+} // extern "C"
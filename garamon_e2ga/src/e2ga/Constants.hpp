@@ -57,6 +57,8 @@ namespace e2ga{
 
     constexpr unsigned int algebraDimension = 2; /*!< dimension of the algebra (number of  basis vectors of grade 1) */
 
+    constexpr unsigned int multivectorSize = 4; /*!< number of coefficients of a full multivector (2^dimension) */
+
     constexpr unsigned int perGradeStartingIndex[3] = {0,1,3};  /*!< array specifying the index of each first element of grade k in the full multivector */
 
     constexpr unsigned int binomialArray[3] = {1,2,1};  /*!< array of the (dimension + 1) first binomial coefficients */
@@ -65,21 +67,23 @@ namespace e2ga{
 
     constexpr unsigned int xorIndexToHomogeneousIndex[] = {0,0,1,0}; /*!< given a Xor index in a multivector, this array indicates the corresponding index in the whole homogeneous vector*/
 
-    std::array<std::vector<unsigned int>, 3> dualPermutations = {{ { 0}, {{ 1, 0}}, {0} }};
+    constexpr unsigned int dualPermutations[3][2] = {{0}, {1,0}, {0}};
 
-    const std::array<Eigen::Matrix<double, Eigen::Dynamic,1>, 3> dualCoefficients = loadFastDualArray<double>(); /*!< array containing the coefficients needed to compute the dual */ 
+    constexpr double dualCoefficients[3][2] = {{1.000000}, {-1.000000,1.000000}, {-1.000000}}; /*!< array containing the coefficients needed to compute the dual */ 
     
     template<typename T>
-    std::array<T, 4> recursiveDualCoefficients = {{ 1.000000, -1.000000, 1.000000, 1.000000}}; /*!< array containing the coefficients needed to compute the recursive product like (primal^dual) */
+    constexpr std::array<T, 4> recursiveDualCoefficients = {{ 1.000000, -1.000000, 1.000000, 1.000000}}; /*!< array containing the coefficients needed to compute the recursive product like (primal^dual) */
     
 
     constexpr double pseudoScalarInverse = -1.000000; /*!< compute the inverse of the pseudo scalar */
 
-    const int signReversePerGrade[3] = {1,1,-1}; /*!< array of signs to avoid the computation of (-1)^k*(k-1)/2 during the reverse operation */
+    constexpr int signReversePerGrade[3] = {1,1,-1}; /*!< array of signs to avoid the computation of (-1)^k*(k-1)/2 during the reverse operation */
 
-    const std::vector<std::string> basisVectors = {"1", "2"}; /*!< name of the basis vectors (of grade 1) */
+    constexpr const char* basisVectors[] = {"1", "2"}; /*!< name of the basis vectors (of grade 1) */
+    constexpr const char* basisBladeNames[4] = {"", "1", "2", "12"}; /*!< name of the basis blade of each coefficient of a dense multivector (see Mvec::toDense), written after "e" by operator<< */
+    constexpr unsigned int basisBladeIndices[4] = {0,1,2,3}; /*!< index in a dense multivector of the basis blade whose basis vectors are the bits of the index (bit i for basisVectors[i]) */
 
-    const std::string metric =
+    constexpr const char* metric =
 "\
 	e1	e2	\n\
 e1	1	0	\n\
@@ -88,18 +92,18 @@ e2	0	1	\n\
 
 
     template<class T>
-    const T zero = 0;
+    constexpr T zero = 0;
 
-    const unsigned int scalar = 0;
-    const unsigned int E1 = 1;
-    const unsigned int E2 = 2;
-    const unsigned int E12 = 3;
+    constexpr unsigned int scalar = 0;
+    constexpr unsigned int E1 = 1;
+    constexpr unsigned int E2 = 2;
+    constexpr unsigned int E12 = 3;
     /*!< defines the constants for the cga */
 
 
 
     template<typename T>
-    Eigen::Matrix<T, Eigen::Dynamic, 1> diagonalMetric = []()->Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic>{Eigen::Matrix<T, Eigen::Dynamic, 1> tmp(2);tmp<<1.000000,1.000000; return tmp;}();   /*!< defines the diagonal metric (stored as a vector) */
+    constexpr std::array<T, 2> diagonalMetric = {{1.000000,1.000000}};   /*!< defines the diagonal metric (stored as a vector) */
 
 
 }  // namespace
@@ -20,6 +20,7 @@
 
 #include "e2ga/Mvec.hpp"
 #include "e2ga/Constants.hpp"
+#include "e2ga/KernelDispatch.hpp"
 
 
 /*!
@@ -29,9 +30,10 @@ namespace e2ga {
     template<typename T> class Mvec;
 
     
+    /// \brief kernels of the geometric product per grades: geometricFunctionsContainer<T>[grade mv1 * mv2][grade mv1][grade mv2], constant-initialized
+    /// with the explicit kernels, that the kernel dispatch (KernelDispatch.hpp) replaces when the library is loaded.
     template<typename T>
-	std::array<std::array<std::array<std::function<void(const Eigen::Matrix<T, Eigen::Dynamic, 1> & , const Eigen::Matrix<T, Eigen::Dynamic, 1> & , Eigen::Matrix<T, Eigen::Dynamic, 1>&)>, 3>, 3>, 3> geometricFunctionsContainer =
-	{{
+	std::array<std::array<std::array<KernelEntry<T>, 3>, 3>, 3> geometricFunctionsContainer = {{
 		{{
 			{{{},{},{}}},
 			{{{},{},{}}},
@@ -20,6 +20,7 @@
 #include "e2ga/Mvec.hpp"
 #include "e2ga/Inner.hpp"
 #include "e2ga/Constants.hpp"
+#include "e2ga/KernelDispatch.hpp"
 
 
 /*!
@@ -130,8 +131,10 @@ namespace e2ga {
 
 
 	
+    /// \brief kernels of the inner product per grades: innerFunctionsContainer<T>[grade mv1][grade mv2], constant-initialized
+    /// with the explicit kernels, that the kernel dispatch (KernelDispatch.hpp) replaces when the library is loaded.
     template<typename T>
-	std::array<std::array<std::function<void(const Eigen::Matrix<T, Eigen::Dynamic, 1> & , const Eigen::Matrix<T, Eigen::Dynamic, 1> & , Eigen::Matrix<T, Eigen::Dynamic, 1>&)>, 3>, 3> innerFunctionsContainer = {{
+	std::array<std::array<KernelEntry<T>, 3>, 3> innerFunctionsContainer = {{
 		{{inner_0_0<T>,inner_0_1<T>,inner_0_2<T>}},
 		{{inner_1_0<T>,inner_1_1<T>,inner_1_2<T>}},
 		{{inner_2_0<T>,inner_2_1<T>,inner_2_2<T>}}
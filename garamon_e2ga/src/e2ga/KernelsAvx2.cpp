@@ -0,0 +1,29 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// KernelsAvx2.cpp
+// This file is part of the Garamon for e2ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file KernelsAvx2.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief SIMD kernels compiled for AVX2 and FMA. This file only includes SimdExplicit.hpp: the inline functions of the
+/// other headers must not be compiled with these instructions, the linker could keep them for the whole library.
+
+
+#include "e2ga/KernelDispatch.hpp"
+
+#if !E2GA_SIMD_KERNELS || !defined(__AVX2__) || defined(__AVX512F__)
+#error "KernelsAvx2.cpp must be compiled with AVX2 and FMA (and without AVX-512)"
+#endif
+
+
+namespace e2ga {
+
+    KernelTable avx2KernelTable() {
+        return {simdKernels<float>().data(), simdKernels<double>().data(), simdKernels<double>().size()};
+    }
+
+}/// End of Namespace
@@ -23,9 +23,14 @@
 #include <iostream>
 #include <cmath>
 #include <limits>
+#include <algorithm>
+#include <array>
 
 // Internal Includes
 #include "e2ga/Utility.hpp"
+#include "e2ga/Instrumentation.hpp"
+#include "e2ga/Tracing.hpp"
+#include "e2ga/SparsityProfile.hpp"
 #include "e2ga/Constants.hpp"
 
 #include "e2ga/Outer.hpp"
@@ -33,6 +38,7 @@
 #include "e2ga/Geometric.hpp"
 
 #include "e2ga/OuterExplicit.hpp"
+#include "e2ga/OuterDualExplicit.hpp"
 #include "e2ga/InnerExplicit.hpp"
 #include "e2ga/GeometricExplicit.hpp"
 
@@ -58,6 +64,37 @@ namespace e2ga{
     };
 
 
+    /// \cond DEV
+    /// \brief per-thread accumulators of the products with pruning (e.g. Mvec::geometricProduct(mv2, epsilon)): a k-vector
+    /// of each grade, allocated once per thread, and the bitmap of the grades written by the current product.
+    template<typename T>
+    struct PrunedWorkspace {
+        std::array<Eigen::Matrix<T, Eigen::Dynamic, 1>, algebraDimension+1> kvecs; /*!< accumulated k-vectors, per grade */
+        unsigned int gradeBitmap = 0; /*!< grades written since the last Mvec::storePruned */
+
+        PrunedWorkspace() {
+            for(unsigned int grade=0; grade<=algebraDimension; ++grade)
+                kvecs[grade] = Eigen::Matrix<T, Eigen::Dynamic, 1>::Zero(binomialArray[grade]);
+        }
+
+        /// \brief the workspace of the calling thread
+        static PrunedWorkspace& local() {
+            thread_local PrunedWorkspace workspace;
+            return workspace;
+        }
+
+        /// \brief the k-vector of grade "grade", set to 0 the first time the current product writes it
+        inline Eigen::Matrix<T, Eigen::Dynamic, 1>& kvec(const unsigned int grade) {
+            if((gradeBitmap & (1 << grade)) == 0){
+                kvecs[grade].setZero();
+                gradeBitmap |= 1 << grade;
+            }
+            return kvecs[grade];
+        }
+    };
+    /// \endcond
+
+
 
     /// \class Mvec
     /// \brief class defining multivectors.
@@ -275,6 +312,32 @@ namespace e2ga{
         /// \return a multivector.
         Mvec<T> dotProduct(const Mvec<T> &mv2) const;
 
+        /// \brief products with pruning: the product of the operator (or method) of the same name, whose coefficients with a
+        /// magnitude lower than epsilon are set to 0 as the result is written, and whose k-vectors full of 0 are never stored.
+        /// Same result as (mv1 * mv2).roundZero(epsilon), without the extra pass nor the allocation of the pruned k-vectors.
+        /// \param mv2 - a multivector
+        /// \param epsilon - threshold, 0 to only drop the k-vectors that are exactly 0
+        /// \return mv1*mv2 (resp. ^, |, <, >, scalarProduct...) rounded to 0
+        Mvec<T> geometricProduct(const Mvec<T> &mv2, const T epsilon) const;
+        Mvec<T> outerProduct(const Mvec<T> &mv2, const T epsilon) const;      ///< \brief outer product (^) with pruning
+        Mvec<T> innerProduct(const Mvec<T> &mv2, const T epsilon) const;      ///< \brief inner product (|) with pruning
+        Mvec<T> leftContraction(const Mvec<T> &mv2, const T epsilon) const;   ///< \brief left contraction (<) with pruning
+        Mvec<T> rightContraction(const Mvec<T> &mv2, const T epsilon) const;  ///< \brief right contraction (>) with pruning
+        Mvec<T> scalarProduct(const Mvec<T> &mv2, const T epsilon) const;     ///< \brief scalarProduct with pruning
+        Mvec<T> dotProduct(const Mvec<T> &mv2, const T epsilon) const;        ///< \brief dotProduct with pruning
+        Mvec<T> outerPrimalDual(const Mvec<T> &mv2, const T epsilon) const;   ///< \brief outerPrimalDual with pruning
+        Mvec<T> outerDualPrimal(const Mvec<T> &mv2, const T epsilon) const;   ///< \brief outerDualPrimal with pruning
+        Mvec<T> outerDualDual(const Mvec<T> &mv2, const T epsilon) const;     ///< \brief outerDualDual with pruning
+
+        /// \cond DEV
+        /// \brief product of this and mv2 accumulated in the PrunedWorkspace of the thread, with the kernels and grades of the operator of the product
+        /// \param product - the product, named as by the instrumentation
+        Mvec<T> prunedProduct(const Mvec<T> &mv2, const InstrumentedProduct product, const T epsilon) const;
+
+        /// \brief move the k-vectors written in workspace to this empty multivector, by ascending grade: their coefficients with a magnitude lower than epsilon are set to 0, and the k-vectors full of 0 are not stored
+        void storePruned(PrunedWorkspace<T> &workspace, const T epsilon);
+        /// \endcond
+
         /// \brief defines the geometric product between a multivector and a scalar
         /// \param value - a scalar
         /// \return mv2*value
@@ -401,6 +464,7 @@ namespace e2ga{
                     // if grade exceed, create it and inster it before the current element
                     Kvec<T> kvec = {Eigen::Matrix<T, Eigen::Dynamic, 1>::Zero(binomialArray[grade]),grade};
                     auto it2 = mvData.insert(it,kvec);
+                    E2GA_INSTRUMENT(instrumentation::countKvecAllocation());
                     gradeBitmap |= 1 << (grade);
                     return it2->vec[idxHomogeneous];
                 }
@@ -410,6 +474,7 @@ namespace e2ga{
             Kvec<T> kvec = {Eigen::Matrix<T, Eigen::Dynamic, 1>::Zero(binomialArray[grade]),grade};
 
             auto it2 = mvData.insert(mvData.end(),kvec);
+            E2GA_INSTRUMENT(instrumentation::countKvecAllocation());
             gradeBitmap |= 1 << (grade);
             return it2->vec[idxHomogeneous];
         }
@@ -482,6 +547,7 @@ namespace e2ga{
             kvec.vec[index] = T(1);
             Mvec mv1;
             mv1.mvData.push_back(kvec);
+            E2GA_INSTRUMENT(instrumentation::countKvecAllocation());
             mv1.gradeBitmap = 1 << (grade);
 
             return mv1;
@@ -511,6 +577,7 @@ namespace e2ga{
 					kvec.vec=Eigen::Matrix<T, Eigen::Dynamic, 1>::Zero(binomialArray[grade]);
 					kvec.grade=grade;
                     auto it2 = mvData.insert(it,kvec);
+                    E2GA_INSTRUMENT(instrumentation::countKvecAllocation());
                     gradeBitmap |= 1 << (grade);
                     return it2;
                 }
@@ -521,6 +588,7 @@ namespace e2ga{
 			kvec.vec=Eigen::Matrix<T, Eigen::Dynamic, 1>::Zero(binomialArray[grade]);
 			kvec.grade=grade;
             auto it2 = mvData.insert(mvData.end(),kvec);
+            E2GA_INSTRUMENT(instrumentation::countKvecAllocation());
             gradeBitmap |= 1 << (grade);
             return it2;
         }
@@ -568,6 +636,11 @@ namespace e2ga{
         /// \return - the dual of the multivector
         Mvec<T> dual() const;
 
+        /// \brief dual with pruning: the dual whose coefficients with a magnitude lower than epsilon are set to 0, the k-vectors full of 0 are not stored
+        /// \param epsilon - threshold
+        /// \return - the dual of the multivector, rounded to 0
+        Mvec<T> dual(const T epsilon) const;
+
         /// \brief compute the reverse of a multivector
         /// \return - the reverse of the multivector
         Mvec<T> reverse() const;
@@ -636,6 +709,19 @@ namespace e2ga{
         /// \param epsilon - threshold, with default value the epsilon of the float/double/long double type from numeric_limits.
         void roundZero(const T epsilon = std::numeric_limits<T>::epsilon());
 
+        /// \brief grades of the multivector, number of coefficients it stores, and among them the number of coefficients equal to 0
+        /// and of the other ones that roundZero(epsilon) sets to 0
+        /// \param epsilon - threshold of roundZero
+        MvecSparsity sparsity(const T epsilon = std::numeric_limits<T>::epsilon()) const;
+
+        /// \brief copy all the coefficients of the multivector into a dense array of multivectorSize elements, ordered by grade (the k-vector part starts at perGradeStartingIndex[k]).
+        /// \param dense - destination array, the coefficients of the missing grades are set to 0.
+        void toDense(T* dense) const;
+
+        /// \brief set the multivector from a dense array of multivectorSize elements ordered by grade (see toDense). The grades whose coefficients are all 0 are not stored.
+        /// \param dense - source array
+        void fromDense(const T* dense);
+
         /// \brief Specify if two multivectors have the same grade.
         /// \param mv - multivector to compare with.
         /// \return true if the two multivectors have the same grade, else return false.
@@ -654,7 +740,7 @@ namespace e2ga{
         /// \param gradeMV - the considered grade
         /// \param moreThanOne - true if it the first element to display (should we put a '+' before)
         template<typename U>
-        friend void traverseKVector(std::ostream &stream, const Eigen::Matrix<U, Eigen::Dynamic, 1>, unsigned int gradeMV, bool& moreThanOne);
+        friend void traverseKVector(std::ostream &stream, const Eigen::Matrix<U, Eigen::Dynamic, 1> &kvector, unsigned int gradeMV, bool& moreThanOne);
         /// \endcond // do not comment this functions
 
 /*
@@ -721,6 +807,7 @@ namespace e2ga{
     template<typename T>
     Mvec<T>::Mvec(const Mvec& mv) : mvData(mv.mvData), gradeBitmap(mv.gradeBitmap)
     {
+        E2GA_INSTRUMENT(instrumentation::countKvecAllocations(mvData.size()));
         //std::cout << "copy constructor " << std::endl;
     }
 
@@ -744,6 +831,7 @@ namespace e2ga{
             for(unsigned int i=0; i<it->vec.size(); ++i)
                 kvec.vec.coeffRef(i) = T(it->vec.coeff(i));
             mvData.push_back(kvec);
+            E2GA_INSTRUMENT(instrumentation::countKvecAllocation());
         }
     }
 
@@ -757,6 +845,7 @@ namespace e2ga{
             kvec.vec =Eigen::Matrix<T, Eigen::Dynamic, 1>(1);
             kvec.grade =0;
             mvData.push_back(kvec);
+            E2GA_INSTRUMENT(instrumentation::countKvecAllocation());
             mvData.begin()->vec.coeffRef(0) = val;
         }
     }
@@ -772,6 +861,7 @@ namespace e2ga{
         if(&mv == this) return *this;
         gradeBitmap = mv.gradeBitmap;
         mvData = mv.mvData;
+        E2GA_INSTRUMENT(instrumentation::countKvecAllocations(mvData.size()));
         return *this;
     }
 
@@ -786,11 +876,13 @@ namespace e2ga{
 
     template<typename T>
     Mvec<T> Mvec<T>::operator+(const Mvec<T> &mv2) const {
+        E2GA_TRACE_SCOPE("add", gradeBitmap, mv2.gradeBitmap);
         Mvec<T> mv3(*this);
         for(auto & itMv : mv2.mvData) {
             auto it = mv3.createVectorXdIfDoesNotExist(itMv.grade);
             it->vec += itMv.vec;
         }
+        E2GA_PROFILE_SPARSITY(add, *this, mv2, mv3);
         return mv3;
     }
 
@@ -831,11 +923,13 @@ namespace e2ga{
 
     template<typename T>
     Mvec<T> Mvec<T>::operator-(const Mvec<T> &mv2) const {
+        E2GA_TRACE_SCOPE("subtract", gradeBitmap, mv2.gradeBitmap);
         Mvec<T> mv3(*this);
         for(auto & itMv : mv2.mvData) {
             auto it = mv3.createVectorXdIfDoesNotExist(itMv.grade);
             it->vec -= itMv.vec;
         }
+        E2GA_PROFILE_SPARSITY(subtract, *this, mv2, mv3);
         return mv3;
     }
 
@@ -867,6 +961,7 @@ namespace e2ga{
 
     template<typename T>
     Mvec<T> Mvec<T>::operator^(const Mvec<T> &mv2) const {
+        E2GA_TRACE_SCOPE("outer", gradeBitmap, mv2.gradeBitmap);
 #if 0 // only recursive version
         // Loop over non-empty grade of mv1 and mv2
         // This version (with recursive call) is only faster than the standard recursive call if
@@ -882,6 +977,7 @@ namespace e2ga{
                                             itMv1.grade, itMv2.grade, grade_mv3);
                 }
             }
+        E2GA_PROFILE_SPARSITY(outer, *this, mv2, mv3);
         return mv3;
 #else // use the adaptative pointer function array
         // Loop over non-empty grade of mv1 and mv2
@@ -891,9 +987,11 @@ namespace e2ga{
             for(const auto & itMv2 : mv2.mvData){
                 if(itMv1.grade + itMv2.grade <= (int) algebraDimension ){
                     auto itMv3 = mv3.createVectorXdIfDoesNotExist(itMv1.grade + itMv2.grade);
+                    E2GA_INSTRUMENT(instrumentation::countProduct(InstrumentedProduct::outer, itMv1.grade, itMv2.grade));
                     outerFunctionsContainer<T>[itMv1.grade][itMv2.grade](itMv1.vec, itMv2.vec, itMv3->vec);
                 }
             }
+        E2GA_PROFILE_SPARSITY(outer, *this, mv2, mv3);
         return mv3;
 #endif
     }
@@ -923,6 +1021,7 @@ namespace e2ga{
 
     template<typename T>
     Mvec<T> Mvec<T>::operator|(const Mvec<T> &mv2) const{
+        E2GA_TRACE_SCOPE("inner", gradeBitmap, mv2.gradeBitmap);
         // Loop over non-empty grade of mv1 and mv2
         // call the right explicit unrolled inner function using the functions pointer called innerFunctionsContainer
         Mvec<T> mv3;
@@ -936,14 +1035,17 @@ namespace e2ga{
                 // perform the inner product
                 int absGradeMv3 = std::abs((int)(itMv1.grade - itMv2.grade));
                 auto itMv3 = mv3.createVectorXdIfDoesNotExist(absGradeMv3);
+                E2GA_INSTRUMENT(instrumentation::countProduct(InstrumentedProduct::inner, itMv1.grade, itMv2.grade));
                 innerFunctionsContainer<T>[itMv1.grade][itMv2.grade](itMv1.vec, itMv2.vec, itMv3->vec);
 
                 // check if the result is non-zero
                 if(!((itMv3->vec.array() != 0.0).any())){
                     mv3.mvData.erase(itMv3);
+                    E2GA_INSTRUMENT(instrumentation::countKvecErasure());
                     mv3.gradeBitmap &= ~(1<<absGradeMv3);
                 }
             }
+        E2GA_PROFILE_SPARSITY(inner, *this, mv2, mv3);
         return mv3;
     }
 
@@ -970,6 +1072,7 @@ namespace e2ga{
 
     template<typename T>
     Mvec<T> Mvec<T>::operator>(const Mvec<T> &mv2) const{
+        E2GA_TRACE_SCOPE("rightContraction", gradeBitmap, mv2.gradeBitmap);
         // Loop over non-empty grade of mv1 and mv2
         // call the right explicit unrolled inner function using the functions pointer called innerFunctionsContainer
         Mvec<T> mv3;
@@ -983,15 +1086,18 @@ namespace e2ga{
                 // perform the inner product
                 int absGradeMv3 = std::abs((int)(itMv1.grade - itMv2.grade));
                 auto itMv3 = mv3.createVectorXdIfDoesNotExist(absGradeMv3);
+                E2GA_INSTRUMENT(instrumentation::countProduct(InstrumentedProduct::rightContraction, itMv1.grade, itMv2.grade));
                 innerFunctionsContainer<T>[itMv1.grade][itMv2.grade](itMv1.vec, itMv2.vec, itMv3->vec);
 
                 // check if the result is non-zero
                 if(!((itMv3->vec.array() != 0.0).any())){
                     mv3.mvData.erase(itMv3);
+                    E2GA_INSTRUMENT(instrumentation::countKvecErasure());
                     mv3.gradeBitmap &= ~(1<<absGradeMv3);
                 }
             }
 
+        E2GA_PROFILE_SPARSITY(rightContraction, *this, mv2, mv3);
         return mv3;
     }
 
@@ -1016,6 +1122,7 @@ namespace e2ga{
 
     template<typename T>
     Mvec<T> Mvec<T>::operator<(const Mvec<T> &mv2) const{
+        E2GA_TRACE_SCOPE("leftContraction", gradeBitmap, mv2.gradeBitmap);
 
         // Loop over non-empty grade of mv1 and mv2
         // call the right explicit unrolled inner function using the functions pointer called innerFunctionsContainer
@@ -1030,14 +1137,17 @@ namespace e2ga{
                 // perform the inner product
                 int absGradeMv3 = std::abs((int)(itMv1.grade - itMv2.grade));
                 auto itMv3 = mv3.createVectorXdIfDoesNotExist(absGradeMv3);
+                E2GA_INSTRUMENT(instrumentation::countProduct(InstrumentedProduct::leftContraction, itMv1.grade, itMv2.grade));
                 innerFunctionsContainer<T>[itMv1.grade][itMv2.grade](itMv1.vec, itMv2.vec, itMv3->vec);
 
                 // check if the result is non-zero
                 if(!((itMv3->vec.array() != 0.0).any())){
                     mv3.mvData.erase(itMv3);
+                    E2GA_INSTRUMENT(instrumentation::countKvecErasure());
                     mv3.gradeBitmap &= ~(1<<absGradeMv3);
                 }
             }
+        E2GA_PROFILE_SPARSITY(leftContraction, *this, mv2, mv3);
         return mv3;
     }
 
@@ -1062,6 +1172,7 @@ namespace e2ga{
 
     template<typename T>
     Mvec<T> Mvec<T>::scalarProduct(const Mvec<T> &mv2) const{
+        E2GA_TRACE_SCOPE("scalarProduct", gradeBitmap, mv2.gradeBitmap);
         // Loop over non-empty grade of mv1 and mv2
         // call the right explicit unrolled inner function using the functions pointer called innerFunctionsContainer
         Mvec<T> mv3;
@@ -1074,14 +1185,17 @@ namespace e2ga{
                 // perform the inner product
                 int absGradeMv3 = 0;
                 auto itMv3 = mv3.createVectorXdIfDoesNotExist(absGradeMv3);
+                E2GA_INSTRUMENT(instrumentation::countProduct(InstrumentedProduct::scalar, itMv1.grade, itMv2.grade));
                 innerFunctionsContainer<T>[itMv1.grade][itMv2.grade](itMv1.vec, itMv2.vec, itMv3->vec);
 
                 // check if the result is non-zero
                 if(!((itMv3->vec.array() != 0.0).any())){
                     mv3.mvData.erase(itMv3);
+                    E2GA_INSTRUMENT(instrumentation::countKvecErasure());
                     mv3.gradeBitmap &= ~(1<<absGradeMv3);
                 }
             }
+        E2GA_PROFILE_SPARSITY(scalarProduct, *this, mv2, mv3);
         return mv3;
     }
 
@@ -1089,6 +1203,7 @@ namespace e2ga{
 
     template<typename T>
     Mvec<T> Mvec<T>::outerPrimalDual(const Mvec<T> &mv2) const{
+        E2GA_TRACE_SCOPE("outerPrimalDual", gradeBitmap, mv2.gradeBitmap);
         Mvec<T> mv3;
 
         for(const auto & itMv1 : this->mvData)    // all per-grade component of mv1
@@ -1098,22 +1213,25 @@ namespace e2ga{
                 if(grade_mv3 <= algebraDimension) {
                     // handle the scalar product as well as the left contraction
                     auto itMv3 = mv3.createVectorXdIfDoesNotExist(grade_mv3);
-                    outerProductPrimalDual(itMv1.vec, itMv2.vec, itMv3->vec,
-                                           itMv1.grade, itMv2.grade, (unsigned)(algebraDimension-grade_mv3));
+                    E2GA_INSTRUMENT(instrumentation::countProduct(InstrumentedProduct::outerPrimalDual, itMv1.grade, itMv2.grade));
+                    outerPrimalDualFunctionsContainer<T>[itMv1.grade][itMv2.grade](itMv1.vec, itMv2.vec, itMv3->vec);
 
                     // check if the result is non-zero
                     if(!((itMv3->vec.array() != 0.0).any())){
                         mv3.mvData.erase(itMv3);
+                        E2GA_INSTRUMENT(instrumentation::countKvecErasure());
                         mv3.gradeBitmap &= ~(1<<grade_mv3);
                     }
                 }
             }
 
+        E2GA_PROFILE_SPARSITY(outerPrimalDual, *this, mv2, mv3);
         return mv3;
     }
 
     template<typename T>
     Mvec<T> Mvec<T>::outerDualPrimal(const Mvec<T> &mv2) const{
+        E2GA_TRACE_SCOPE("outerDualPrimal", gradeBitmap, mv2.gradeBitmap);
         Mvec<T> mv3;
 
         for(const auto & itMv1 : this->mvData)    // all per-grade component of mv1
@@ -1123,24 +1241,27 @@ namespace e2ga{
                 if(grade_mv3 <= algebraDimension) {
                     // handle the scalar product as well as the left contraction
                     auto itMv3 = mv3.createVectorXdIfDoesNotExist(grade_mv3);
-                    outerProductDualPrimal(itMv1.vec, itMv2.vec, itMv3->vec,
-                                           itMv1.grade, itMv2.grade, (unsigned)(algebraDimension-grade_mv3));
+                    E2GA_INSTRUMENT(instrumentation::countProduct(InstrumentedProduct::outerDualPrimal, itMv1.grade, itMv2.grade));
+                    outerDualPrimalFunctionsContainer<T>[itMv1.grade][itMv2.grade](itMv1.vec, itMv2.vec, itMv3->vec);
 
                     // check if the result is non-zero
                     if(!((itMv3->vec.array() != 0.0).any())){
                         mv3.mvData.erase(itMv3);
+                        E2GA_INSTRUMENT(instrumentation::countKvecErasure());
                         mv3.gradeBitmap &= ~(1<<grade_mv3);
                     }
                 }
             }
 
 
+        E2GA_PROFILE_SPARSITY(outerDualPrimal, *this, mv2, mv3);
         return mv3;
 
     }
 
     template<typename T>
     Mvec<T> Mvec<T>::outerDualDual(const Mvec<T> &mv2) const{
+        E2GA_TRACE_SCOPE("outerDualDual", gradeBitmap, mv2.gradeBitmap);
         Mvec<T> mv3;
 
         for(const auto & itMv1 : this->mvData)    // all per-grade component of mv1
@@ -1150,18 +1271,20 @@ namespace e2ga{
                 if(grade_mv3 <= algebraDimension) {
                     // handle the scalar product as well as the left contraction
                     auto itMv3 = mv3.createVectorXdIfDoesNotExist(grade_mv3);
-                    outerProductDualDual(itMv1.vec, itMv2.vec, itMv3->vec,
-                                           itMv1.grade, itMv2.grade, (unsigned)(algebraDimension-grade_mv3));
+                    E2GA_INSTRUMENT(instrumentation::countProduct(InstrumentedProduct::outerDualDual, itMv1.grade, itMv2.grade));
+                    outerDualDualFunctionsContainer<T>[itMv1.grade][itMv2.grade](itMv1.vec, itMv2.vec, itMv3->vec);
 
                     // check if the result is non-zero
                     if(!((itMv3->vec.array() != 0.0).any())){
                         mv3.mvData.erase(itMv3);
+                        E2GA_INSTRUMENT(instrumentation::countKvecErasure());
                         mv3.gradeBitmap &= ~(1<<grade_mv3);
                     }
                 }
             }
 
 
+        E2GA_PROFILE_SPARSITY(outerDualDual, *this, mv2, mv3);
         return mv3;
 
     }
@@ -1170,6 +1293,7 @@ namespace e2ga{
 
     template<typename T>
     Mvec<T> Mvec<T>::dotProduct(const Mvec<T> &mv2) const{
+        E2GA_TRACE_SCOPE("dotProduct", gradeBitmap, mv2.gradeBitmap);
         // Loop over non-empty grade of mv1 and mv2
         // call the right explicit unrolled inner function using the functions pointer called innerFunctionsContainer
         Mvec<T> mv3;
@@ -1179,26 +1303,32 @@ namespace e2ga{
                 // perform the inner product
                 int absGradeMv3 = std::abs((int)(itMv1.grade - itMv2.grade));
                 auto itMv3 = mv3.createVectorXdIfDoesNotExist(absGradeMv3);
+                E2GA_INSTRUMENT(instrumentation::countProduct(InstrumentedProduct::dot, itMv1.grade, itMv2.grade));
                 innerFunctionsContainer<T>[itMv1.grade][itMv2.grade](itMv1.vec, itMv2.vec, itMv3->vec);
 
                 // check if the result is non-zero
                 if(!((itMv3->vec.array() != 0.0).any())){
                     mv3.mvData.erase(itMv3);
+                    E2GA_INSTRUMENT(instrumentation::countKvecErasure());
                     mv3.gradeBitmap &= ~(1<<absGradeMv3);
                 }
             }
+        E2GA_PROFILE_SPARSITY(dotProduct, *this, mv2, mv3);
         return mv3;
     }
 
 
     template<typename T>
     Mvec<T> Mvec<T>::operator*(const Mvec<T> &mv2) const {
+        E2GA_TRACE_SCOPE("geometric", gradeBitmap, mv2.gradeBitmap);
         // Loop over non-empty grade of mv1 and mv2
         // call the right explicit unrolled product function using the functions pointer
         Mvec<T> mv3;
         for(const auto & itMv1 : this->mvData)
             for(const auto & itMv2 : mv2.mvData){
                 
+                E2GA_INSTRUMENT(instrumentation::countProduct(InstrumentedProduct::geometric, itMv1.grade, itMv2.grade));
+
                 // outer product block
                 unsigned int gradeOuter = itMv1.grade + itMv2.grade;
                 if(gradeOuter <=  algebraDimension ){
@@ -1206,6 +1336,7 @@ namespace e2ga{
                     outerFunctionsContainer<T>[itMv1.grade][itMv2.grade](itMv1.vec, itMv2.vec, itMv3->vec);
                     if(!((itMv3->vec.array() != 0.0).any())){
                         mv3.mvData.erase(itMv3);
+                        E2GA_INSTRUMENT(instrumentation::countKvecErasure());
                         mv3.gradeBitmap &= ~(1<<gradeOuter);
                     }
                 }
@@ -1219,6 +1350,7 @@ namespace e2ga{
                     // check if the result is non-zero
                     if(!((itMv3->vec.array() != 0.0).any())){
                         mv3.mvData.erase(itMv3);
+                        E2GA_INSTRUMENT(instrumentation::countKvecErasure());
                         mv3.gradeBitmap &= ~(1<<gradeInner);
                     }
 
@@ -1230,11 +1362,183 @@ namespace e2ga{
                         // check if the result is non-zero
                         if(!((itMv3->vec.array() != 0.0).any())){
                             mv3.mvData.erase(itMv3);
+                            E2GA_INSTRUMENT(instrumentation::countKvecErasure());
                             mv3.gradeBitmap &= ~(1<<gradeResult);
                         }
                     }
                 }
             }
+        E2GA_PROFILE_SPARSITY(geometric, *this, mv2, mv3);
+        return mv3;
+    }
+
+
+    template<typename T>
+    Mvec<T> Mvec<T>::prunedProduct(const Mvec<T> &mv2, const InstrumentedProduct product, const T epsilon) const {
+        // same loops as the operators, but the kernels accumulate in the workspace of the thread, which is rounded once
+        // the product is complete: the partial sums must not be rounded
+        PrunedWorkspace<T>& workspace = PrunedWorkspace<T>::local();
+        workspace.gradeBitmap = 0;
+        for(const auto & itMv1 : this->mvData)
+            for(const auto & itMv2 : mv2.mvData){
+                const unsigned int gradeOuter = itMv1.grade + itMv2.grade;
+                const unsigned int gradeInner = (unsigned int)std::abs((int)(itMv1.grade-itMv2.grade));
+                const unsigned int gradeDual = itMv1.grade + (algebraDimension-itMv2.grade);
+                switch(product){
+                    case InstrumentedProduct::outer:
+                        if(gradeOuter > algebraDimension) continue;
+                        E2GA_INSTRUMENT(instrumentation::countProduct(product, itMv1.grade, itMv2.grade));
+                        outerFunctionsContainer<T>[itMv1.grade][itMv2.grade](itMv1.vec, itMv2.vec, workspace.kvec(gradeOuter));
+                        break;
+                    case InstrumentedProduct::inner:
+                    case InstrumentedProduct::leftContraction:
+                    case InstrumentedProduct::rightContraction:
+                    case InstrumentedProduct::scalar:
+                    case InstrumentedProduct::dot:
+                        if((product == InstrumentedProduct::inner && itMv1.grade*itMv2.grade == 0)
+                           || (product == InstrumentedProduct::leftContraction && itMv1.grade > itMv2.grade)
+                           || (product == InstrumentedProduct::rightContraction && itMv1.grade < itMv2.grade)
+                           || (product == InstrumentedProduct::scalar && itMv1.grade != itMv2.grade))
+                            continue;
+                        E2GA_INSTRUMENT(instrumentation::countProduct(product, itMv1.grade, itMv2.grade));
+                        innerFunctionsContainer<T>[itMv1.grade][itMv2.grade](itMv1.vec, itMv2.vec, workspace.kvec(gradeInner));
+                        break;
+                    case InstrumentedProduct::outerPrimalDual:
+                        if(gradeDual > algebraDimension) continue;
+                        E2GA_INSTRUMENT(instrumentation::countProduct(product, itMv1.grade, itMv2.grade));
+                        outerPrimalDualFunctionsContainer<T>[itMv1.grade][itMv2.grade](itMv1.vec, itMv2.vec, workspace.kvec(gradeDual));
+                        break;
+                    case InstrumentedProduct::outerDualPrimal:
+                        if(gradeDual > algebraDimension) continue;
+                        E2GA_INSTRUMENT(instrumentation::countProduct(product, itMv1.grade, itMv2.grade));
+                        outerDualPrimalFunctionsContainer<T>[itMv1.grade][itMv2.grade](itMv1.vec, itMv2.vec, workspace.kvec(gradeDual));
+                        break;
+                    case InstrumentedProduct::outerDualDual:
+                        if(gradeDual > algebraDimension) continue;
+                        E2GA_INSTRUMENT(instrumentation::countProduct(product, itMv1.grade, itMv2.grade));
+                        outerDualDualFunctionsContainer<T>[itMv1.grade][itMv2.grade](itMv1.vec, itMv2.vec, workspace.kvec(gradeDual));
+                        break;
+                    case InstrumentedProduct::geometric:
+                        E2GA_INSTRUMENT(instrumentation::countProduct(product, itMv1.grade, itMv2.grade));
+                        // outer product block
+                        if(gradeOuter <= algebraDimension)
+                            outerFunctionsContainer<T>[itMv1.grade][itMv2.grade](itMv1.vec, itMv2.vec, workspace.kvec(gradeOuter));
+                        // inner product block, then the grades in between
+                        if(gradeInner != gradeOuter) {
+                            innerFunctionsContainer<T>[itMv1.grade][itMv2.grade](itMv1.vec, itMv2.vec, workspace.kvec(gradeInner));
+                            int gradeMax = std::min(((2*algebraDimension)-gradeOuter)+1,gradeOuter);
+                            for (int gradeResult = gradeInner+2; gradeResult < gradeMax; gradeResult+=2)
+                                geometricFunctionsContainer<T>[gradeResult][itMv1.grade][itMv2.grade](itMv1.vec, itMv2.vec, workspace.kvec(gradeResult));
+                        }
+                        break;
+                }
+            }
+        Mvec<T> mv3;
+        mv3.storePruned(workspace, epsilon);
+        return mv3;
+    }
+
+
+    template<typename T>
+    void Mvec<T>::storePruned(PrunedWorkspace<T> &workspace, const T epsilon) {
+        for(unsigned int grade=0; grade<=algebraDimension; ++grade){
+            if((workspace.gradeBitmap & (1 << grade)) == 0)
+                continue;
+            auto & kvec = workspace.kvecs[grade];
+            bool nonZero = false;
+            for(unsigned int i=0; i<(unsigned int)kvec.size(); ++i){
+                if(fabs(kvec.coeff(i)) <= epsilon)
+                    kvec.coeffRef(i) = 0.0;
+                else
+                    nonZero = true;
+            }
+            if(!nonZero)
+                continue;
+            mvData.push_back({kvec, grade});
+            E2GA_INSTRUMENT(instrumentation::countKvecAllocation());
+            gradeBitmap |= 1 << grade;
+        }
+        workspace.gradeBitmap = 0;
+    }
+
+
+    template<typename T>
+    Mvec<T> Mvec<T>::geometricProduct(const Mvec<T> &mv2, const T epsilon) const {
+        E2GA_TRACE_SCOPE("geometric", gradeBitmap, mv2.gradeBitmap);
+        Mvec<T> mv3 = prunedProduct(mv2, InstrumentedProduct::geometric, epsilon);
+        E2GA_PROFILE_SPARSITY(geometric, *this, mv2, mv3);
+        return mv3;
+    }
+
+    template<typename T>
+    Mvec<T> Mvec<T>::outerProduct(const Mvec<T> &mv2, const T epsilon) const {
+        E2GA_TRACE_SCOPE("outer", gradeBitmap, mv2.gradeBitmap);
+        Mvec<T> mv3 = prunedProduct(mv2, InstrumentedProduct::outer, epsilon);
+        E2GA_PROFILE_SPARSITY(outer, *this, mv2, mv3);
+        return mv3;
+    }
+
+    template<typename T>
+    Mvec<T> Mvec<T>::innerProduct(const Mvec<T> &mv2, const T epsilon) const {
+        E2GA_TRACE_SCOPE("inner", gradeBitmap, mv2.gradeBitmap);
+        Mvec<T> mv3 = prunedProduct(mv2, InstrumentedProduct::inner, epsilon);
+        E2GA_PROFILE_SPARSITY(inner, *this, mv2, mv3);
+        return mv3;
+    }
+
+    template<typename T>
+    Mvec<T> Mvec<T>::leftContraction(const Mvec<T> &mv2, const T epsilon) const {
+        E2GA_TRACE_SCOPE("leftContraction", gradeBitmap, mv2.gradeBitmap);
+        Mvec<T> mv3 = prunedProduct(mv2, InstrumentedProduct::leftContraction, epsilon);
+        E2GA_PROFILE_SPARSITY(leftContraction, *this, mv2, mv3);
+        return mv3;
+    }
+
+    template<typename T>
+    Mvec<T> Mvec<T>::rightContraction(const Mvec<T> &mv2, const T epsilon) const {
+        E2GA_TRACE_SCOPE("rightContraction", gradeBitmap, mv2.gradeBitmap);
+        Mvec<T> mv3 = prunedProduct(mv2, InstrumentedProduct::rightContraction, epsilon);
+        E2GA_PROFILE_SPARSITY(rightContraction, *this, mv2, mv3);
+        return mv3;
+    }
+
+    template<typename T>
+    Mvec<T> Mvec<T>::scalarProduct(const Mvec<T> &mv2, const T epsilon) const {
+        E2GA_TRACE_SCOPE("scalarProduct", gradeBitmap, mv2.gradeBitmap);
+        Mvec<T> mv3 = prunedProduct(mv2, InstrumentedProduct::scalar, epsilon);
+        E2GA_PROFILE_SPARSITY(scalarProduct, *this, mv2, mv3);
+        return mv3;
+    }
+
+    template<typename T>
+    Mvec<T> Mvec<T>::dotProduct(const Mvec<T> &mv2, const T epsilon) const {
+        E2GA_TRACE_SCOPE("dotProduct", gradeBitmap, mv2.gradeBitmap);
+        Mvec<T> mv3 = prunedProduct(mv2, InstrumentedProduct::dot, epsilon);
+        E2GA_PROFILE_SPARSITY(dotProduct, *this, mv2, mv3);
+        return mv3;
+    }
+
+    template<typename T>
+    Mvec<T> Mvec<T>::outerPrimalDual(const Mvec<T> &mv2, const T epsilon) const {
+        E2GA_TRACE_SCOPE("outerPrimalDual", gradeBitmap, mv2.gradeBitmap);
+        Mvec<T> mv3 = prunedProduct(mv2, InstrumentedProduct::outerPrimalDual, epsilon);
+        E2GA_PROFILE_SPARSITY(outerPrimalDual, *this, mv2, mv3);
+        return mv3;
+    }
+
+    template<typename T>
+    Mvec<T> Mvec<T>::outerDualPrimal(const Mvec<T> &mv2, const T epsilon) const {
+        E2GA_TRACE_SCOPE("outerDualPrimal", gradeBitmap, mv2.gradeBitmap);
+        Mvec<T> mv3 = prunedProduct(mv2, InstrumentedProduct::outerDualPrimal, epsilon);
+        E2GA_PROFILE_SPARSITY(outerDualPrimal, *this, mv2, mv3);
+        return mv3;
+    }
+
+    template<typename T>
+    Mvec<T> Mvec<T>::outerDualDual(const Mvec<T> &mv2, const T epsilon) const {
+        E2GA_TRACE_SCOPE("outerDualDual", gradeBitmap, mv2.gradeBitmap);
+        Mvec<T> mv3 = prunedProduct(mv2, InstrumentedProduct::outerDualDual, epsilon);
+        E2GA_PROFILE_SPARSITY(outerDualDual, *this, mv2, mv3);
         return mv3;
     }
 
@@ -1305,9 +1609,12 @@ namespace e2ga{
 
     template<typename T>
     Mvec<T> Mvec<T>::inv() const {
+        E2GA_TRACE_SCOPE("inv", gradeBitmap, 0);
         T n = this->quadraticNorm();
-        if(n<std::numeric_limits<T>::epsilon() && n>-std::numeric_limits<T>::epsilon())
+        if(n<std::numeric_limits<T>::epsilon() && n>-std::numeric_limits<T>::epsilon()){
+            E2GA_INSTRUMENT(instrumentation::countInverseFailure());
             return Mvec<T>(); // return 0, this is was gaviewer does.
+        }
         return this->reverse() / n;
     }
 
@@ -1360,6 +1667,7 @@ namespace e2ga{
     // compute the dual of a multivector (i.e mv* = mv.reverse() * Iinv)
     template<typename T>
     Mvec<T> Mvec<T>::dual() const {
+        E2GA_TRACE_SCOPE("dual", gradeBitmap, 0);
         Mvec<T> mvResult;
         // for each k-vectors of the multivector
         for(auto itMv=mvData.rbegin(); itMv!=mvData.rend(); ++itMv){
@@ -1367,17 +1675,32 @@ namespace e2ga{
             // create the dual k-vector
             Kvec<T> kvec ={itMv->vec,algebraDimension-(itMv->grade)};
 
-            // some elements need to be permuted
+            // some elements need to be permuted, and the inner product may involve some constant multiplication for the dual elements
             for(unsigned int i=0;i<binomialArray[itMv->grade];++i)
-                kvec.vec.coeffRef(dualPermutations[itMv->grade][i]) = itMv->vec.coeff(i);
-
-            // the inner product may involve some constant multiplucation for the dual elements
-            kvec.vec = kvec.vec.cwiseProduct(dualCoefficients[itMv->grade].template cast<T>());
+                kvec.vec.coeffRef(dualPermutations[itMv->grade][i]) = itMv->vec.coeff(i) * T(dualCoefficients[itMv->grade][dualPermutations[itMv->grade][i]]);
 
             // add the k-vector to the resulting multivector
             mvResult.mvData.push_back(kvec);
+            E2GA_INSTRUMENT(instrumentation::countKvecAllocation());
             mvResult.gradeBitmap |= (1 << kvec.grade);
         }
+        E2GA_PROFILE_SPARSITY_UNARY(dual, *this, mvResult);
+        return mvResult;
+    }
+
+    template<typename T>
+    Mvec<T> Mvec<T>::dual(const T epsilon) const {
+        E2GA_TRACE_SCOPE("dual", gradeBitmap, 0);
+        PrunedWorkspace<T>& workspace = PrunedWorkspace<T>::local();
+        workspace.gradeBitmap = 0;
+        for(const auto & itMv : mvData){
+            auto & kvec = workspace.kvec(algebraDimension-itMv.grade);
+            for(unsigned int i=0;i<binomialArray[itMv.grade];++i)
+                kvec.coeffRef(dualPermutations[itMv.grade][i]) = itMv.vec.coeff(i) * T(dualCoefficients[itMv.grade][dualPermutations[itMv.grade][i]]);
+        }
+        Mvec<T> mvResult;
+        mvResult.storePruned(workspace, epsilon);
+        E2GA_PROFILE_SPARSITY_UNARY(dual, *this, mvResult);
         return mvResult;
     }
 
@@ -1385,6 +1708,7 @@ namespace e2ga{
     // \return - the reverse of the multivector
     template<typename T>
     Mvec<T> Mvec<T>::reverse() const {
+        E2GA_TRACE_SCOPE("reverse", gradeBitmap, 0);
         Mvec<T> mv(*this);
         for(auto & itMv : mv.mvData)
             if(signReversePerGrade[itMv.grade] == -1)
@@ -1405,6 +1729,7 @@ namespace e2ga{
 
         // else return the grade 'i' data
         mv.mvData.push_back(*it);
+        E2GA_INSTRUMENT(instrumentation::countKvecAllocation());
         mv.gradeBitmap = 1 << (i);
 
         return mv;
@@ -1426,6 +1751,7 @@ namespace e2ga{
 
     template<typename T>
     void Mvec<T>::roundZero(const T epsilon) {
+        E2GA_TRACE_SCOPE("roundZero", gradeBitmap, 0);
         // loop over each k-vector of the multivector
         auto itMv=mvData.begin();
         while(itMv != mvData.end()){
@@ -1437,12 +1763,53 @@ namespace e2ga{
             if(!((itMv->vec.array() != 0.0).any())){
                 gradeBitmap = gradeBitmap - (1 << itMv->grade);
                 mvData.erase(itMv++);
+                E2GA_INSTRUMENT(instrumentation::countKvecErasure());
             }
             else ++itMv;
         }
     }
 
 
+    template<typename T>
+    MvecSparsity Mvec<T>::sparsity(const T epsilon) const {
+        MvecSparsity sparsity;
+        sparsity.gradeBitmap = gradeBitmap;
+        for(const auto & itMv : mvData){
+            sparsity.stored += (unsigned int)itMv.vec.size();
+            for(unsigned int i=0; i<(unsigned int)itMv.vec.size(); ++i){
+                if(itMv.vec.coeff(i) == T(0)) ++sparsity.exactZeros;
+                else if(fabs(itMv.vec.coeff(i)) <= epsilon) ++sparsity.nearZeros;
+            }
+        }
+        return sparsity;
+    }
+
+
+    template<typename T>
+    void Mvec<T>::toDense(T* dense) const {
+        std::fill(dense, dense + multivectorSize, T(0));
+        for(const auto & itMv : mvData)
+            std::copy(itMv.vec.data(), itMv.vec.data() + itMv.vec.size(), dense + perGradeStartingIndex[itMv.grade]);
+    }
+
+
+    template<typename T>
+    void Mvec<T>::fromDense(const T* dense) {
+        mvData.clear();
+        gradeBitmap = 0;
+        for(unsigned int grade=0; grade<=algebraDimension; ++grade){
+            Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>> kvector(dense + perGradeStartingIndex[grade], binomialArray[grade]);
+            // only store the non-zero k-vectors
+            if(!((kvector.array() != 0.0).any()))
+                continue;
+            Kvec<T> kvec = {kvector, grade};
+            mvData.push_back(kvec);
+            E2GA_INSTRUMENT(instrumentation::countKvecAllocation());
+            gradeBitmap |= 1 << grade;
+        }
+    }
+
+
     template<typename T>
     void Mvec<T>::clear(const int grade) {
 
@@ -1458,6 +1825,7 @@ namespace e2ga{
         if(iter != mvData.end()) {
             gradeBitmap = gradeBitmap - (1 << iter->grade);
             iter = mvData.erase(iter);
+            E2GA_INSTRUMENT(instrumentation::countKvecErasure());
         }
     }
 
@@ -1477,41 +1845,25 @@ namespace e2ga{
 
     /// \cond DEV
     template<typename U>
-    void traverseKVector(std::ostream &stream, const Eigen::Matrix<U, Eigen::Dynamic, 1> kvector, unsigned int gradeMV, bool& moreThanOne ){
-
-        // version with XOR indices
-        // for the current grade, generate all the XOR indices
-        std::vector<bool> booleanXorIndex(algebraDimension);
-        std::fill(booleanXorIndex.begin(), booleanXorIndex.end(), false);
-        // build the first xorIndex of grade 'grade' (with 'grade' values to true).
-        std::fill(booleanXorIndex.begin(), booleanXorIndex.begin() + gradeMV, true);
-        unsigned int positionInKVector = 0;
-
-        do {
-            // convert the vector of bool to the string containing all the basis vectors
-            std::string basisBlades={};
-            for(unsigned int i=0; i<algebraDimension; ++i) {
-                if(booleanXorIndex[i]) {
-                    basisBlades += basisVectors[i];
-                }
+    void traverseKVector(std::ostream &stream, const Eigen::Matrix<U, Eigen::Dynamic, 1> &kvector, unsigned int gradeMV, bool& moreThanOne ){
+
+        // names of the basis blades of the grade, precomputed in the order of the k-vector
+        const char* const* basisBlades = basisBladeNames + perGradeStartingIndex[gradeMV];
+        for(unsigned int positionInKVector=0; positionInKVector<(unsigned int)kvector.size(); ++positionInKVector){
+
+            if(kvector.coeff(positionInKVector) == 0)
+                continue;
+
+            if(!(moreThanOne)){
+                stream<< kvector.coeff(positionInKVector) << "*e" << basisBlades[positionInKVector];
+                moreThanOne = true;
+            }else{
+                if(kvector.coeff(positionInKVector)>0)
+                    stream<< " + " << kvector.coeff(positionInKVector) << "*e" << basisBlades[positionInKVector];
+                else
+                    stream<< " - " << -kvector.coeff(positionInKVector) << "*e" << basisBlades[positionInKVector];
             }
-
-            if(kvector.coeff(positionInKVector)!= 0) {
-                if(!(moreThanOne)){
-                    stream<< kvector.coeff(positionInKVector) << "*e"+ basisBlades;
-                    moreThanOne = true;
-                }else{
-                    if(kvector.coeff(positionInKVector)>0)
-                        stream<< " + " << kvector.coeff(positionInKVector) << "*e" + basisBlades;
-                    else
-                        stream<< " - " << -kvector.coeff(positionInKVector) << "*e" + basisBlades;
-                }
-            }
-
-            positionInKVector++;
-
-        } while(std::prev_permutation(booleanXorIndex.begin(), booleanXorIndex.end())); // compute next permutation of the true values of booleanXorIndex
-
+        }
     }
     /// \endcond
 
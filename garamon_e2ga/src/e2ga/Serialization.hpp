@@ -0,0 +1,169 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Serialization.hpp
+// This file is part of the Garamon for e2ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Serialization.hpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Compact binary encoding of multivectors and arrays of multivectors: a grade bitmap followed by the coefficients
+/// of the grades it contains only. The values are written in the byte order of the machine.
+
+
+#ifndef E2GA_SERIALIZATION_HPP__
+#define E2GA_SERIALIZATION_HPP__
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#include "e2ga/Mvec.hpp"
+#include "e2ga/MvecArray.hpp"
+
+
+/*!
+ * @namespace e2ga
+ */
+namespace e2ga {
+
+    /// \cond DEV
+    /// \brief append the bytes of value to buffer
+    template<typename V>
+    void appendBytes(std::string& buffer, const V& value) {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(V));
+    }
+
+    /// \brief read a value from the bytes of buffer at position offset, then move offset after it
+    /// \return false if buffer is too short
+    template<typename V>
+    bool readBytes(const std::string& buffer, std::size_t& offset, V& value) {
+        if(buffer.size() < offset + sizeof(V)) return false;
+        std::memcpy(&value, buffer.data() + offset, sizeof(V));
+        offset += sizeof(V);
+        return true;
+    }
+
+    /// \brief number of coefficients of the grades of gradeBitmap, or 0 if it contains grades above algebraDimension
+    inline std::size_t serializedCoefficientCount(const std::uint32_t gradeBitmap) {
+        if(gradeBitmap >> (algebraDimension+1)) return 0;
+        std::size_t coefficientCount = 0;
+        for(unsigned int grade=0; grade<=algebraDimension; ++grade)
+            if(gradeBitmap & (1u << grade))
+                coefficientCount += binomialArray[grade];
+        return coefficientCount;
+    }
+
+    /// \brief grade bitmap of the non-zero k-vectors of count multivectors stored as a structure of arrays (see MvecArray)
+    template<typename T>
+    std::uint32_t nonZeroGrades(const T* coefficients, const std::size_t count) {
+        std::uint32_t gradeBitmap = 0;
+        for(unsigned int grade=0; grade<=algebraDimension; ++grade){
+            const T* first = coefficients + perGradeStartingIndex[grade]*count;
+            for(const T* coefficient = first; coefficient != first + binomialArray[grade]*count; ++coefficient)
+                if(*coefficient != T(0)){
+                    gradeBitmap |= 1u << grade;
+                    break;
+                }
+        }
+        return gradeBitmap;
+    }
+    /// \endcond
+
+
+    /// \brief binary encoding of a multivector: sizeof(T) on one byte, the bitmap of its non-zero grades on 4 bytes, then
+    /// the coefficients of each of these grades, by increasing grade.
+    template<typename T>
+    std::string serialize(const Mvec<T>& mv) {
+        T dense[multivectorSize];
+        mv.toDense(dense);
+        const std::uint32_t gradeBitmap = nonZeroGrades(dense, 1);
+        std::string buffer;
+        buffer.reserve(1 + sizeof(gradeBitmap) + serializedCoefficientCount(gradeBitmap)*sizeof(T));
+        appendBytes(buffer, (std::uint8_t)sizeof(T));
+        appendBytes(buffer, gradeBitmap);
+        for(unsigned int grade=0; grade<=algebraDimension; ++grade)
+            if(gradeBitmap & (1u << grade))
+                buffer.append(reinterpret_cast<const char*>(dense + perGradeStartingIndex[grade]), binomialArray[grade]*sizeof(T));
+        return buffer;
+    }
+
+    /// \brief decode a multivector encoded by serialize
+    /// \param buffer - the encoded multivector
+    /// \param mv - the decoded multivector
+    /// \return false if buffer is not the encoding of a multivector of this algebra with coefficients of type T, mv is then unchanged
+    template<typename T>
+    bool deserialize(const std::string& buffer, Mvec<T>& mv) {
+        std::size_t offset = 0;
+        std::uint8_t coefficientSize;
+        std::uint32_t gradeBitmap;
+        if(!readBytes(buffer, offset, coefficientSize) || coefficientSize != sizeof(T) || !readBytes(buffer, offset, gradeBitmap))
+            return false;
+        if((gradeBitmap >> (algebraDimension+1)) || buffer.size() != offset + serializedCoefficientCount(gradeBitmap)*sizeof(T))
+            return false;
+        T dense[multivectorSize] = {};
+        for(unsigned int grade=0; grade<=algebraDimension; ++grade){
+            if(!(gradeBitmap & (1u << grade))) continue;
+            std::memcpy(dense + perGradeStartingIndex[grade], buffer.data() + offset, binomialArray[grade]*sizeof(T));
+            offset += binomialArray[grade]*sizeof(T);
+        }
+        mv.fromDense(dense);
+        return true;
+    }
+
+    /// \brief binary encoding of an array of multivectors: sizeof(T) on one byte, the number of multivectors on 8 bytes,
+    /// the bitmap of the grades that are non-zero in at least one multivector on 4 bytes, then the rows of coefficients (see MvecArray) of each of these grades.
+    /// A non-empty array of zeros is written with its grade 0: the coefficients of an encoding bound its number of multivectors.
+    template<typename T>
+    std::string serialize(const MvecArray<T>& array) {
+        const std::size_t count = array.size();
+        std::uint32_t gradeBitmap = nonZeroGrades(array.data(), count);
+        if(gradeBitmap == 0 && count != 0) gradeBitmap = 1;
+        std::string buffer;
+        buffer.reserve(1 + sizeof(std::uint64_t) + sizeof(gradeBitmap) + serializedCoefficientCount(gradeBitmap)*count*sizeof(T));
+        appendBytes(buffer, (std::uint8_t)sizeof(T));
+        appendBytes(buffer, (std::uint64_t)count);
+        appendBytes(buffer, gradeBitmap);
+        for(unsigned int grade=0; grade<=algebraDimension; ++grade)
+            if(gradeBitmap & (1u << grade))
+                buffer.append(reinterpret_cast<const char*>(array.coefficientRow(perGradeStartingIndex[grade])), binomialArray[grade]*count*sizeof(T));
+        return buffer;
+    }
+
+    /// \brief decode an array of multivectors encoded by serialize
+    /// \param buffer - the encoded array
+    /// \param array - the decoded array
+    /// \return false if buffer is not the encoding of an array of this algebra with coefficients of type T, array is then unchanged.
+    /// The encoding is checked before the array is allocated, whose size is bounded by the one of buffer.
+    template<typename T>
+    bool deserialize(const std::string& buffer, MvecArray<T>& array) {
+        std::size_t offset = 0;
+        std::uint8_t coefficientSize;
+        std::uint64_t count;
+        std::uint32_t gradeBitmap;
+        if(!readBytes(buffer, offset, coefficientSize) || coefficientSize != sizeof(T)
+           || !readBytes(buffer, offset, count) || !readBytes(buffer, offset, gradeBitmap))
+            return false;
+        // a non-empty array has coefficients (see serialize), whose size bounds count: a few bytes cannot allocate a huge
+        // array. The size of the array, and then serializedCoefficientCount(gradeBitmap)*count*sizeof(T), do not overflow.
+        const std::uint64_t largestCount = (std::uint64_t)std::numeric_limits<std::ptrdiff_t>::max() / (multivectorSize*sizeof(T));
+        if((gradeBitmap >> (algebraDimension+1)) || (gradeBitmap == 0 && count != 0) || count > largestCount
+           || buffer.size() - offset != serializedCoefficientCount(gradeBitmap)*(std::size_t)count*sizeof(T))
+            return false;
+        MvecArray<T> result((std::size_t)count);
+        for(unsigned int grade=0; grade<=algebraDimension; ++grade){
+            if(!(gradeBitmap & (1u << grade))) continue;
+            std::memcpy(result.coefficientRow(perGradeStartingIndex[grade]), buffer.data() + offset, binomialArray[grade]*count*sizeof(T));
+            offset += binomialArray[grade]*count*sizeof(T);
+        }
+        array = std::move(result);
+        return true;
+    }
+
+}/// End of Namespace
+
+#endif // E2GA_SERIALIZATION_HPP__
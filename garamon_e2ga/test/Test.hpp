@@ -0,0 +1,49 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Test.hpp
+// This file is part of the Garamon for e2ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Test.hpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Checks of the test programs of e2ga, run by ctest. A test program reports each failed check on the error output
+/// and returns testResult(): 0 if all the checks passed, 1 otherwise.
+
+
+#ifndef E2GA_TEST_HPP__
+#define E2GA_TEST_HPP__
+#pragma once
+
+#include <cstdio>
+#include <string>
+
+
+namespace e2ga {
+namespace test {
+
+    /// \brief number of failed checks of the program
+    inline unsigned int& failures() {
+        static unsigned int count = 0;
+        return count;
+    }
+
+    /// \brief report the check described by what as failed when condition is false
+    inline void check(const bool condition, const std::string& what) {
+        if(condition) return;
+        ++failures();
+        std::fprintf(stderr, "check failed: %s\n", what.c_str());
+    }
+
+    /// \brief exit status of the program: 1 if a check failed
+    inline int testResult() {
+        if(failures() != 0) std::fprintf(stderr, "%u check(s) failed\n", failures());
+        return failures() == 0 ? 0 : 1;
+    }
+
+}/// End of Namespace test
+}/// End of Namespace
+
+#endif // E2GA_TEST_HPP__
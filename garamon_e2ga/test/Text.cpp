@@ -0,0 +1,124 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Text.cpp
+// This file is part of the Garamon for e2ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Text.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Test of the text of the multivectors (Text.hpp), for float and double:
+///  - the round trips of random multivectors of each set of grades, of 0 and of extreme coefficients, through toText,
+///    and through operator<< with max_digits10 digits,
+///  - a sequence of multivectors, one per line, read by parseText,
+///  - the basis vectors of a blade in any order, the terms of a blade added,
+///  - the syntax errors are rejected and leave the multivector unchanged.
+
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "e2ga/Mvec.hpp"
+#include "e2ga/Text.hpp"
+
+#include "RandomMvec.hpp"
+#include "Test.hpp"
+
+
+namespace {
+
+    using e2ga::test::check;
+    using e2ga::test::randomMvec;
+    using e2ga::test::sameMvec;
+    using e2ga::test::typeName;
+
+    template<typename T>
+    void testRoundTrips(std::mt19937& randomEngine) {
+        bool texts = true, streams = true;
+        std::vector<e2ga::Mvec<T>> mvs;
+        for(std::uint32_t gradeBitmap=0; gradeBitmap<=e2ga::test::allGrades; ++gradeBitmap){
+            const e2ga::Mvec<T> mv = randomMvec<T>(randomEngine, gradeBitmap);
+            e2ga::Mvec<T> parsed;
+            texts = texts && e2ga::fromText(e2ga::toText(mv), parsed) && sameMvec(parsed, mv);
+
+            std::ostringstream stream;
+            stream.precision(std::numeric_limits<T>::max_digits10);
+            stream << mv;
+            parsed = e2ga::Mvec<T>();
+            streams = streams && e2ga::fromText(stream.str(), parsed) && sameMvec(parsed, mv);
+            mvs.push_back(mv);
+        }
+        check(texts, "round trip of multivectors of each set of grades by toText, " + typeName<T>());
+        check(streams, "round trip of multivectors of each set of grades by operator<<, " + typeName<T>());
+
+        e2ga::Mvec<T> parsed = e2ga::Mvec<T>() + T(1);
+        check(e2ga::toText(e2ga::Mvec<T>()) == "0" && e2ga::fromText("0", parsed) && sameMvec(parsed, e2ga::Mvec<T>()),
+              "text of the multivector 0, " + typeName<T>());
+
+        const T extremes[] = {std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest(), std::numeric_limits<T>::min(),
+                              std::numeric_limits<T>::denorm_min(), T(1) / T(3), T(-1e-30)};
+        bool extremeTexts = true;
+        for(const T value : extremes){
+            T dense[e2ga::multivectorSize] = {};
+            dense[0] = value;
+            dense[e2ga::multivectorSize-1] = -value;
+            e2ga::Mvec<T> mv;
+            mv.fromDense(dense);
+            extremeTexts = extremeTexts && e2ga::fromText(e2ga::toText(mv), parsed) && sameMvec(parsed, mv);
+        }
+        check(extremeTexts, "round trip of extreme coefficients, " + typeName<T>());
+
+        // a sequence of multivectors, one per line
+        std::string text;
+        for(const e2ga::Mvec<T>& mv : mvs){
+            e2ga::appendText(text, mv);
+            text += '\n';
+        }
+        bool sequence = true;
+        const char* it = text.data();
+        for(std::size_t i=0; i<mvs.size() && sequence; ++i){
+            it = e2ga::parseText(it, text.data() + text.size(), parsed);
+            sequence = it != nullptr && sameMvec(parsed, mvs[i]);
+        }
+        check(sequence, "sequence of multivectors read by parseText, " + typeName<T>());
+    }
+
+    void testSyntax() {
+        using Mvec = e2ga::Mvec<double>;
+        const std::string e0 = e2ga::basisVectors[0], e1 = e2ga::basisVectors[1];
+        double dense[e2ga::multivectorSize] = {};
+        dense[0] = 1.5;
+        dense[e2ga::basisBladeIndices[3]] = -2.0;
+        dense[e2ga::basisBladeIndices[1]] = 3.0;
+        Mvec expected;
+        expected.fromDense(dense);
+        Mvec parsed;
+        check(e2ga::fromText("  1.5 + 2*e" + e1 + e0 + " + 1*e" + e0 + " + 2 * e" + e0 + "\n", parsed) && sameMvec(parsed, expected),
+              "basis vectors of a blade in any order, terms of a blade added");
+
+        const Mvec unchanged = Mvec() + 7.0;
+        const std::string errors[] = {"", "1 +", "2*", "2*e", "2*x" + e0, "1 + * e" + e0, "2*e" + e0 + e0, "1 2", "e" + e0};
+        bool rejected = true;
+        for(const std::string& error : errors){
+            parsed = unchanged;
+            rejected = rejected && !e2ga::fromText(error, parsed) && sameMvec(parsed, unchanged);
+        }
+        check(rejected, "syntax errors rejected, the multivector unchanged");
+    }
+}
+
+
+int main() {
+    std::mt19937 randomEngine(13);
+    testRoundTrips<float>(randomEngine);
+    testRoundTrips<double>(randomEngine);
+    testSyntax();
+    return e2ga::test::testResult();
+}
@@ -0,0 +1,171 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// AllocationAudit.cpp
+// This file is part of the Garamon for e3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file AllocationAudit.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Count the heap allocations of the operations of e3ga, and fail if an operation that should not allocate does.
+///
+/// The allocations of the calling thread are counted by AllocationCounter.hpp. Each operation is run n and 4n times, the
+/// difference gives the allocations per operation (per multivector for the batch functions), the rest is a fixed cost
+/// per call. The per grades kernels of the products, toDense, roundZero and the batch functions (per multivector) are
+/// allocation-free; the operators and the copies of Mvec allocate the k-vectors of their result. The batch functions
+/// are run on batches too small to be spread over several threads. The kernels and the products of Mvec are the cases
+/// of the kernels benchmark (Benchmark.hpp). With E3GA_INSTRUMENTATION, the audit also fails if the counter of the
+/// k-vectors misses the k-vectors of the copies.
+///
+/// Usage: e3ga_allocation_audit [--quiet], returns 1 if an allocation-free operation allocates. The build of this
+/// program runs it.
+
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "e3ga/Mvec.hpp"
+#include "e3ga/Batch.hpp"
+#include "e3ga/Instrumentation.hpp"
+
+#include "Benchmark.hpp"
+
+
+namespace {
+
+    using e3ga::benchmark::doNotOptimize;
+    using e3ga::benchmark::randomMvec;
+
+    /// \brief allocations expected from an operation
+    enum class Expectation {
+        allocates,
+        allocationFree,          /*!< no allocation at all */
+        allocationFreePerItem    /*!< a batch function: a fixed number of allocations per call, whatever the size of the batch */
+    };
+
+    /// \brief an operation of the audit: run(n) computes it n times (or on a batch of n multivectors)
+    struct AuditedOperation {
+        AuditedOperation(const std::string& name, const Expectation expectation, std::function<void(std::size_t)> run)
+            : name(name), expectation(expectation), run(std::move(run)) {}
+
+        /// \brief a case of the kernels benchmark (see e3ga::benchmark::addCase): the kernels are allocation-free
+        AuditedOperation(const std::string& name, const std::string& /*operation*/, const std::string& engine,
+                         const std::vector<unsigned int>& /*grades*/, std::function<void(std::size_t)> run)
+            : name(name), expectation(engine == "kernel" ? Expectation::allocationFree : Expectation::allocates), run(std::move(run)) {}
+
+        std::string name;
+        Expectation expectation;
+        std::function<void(std::size_t)> run;
+    };
+
+    /// \brief the unary operations of Mvec, on a multivector of all the grades
+    void addMvecUnaryOperations(std::vector<AuditedOperation>& operations) {
+        using Mvec = e3ga::Mvec<double>;
+        auto mv = std::make_shared<Mvec>(randomMvec((1u << (e3ga::algebraDimension+1)) - 1));
+        auto dense = std::make_shared<std::vector<double>>(e3ga::multivectorSize);
+        auto sink = std::make_shared<double>(0.0);
+        operations.push_back({"Mvec dual", Expectation::allocates, [mv](const std::size_t n){ for(std::size_t i=0; i<n; ++i) mv->dual(); }});
+        operations.push_back({"Mvec dual pruned", Expectation::allocates, [mv](const std::size_t n){ for(std::size_t i=0; i<n; ++i) mv->dual(1e-12); }});
+        operations.push_back({"Mvec reverse", Expectation::allocates, [mv](const std::size_t n){ for(std::size_t i=0; i<n; ++i) mv->reverse(); }});
+        operations.push_back({"Mvec inv", Expectation::allocates, [mv](const std::size_t n){ for(std::size_t i=0; i<n; ++i) mv->inv(); }});
+        operations.push_back({"Mvec norm", Expectation::allocates, [mv, sink](const std::size_t n){ for(std::size_t i=0; i<n; ++i) *sink += mv->norm(); }});
+        operations.push_back({"Mvec roundZero", Expectation::allocationFree, [mv](const std::size_t n){ for(std::size_t i=0; i<n; ++i) mv->roundZero(1e-300); }});
+        operations.push_back({"Mvec toDense", Expectation::allocationFree, [mv, dense](const std::size_t n){ for(std::size_t i=0; i<n; ++i) mv->toDense(dense->data()); }});
+        operations.push_back({"Mvec fromDense", Expectation::allocates, [mv, dense](const std::size_t n){ for(std::size_t i=0; i<n; ++i) Mvec().fromDense(dense->data()); }});
+        operations.push_back({"Mvec copy", Expectation::allocates, [mv](const std::size_t n){ for(std::size_t i=0; i<n; ++i) doNotOptimize(Mvec(*mv)); }});
+        auto copy = std::make_shared<Mvec>();
+        operations.push_back({"Mvec copy assignment", Expectation::allocates, [mv, copy](const std::size_t n){
+            for(std::size_t i=0; i<n; ++i){
+                *copy = Mvec();
+                *copy = *mv;
+                doNotOptimize(*copy);
+            }
+        }});
+    }
+
+    /// \brief true if the counter of the k-vectors of the instrumentation counts the k-vectors of the copies
+    bool copiesInstrumented() {
+#if defined(E3GA_INSTRUMENTATION)
+        const e3ga::Mvec<double> mv = randomMvec((1u << (e3ga::algebraDimension+1)) - 1);
+        e3ga::Mvec<double> assigned;
+        e3ga::resetInstrumentation();
+        const e3ga::Mvec<double> copy(mv);
+        assigned = mv;
+        return e3ga::instrumentationSnapshot().kvecAllocations == 2 * (e3ga::algebraDimension + 1);
+#else
+        return true;
+#endif
+    }
+
+    /// \brief the batch functions, allocation-free per multivector
+    void addBatches(std::vector<AuditedOperation>& operations) {
+        const std::size_t maxCount = 4 * 32;
+        auto mv1 = std::make_shared<std::vector<double>>(maxCount * e3ga::multivectorSize);
+        auto mv2 = std::make_shared<std::vector<double>>(maxCount * e3ga::multivectorSize);
+        auto mv3 = std::make_shared<std::vector<double>>(maxCount * e3ga::multivectorSize);
+        auto norms = std::make_shared<std::vector<double>>(maxCount);
+        for(std::size_t item=0; item<maxCount; ++item){
+            randomMvec((1u << (e3ga::algebraDimension+1)) - 1).toDense(mv1->data() + item * e3ga::multivectorSize);
+            randomMvec(2u).toDense(mv2->data() + item * e3ga::multivectorSize);
+        }
+        const auto a = [mv1](){ return e3ga::aosBatch<const double>(mv1->data()); };
+        const auto b = [mv2](){ return e3ga::aosBatch<const double>(mv2->data()); };
+        const auto c = [mv3](){ return e3ga::aosBatch(mv3->data()); };
+        operations.push_back({"geometricProductBatch", Expectation::allocationFreePerItem, [=](const std::size_t n){ e3ga::geometricProductBatch(a(), b(), c(), n); }});
+        operations.push_back({"outerProductBatch", Expectation::allocationFreePerItem, [=](const std::size_t n){ e3ga::outerProductBatch(a(), b(), c(), n); }});
+        operations.push_back({"innerProductBatch", Expectation::allocationFreePerItem, [=](const std::size_t n){ e3ga::innerProductBatch(a(), b(), c(), n); }});
+        operations.push_back({"applyVersorBatch", Expectation::allocationFreePerItem, [=](const std::size_t n){ e3ga::applyVersorBatch(a(), b(), c(), n); }});
+        operations.push_back({"dualBatch", Expectation::allocationFreePerItem, [=](const std::size_t n){ e3ga::dualBatch(a(), c(), n); }});
+        operations.push_back({"reverseBatch", Expectation::allocationFreePerItem, [=](const std::size_t n){ e3ga::reverseBatch(a(), c(), n); }});
+        operations.push_back({"normBatch", Expectation::allocationFreePerItem, [=](const std::size_t n){ e3ga::normBatch(a(), norms->data(), n); }});
+    }
+
+    std::size_t countAllocations(const std::function<void(std::size_t)>& run, const std::size_t n) {
+        const std::size_t before = e3ga::benchmark::allocationCount();
+        run(n);
+        return e3ga::benchmark::allocationCount() - before;
+    }
+}
+
+
+int main(int argc, char** argv) {
+    const bool quiet = argc > 1 && std::strcmp(argv[1], "--quiet") == 0;
+
+    std::vector<AuditedOperation> operations;
+    e3ga::benchmark::addKernels(operations);
+    e3ga::benchmark::addMvecProducts(operations);
+    addMvecUnaryOperations(operations);
+    addBatches(operations);
+
+    const std::size_t n = 32;
+    unsigned int failures = 0;
+    if(!quiet) std::printf("%-32s %12s %12s\n", "operation", "allocs/op", "fixed/call");
+    for(const AuditedOperation& operation : operations){
+        operation.run(1); // initialization of the function containers and of the static data
+        const std::size_t allocations1 = countAllocations(operation.run, n);
+        const std::size_t allocations4 = countAllocations(operation.run, 4 * n);
+        const double perOperation = double(allocations4 - std::min(allocations1, allocations4)) / double(3 * n);
+        const double fixed = std::max(0.0, double(allocations1) - perOperation * double(n));
+        const bool failed = (operation.expectation == Expectation::allocationFree && allocations4 > 0)
+                         || (operation.expectation == Expectation::allocationFreePerItem && allocations4 > allocations1);
+        failures += failed;
+        if(!quiet || failed)
+            std::printf("%-32s %12.2f %12.2f%s\n", operation.name.c_str(), perOperation, fixed,
+                        failed ? "  FAIL: allocation-free" : (operation.expectation != Expectation::allocates ? "  (allocation-free)" : ""));
+    }
+    std::printf("e3ga allocation audit: %zu operations, %u allocation-free operations allocate\n", operations.size(), failures);
+    if(!copiesInstrumented()){
+        std::printf("e3ga allocation audit: FAIL: the instrumentation misses the k-vectors of the copies\n");
+        return 1;
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,149 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Macro.cpp
+// This file is part of the Garamon for e3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Macro.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Macro benchmarks of e3ga: workloads of applications, with their throughput and the latency of their requests.
+///
+/// The scenario, on data of a fixed seed:
+///  - imuRotorIntegration: the orientation of 256 inertial measurement units, integrated from 1024 samples of their
+///    gyroscope (1 kHz): R = R * exp(-0.5 dt w), w the bivector of the angular velocity, R normalized every 64 samples.
+///    A request is the stream of a unit, an item a sample.
+///  - rotorCodec32, rotorCodec48, rotorCodec64: the replay of attitude streams of 4096 unit rotors, encoded and decoded by
+///    the codec of RotorCodec.hpp from and to a structure of arrays. A request is a stream, an item a rotor.
+/// The angular velocity of a unit keeps its axis and varies in magnitude, so that the orientation of each pass is checked
+/// against the closed form rotor; the program returns 1 if one of them is wrong. The error bounds of the codec are checked
+/// by its test (test/RotorCodec.cpp).
+///
+/// Usage: e3ga_macro_benchmark [--repetitions <passes>] [--counters] [--filter <text>] [--output <path>] [--scale <factor>],
+/// the scale multiplies the number of units. See Benchmark.hpp for the report.
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "e3ga/Mvec.hpp"
+#include "e3ga/MvecArray.hpp"
+#include "e3ga/RotorCodec.hpp"
+
+#include "Benchmark.hpp"
+
+
+namespace {
+
+    using Mvec = e3ga::Mvec<double>;
+    using e3ga::benchmark::ScenarioCase;
+
+    constexpr double pi = 3.14159265358979323846;
+
+    /// \brief an inertial measurement unit: gyroscope samples and integrated orientation
+    struct InertialUnit {
+        double axis[3];               // unit vector
+        std::vector<double> rates;    // angular velocity about the axis, rad/s
+        Mvec orientation;
+    };
+
+    /// \brief the bivector of a rotation of angle about the unit vector axis: angle * dual(axis)
+    Mvec rotationBivector(const double* axis, const double angle) {
+        return angle * (axis[0] * e3ga::e23<double>() - axis[1] * e3ga::e13<double>() + axis[2] * e3ga::e12<double>());
+    }
+
+    ScenarioCase imuRotorIntegration(const double scale) {
+        const std::size_t samples = 1024, normalizationPeriod = 64;
+        const double dt = 1e-3;
+        const std::size_t units = std::max<std::size_t>(1, std::size_t(256 * scale));
+        auto imus = std::make_shared<std::vector<InertialUnit>>(units);
+        std::mt19937 randomEngine(3);
+        std::normal_distribution<double> normal;
+        std::uniform_real_distribution<double> amplitude(0.5, 10.0), frequency(0.5, 20.0);
+        for(InertialUnit& imu : *imus){
+            double squaredNorm = 0.0;
+            for(double& coordinate : imu.axis){
+                coordinate = normal(randomEngine);
+                squaredNorm += coordinate * coordinate;
+            }
+            for(double& coordinate : imu.axis) coordinate /= std::sqrt(squaredNorm);
+            const double a = amplitude(randomEngine), f = frequency(randomEngine);
+            for(std::size_t s=0; s<samples; ++s)
+                imu.rates.push_back(a * (1.0 + 0.5 * std::sin(2.0 * pi * f * double(s) * dt)) + 0.1 * normal(randomEngine));
+        }
+
+        return {"imuRotorIntegration", units, samples, [=](const std::size_t request){
+            InertialUnit& imu = (*imus)[request];
+            const Mvec axis = rotationBivector(imu.axis, 1.0);
+            Mvec orientation = Mvec() + 1.0;
+            for(std::size_t s=0; s<samples; ++s){
+                const double halfAngle = 0.5 * imu.rates[s] * dt;
+                orientation = orientation * (std::cos(halfAngle) - std::sin(halfAngle) * axis);
+                if((s+1) % normalizationPeriod == 0)
+                    orientation = orientation / orientation.norm();
+            }
+            imu.orientation = orientation;
+        }, [=](){
+            for(const InertialUnit& imu : *imus){
+                double angle = 0.0;
+                for(const double rate : imu.rates) angle += rate * dt;
+                const Mvec expected = std::cos(0.5 * angle) - rotationBivector(imu.axis, std::sin(0.5 * angle));
+                if(!((imu.orientation - expected).norm() < 1e-9)) return false;
+            }
+            return true;
+        }};
+    }
+
+    ScenarioCase rotorCodec(const e3ga::RotorPrecision precision, const double scale) {
+        const std::size_t rotorsPerStream = 4096;
+        const std::size_t streams = std::max<std::size_t>(1, std::size_t(64 * scale));
+        const std::size_t count = streams * rotorsPerStream, codeSize = e3ga::rotorCodeSize(precision);
+        auto rotors = std::make_shared<e3ga::MvecArray<double>>(count);
+        auto decoded = std::make_shared<e3ga::MvecArray<double>>(count);
+        auto codes = std::make_shared<std::vector<std::uint8_t>>(count * codeSize);
+
+        // random orientations, and rotations about the basis vectors, whose coefficients 0 are exact in the codes
+        std::mt19937 randomEngine(7);
+        std::normal_distribution<double> normal;
+        for(std::size_t i=0; i<count; ++i){
+            double coefficients[4], squaredNorm = 0.0;
+            for(unsigned int c=0; c<4; ++c){
+                coefficients[c] = (i % 16 == 0 && c != 0 && c != 1 + (i / 16) % 3) ? 0.0 : normal(randomEngine);
+                squaredNorm += coefficients[c] * coefficients[c];
+            }
+            for(unsigned int c=0; c<4; ++c)
+                rotors->coefficientRow(e3ga::rotorDenseIndex(c))[i] = coefficients[c] / std::sqrt(squaredNorm);
+        }
+
+        const std::string name = "rotorCodec" + std::to_string((unsigned int)precision);
+        return {name, streams, rotorsPerStream, [=](const std::size_t request){
+            const std::size_t first = request * rotorsPerStream;
+            const e3ga::BatchView<double> source = rotors->view(), target = decoded->view();
+            const e3ga::BatchView<const double> stream = {source.data + first, source.itemStride, source.coeffStride};
+            std::uint8_t* const streamCodes = codes->data() + first * codeSize;
+            e3ga::encodeRotorBatch(stream, streamCodes, rotorsPerStream, precision);
+            e3ga::decodeRotorBatch(streamCodes, e3ga::BatchView<double>{target.data + first, target.itemStride, target.coeffStride},
+                                   rotorsPerStream, precision);
+        }};
+    }
+}
+
+
+int main(int argc, char** argv) {
+    e3ga::benchmark::BenchmarkOptions options;
+    if(!e3ga::benchmark::parseBenchmarkOptions(argc, argv, options)) return 2;
+
+    const std::vector<ScenarioCase> scenarios = {imuRotorIntegration(options.scale),
+                                                 rotorCodec(e3ga::RotorPrecision::bits32, options.scale),
+                                                 rotorCodec(e3ga::RotorPrecision::bits48, options.scale),
+                                                 rotorCodec(e3ga::RotorPrecision::bits64, options.scale)};
+    return e3ga::benchmark::runScenarios("macro", scenarios, options);
+}
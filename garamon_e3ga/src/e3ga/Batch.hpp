@@ -0,0 +1,354 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Batch.hpp
+// This file is part of the Garamon for e3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Batch.hpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Products and unary operations applied to large sets of multivectors stored as dense arrays (see Mvec::toDense).
+
+
+#ifndef E3GA_BATCH_HPP__
+#define E3GA_BATCH_HPP__
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <Eigen/Core>
+
+#include "e3ga/Mvec.hpp"
+
+
+/*!
+ * @namespace e3ga
+ */
+namespace e3ga {
+
+    constexpr std::size_t batchParallelThreshold = 256; /*!< minimal number of multivectors in a batch before the work is spread over several threads */
+
+
+    /// \brief location in memory of a set of multivectors whose coefficients are stored densely, ordered by grade (see Mvec::toDense).
+    /// \tparam T - type of the coefficients, const for the operands of the batch functions
+    template<typename T>
+    struct BatchView {
+        T* data;                    /*!< first coefficient of the first multivector */
+        std::ptrdiff_t itemStride;  /*!< distance between two consecutive multivectors, 0 to use the same multivector for the whole batch */
+        std::ptrdiff_t coeffStride; /*!< distance between two consecutive coefficients of a multivector */
+
+        /// \brief address of the coefficient idx of the multivector item
+        inline T& operator()(const std::size_t item, const unsigned int idx) const {
+            return data[(std::ptrdiff_t)item*itemStride + (std::ptrdiff_t)idx*coeffStride];
+        }
+    };
+
+    /// \brief view on multivectors stored one after the other (array of structures, shape N x multivectorSize)
+    template<typename T>
+    BatchView<T> aosBatch(T* data) {
+        return {data, (std::ptrdiff_t)multivectorSize, 1};
+    }
+
+    /// \brief view on count multivectors stored coefficient per coefficient (structure of arrays, shape multivectorSize x count)
+    template<typename T>
+    BatchView<T> soaBatch(T* data, const std::size_t count) {
+        return {data, 1, (std::ptrdiff_t)count};
+    }
+
+    /// \brief view on a single multivector repeated for all the elements of a batch
+    template<typename T>
+    BatchView<T> broadcastBatch(T* data) {
+        return {data, 0, 1};
+    }
+
+
+    /// \brief all the k-vectors of a multivector, stored per grade with their final size
+    template<typename T>
+    using DenseKvecs = std::array<Eigen::Matrix<T, Eigen::Dynamic, 1>, algebraDimension+1>;
+
+    /// \brief per-thread temporary k-vectors, allocated once, used to call the explicit kernels on dense data.
+    template<typename T>
+    struct BatchWorkspace {
+        DenseKvecs<T> mv1, mv2, mv3, mv4; /*!< operands, result and intermediate result */
+
+        BatchWorkspace() {
+            for(unsigned int grade=0; grade<=algebraDimension; ++grade){
+                mv1[grade] = Eigen::Matrix<T, Eigen::Dynamic, 1>::Zero(binomialArray[grade]);
+                mv2[grade] = mv1[grade];
+                mv3[grade] = mv1[grade];
+                mv4[grade] = mv1[grade];
+            }
+        }
+    };
+
+
+    /// \cond DEV
+    /// \brief copy the multivector item of a batch into per-grade k-vectors
+    /// \return the grade bitmap of the non-zero k-vectors
+    template<typename T>
+    unsigned int loadKvecs(const BatchView<const T>& view, const std::size_t item, DenseKvecs<T>& kvecs) {
+        unsigned int gradeBitmap = 0;
+        for(unsigned int grade=0; grade<=algebraDimension; ++grade){
+            bool nonZero = false;
+            for(unsigned int i=0; i<binomialArray[grade]; ++i){
+                kvecs[grade].coeffRef(i) = view(item, perGradeStartingIndex[grade]+i);
+                nonZero = nonZero || (kvecs[grade].coeff(i) != T(0));
+            }
+            if(nonZero)
+                gradeBitmap |= 1 << grade;
+        }
+        return gradeBitmap;
+    }
+
+    /// \brief copy per-grade k-vectors into the multivector item of a batch, the grades missing from gradeBitmap are set to 0
+    /// \param epsilon - the coefficients with a magnitude lower than epsilon are written as 0 (as by Mvec::roundZero), none if epsilon < 0
+    template<typename T>
+    void storeKvecs(const DenseKvecs<T>& kvecs, const unsigned int gradeBitmap, const BatchView<T>& view, const std::size_t item, const T epsilon = T(-1)) {
+        for(unsigned int grade=0; grade<=algebraDimension; ++grade){
+            const bool present = (gradeBitmap & (1 << grade)) != 0;
+            for(unsigned int i=0; i<binomialArray[grade]; ++i)
+                view(item, perGradeStartingIndex[grade]+i) = (present && !(std::fabs(kvecs[grade].coeff(i)) <= epsilon)) ? kvecs[grade].coeff(i) : T(0);
+        }
+    }
+
+    /// \brief set to 0 the k-vectors that will receive the result of a product
+    template<typename T>
+    void clearKvecs(DenseKvecs<T>& kvecs) {
+        for(auto & kvec : kvecs)
+            kvec.setZero();
+    }
+
+    /// \brief outer product between two multivectors stored per grade (same kernels as Mvec::operator^)
+    /// \return the grade bitmap of the result
+    template<typename T>
+    unsigned int outerProductKvecs(const DenseKvecs<T>& mv1, const unsigned int gradeBitmap1, const DenseKvecs<T>& mv2, const unsigned int gradeBitmap2, DenseKvecs<T>& mv3) {
+        clearKvecs(mv3);
+        unsigned int gradeBitmap3 = 0;
+        for(unsigned int grade1=0; grade1<=algebraDimension; ++grade1){
+            if((gradeBitmap1 & (1 << grade1)) == 0) continue;
+            for(unsigned int grade2=0; grade1+grade2<=algebraDimension; ++grade2){
+                if((gradeBitmap2 & (1 << grade2)) == 0) continue;
+                outerFunctionsContainer<T>[grade1][grade2](mv1[grade1], mv2[grade2], mv3[grade1+grade2]);
+                gradeBitmap3 |= 1 << (grade1+grade2);
+            }
+        }
+        return gradeBitmap3;
+    }
+
+    /// \brief kinds of inner products, they differ by the grade pairs they involve
+    enum class InnerKind { inner, leftContraction, rightContraction, scalar };
+
+    /// \brief inner products between two multivectors stored per grade (same kernels as Mvec::operator|, operator< and operator>)
+    /// \return the grade bitmap of the result
+    template<typename T>
+    unsigned int innerProductKvecs(const DenseKvecs<T>& mv1, const unsigned int gradeBitmap1, const DenseKvecs<T>& mv2, const unsigned int gradeBitmap2, DenseKvecs<T>& mv3, const InnerKind kind) {
+        clearKvecs(mv3);
+        unsigned int gradeBitmap3 = 0;
+        for(unsigned int grade1=0; grade1<=algebraDimension; ++grade1){
+            if((gradeBitmap1 & (1 << grade1)) == 0) continue;
+            for(unsigned int grade2=0; grade2<=algebraDimension; ++grade2){
+                if((gradeBitmap2 & (1 << grade2)) == 0) continue;
+                if((kind == InnerKind::inner && grade1*grade2 == 0)
+                   || (kind == InnerKind::leftContraction && grade1 > grade2)
+                   || (kind == InnerKind::rightContraction && grade1 < grade2)
+                   || (kind == InnerKind::scalar && grade1 != grade2))
+                    continue;
+                const unsigned int grade3 = (unsigned int)std::abs((int)grade1 - (int)grade2);
+                innerFunctionsContainer<T>[grade1][grade2](mv1[grade1], mv2[grade2], mv3[grade3]);
+                gradeBitmap3 |= 1 << grade3;
+            }
+        }
+        return gradeBitmap3;
+    }
+
+    /// \brief geometric product between two multivectors stored per grade (same kernels as Mvec::operator*)
+    /// \return the grade bitmap of the result
+    template<typename T>
+    unsigned int geometricProductKvecs(const DenseKvecs<T>& mv1, const unsigned int gradeBitmap1, const DenseKvecs<T>& mv2, const unsigned int gradeBitmap2, DenseKvecs<T>& mv3) {
+        clearKvecs(mv3);
+        unsigned int gradeBitmap3 = 0;
+        for(unsigned int grade1=0; grade1<=algebraDimension; ++grade1){
+            if((gradeBitmap1 & (1 << grade1)) == 0) continue;
+            for(unsigned int grade2=0; grade2<=algebraDimension; ++grade2){
+                if((gradeBitmap2 & (1 << grade2)) == 0) continue;
+
+                // outer product block
+                const unsigned int gradeOuter = grade1 + grade2;
+                if(gradeOuter <= algebraDimension){
+                    outerFunctionsContainer<T>[grade1][grade2](mv1[grade1], mv2[grade2], mv3[gradeOuter]);
+                    gradeBitmap3 |= 1 << gradeOuter;
+                }
+
+                // inner product block, the same as the outer product when one of the grades is 0
+                const unsigned int gradeInner = (unsigned int)std::abs((int)grade1 - (int)grade2);
+                if(gradeInner != gradeOuter){
+                    innerFunctionsContainer<T>[grade1][grade2](mv1[grade1], mv2[grade2], mv3[gradeInner]);
+                    gradeBitmap3 |= 1 << gradeInner;
+
+                    // geometric product part
+                    const unsigned int gradeMax = std::min(((2*algebraDimension)-gradeOuter)+1, gradeOuter);
+                    for(unsigned int gradeResult = gradeInner+2; gradeResult < gradeMax; gradeResult+=2){
+                        geometricFunctionsContainer<T>[gradeResult][grade1][grade2](mv1[grade1], mv2[grade2], mv3[gradeResult]);
+                        gradeBitmap3 |= 1 << gradeResult;
+                    }
+                }
+            }
+        }
+        return gradeBitmap3;
+    }
+
+    /// \brief reverse of a multivector stored per grade, computed in place
+    template<typename T>
+    void reverseKvecs(DenseKvecs<T>& mv, const unsigned int gradeBitmap) {
+        for(unsigned int grade=0; grade<=algebraDimension; ++grade)
+            if((gradeBitmap & (1 << grade)) && signReversePerGrade[grade] == -1)
+                mv[grade] = -mv[grade];
+    }
+
+    /// \brief dual of a multivector stored per grade (same computation as Mvec::dual)
+    /// \return the grade bitmap of the result
+    template<typename T>
+    unsigned int dualKvecs(const DenseKvecs<T>& mv1, const unsigned int gradeBitmap1, DenseKvecs<T>& mv2) {
+        unsigned int gradeBitmap2 = 0;
+        for(unsigned int grade=0; grade<=algebraDimension; ++grade){
+            const unsigned int dualGrade = algebraDimension - grade;
+            if((gradeBitmap1 & (1 << grade)) == 0){
+                mv2[dualGrade].setZero();
+                continue;
+            }
+            for(unsigned int i=0; i<binomialArray[grade]; ++i)
+                mv2[dualGrade].coeffRef(dualPermutations[grade][i]) = mv1[grade].coeff(i) * T(dualCoefficients[grade][dualPermutations[grade][i]]);
+            gradeBitmap2 |= 1 << dualGrade;
+        }
+        return gradeBitmap2;
+    }
+
+    /// \brief inverse of a multivector stored per grade (same computation as Mvec::inv), mv2 is used as temporary storage
+    /// \return the grade bitmap of the result, 0 if the multivector is not invertible
+    template<typename T>
+    unsigned int inverseKvecs(const DenseKvecs<T>& mv1, const unsigned int gradeBitmap1, DenseKvecs<T>& mv2, DenseKvecs<T>& mv3) {
+        mv2 = mv1;
+        reverseKvecs(mv2, gradeBitmap1);
+        innerProductKvecs(mv2, gradeBitmap1, mv1, gradeBitmap1, mv3, InnerKind::scalar);
+        const T quadraticNorm = mv3[0].coeff(0);
+        if(quadraticNorm<std::numeric_limits<T>::epsilon() && quadraticNorm>-std::numeric_limits<T>::epsilon())
+            return 0;
+        for(unsigned int grade=0; grade<=algebraDimension; ++grade)
+            mv3[grade] = mv2[grade] / quadraticNorm;
+        return gradeBitmap1;
+    }
+
+
+    /// \brief run operation(workspace, item) for all the items of a batch, on several threads when OpenMP is enabled
+    template<typename T, typename Operation>
+    void runBatch(const std::size_t count, Operation operation) {
+#ifdef _OPENMP
+#pragma omp parallel if(count >= batchParallelThreshold)
+#endif
+        {
+            BatchWorkspace<T> workspace;
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for(std::ptrdiff_t item=0; item<(std::ptrdiff_t)count; ++item)
+                operation(workspace, (std::size_t)item);
+        }
+    }
+    /// \endcond
+
+
+    /// \brief geometric product between the elements of two batches: mv3[i] = mv1[i] * mv2[i]
+    /// \param mv1 - first operands
+    /// \param mv2 - second operands
+    /// \param mv3 - results, may alias one of the operands
+    /// \param count - number of multivectors in the batch
+    template<typename T>
+    void geometricProductBatch(const BatchView<const T> mv1, const BatchView<const T> mv2, const BatchView<T> mv3, const std::size_t count, const T epsilon = T(-1)) {
+        E3GA_TRACE_BATCH_SCOPE("geometricProductBatch", count);
+        runBatch<T>(count, [&](BatchWorkspace<T>& ws, const std::size_t i){
+            const unsigned int gradeBitmap1 = loadKvecs(mv1, i, ws.mv1);
+            const unsigned int gradeBitmap2 = loadKvecs(mv2, i, ws.mv2);
+            storeKvecs(ws.mv3, geometricProductKvecs(ws.mv1, gradeBitmap1, ws.mv2, gradeBitmap2, ws.mv3), mv3, i, epsilon);
+        });
+    }
+
+    /// \brief outer product between the elements of two batches: mv3[i] = mv1[i] ^ mv2[i]
+    template<typename T>
+    void outerProductBatch(const BatchView<const T> mv1, const BatchView<const T> mv2, const BatchView<T> mv3, const std::size_t count, const T epsilon = T(-1)) {
+        E3GA_TRACE_BATCH_SCOPE("outerProductBatch", count);
+        runBatch<T>(count, [&](BatchWorkspace<T>& ws, const std::size_t i){
+            const unsigned int gradeBitmap1 = loadKvecs(mv1, i, ws.mv1);
+            const unsigned int gradeBitmap2 = loadKvecs(mv2, i, ws.mv2);
+            storeKvecs(ws.mv3, outerProductKvecs(ws.mv1, gradeBitmap1, ws.mv2, gradeBitmap2, ws.mv3), mv3, i, epsilon);
+        });
+    }
+
+    /// \brief inner product (or contraction) between the elements of two batches, e.g. mv3[i] = mv1[i] | mv2[i]
+    /// \param kind - inner product, left contraction (operator<), right contraction (operator>) or scalar product
+    template<typename T>
+    void innerProductBatch(const BatchView<const T> mv1, const BatchView<const T> mv2, const BatchView<T> mv3, const std::size_t count, const InnerKind kind = InnerKind::inner, const T epsilon = T(-1)) {
+        E3GA_TRACE_BATCH_SCOPE("innerProductBatch", count);
+        runBatch<T>(count, [&](BatchWorkspace<T>& ws, const std::size_t i){
+            const unsigned int gradeBitmap1 = loadKvecs(mv1, i, ws.mv1);
+            const unsigned int gradeBitmap2 = loadKvecs(mv2, i, ws.mv2);
+            storeKvecs(ws.mv3, innerProductKvecs(ws.mv1, gradeBitmap1, ws.mv2, gradeBitmap2, ws.mv3, kind), mv3, i, epsilon);
+        });
+    }
+
+    /// \brief apply versors to multivectors: result[i] = versor[i] * mv[i] * versor[i].inv(). A single versor can be broadcast with broadcastBatch.
+    template<typename T>
+    void applyVersorBatch(const BatchView<const T> versor, const BatchView<const T> mv, const BatchView<T> result, const std::size_t count, const T epsilon = T(-1)) {
+        E3GA_TRACE_BATCH_SCOPE("applyVersorBatch", count);
+        runBatch<T>(count, [&](BatchWorkspace<T>& ws, const std::size_t i){
+            const unsigned int gradeBitmapVersor = loadKvecs(versor, i, ws.mv1);
+            const unsigned int gradeBitmapInverse = inverseKvecs(ws.mv1, gradeBitmapVersor, ws.mv4, ws.mv3);
+            ws.mv4 = ws.mv3; // inverse of the versor
+            const unsigned int gradeBitmapMv = loadKvecs(mv, i, ws.mv2);
+            const unsigned int gradeBitmapVX = geometricProductKvecs(ws.mv1, gradeBitmapVersor, ws.mv2, gradeBitmapMv, ws.mv3);
+            storeKvecs(ws.mv2, geometricProductKvecs(ws.mv3, gradeBitmapVX, ws.mv4, gradeBitmapInverse, ws.mv2), result, i, epsilon);
+        });
+    }
+
+    /// \brief dual of the elements of a batch: result[i] = mv[i].dual()
+    template<typename T>
+    void dualBatch(const BatchView<const T> mv, const BatchView<T> result, const std::size_t count, const T epsilon = T(-1)) {
+        E3GA_TRACE_BATCH_SCOPE("dualBatch", count);
+        runBatch<T>(count, [&](BatchWorkspace<T>& ws, const std::size_t i){
+            const unsigned int gradeBitmap = loadKvecs(mv, i, ws.mv1);
+            storeKvecs(ws.mv2, dualKvecs(ws.mv1, gradeBitmap, ws.mv2), result, i, epsilon);
+        });
+    }
+
+    /// \brief reverse of the elements of a batch: result[i] = mv[i].reverse()
+    template<typename T>
+    void reverseBatch(const BatchView<const T> mv, const BatchView<T> result, const std::size_t count, const T epsilon = T(-1)) {
+        E3GA_TRACE_BATCH_SCOPE("reverseBatch", count);
+        runBatch<T>(count, [&](BatchWorkspace<T>& ws, const std::size_t i){
+            const unsigned int gradeBitmap = loadKvecs(mv, i, ws.mv1);
+            reverseKvecs(ws.mv1, gradeBitmap);
+            storeKvecs(ws.mv1, gradeBitmap, result, i, epsilon);
+        });
+    }
+
+    /// \brief norm of the elements of a batch: norms[i] = mv[i].norm()
+    /// \param norms - array of count values
+    template<typename T>
+    void normBatch(const BatchView<const T> mv, T* norms, const std::size_t count) {
+        E3GA_TRACE_BATCH_SCOPE("normBatch", count);
+        runBatch<T>(count, [&](BatchWorkspace<T>& ws, const std::size_t i){
+            const unsigned int gradeBitmap = loadKvecs(mv, i, ws.mv1);
+            ws.mv2 = ws.mv1;
+            reverseKvecs(ws.mv2, gradeBitmap);
+            innerProductKvecs(ws.mv1, gradeBitmap, ws.mv2, gradeBitmap, ws.mv3, InnerKind::scalar);
+            norms[i] = std::sqrt(std::fabs(ws.mv3[0].coeff(0)));
+        });
+    }
+
+}/// End of Namespace
+
+#endif // E3GA_BATCH_HPP__
@@ -0,0 +1,209 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// CApi.cpp
+// This file is part of the Garamon for e3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file CApi.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief C interface of the e3ga library, implemented on top of Mvec<double> and the batch functions.
+
+
+#include "e3ga/CApi.h"
+
+#include <new>
+
+#include "e3ga/Mvec.hpp"
+#include "e3ga/Batch.hpp"
+#include "e3ga/KernelDispatch.hpp"
+
+
+/// \brief the multivector behind an opaque handle
+struct e3ga_mvec {
+    e3ga::Mvec<double> mv;
+};
+
+
+/// \cond DEV
+// no exception may cross the C interface: the functions returning a status catch them all
+#define E3GA_CAPI_TRY(statements) \
+    try { statements; return 0; } \
+    catch(...) { return -1; }
+
+namespace {
+
+    /// \brief view on the operand of a batch function, stored as multivectors of multivectorSize coefficients
+    inline e3ga::BatchView<const double> operandBatch(const double* data, const ptrdiff_t itemStride) {
+        return {data, itemStride, 1};
+    }
+
+    /// \brief new handle on mv, NULL if the allocation fails
+    inline e3ga_mvec* newHandle(e3ga::Mvec<double>&& mv) {
+        return new (std::nothrow) e3ga_mvec{std::move(mv)};
+    }
+}
+/// \endcond
+
+
+extern "C" {
+
+int e3ga_api_version(void) {
+    return E3GA_CAPI_VERSION;
+}
+
+unsigned int e3ga_algebra_dimension(void) {
+    return e3ga::algebraDimension;
+}
+
+unsigned int e3ga_multivector_size(void) {
+    return e3ga::multivectorSize;
+}
+
+unsigned int e3ga_dense_index(const unsigned int xor_index) {
+    if(xor_index >= e3ga::multivectorSize) return e3ga::multivectorSize;
+    return e3ga::perGradeStartingIndex[e3ga::xorIndexToGrade[xor_index]] + e3ga::xorIndexToHomogeneousIndex[xor_index];
+}
+
+
+e3ga_mvec* e3ga_mvec_new(void) {
+    try { return newHandle(e3ga::Mvec<double>()); }
+    catch(...) { return nullptr; }
+}
+
+e3ga_mvec* e3ga_mvec_from_dense(const double* dense) {
+    try {
+        e3ga::Mvec<double> mv;
+        mv.fromDense(dense);
+        return newHandle(std::move(mv));
+    }
+    catch(...) { return nullptr; }
+}
+
+e3ga_mvec* e3ga_mvec_clone(const e3ga_mvec* mv) {
+    try { return newHandle(e3ga::Mvec<double>(mv->mv)); }
+    catch(...) { return nullptr; }
+}
+
+void e3ga_mvec_free(e3ga_mvec* mv) {
+    delete mv;
+}
+
+void e3ga_mvec_to_dense(const e3ga_mvec* mv, double* dense) {
+    mv->mv.toDense(dense);
+}
+
+double e3ga_mvec_get(const e3ga_mvec* mv, const unsigned int xor_index) {
+    if(xor_index >= e3ga::multivectorSize) return 0.0;
+    double dense[e3ga::multivectorSize];
+    mv->mv.toDense(dense);
+    return dense[e3ga_dense_index(xor_index)];
+}
+
+int e3ga_mvec_set(e3ga_mvec* mv, const unsigned int xor_index, const double value) {
+    if(xor_index >= e3ga::multivectorSize) return -1;
+    E3GA_CAPI_TRY(mv->mv[xor_index] = value)
+}
+
+
+int e3ga_mvec_add(const e3ga_mvec* a, const e3ga_mvec* b, e3ga_mvec* result) {
+    E3GA_CAPI_TRY(result->mv = a->mv + b->mv)
+}
+
+int e3ga_mvec_sub(const e3ga_mvec* a, const e3ga_mvec* b, e3ga_mvec* result) {
+    E3GA_CAPI_TRY(result->mv = a->mv - b->mv)
+}
+
+int e3ga_mvec_scale(const e3ga_mvec* a, const double value, e3ga_mvec* result) {
+    E3GA_CAPI_TRY(result->mv = a->mv * value)
+}
+
+int e3ga_mvec_geometric_product(const e3ga_mvec* a, const e3ga_mvec* b, e3ga_mvec* result) {
+    E3GA_CAPI_TRY(result->mv = a->mv * b->mv)
+}
+
+int e3ga_mvec_outer_product(const e3ga_mvec* a, const e3ga_mvec* b, e3ga_mvec* result) {
+    E3GA_CAPI_TRY(result->mv = a->mv ^ b->mv)
+}
+
+int e3ga_mvec_inner_product(const e3ga_mvec* a, const e3ga_mvec* b, e3ga_mvec* result) {
+    E3GA_CAPI_TRY(result->mv = a->mv | b->mv)
+}
+
+int e3ga_mvec_left_contraction(const e3ga_mvec* a, const e3ga_mvec* b, e3ga_mvec* result) {
+    E3GA_CAPI_TRY(result->mv = a->mv < b->mv)
+}
+
+int e3ga_mvec_right_contraction(const e3ga_mvec* a, const e3ga_mvec* b, e3ga_mvec* result) {
+    E3GA_CAPI_TRY(result->mv = a->mv > b->mv)
+}
+
+int e3ga_mvec_dual(const e3ga_mvec* a, e3ga_mvec* result) {
+    E3GA_CAPI_TRY(result->mv = a->mv.dual())
+}
+
+int e3ga_mvec_reverse(const e3ga_mvec* a, e3ga_mvec* result) {
+    E3GA_CAPI_TRY(result->mv = a->mv.reverse())
+}
+
+int e3ga_mvec_inverse(const e3ga_mvec* a, e3ga_mvec* result) {
+    E3GA_CAPI_TRY(result->mv = a->mv.inv())
+}
+
+double e3ga_mvec_norm(const e3ga_mvec* a) {
+    return a->mv.norm();
+}
+
+
+int e3ga_geometric_product_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    E3GA_CAPI_TRY(e3ga::geometricProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), e3ga::aosBatch(result), count))
+}
+
+int e3ga_outer_product_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    E3GA_CAPI_TRY(e3ga::outerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), e3ga::aosBatch(result), count))
+}
+
+int e3ga_inner_product_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    E3GA_CAPI_TRY(e3ga::innerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), e3ga::aosBatch(result), count, e3ga::InnerKind::inner))
+}
+
+int e3ga_left_contraction_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    E3GA_CAPI_TRY(e3ga::innerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), e3ga::aosBatch(result), count, e3ga::InnerKind::leftContraction))
+}
+
+int e3ga_right_contraction_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    E3GA_CAPI_TRY(e3ga::innerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), e3ga::aosBatch(result), count, e3ga::InnerKind::rightContraction))
+}
+
+int e3ga_apply_versor_batch(const double* versor, const ptrdiff_t versor_stride, const double* mv, const ptrdiff_t mv_stride, double* result, const size_t count) {
+    E3GA_CAPI_TRY(e3ga::applyVersorBatch(operandBatch(versor, versor_stride), operandBatch(mv, mv_stride), e3ga::aosBatch(result), count))
+}
+
+int e3ga_dual_batch(const double* a, const ptrdiff_t a_stride, double* result, const size_t count) {
+    E3GA_CAPI_TRY(e3ga::dualBatch(operandBatch(a, a_stride), e3ga::aosBatch(result), count))
+}
+
+int e3ga_reverse_batch(const double* a, const ptrdiff_t a_stride, double* result, const size_t count) {
+    E3GA_CAPI_TRY(e3ga::reverseBatch(operandBatch(a, a_stride), e3ga::aosBatch(result), count))
+}
+
+int e3ga_norm_batch(const double* a, const ptrdiff_t a_stride, double* norms, const size_t count) {
+    E3GA_CAPI_TRY(e3ga::normBatch(operandBatch(a, a_stride), norms, count))
+}
+
+const char* e3ga_kernel_isa(void) {
+    return e3ga::kernelIsaName(e3ga::activeKernelIsa());
+}
+
+int e3ga_select_kernel_isa(const char* name) {
+    if(name == nullptr) return -1;
+    return e3ga::selectKernelIsa(name) ? 0 : -1;
+}
+
+int e3ga_autotune_kernels(const char* path) {
+    E3GA_CAPI_TRY(if(!e3ga::autotuneKernels(path)) return -1)
+}
+
+} // extern "C"
@@ -20,6 +20,7 @@
 #include "e3ga/Mvec.hpp"
 #include "e3ga/Inner.hpp"
 #include "e3ga/Constants.hpp"
+#include "e3ga/KernelDispatch.hpp"
 
 
 /*!
@@ -217,8 +218,10 @@ namespace e3ga {
 
 
 	
+    /// \brief kernels of the inner product per grades: innerFunctionsContainer<T>[grade mv1][grade mv2], constant-initialized
+    /// with the explicit kernels, that the kernel dispatch (KernelDispatch.hpp) replaces when the library is loaded.
     template<typename T>
-	std::array<std::array<std::function<void(const Eigen::Matrix<T, Eigen::Dynamic, 1> & , const Eigen::Matrix<T, Eigen::Dynamic, 1> & , Eigen::Matrix<T, Eigen::Dynamic, 1>&)>, 4>, 4> innerFunctionsContainer = {{
+	std::array<std::array<KernelEntry<T>, 4>, 4> innerFunctionsContainer = {{
 		{{inner_0_0<T>,inner_0_1<T>,inner_0_2<T>,inner_0_3<T>}},
 		{{inner_1_0<T>,inner_1_1<T>,inner_1_2<T>,inner_1_3<T>}},
 		{{inner_2_0<T>,inner_2_1<T>,inner_2_2<T>,inner_2_3<T>}},
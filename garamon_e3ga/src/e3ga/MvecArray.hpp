@@ -0,0 +1,350 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// MvecArray.hpp
+// This file is part of the Garamon for e3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file MvecArray.hpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Array of multivectors stored as a structure of arrays, with element-wise operators.
+
+
+#ifndef E3GA_MVEC_ARRAY_HPP__
+#define E3GA_MVEC_ARRAY_HPP__
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "e3ga/Mvec.hpp"
+#include "e3ga/Batch.hpp"
+
+
+/*!
+ * @namespace e3ga
+ */
+namespace e3ga {
+
+    /// \class MvecArray
+    /// \brief set of multivectors stored as a structure of arrays: the coefficient idx (in the order of Mvec::toDense) of all the
+    /// multivectors is contiguous in memory. The operators work element per element, an array holding a single multivector being
+    /// broadcast over the elements of the other operand.
+    /// \tparam T - type of the coefficients
+    template<typename T>
+    class MvecArray {
+
+    protected:
+        std::vector<T> coefficients; /*!< multivectorSize rows of count coefficients */
+        std::size_t count;           /*!< number of multivectors */
+
+    public:
+
+        /// \brief Default constructor, generate an empty array
+        MvecArray() : count(0) {}
+
+        /// \brief Constructor of an array of count multivectors equal to 0
+        explicit MvecArray(const std::size_t count) : coefficients(multivectorSize*count, T(0)), count(count) {}
+
+        /// \brief Constructor of an array holding the single multivector mv, broadcast by the operators
+        explicit MvecArray(const Mvec<T>& mv) : MvecArray(1) {
+            set(0, mv);
+        }
+
+        /// \brief Constructor of an array holding a copy of the multivectors mvs
+        explicit MvecArray(const std::vector<Mvec<T>>& mvs) : MvecArray(mvs.size()) {
+            for(std::size_t i=0; i<count; ++i)
+                set(i, mvs[i]);
+        }
+
+        /// \brief array built from multivectors stored one after the other (shape count x multivectorSize, see Mvec::toDense)
+        static MvecArray fromDense(const T* dense, const std::size_t count) {
+            MvecArray array(count);
+            for(std::size_t i=0; i<count; ++i)
+                for(unsigned int idx=0; idx<multivectorSize; ++idx)
+                    array.coefficients[idx*count+i] = dense[i*multivectorSize+idx];
+            return array;
+        }
+
+        /// \brief array of vectors (grade 1) built from their coordinates on the basis vectors
+        /// \param coordinates - count x algebraDimension coordinates, one vector after the other
+        static MvecArray fromVectors(const T* coordinates, const std::size_t count) {
+            MvecArray array(count);
+            for(unsigned int k=0; k<algebraDimension; ++k){
+                T* row = array.coefficientRow(perGradeStartingIndex[1] + xorIndexToHomogeneousIndex[1u << k]);
+                for(std::size_t i=0; i<count; ++i)
+                    row[i] = coordinates[i*algebraDimension+k];
+            }
+            return array;
+        }
+
+        /// \brief copy the multivectors one after the other in dense (count x multivectorSize coefficients, see Mvec::toDense)
+        void toDense(T* dense) const {
+            for(std::size_t i=0; i<count; ++i)
+                for(unsigned int idx=0; idx<multivectorSize; ++idx)
+                    dense[i*multivectorSize+idx] = coefficients[idx*count+i];
+        }
+
+        /// \brief number of multivectors in the array
+        inline std::size_t size() const { return count; }
+
+        /// \brief address of the coefficients, multivectorSize rows of size() values
+        inline T* data() { return coefficients.data(); }
+
+        /// \brief address of the coefficients, multivectorSize rows of size() values
+        inline const T* data() const { return coefficients.data(); }
+
+        /// \brief coefficient idx (in the order of Mvec::toDense) of all the multivectors
+        inline T* coefficientRow(const unsigned int idx) { return coefficients.data() + idx*count; }
+
+        /// \brief coefficient idx (in the order of Mvec::toDense) of all the multivectors
+        inline const T* coefficientRow(const unsigned int idx) const { return coefficients.data() + idx*count; }
+
+        /// \brief view on the array for the batch functions
+        inline BatchView<T> view() { return soaBatch(coefficients.data(), count); }
+
+        /// \brief view on the array for the batch functions, an array of one multivector being broadcast
+        inline BatchView<const T> view() const {
+            return count == 1 ? broadcastBatch(coefficients.data()) : soaBatch(coefficients.data(), count);
+        }
+
+        /// \brief copy of the multivector i
+        Mvec<T> at(const std::size_t i) const {
+            if(i >= count) throw std::out_of_range("MvecArray index out of range");
+            std::array<T, multivectorSize> dense;
+            for(unsigned int idx=0; idx<multivectorSize; ++idx)
+                dense[idx] = coefficients[idx*count+i];
+            Mvec<T> mv;
+            mv.fromDense(dense.data());
+            return mv;
+        }
+
+        /// \brief replace the multivector i by mv
+        void set(const std::size_t i, const Mvec<T>& mv) {
+            if(i >= count) throw std::out_of_range("MvecArray index out of range");
+            std::array<T, multivectorSize> dense;
+            mv.toDense(dense.data());
+            for(unsigned int idx=0; idx<multivectorSize; ++idx)
+                coefficients[idx*count+i] = dense[idx];
+        }
+
+
+        /// \brief element-wise addition, broadcasting an array of one multivector
+        MvecArray operator+(const MvecArray& mv2) const {
+            return coefficientWise(*this, mv2, std::plus<T>());
+        }
+
+        /// \brief add a scalar to all the multivectors
+        MvecArray operator+(const T value) const {
+            MvecArray result(*this);
+            for(std::size_t i=0; i<count; ++i)
+                result.coefficients[i] += value;
+            return result;
+        }
+
+        /// \brief add a scalar to all the multivectors
+        friend MvecArray operator+(const T value, const MvecArray& mv) {
+            return mv + value;
+        }
+
+        /// \brief element-wise difference, broadcasting an array of one multivector
+        MvecArray operator-(const MvecArray& mv2) const {
+            return coefficientWise(*this, mv2, std::minus<T>());
+        }
+
+        /// \brief subtract a scalar from all the multivectors
+        MvecArray operator-(const T value) const {
+            return *this + (-value);
+        }
+
+        /// \brief subtract all the multivectors from a scalar
+        friend MvecArray operator-(const T value, const MvecArray& mv) {
+            return (-mv) + value;
+        }
+
+        /// \brief opposite of all the multivectors
+        MvecArray operator-() const {
+            MvecArray result(*this);
+            for(auto & coefficient : result.coefficients)
+                coefficient = -coefficient;
+            return result;
+        }
+
+        /// \brief element-wise geometric product, broadcasting an array of one multivector
+        MvecArray operator*(const MvecArray& mv2) const {
+            return binaryOperation(*this, mv2, [](const BatchView<const T> view1, const BatchView<const T> view2, const BatchView<T> view3, const std::size_t n){
+                geometricProductBatch(view1, view2, view3, n);
+            });
+        }
+
+        /// \brief product of all the multivectors by a scalar
+        MvecArray operator*(const T value) const {
+            MvecArray result(*this);
+            for(auto & coefficient : result.coefficients)
+                coefficient *= value;
+            return result;
+        }
+
+        /// \brief product of all the multivectors by a scalar
+        friend MvecArray operator*(const T value, const MvecArray& mv) {
+            return mv * value;
+        }
+
+        /// \brief element-wise outer product, broadcasting an array of one multivector
+        MvecArray operator^(const MvecArray& mv2) const {
+            return binaryOperation(*this, mv2, [](const BatchView<const T> view1, const BatchView<const T> view2, const BatchView<T> view3, const std::size_t n){
+                outerProductBatch(view1, view2, view3, n);
+            });
+        }
+
+        /// \brief outer product with a scalar, i.e. scaling of all the multivectors
+        MvecArray operator^(const T value) const {
+            return *this * value;
+        }
+
+        /// \brief outer product with a scalar, i.e. scaling of all the multivectors
+        friend MvecArray operator^(const T value, const MvecArray& mv) {
+            return mv * value;
+        }
+
+        /// \brief element-wise inner product, broadcasting an array of one multivector
+        MvecArray operator|(const MvecArray& mv2) const {
+            return innerOperation(*this, mv2, InnerKind::inner);
+        }
+
+        /// \brief inner product with a scalar (same result as Mvec::operator|)
+        MvecArray operator|(const T value) const {
+            return innerOperation(*this, MvecArray(Mvec<T>(value)), InnerKind::inner);
+        }
+
+        /// \brief inner product with a scalar (same result as Mvec::operator|)
+        friend MvecArray operator|(const T value, const MvecArray& mv) {
+            return innerOperation(MvecArray(Mvec<T>(value)), mv, InnerKind::inner);
+        }
+
+        /// \brief element-wise left contraction, broadcasting an array of one multivector
+        MvecArray operator<(const MvecArray& mv2) const {
+            return innerOperation(*this, mv2, InnerKind::leftContraction);
+        }
+
+        /// \brief left contraction with a scalar (same result as Mvec::operator<)
+        MvecArray operator<(const T value) const {
+            return innerOperation(*this, MvecArray(Mvec<T>(value)), InnerKind::leftContraction);
+        }
+
+        /// \brief left contraction of a scalar (same result as Mvec::operator<)
+        friend MvecArray operator<(const T value, const MvecArray& mv) {
+            return innerOperation(MvecArray(Mvec<T>(value)), mv, InnerKind::leftContraction);
+        }
+
+        /// \brief element-wise right contraction, broadcasting an array of one multivector
+        MvecArray operator>(const MvecArray& mv2) const {
+            return innerOperation(*this, mv2, InnerKind::rightContraction);
+        }
+
+        /// \brief right contraction with a scalar (same result as Mvec::operator>)
+        MvecArray operator>(const T value) const {
+            return innerOperation(*this, MvecArray(Mvec<T>(value)), InnerKind::rightContraction);
+        }
+
+        /// \brief right contraction of a scalar (same result as Mvec::operator>)
+        friend MvecArray operator>(const T value, const MvecArray& mv) {
+            return innerOperation(MvecArray(Mvec<T>(value)), mv, InnerKind::rightContraction);
+        }
+
+        /// \brief reverse of all the multivectors
+        friend MvecArray operator~(const MvecArray& mv) {
+            return mv.reverse();
+        }
+
+        /// \brief reverse of all the multivectors
+        MvecArray reverse() const {
+            MvecArray result(*this);
+            for(unsigned int grade=0; grade<=algebraDimension; ++grade){
+                if(signReversePerGrade[grade] == 1) continue;
+                T* first = result.coefficientRow(perGradeStartingIndex[grade]);
+                for(T* coefficient = first; coefficient != first + binomialArray[grade]*count; ++coefficient)
+                    *coefficient = -*coefficient;
+            }
+            return result;
+        }
+
+        /// \brief dual of all the multivectors
+        MvecArray dual() const {
+            MvecArray result(count);
+            dualBatch(view(), result.view(), count);
+            return result;
+        }
+
+        /// \brief k-vector part of all the multivectors
+        MvecArray grade(const unsigned int k) const {
+            MvecArray result(count);
+            if(k <= algebraDimension)
+                std::copy(coefficientRow(perGradeStartingIndex[k]), coefficientRow(perGradeStartingIndex[k]) + binomialArray[k]*count,
+                          result.coefficientRow(perGradeStartingIndex[k]));
+            return result;
+        }
+
+        /// \brief norm of all the multivectors
+        /// \param norms - array of size() values
+        void norm(T* norms) const {
+            normBatch(view(), norms, count);
+        }
+
+        /// \brief norm of all the multivectors
+        std::vector<T> norm() const {
+            std::vector<T> norms(count);
+            norm(norms.data());
+            return norms;
+        }
+
+    protected:
+        /// \cond DEV
+        /// \brief size of the result of an element-wise operation between arrays of count1 and count2 multivectors
+        static std::size_t broadcastSize(const std::size_t count1, const std::size_t count2) {
+            if(count1 == count2 || count2 == 1) return count1;
+            if(count1 == 1) return count2;
+            throw std::invalid_argument("the arrays do not contain the same number of multivectors");
+        }
+
+        /// \brief apply function to the coefficients of the multivectors of mv1 and mv2
+        template<typename Function>
+        static MvecArray coefficientWise(const MvecArray& mv1, const MvecArray& mv2, Function function) {
+            const std::size_t resultCount = broadcastSize(mv1.count, mv2.count);
+            MvecArray result(resultCount);
+            const BatchView<const T> view1 = mv1.view(), view2 = mv2.view();
+            for(unsigned int idx=0; idx<multivectorSize; ++idx){
+                T* row = result.coefficientRow(idx);
+                for(std::size_t i=0; i<resultCount; ++i)
+                    row[i] = function(view1(i, idx), view2(i, idx));
+            }
+            return result;
+        }
+
+        /// \brief apply a batch product to mv1 and mv2
+        template<typename Function>
+        static MvecArray binaryOperation(const MvecArray& mv1, const MvecArray& mv2, Function function) {
+            const std::size_t resultCount = broadcastSize(mv1.count, mv2.count);
+            MvecArray result(resultCount);
+            function(mv1.view(), mv2.view(), result.view(), resultCount);
+            return result;
+        }
+
+        /// \brief apply an inner product or a contraction to mv1 and mv2
+        static MvecArray innerOperation(const MvecArray& mv1, const MvecArray& mv2, const InnerKind kind) {
+            return binaryOperation(mv1, mv2, [kind](const BatchView<const T> view1, const BatchView<const T> view2, const BatchView<T> view3, const std::size_t n){
+                innerProductBatch(view1, view2, view3, n, kind);
+            });
+        }
+        /// \endcond
+    };
+
+}/// End of Namespace
+
+#endif // E3GA_MVEC_ARRAY_HPP__
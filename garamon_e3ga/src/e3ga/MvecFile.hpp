@@ -0,0 +1,430 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// MvecFile.hpp
+// This file is part of the Garamon for e3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file MvecFile.hpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Binary files of multivectors, read in place from a memory mapping: MvecFileWriter appends multivectors to a
+/// file, MvecFileReader gives access to the coefficients of the file without parsing nor copying them.
+///
+/// A file is a header of 64 bytes (MvecFileHeader: version, algebra, type of the coefficients and grades stored), followed
+/// by blocks of at most blockCapacity multivectors. A block is a header of 64 bytes (MvecFileBlockHeader) and the rows of
+/// the coefficients of the stored grades, in the order of Mvec::toDense, as in MvecArray: a row holds the coefficient idx
+/// of all the multivectors of the block. The rows are padded to a multiple of 64 bytes, so that every row of a mapped
+/// file is aligned on a cache line. The values are written in the byte order of the machine, a reader of the other byte
+/// order rejects the file. The blocks are only appended, a reader can map a file while another process appends to it.
+
+
+#ifndef E3GA_MVEC_FILE_HPP__
+#define E3GA_MVEC_FILE_HPP__
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "e3ga/Mvec.hpp"
+#include "e3ga/Batch.hpp"
+#include "e3ga/MvecArray.hpp"
+#include "e3ga/Serialization.hpp"
+
+
+/*!
+ * @namespace e3ga
+ */
+namespace e3ga {
+
+    /// \brief version of the files written by MvecFileWriter, a reader rejects the files of a later version
+    constexpr std::uint32_t mvecFileVersion = 1;
+
+    /// \brief grade bitmap of all the grades of the algebra, the default layout of a file
+    constexpr std::uint32_t allGradesBitmap = (1u << (algebraDimension+1)) - 1;
+
+    /// \brief header at the beginning of a file of multivectors
+    struct MvecFileHeader {
+        char magic[8];                  /*!< "GARAMON" */
+        std::uint32_t version;          /*!< version of the format, mvecFileVersion */
+        std::uint32_t byteOrder;        /*!< 0x01020304 in the byte order of the file */
+        char algebra[8];                /*!< name of the algebra, "e3ga" */
+        std::uint8_t scalarSize;        /*!< sizeof of the coefficients */
+        std::uint8_t scalarDigits;      /*!< std::numeric_limits<T>::digits of the coefficients: 24 for float, 53 for double */
+        std::uint8_t algebraDimension;  /*!< dimension of the algebra */
+        std::uint8_t reserved0;
+        std::uint32_t multivectorSize;  /*!< number of coefficients of a multivector */
+        std::uint32_t gradeBitmap;      /*!< grades stored in the blocks, bit k for the grade k */
+        std::uint32_t blockCapacity;    /*!< maximal number of multivectors of a block */
+        std::uint8_t reserved[24];
+    };
+
+    /// \brief header of a block of multivectors, followed by its rows of coefficients
+    struct MvecFileBlockHeader {
+        char magic[8];                  /*!< "GABLOCK" */
+        std::uint64_t count;            /*!< number of multivectors of the block */
+        std::uint64_t rowStride;        /*!< number of values between the beginnings of two rows (count and the padding) */
+        std::uint8_t reserved[40];
+    };
+
+    static_assert(sizeof(MvecFileHeader) == 64 && sizeof(MvecFileBlockHeader) == 64, "the headers of the files have 64 bytes");
+
+
+    /// \cond DEV
+    /// \class MappedFile
+    /// \brief read-only memory mapping of a whole file (see MvecFile.cpp)
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile() { close(); }
+
+        /// \brief map the file path, an empty file is mapped with data() == nullptr
+        /// \return false if the file cannot be opened or mapped
+        bool open(const std::string& path);
+
+        /// \brief unmap the file
+        void close();
+
+        inline const char* data() const { return mappedData; }
+        inline std::size_t size() const { return mappedSize; }
+
+    private:
+        const char* mappedData = nullptr;
+        std::size_t mappedSize = 0;
+#if defined(_WIN32)
+        void* mappingHandle = nullptr;
+#endif
+    };
+
+    /// \brief number of values of a row of a block of count multivectors, padded to a multiple of 64 bytes
+    template<typename T>
+    constexpr std::size_t mvecFileRowStride(const std::size_t count) {
+        return (count*sizeof(T) + 63) / 64 * 64 / sizeof(T);
+    }
+
+    /// \brief row of each coefficient (in the order of Mvec::toDense) in the blocks of a file storing the grades of gradeBitmap, -1 for the coefficients not stored
+    inline std::array<int, multivectorSize> mvecFileRows(const std::uint32_t gradeBitmap) {
+        std::array<int, multivectorSize> rows;
+        int row = 0;
+        for(unsigned int grade=0; grade<=algebraDimension; ++grade)
+            for(unsigned int i=0; i<binomialArray[grade]; ++i)
+                rows[perGradeStartingIndex[grade]+i] = (gradeBitmap & (1u << grade)) ? row++ : -1;
+        return rows;
+    }
+
+    /// \brief header of a file of multivectors with coefficients of type T
+    template<typename T>
+    MvecFileHeader mvecFileHeader(const std::uint32_t gradeBitmap, const std::size_t blockCapacity) {
+        MvecFileHeader header = {};
+        std::memcpy(header.magic, "GARAMON", 8);
+        header.version = mvecFileVersion;
+        header.byteOrder = 0x01020304;
+        std::strncpy(header.algebra, "e3ga", sizeof(header.algebra));
+        header.scalarSize = (std::uint8_t)sizeof(T);
+        header.scalarDigits = (std::uint8_t)std::numeric_limits<T>::digits;
+        header.algebraDimension = (std::uint8_t)algebraDimension;
+        header.multivectorSize = multivectorSize;
+        header.gradeBitmap = gradeBitmap;
+        header.blockCapacity = (std::uint32_t)blockCapacity;
+        return header;
+    }
+
+    /// \brief true if header is the header of a file of this algebra with coefficients of type T, that this version can read
+    template<typename T>
+    bool isMvecFileHeader(const MvecFileHeader& header) {
+        const MvecFileHeader expected = mvecFileHeader<T>(header.gradeBitmap, header.blockCapacity);
+        return std::memcmp(header.magic, expected.magic, sizeof(header.magic)) == 0
+               && header.version >= 1 && header.version <= mvecFileVersion && header.byteOrder == expected.byteOrder
+               && std::memcmp(header.algebra, expected.algebra, sizeof(header.algebra)) == 0
+               && header.scalarSize == expected.scalarSize && header.scalarDigits == expected.scalarDigits
+               && header.algebraDimension == expected.algebraDimension && header.multivectorSize == expected.multivectorSize
+               && header.gradeBitmap != 0 && (header.gradeBitmap >> (algebraDimension+1)) == 0 && header.blockCapacity != 0;
+    }
+
+    /// \brief size in bytes of the block that starts with blockHeader in a file of header, 0 if blockHeader is not a complete block header of this file
+    template<typename T>
+    std::size_t mvecFileBlockBytes(const MvecFileHeader& header, const MvecFileBlockHeader& blockHeader) {
+        if(std::memcmp(blockHeader.magic, "GABLOCK", 8) != 0 || blockHeader.count == 0 || blockHeader.count > header.blockCapacity
+           || blockHeader.rowStride != mvecFileRowStride<T>((std::size_t)blockHeader.count))
+            return 0;
+        return sizeof(MvecFileBlockHeader) + serializedCoefficientCount(header.gradeBitmap) * (std::size_t)blockHeader.rowStride * sizeof(T);
+    }
+    /// \endcond
+
+
+    /// \class MvecFileReader
+    /// \brief memory mapping of a file of multivectors (see MvecFile.hpp): the coefficients are read in place, as the rows
+    /// of the blocks of the file. The blocks that a writer is appending are ignored until refresh.
+    /// \tparam T - type of the coefficients
+    template<typename T>
+    class MvecFileReader {
+    public:
+        MvecFileReader() = default;
+
+        /// \brief map the file path
+        /// \return false if the file cannot be mapped, or if it is not a file of this algebra with coefficients of type T
+        bool open(const std::string& path) {
+            close();
+            filePath = path;
+            return refresh();
+        }
+
+        /// \brief map the file again, with the blocks appended since open or the last refresh. The pointers and views on
+        /// the previous mapping are invalid.
+        /// \return false if the file cannot be mapped anymore, the reader is then closed
+        bool refresh() {
+            blocks.clear();
+            totalCount = 0;
+            if(!file.open(filePath) || file.size() < sizeof(MvecFileHeader)){
+                close();
+                return false;
+            }
+            std::memcpy(&header, file.data(), sizeof(header));
+            if(!isMvecFileHeader<T>(header)){
+                close();
+                return false;
+            }
+            rows = mvecFileRows(header.gradeBitmap);
+
+            // the blocks up to the first one incomplete, still being written
+            MvecFileBlockHeader blockHeader;
+            for(end = sizeof(MvecFileHeader); end + sizeof(blockHeader) <= file.size(); ){
+                std::memcpy(&blockHeader, file.data() + end, sizeof(blockHeader));
+                const std::size_t bytes = mvecFileBlockBytes<T>(header, blockHeader);
+                if(bytes == 0 || bytes > file.size() - end) break;
+                blocks.push_back({reinterpret_cast<const T*>(file.data() + end + sizeof(blockHeader)), (std::size_t)blockHeader.count,
+                                  (std::size_t)blockHeader.rowStride, totalCount});
+                totalCount += (std::size_t)blockHeader.count;
+                end += bytes;
+            }
+            return true;
+        }
+
+        /// \brief unmap the file
+        void close() {
+            file.close();
+            blocks.clear();
+            totalCount = 0;
+        }
+
+        /// \brief true if a file is mapped
+        inline bool isOpen() const { return file.size() != 0; }
+
+        /// \brief true if the mapping ends with a complete block, false while a writer is appending a block
+        inline bool complete() const { return isOpen() && end == file.size(); }
+
+        /// \brief number of multivectors of the file
+        inline std::size_t size() const { return totalCount; }
+
+        /// \brief grades stored by the file, bit k for the grade k, the other coefficients are 0
+        inline std::uint32_t gradeBitmap() const { return header.gradeBitmap; }
+
+        /// \brief maximal number of multivectors of a block
+        inline std::size_t blockCapacity() const { return header.blockCapacity; }
+
+        /// \brief number of blocks of the file
+        inline std::size_t blockCount() const { return blocks.size(); }
+
+        /// \brief number of multivectors of the block b
+        inline std::size_t blockSize(const std::size_t b) const { return blocks[b].count; }
+
+        /// \brief index in the file of the first multivector of the block b
+        inline std::size_t blockStart(const std::size_t b) const { return blocks[b].start; }
+
+        /// \brief coefficient idx (in the order of Mvec::toDense) of the multivectors of the block b, in the mapping
+        /// \return nullptr if the file does not store the grade of idx
+        inline const T* coefficientRow(const std::size_t b, const unsigned int idx) const {
+            return rows[idx] < 0 ? nullptr : blocks[b].rows + (std::size_t)rows[idx]*blocks[b].rowStride;
+        }
+
+        /// \brief view on the multivectors of the block b for the batch functions, in the mapping
+        /// \throw std::logic_error if the file does not store all the grades (see gradeBitmap), copy the block with block(b)
+        BatchView<const T> view(const std::size_t b) const {
+            if(header.gradeBitmap != allGradesBitmap) throw std::logic_error("MvecFileReader::view on a file without all the grades");
+            return {blocks[b].rows, 1, (std::ptrdiff_t)blocks[b].rowStride};
+        }
+
+        /// \brief copy of the multivectors of the block b
+        MvecArray<T> block(const std::size_t b) const {
+            MvecArray<T> array(blocks[b].count);
+            for(unsigned int idx=0; idx<multivectorSize; ++idx)
+                if(const T* row = coefficientRow(b, idx))
+                    std::memcpy(array.coefficientRow(idx), row, blocks[b].count*sizeof(T));
+            return array;
+        }
+
+        /// \brief copy of the multivector i of the file
+        Mvec<T> at(const std::size_t i) const {
+            if(i >= totalCount) throw std::out_of_range("MvecFileReader index out of range");
+            const std::size_t b = std::upper_bound(blocks.begin(), blocks.end(), i, [](const std::size_t index, const Block& block){
+                return index < block.start;
+            }) - blocks.begin() - 1;
+            T dense[multivectorSize];
+            for(unsigned int idx=0; idx<multivectorSize; ++idx){
+                const T* row = coefficientRow(b, idx);
+                dense[idx] = row ? row[i - blocks[b].start] : T(0);
+            }
+            Mvec<T> mv;
+            mv.fromDense(dense);
+            return mv;
+        }
+
+    private:
+        /// \brief a block of the mapping
+        struct Block {
+            const T* rows;          /*!< first row of the block */
+            std::size_t count;      /*!< number of multivectors */
+            std::size_t rowStride;  /*!< number of values between two rows */
+            std::size_t start;      /*!< index in the file of its first multivector */
+        };
+
+        std::string filePath;
+        MappedFile file;
+        MvecFileHeader header = {};
+        std::array<int, multivectorSize> rows = {};  /*!< row of each coefficient in a block, see mvecFileRows */
+        std::vector<Block> blocks;
+        std::size_t totalCount = 0;
+        std::size_t end = 0;                         /*!< end of the last complete block in the mapping */
+    };
+
+
+    /// \class MvecFileWriter
+    /// \brief append multivectors to a file of multivectors (see MvecFile.hpp). The multivectors are gathered in a block of
+    /// blockCapacity multivectors, written to the file when it is full, by flush or by close.
+    /// \tparam T - type of the coefficients
+    template<typename T>
+    class MvecFileWriter {
+    public:
+        MvecFileWriter() = default;
+        MvecFileWriter(const MvecFileWriter&) = delete;
+        MvecFileWriter& operator=(const MvecFileWriter&) = delete;
+
+        /// \brief write the pending multivectors and close the file
+        ~MvecFileWriter() { close(); }
+
+        /// \brief open the file path to append multivectors to it, create it if it does not exist or is empty
+        /// \param gradeBitmap - grades stored by a new file, bit k for the grade k: the coefficients of the other grades are
+        /// not written. An existing file keeps its grades and block capacity.
+        /// \param blockCapacity - maximal number of multivectors of the blocks of a new file
+        /// \return false if the file cannot be opened, or if it is not a file of this algebra with coefficients of type T
+        /// ending with a complete block
+        bool open(const std::string& path, const std::uint32_t gradeBitmap = allGradesBitmap, const std::size_t blockCapacity = 4096) {
+            close();
+            if(gradeBitmap == 0 || (gradeBitmap >> (algebraDimension+1)) || blockCapacity == 0
+               || blockCapacity > std::numeric_limits<std::uint32_t>::max())
+                return false;
+            MvecFileHeader fileHeader = mvecFileHeader<T>(gradeBitmap, blockCapacity);
+            bool existing = false;
+            if(std::FILE* input = std::fopen(path.c_str(), "rb")){
+                existing = std::fgetc(input) != EOF;
+                std::fclose(input);
+            }
+            if(existing){
+                MvecFileReader<T> reader;
+                if(!reader.open(path) || !reader.complete()) return false;
+                fileHeader = mvecFileHeader<T>(reader.gradeBitmap(), reader.blockCapacity());
+            }
+            if(!(file = std::fopen(path.c_str(), "ab"))) return false;
+            header = fileHeader;
+            rows = mvecFileRows(header.gradeBitmap);
+            pending.assign(serializedCoefficientCount(header.gradeBitmap) * header.blockCapacity, T(0));
+            pendingCount = 0;
+            good = existing || std::fwrite(&header, sizeof(header), 1, file) == 1;
+            return good;
+        }
+
+        /// \brief true if a file is open
+        inline bool isOpen() const { return file != nullptr; }
+
+        /// \brief grades stored by the file, bit k for the grade k
+        inline std::uint32_t gradeBitmap() const { return header.gradeBitmap; }
+
+        /// \brief append a multivector
+        void append(const Mvec<T>& mv) {
+            T dense[multivectorSize];
+            mv.toDense(dense);
+            append(aosBatch<const T>(dense), 1);
+        }
+
+        /// \brief append the multivectors of array
+        void append(const MvecArray<T>& array) {
+            append(soaBatch(array.data(), array.size()), array.size());
+        }
+
+        /// \brief append count multivectors of a batch view
+        void append(const BatchView<const T> view, const std::size_t count) {
+            if(!file) throw std::logic_error("MvecFileWriter::append on a closed file");
+            for(std::size_t first=0; first<count; ){
+                const std::size_t n = std::min<std::size_t>(count - first, header.blockCapacity - pendingCount);
+                for(unsigned int idx=0; idx<multivectorSize; ++idx){
+                    if(rows[idx] < 0) continue;
+                    T* row = pending.data() + (std::size_t)rows[idx]*header.blockCapacity + pendingCount;
+                    for(std::size_t i=0; i<n; ++i)
+                        row[i] = view(first+i, idx);
+                }
+                pendingCount += n;
+                first += n;
+                if(pendingCount == header.blockCapacity) writeBlock();
+            }
+        }
+
+        /// \brief write the pending multivectors as a block, then flush the file for its readers
+        /// \return false if a write failed since the opening of the file
+        bool flush() {
+            if(!file) return false;
+            writeBlock();
+            good = std::fflush(file) == 0 && good;
+            return good;
+        }
+
+        /// \brief write the pending multivectors and close the file
+        /// \return false if a write failed since the opening of the file
+        bool close() {
+            if(!file) return false;
+            writeBlock();
+            good = std::fclose(file) == 0 && good;
+            file = nullptr;
+            return good;
+        }
+
+    private:
+        std::FILE* file = nullptr;
+        MvecFileHeader header = {};
+        std::array<int, multivectorSize> rows = {};  /*!< row of each coefficient in a block, see mvecFileRows */
+        std::vector<T> pending;                      /*!< rows of blockCapacity coefficients of the block being filled */
+        std::size_t pendingCount = 0;                /*!< multivectors of the block being filled */
+        bool good = false;                           /*!< no write failed */
+
+        /// \brief write the pending multivectors as a block
+        void writeBlock() {
+            if(pendingCount == 0) return;
+            MvecFileBlockHeader blockHeader = {};
+            std::memcpy(blockHeader.magic, "GABLOCK", 8);
+            blockHeader.count = pendingCount;
+            blockHeader.rowStride = mvecFileRowStride<T>(pendingCount);
+            const std::size_t padding = (std::size_t)blockHeader.rowStride - pendingCount;
+            const T zeros[64 / sizeof(T) + 1] = {};
+            bool written = std::fwrite(&blockHeader, sizeof(blockHeader), 1, file) == 1;
+            const std::size_t rowCount = serializedCoefficientCount(header.gradeBitmap);
+            for(std::size_t row=0; row<rowCount && written; ++row)
+                written = std::fwrite(pending.data() + row*header.blockCapacity, sizeof(T), pendingCount, file) == pendingCount
+                          && std::fwrite(zeros, sizeof(T), padding, file) == padding;
+            good = good && written;
+            pendingCount = 0;
+        }
+    };
+
+}/// End of Namespace
+
+#endif // E3GA_MVEC_FILE_HPP__
@@ -20,6 +20,7 @@
 
 #include "e3ga/Mvec.hpp"
 #include "e3ga/Outer.hpp"
+#include "e3ga/KernelDispatch.hpp"
 
 
 /*!
@@ -142,8 +143,10 @@ namespace e3ga {
 
 	
 
+    /// \brief kernels of the outer product per grades: outerFunctionsContainer<T>[grade mv1][grade mv2], constant-initialized
+    /// with the explicit kernels, that the kernel dispatch (KernelDispatch.hpp) replaces when the library is loaded.
     template<typename T>
-	std::array<std::array<std::function<void(const Eigen::Matrix<T, Eigen::Dynamic, 1> & , const Eigen::Matrix<T, Eigen::Dynamic, 1> & , Eigen::Matrix<T, Eigen::Dynamic, 1>&)>, 4>, 4> outerFunctionsContainer = {{
+	std::array<std::array<KernelEntry<T>, 4>, 4> outerFunctionsContainer = {{
 		{{outer_0_0<T>,outer_0_1<T>,outer_0_2<T>,outer_0_3<T>}},
 		{{outer_1_0<T>,outer_1_1<T>,outer_1_2<T>,{}}},
 		{{outer_2_0<T>,outer_2_1<T>,{},{}}},
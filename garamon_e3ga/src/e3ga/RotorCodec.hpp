@@ -0,0 +1,205 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// RotorCodec.hpp
+// This file is part of the Garamon for e3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file RotorCodec.hpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Compact codes of unit rotors (scalar + bivector) on 32, 48 or 64 bits, by the "smallest three" quantization.
+///
+/// The four coefficients of a unit rotor (scalar, e12, e13, e23) have a unit norm, so that the largest one in magnitude
+/// is known from the three others. Since R and -R are the same rotation, the rotor is negated if needed for this
+/// coefficient to be positive: the code stores its position on 2 bits and the three other coefficients, in
+/// [-1/sqrt(2), 1/sqrt(2)], quantized on 10, 15 or 20 bits each. The quantization has an odd number of levels, so that 0
+/// is exact: the identity and the rotations about the basis vectors keep their zero coefficients. The codes are written
+/// with their least significant byte first, whatever the machine.
+///
+/// Error bounds, with e = rotorCodeCoefficientError(precision) = 1 / (sqrt(2) (2^bits - 2)):
+///  - each of the three coefficients stored differs from the coefficient of the normalized rotor by at most e, and the
+///    decoded rotor is a unit rotor, up to the rounding of T,
+///  - the angle of the rotation between the rotor and the decoded rotor (the error of the orientation) is at most
+///    rotorCodeAngleError(precision) = 7 e (4 sqrt(3) e to the first order in e): about 4.8e-3 rad for 32 bits, 1.5e-4
+///    rad for 48 bits and 4.7e-6 rad for 64 bits.
+/// The decoded rotor can be the opposite of the rotor, which is the same rotation. A rotor 0, or with a coefficient NaN or
+/// infinite, has the code of the identity (rotorIdentityCode).
+
+
+#ifndef E3GA_ROTOR_CODEC_HPP__
+#define E3GA_ROTOR_CODEC_HPP__
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "e3ga/Mvec.hpp"
+#include "e3ga/Batch.hpp"
+
+
+/*!
+ * @namespace e3ga
+ */
+namespace e3ga {
+
+    /// \brief size of the codes of the rotors
+    enum class RotorPrecision : unsigned int { bits32 = 32, bits48 = 48, bits64 = 64 };
+
+    /// \brief number of bytes of the code of a rotor
+    constexpr std::size_t rotorCodeSize(const RotorPrecision precision) {
+        return (std::size_t)precision / 8;
+    }
+
+    /// \brief number of bits of each of the three coefficients of the code of a rotor
+    constexpr unsigned int rotorCoefficientBits(const RotorPrecision precision) {
+        return precision == RotorPrecision::bits32 ? 10 : precision == RotorPrecision::bits48 ? 15 : 20;
+    }
+
+    /// \brief largest error of the three coefficients stored in the code of a unit rotor (see RotorCodec.hpp)
+    constexpr double rotorCodeCoefficientError(const RotorPrecision precision) {
+        return 0.70710678118654752440 / double((1u << rotorCoefficientBits(precision)) - 2);
+    }
+
+    /// \brief largest angle, in radians, of the rotation between a unit rotor and its decoded code (see RotorCodec.hpp)
+    constexpr double rotorCodeAngleError(const RotorPrecision precision) {
+        return 7.0 * rotorCodeCoefficientError(precision);
+    }
+
+    /// \brief code of the identity: the scalar is the largest coefficient, the three others are at their middle level, 0
+    constexpr std::uint64_t rotorIdentityCode(const RotorPrecision precision) {
+        return (((std::uint64_t(1) << (rotorCoefficientBits(precision) - 1)) - 1) << 2)
+             | (((std::uint64_t(1) << (rotorCoefficientBits(precision) - 1)) - 1) << (2 + rotorCoefficientBits(precision)))
+             | (((std::uint64_t(1) << (rotorCoefficientBits(precision) - 1)) - 1) << (2 + 2*rotorCoefficientBits(precision)));
+    }
+
+    /// \cond DEV
+    /// \brief position in a dense multivector (see Mvec::toDense) of the coefficient i of a rotor: scalar, e12, e13, e23
+    constexpr unsigned int rotorDenseIndex(const unsigned int i) {
+        return i == 0 ? 0 : perGradeStartingIndex[2] + i - 1;
+    }
+
+    /// \brief positions (scalar, e12, e13, e23) of the three coefficients stored in a code, per position of the largest one
+    constexpr unsigned int rotorStoredCoefficients[4][3] = {{1,2,3}, {0,2,3}, {0,1,3}, {0,1,2}};
+
+    /// \brief code of the unit rotor of coefficients (scalar, e12, e13, e23), not necessarily normalized
+    template<typename T>
+    std::uint64_t encodeRotorCoefficients(const T (&rotor)[4], const RotorPrecision precision) {
+        const unsigned int bits = rotorCoefficientBits(precision);
+        const double lastLevel = double((1u << bits) - 2);
+        const double coefficients[4] = {double(rotor[0]), double(rotor[1]), double(rotor[2]), double(rotor[3])};
+        const double squaredNorm = coefficients[0]*coefficients[0] + coefficients[1]*coefficients[1]
+                                 + coefficients[2]*coefficients[2] + coefficients[3]*coefficients[3];
+        if(!(squaredNorm > 0.0) || std::isinf(squaredNorm)) return rotorIdentityCode(precision); // the code 0 is not a unit rotor
+
+        // without branches: the position of the largest coefficient is random for the orientations of a stream
+        const unsigned int largest01 = std::abs(coefficients[1]) > std::abs(coefficients[0]) ? 1 : 0;
+        const unsigned int largest23 = std::abs(coefficients[3]) > std::abs(coefficients[2]) ? 3 : 2;
+        const unsigned int upper = 0u - (unsigned int)(std::abs(coefficients[largest23]) > std::abs(coefficients[largest01]));
+        const unsigned int largest = largest01 ^ ((largest01 ^ largest23) & upper);
+        const double scale = std::copysign(0.70710678118654752440 * lastLevel, coefficients[largest]) / std::sqrt(squaredNorm);
+
+        // level of each coefficient in [-1/sqrt(2), 1/sqrt(2)], 0 in the middle, rounded to the nearest
+        std::uint64_t code = largest;
+        for(unsigned int j=0; j<3; ++j){
+            const double level = coefficients[rotorStoredCoefficients[largest][j]] * scale + 0.5 * lastLevel + 0.5;
+            code |= (std::uint64_t)(std::uint32_t)(level < 0.0 ? 0.0 : level > lastLevel ? lastLevel : level) << (2 + j*bits);
+        }
+        return code;
+    }
+
+    /// \brief coefficients (scalar, e12, e13, e23) of the unit rotor of a code
+    template<typename T>
+    void decodeRotorCoefficients(const std::uint64_t code, const RotorPrecision precision, T (&rotor)[4]) {
+        const unsigned int bits = rotorCoefficientBits(precision);
+        const T step = T(1.41421356237309504880) / T((1u << bits) - 2);
+        const T middle = T((1u << (bits - 1)) - 1);
+        const std::uint64_t mask = (std::uint64_t(1) << bits) - 1;
+        const unsigned int largest = (unsigned int)(code & 3u);
+        T squaredNorm = T(0);
+        for(unsigned int j=0; j<3; ++j){
+            const T coefficient = (T((code >> (2 + j*bits)) & mask) - middle) * step;
+            rotor[rotorStoredCoefficients[largest][j]] = coefficient;
+            squaredNorm += coefficient * coefficient;
+        }
+        rotor[largest] = std::sqrt(squaredNorm < T(1) ? T(1) - squaredNorm : T(0));
+    }
+
+    /// \brief write the code of a rotor with its least significant byte first
+    inline void storeRotorCode(std::uint64_t code, std::uint8_t* bytes, const std::size_t size) {
+        for(std::size_t b=0; b<size; ++b, code >>= 8)
+            bytes[b] = (std::uint8_t)(code & 0xFF);
+    }
+
+    /// \brief read a code written by storeRotorCode
+    inline std::uint64_t loadRotorCode(const std::uint8_t* bytes, const std::size_t size) {
+        std::uint64_t code = 0;
+        for(std::size_t b=size; b-- > 0; )
+            code = (code << 8) | bytes[b];
+        return code;
+    }
+    /// \endcond
+
+
+    /// \brief codes of unit rotors, see RotorCodec.hpp. Only the scalar and bivector coefficients of the rotors are read,
+    /// they are normalized before the quantization.
+    /// \param rotors - count rotors, for instance the view of an MvecArray
+    /// \param codes - count x rotorCodeSize(precision) bytes, one code after the other
+    template<typename T>
+    void encodeRotorBatch(const BatchView<const T> rotors, std::uint8_t* codes, const std::size_t count, const RotorPrecision precision) {
+        const std::size_t codeSize = rotorCodeSize(precision);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if(count >= batchParallelThreshold)
+#endif
+        for(std::ptrdiff_t item=0; item<(std::ptrdiff_t)count; ++item){
+            T rotor[4];
+            for(unsigned int i=0; i<4; ++i)
+                rotor[i] = rotors(item, rotorDenseIndex(i));
+            storeRotorCode(encodeRotorCoefficients(rotor, precision), codes + item*codeSize, codeSize);
+        }
+    }
+
+    /// \brief unit rotors of codes written by encodeRotorBatch, see RotorCodec.hpp for their error
+    /// \param codes - count x rotorCodeSize(precision) bytes, one code after the other
+    /// \param rotors - the count rotors, their coefficients of grade 1 and 3 are set to 0
+    template<typename T>
+    void decodeRotorBatch(const std::uint8_t* codes, const BatchView<T> rotors, const std::size_t count, const RotorPrecision precision) {
+        const std::size_t codeSize = rotorCodeSize(precision);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if(count >= batchParallelThreshold)
+#endif
+        for(std::ptrdiff_t item=0; item<(std::ptrdiff_t)count; ++item){
+            T rotor[4];
+            decodeRotorCoefficients(loadRotorCode(codes + item*codeSize, codeSize), precision, rotor);
+            for(unsigned int idx=0; idx<multivectorSize; ++idx)
+                rotors(item, idx) = T(0);
+            for(unsigned int i=0; i<4; ++i)
+                rotors(item, rotorDenseIndex(i)) = rotor[i];
+        }
+    }
+
+    /// \brief code of a unit rotor, in its rotorCodeSize(precision) least significant bytes, see encodeRotorBatch
+    template<typename T>
+    std::uint64_t encodeRotor(const Mvec<T>& rotor, const RotorPrecision precision) {
+        const T coefficients[4] = {rotor[scalar], rotor[E12], rotor[E13], rotor[E23]};
+        return encodeRotorCoefficients(coefficients, precision);
+    }
+
+    /// \brief unit rotor of a code of encodeRotor
+    template<typename T>
+    Mvec<T> decodeRotor(const std::uint64_t code, const RotorPrecision precision) {
+        T coefficients[4];
+        decodeRotorCoefficients(code, precision, coefficients);
+        Mvec<T> rotor;
+        rotor[scalar] = coefficients[0];
+        rotor[E12] = coefficients[1];
+        rotor[E13] = coefficients[2];
+        rotor[E23] = coefficients[3];
+        return rotor;
+    }
+
+}/// End of Namespace
+
+#endif // E3GA_ROTOR_CODEC_HPP__
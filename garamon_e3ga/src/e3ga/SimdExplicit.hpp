@@ -0,0 +1,228 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// SimdExplicit.hpp
+// This file is part of the Garamon for e3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file SimdExplicit.hpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Explicit precomputed per grades products computed on 4-lane SIMD registers, for a single pair of multivectors.
+///
+/// A product is computed column by column: for each coefficient of mv1, the coefficients of mv2 it multiplies are
+/// gathered in registers of 4 consecutive coefficients of the result, their signs are set with a sign mask, and they are
+/// accumulated with fused multiply-adds. Only the products with at least 4 coefficients in their result and registers
+/// filled at 40% on average have a SIMD version, the explicit kernels are faster for the others.
+///
+/// The library compiles these kernels for several instruction sets, the function containers use the variant selected
+/// for the processor at run time (see KernelDispatch.hpp).
+
+
+#ifndef E3GA_SIMD_EXPLICIT_HPP__
+#define E3GA_SIMD_EXPLICIT_HPP__
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <Eigen/Core>
+
+#if (defined(__AVX__) && defined(__FMA__)) || (defined(_MSC_VER) && defined(__AVX2__))
+#define E3GA_SIMD_KERNELS 1
+#include <immintrin.h>
+#else
+#define E3GA_SIMD_KERNELS 0
+#endif
+
+/// \cond DEV
+// the SIMD code depends on the instruction set: it is put in a namespace per instruction set, so that the translation
+// units compiled with different flags do not share (and randomly replace each other's) definitions
+#if E3GA_SIMD_KERNELS && defined(__AVX512F__)
+#define E3GA_SIMD_NAMESPACE simd_avx512
+#elif E3GA_SIMD_KERNELS && defined(__AVX2__)
+#define E3GA_SIMD_NAMESPACE simd_avx2
+#elif E3GA_SIMD_KERNELS
+#define E3GA_SIMD_NAMESPACE simd_avx
+#else
+#define E3GA_SIMD_NAMESPACE simd_none
+#endif
+/// \endcond
+
+
+/*!
+ * @namespace e3ga
+ */
+namespace e3ga {
+
+    /// \brief signature of the explicit kernels of the products, stored in the function containers
+    template<typename T>
+    using ProductKernel = void(const Eigen::Matrix<T, Eigen::Dynamic, 1>&, const Eigen::Matrix<T, Eigen::Dynamic, 1>&, Eigen::Matrix<T, Eigen::Dynamic, 1>&);
+
+    /// \brief entry of the function containers (outerFunctionsContainer, innerFunctionsContainer, geometricFunctionsContainer):
+    /// a kernel, or none. The kernel dispatch (KernelDispatch.hpp) replaces it while other threads may call it, its function
+    /// pointer is read and replaced atomically. The kernels are functions, no data is published with them: the accesses are
+    /// relaxed, a plain load and store on the usual processors.
+    template<typename T>
+    class KernelEntry {
+    public:
+        constexpr KernelEntry() : kernel(nullptr) {}
+        constexpr KernelEntry(ProductKernel<T>* const function) : kernel(function) {}
+        KernelEntry(const KernelEntry& entry) : kernel(entry.load()) {}
+        KernelEntry& operator=(const KernelEntry& entry) { store(entry.load()); return *this; }
+
+        /// \brief compute the product of mv1 and mv2 in mv3 with the current kernel
+        void operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv1, const Eigen::Matrix<T, Eigen::Dynamic, 1>& mv2, Eigen::Matrix<T, Eigen::Dynamic, 1>& mv3) const {
+            load()(mv1, mv2, mv3);
+        }
+
+        /// \brief true if the entry has a kernel
+        explicit operator bool() const { return load() != nullptr; }
+
+        /// \brief the current kernel, nullptr if none
+        ProductKernel<T>* load() const { return kernel.load(std::memory_order_relaxed); }
+
+        /// \brief replace the kernel
+        void store(ProductKernel<T>* const function) { kernel.store(function, std::memory_order_relaxed); }
+
+    private:
+        std::atomic<ProductKernel<T>*> kernel;
+    };
+
+    /// \brief products that have per grades kernels
+    enum class ProductKind { outer, inner, geometric };
+
+    /// \brief a kernel of a product between two homogeneous multivectors of grade grade1 and grade2, whose result has grade grade3
+    template<typename T>
+    struct GradeKernel {
+        ProductKind product;
+        unsigned int grade1;
+        unsigned int grade2;
+        unsigned int grade3;
+        ProductKernel<T>* kernel;
+    };
+
+    inline namespace E3GA_SIMD_NAMESPACE {
+
+    /// \brief register of 4 values of type T and its operations, used by the SIMD kernels.
+    /// The generic version stores the values in an array, it is specialized on SIMD registers for float and double.
+    template<typename T>
+    struct SimdPack {
+        static constexpr bool vectorized = false; /*!< true when the operations use SIMD registers */
+
+        struct Register { T value[4]; };
+
+        static Register broadcast(const T x) { return {{x, x, x, x}}; }
+
+        static Register set(const T x0, const T x1, const T x2, const T x3) { return {{x0, x1, x2, x3}}; }
+
+        /// \brief set(x0, x1, x2, x3) with the sign of the lanes k whose bit k is set in signMask flipped
+        template<unsigned int signMask>
+        static Register setSigned(const T x0, const T x1, const T x2, const T x3) {
+            return {{(signMask & 1) ? -x0 : x0, (signMask & 2) ? -x1 : x1, (signMask & 4) ? -x2 : x2, (signMask & 8) ? -x3 : x3}};
+        }
+
+        static Register multiply(const Register& a, const Register& b) {
+            Register result;
+            for(unsigned int k=0; k<4; ++k) result.value[k] = a.value[k]*b.value[k];
+            return result;
+        }
+
+        /// \brief a*b + c
+        static Register multiplyAdd(const Register& a, const Register& b, Register c) {
+            for(unsigned int k=0; k<4; ++k) c.value[k] += a.value[k]*b.value[k];
+            return c;
+        }
+
+        /// \brief add the first lanes lanes of r to the values pointed by c
+        template<unsigned int lanes>
+        static void addTo(T* c, const Register& r) {
+            for(unsigned int k=0; k<lanes; ++k) c[k] += r.value[k];
+        }
+    };
+
+#if E3GA_SIMD_KERNELS
+    /// \cond DEV
+    template<>
+    struct SimdPack<double> {
+        static constexpr bool vectorized = true;
+
+        using Register = __m256d;
+
+        static Register broadcast(const double x) { return _mm256_set1_pd(x); }
+
+        static Register set(const double x0, const double x1, const double x2, const double x3) { return _mm256_setr_pd(x0, x1, x2, x3); }
+
+        template<unsigned int signMask>
+        static Register setSigned(const double x0, const double x1, const double x2, const double x3) {
+            const long long sign = (long long)0x8000000000000000ull;
+            const __m256d mask = _mm256_castsi256_pd(_mm256_setr_epi64x((signMask & 1) ? sign : 0, (signMask & 2) ? sign : 0, (signMask & 4) ? sign : 0, (signMask & 8) ? sign : 0));
+            return _mm256_xor_pd(_mm256_setr_pd(x0, x1, x2, x3), mask);
+        }
+
+        static Register multiply(const Register a, const Register b) { return _mm256_mul_pd(a, b); }
+
+        static Register multiplyAdd(const Register a, const Register b, const Register c) { return _mm256_fmadd_pd(a, b, c); }
+
+        template<unsigned int lanes>
+        static void addTo(double* c, const Register r) {
+            if(lanes == 4){
+                _mm256_storeu_pd(c, _mm256_add_pd(_mm256_loadu_pd(c), r));
+                return;
+            }
+            alignas(32) double values[4];
+            _mm256_store_pd(values, r);
+            for(unsigned int k=0; k<lanes; ++k) c[k] += values[k];
+        }
+    };
+
+    template<>
+    struct SimdPack<float> {
+        static constexpr bool vectorized = true;
+
+        using Register = __m128;
+
+        static Register broadcast(const float x) { return _mm_set1_ps(x); }
+
+        static Register set(const float x0, const float x1, const float x2, const float x3) { return _mm_setr_ps(x0, x1, x2, x3); }
+
+        template<unsigned int signMask>
+        static Register setSigned(const float x0, const float x1, const float x2, const float x3) {
+            const int sign = (int)0x80000000u;
+            const __m128 mask = _mm_castsi128_ps(_mm_setr_epi32((signMask & 1) ? sign : 0, (signMask & 2) ? sign : 0, (signMask & 4) ? sign : 0, (signMask & 8) ? sign : 0));
+            return _mm_xor_ps(_mm_setr_ps(x0, x1, x2, x3), mask);
+        }
+
+        static Register multiply(const Register a, const Register b) { return _mm_mul_ps(a, b); }
+
+        static Register multiplyAdd(const Register a, const Register b, const Register c) { return _mm_fmadd_ps(a, b, c); }
+
+        template<unsigned int lanes>
+        static void addTo(float* c, const Register r) {
+            if(lanes == 4){
+                _mm_storeu_ps(c, _mm_add_ps(_mm_loadu_ps(c), r));
+                return;
+            }
+            alignas(16) float values[4];
+            _mm_store_ps(values, r);
+            for(unsigned int k=0; k<lanes; ++k) c[k] += values[k];
+        }
+    };
+    /// \endcond
+#endif
+
+
+	// no product of e3ga has a result of 4 coefficients or more: the explicit kernels are used for all of them
+
+	/// \brief the SIMD kernels of this file
+	template<typename T>
+	const std::array<GradeKernel<T>, 0>& simdKernels() {
+		static const std::array<GradeKernel<T>, 0> kernels = {{}};
+		return kernels;
+	}
+
+    }/// End of inline namespace E3GA_SIMD_NAMESPACE
+
+}/// End of Namespace
+
+#endif // E3GA_SIMD_EXPLICIT_HPP__
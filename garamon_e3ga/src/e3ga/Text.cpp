@@ -0,0 +1,101 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Text.cpp
+// This file is part of the Garamon for e3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Text.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Conversions between the coefficients of the multivectors and their text, for Text.hpp.
+///
+/// This file is compiled as C++17 (see CMakeLists.txt) for std::to_chars and std::from_chars: the shortest exact text,
+/// without locale nor allocation. With a standard library that lacks their floating point versions, the coefficients
+/// are written with max_digits10 significant digits by printf and read by strtod, exact as well.
+
+
+#include "e3ga/Text.hpp"
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
+
+
+namespace e3ga {
+
+    namespace {
+
+#if defined(__cpp_lib_to_chars)
+        template<typename T>
+        char* toChars(char* first, char* last, const T value) {
+            const std::to_chars_result result = std::to_chars(first, last, value);
+            return result.ec == std::errc() ? result.ptr : nullptr;
+        }
+
+        template<typename T>
+        const char* fromChars(const char* first, const char* last, T& value) {
+            if(first != last && *first == '+') ++first; // accepted by operator>> but not by from_chars
+            const std::from_chars_result result = std::from_chars(first, last, value);
+            return result.ec == std::errc() ? result.ptr : nullptr;
+        }
+#else
+        inline int print(char* buffer, const std::size_t size, const double value) {
+            return std::snprintf(buffer, size, "%.*g", std::numeric_limits<double>::max_digits10, value);
+        }
+
+        inline int print(char* buffer, const std::size_t size, const float value) {
+            return std::snprintf(buffer, size, "%.*g", std::numeric_limits<float>::max_digits10, double(value));
+        }
+
+        inline int print(char* buffer, const std::size_t size, const long double value) {
+            return std::snprintf(buffer, size, "%.*Lg", std::numeric_limits<long double>::max_digits10, value);
+        }
+
+        inline char* read(const char* text, float& value) { char* end; value = std::strtof(text, &end); return end; }
+        inline char* read(const char* text, double& value) { char* end; value = std::strtod(text, &end); return end; }
+        inline char* read(const char* text, long double& value) { char* end; value = std::strtold(text, &end); return end; }
+
+        template<typename T>
+        char* toChars(char* first, char* last, const T value) {
+            char buffer[textCoefficientCapacity<T> + 1];
+            const int length = print(buffer, sizeof(buffer), value);
+            if(length < 0 || length > last - first) return nullptr;
+            std::memcpy(first, buffer, (std::size_t)length);
+            return first + length;
+        }
+
+        template<typename T>
+        const char* fromChars(const char* first, const char* last, T& value) {
+            // copy the number to a terminated buffer for strtod: sign, digits, point, exponent, inf and nan
+            char buffer[textCoefficientCapacity<T> + 16];
+            std::size_t length = 0;
+            for(const char* it = first; it != last && length + 1 < sizeof(buffer); ++it){
+                if(!(std::isalnum((unsigned char)*it) || *it == '.'
+                     || ((*it == '+' || *it == '-') && (it == first || *(it-1) == 'e' || *(it-1) == 'E'))))
+                    break;
+                buffer[length++] = *it;
+            }
+            buffer[length] = '\0';
+            const char* const end = read(buffer, value);
+            return end == buffer ? nullptr : first + (end - buffer);
+        }
+#endif
+    }
+
+    char* formatCoefficient(char* first, char* last, const float value) { return toChars(first, last, value); }
+    char* formatCoefficient(char* first, char* last, const double value) { return toChars(first, last, value); }
+    char* formatCoefficient(char* first, char* last, const long double value) { return toChars(first, last, value); }
+
+    const char* parseCoefficient(const char* first, const char* last, float& value) { return fromChars(first, last, value); }
+    const char* parseCoefficient(const char* first, const char* last, double& value) { return fromChars(first, last, value); }
+    const char* parseCoefficient(const char* first, const char* last, long double& value) { return fromChars(first, last, value); }
+
+}/// End of Namespace
@@ -0,0 +1,65 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// RandomMvec.hpp
+// This file is part of the Garamon for e3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file RandomMvec.hpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Random multivectors of the test programs of e3ga, and their exact comparison.
+
+
+#ifndef E3GA_TEST_RANDOM_MVEC_HPP__
+#define E3GA_TEST_RANDOM_MVEC_HPP__
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "e3ga/Mvec.hpp"
+
+
+namespace e3ga {
+namespace test {
+
+    /// \brief grade bitmap of all the grades of the algebra
+    constexpr std::uint32_t allGrades = (1u << (algebraDimension+1)) - 1;
+
+    template<typename T>
+    std::string typeName() {
+        return sizeof(T) == sizeof(float) ? "float" : "double";
+    }
+
+    /// \brief random multivector with the grades of gradeBitmap
+    template<typename T>
+    Mvec<T> randomMvec(std::mt19937& randomEngine, const std::uint32_t gradeBitmap) {
+        std::uniform_real_distribution<T> uniform(T(-1), T(1));
+        T dense[multivectorSize] = {};
+        for(unsigned int grade=0; grade<=algebraDimension; ++grade)
+            if(gradeBitmap & (1u << grade))
+                for(unsigned int i=0; i<binomialArray[grade]; ++i)
+                    dense[perGradeStartingIndex[grade] + i] = uniform(randomEngine);
+        Mvec<T> mv;
+        mv.fromDense(dense);
+        return mv;
+    }
+
+    /// \brief true if mv1 and mv2 have the same coefficients
+    template<typename T>
+    bool sameMvec(const Mvec<T>& mv1, const Mvec<T>& mv2) {
+        T dense1[multivectorSize], dense2[multivectorSize];
+        mv1.toDense(dense1);
+        mv2.toDense(dense2);
+        for(unsigned int i=0; i<multivectorSize; ++i)
+            if(dense1[i] != dense2[i]) return false;
+        return true;
+    }
+
+}/// End of Namespace test
+}/// End of Namespace
+
+#endif // E3GA_TEST_RANDOM_MVEC_HPP__
@@ -0,0 +1,144 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// RotorCodec.cpp
+// This file is part of the Garamon for e3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file RotorCodec.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Test of the codes of unit rotors (RotorCodec.hpp), at each precision:
+///  - the rotor 0, NaN or infinite has the code of the identity, which decodes to the identity,
+///  - random rotors, and the rotations about the basis vectors, decoded by the batch functions within the error bounds of
+///    the coefficients and of the angle, as unit rotors, the zero coefficients being exact,
+///  - the codes are written with their least significant byte first, and encodeRotor / decodeRotor agree with the batches.
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "e3ga/Mvec.hpp"
+#include "e3ga/MvecArray.hpp"
+#include "e3ga/RotorCodec.hpp"
+
+#include "Test.hpp"
+
+
+namespace {
+
+    using e3ga::test::check;
+    using e3ga::RotorPrecision;
+
+    constexpr RotorPrecision precisions[] = {RotorPrecision::bits32, RotorPrecision::bits48, RotorPrecision::bits64};
+
+    std::string precisionName(const RotorPrecision precision) {
+        return std::to_string((unsigned int)precision) + " bits";
+    }
+
+    void testIdentity(const RotorPrecision precision) {
+        const double nan = std::numeric_limits<double>::quiet_NaN(), infinity = std::numeric_limits<double>::infinity();
+        const double rotors[][4] = {{1.0, 0.0, 0.0, 0.0}, {0.0, 0.0, 0.0, 0.0}, {nan, 0.0, 0.0, 0.0}, {0.5, nan, 0.5, 0.5},
+                                    {infinity, 1.0, 0.0, 0.0}};
+        for(const auto& rotor : rotors)
+            check(e3ga::encodeRotorCoefficients(rotor, precision) == e3ga::rotorIdentityCode(precision),
+                  "code of the identity for a rotor 1, 0, NaN or infinite, " + precisionName(precision));
+
+        double decoded[4];
+        e3ga::decodeRotorCoefficients(e3ga::rotorIdentityCode(precision), precision, decoded);
+        check(decoded[0] == 1.0 && decoded[1] == 0.0 && decoded[2] == 0.0 && decoded[3] == 0.0,
+              "identity decoded from its code, " + precisionName(precision));
+        e3ga::decodeRotorCoefficients(0, precision, decoded);
+        check(!(decoded[0] == 1.0), "the code 0 is not the identity, " + precisionName(precision));
+    }
+
+    void testErrorBounds(const RotorPrecision precision) {
+        const std::size_t count = 1 << 14, codeSize = e3ga::rotorCodeSize(precision);
+        e3ga::MvecArray<double> rotors(count), decoded(count);
+        std::vector<std::uint8_t> codes(count * codeSize);
+
+        // random orientations, and rotations about the basis vectors, whose coefficients 0 are exact in the codes
+        std::mt19937 randomEngine(7);
+        std::normal_distribution<double> normal;
+        for(std::size_t i=0; i<count; ++i){
+            double coefficients[4], squaredNorm = 0.0;
+            for(unsigned int c=0; c<4; ++c){
+                coefficients[c] = (i % 16 == 0 && c != 0 && c != 1 + (i / 16) % 3) ? 0.0 : normal(randomEngine);
+                squaredNorm += coefficients[c] * coefficients[c];
+            }
+            for(unsigned int c=0; c<4; ++c)
+                rotors.coefficientRow(e3ga::rotorDenseIndex(c))[i] = coefficients[c] / std::sqrt(squaredNorm);
+        }
+        const e3ga::MvecArray<double>& source = rotors;
+        e3ga::encodeRotorBatch(source.view(), codes.data(), count, precision);
+        e3ga::decodeRotorBatch(codes.data(), decoded.view(), count, precision);
+
+        // angle of the rotation between a rotor and its decoded rotor, which can be its opposite
+        bool angles = true, coefficientErrors = true, unitRotors = true, zeros = true;
+        for(std::size_t i=0; i<count; ++i){
+            double dot = 0.0, squaredNorm = 0.0, difference = 0.0, storedError = 0.0;
+            unsigned int largest = 0;
+            for(unsigned int c=0; c<4; ++c){
+                const double original = rotors.coefficientRow(e3ga::rotorDenseIndex(c))[i];
+                dot += original * decoded.coefficientRow(e3ga::rotorDenseIndex(c))[i];
+                if(std::abs(original) > std::abs(rotors.coefficientRow(e3ga::rotorDenseIndex(largest))[i])) largest = c;
+            }
+            for(unsigned int c=0; c<4; ++c){
+                const double original = rotors.coefficientRow(e3ga::rotorDenseIndex(c))[i];
+                const double coefficient = decoded.coefficientRow(e3ga::rotorDenseIndex(c))[i];
+                const double error = original - (dot < 0.0 ? -coefficient : coefficient);
+                squaredNorm += coefficient * coefficient;
+                difference += error * error;
+                if(c != largest) storedError = std::max(storedError, std::abs(error));
+                zeros = zeros && (original != 0.0 || coefficient == 0.0);
+            }
+            const double angle = 4.0 * std::asin(std::min(1.0, 0.5 * std::sqrt(difference)));
+            angles = angles && angle <= e3ga::rotorCodeAngleError(precision);
+            // the largest coefficient is computed from the three others stored, which have the bound (up to the rounding)
+            coefficientErrors = coefficientErrors && storedError <= e3ga::rotorCodeCoefficientError(precision) * (1.0 + 1e-9);
+            unitRotors = unitRotors && std::abs(squaredNorm - 1.0) < 1e-12;
+        }
+        check(angles, "angle error of the decoded rotors within rotorCodeAngleError, " + precisionName(precision));
+        check(coefficientErrors, "error of the stored coefficients within rotorCodeCoefficientError, " + precisionName(precision));
+        check(unitRotors, "decoded rotors of unit norm, " + precisionName(precision));
+        check(zeros, "zero coefficients decoded exactly, " + precisionName(precision));
+    }
+
+    void testCodes(const RotorPrecision precision) {
+        const std::size_t codeSize = e3ga::rotorCodeSize(precision);
+        const std::uint64_t code = 0x0123456789ABCDEFull & ((std::uint64_t(1) << (8*codeSize - 1) << 1) - 1);
+        std::uint8_t bytes[8];
+        e3ga::storeRotorCode(code, bytes, codeSize);
+        check(bytes[0] == 0xEF && bytes[1] == 0xCD && e3ga::loadRotorCode(bytes, codeSize) == code,
+              "code written with its least significant byte first, " + precisionName(precision));
+
+        // a rotation of 1 radian about (1, 2, 3)
+        const e3ga::Mvec<double> rotor = std::cos(0.5) - std::sin(0.5) / std::sqrt(14.0)
+            * (1.0 * e3ga::e23<double>() - 2.0 * e3ga::e13<double>() + 3.0 * e3ga::e12<double>());
+        e3ga::MvecArray<double> rotors(1), decoded(1);
+        rotors.set(0, rotor);
+        const e3ga::MvecArray<double>& source = rotors;
+        e3ga::encodeRotorBatch(source.view(), bytes, 1, precision);
+        e3ga::decodeRotorBatch(bytes, decoded.view(), 1, precision);
+        const std::uint64_t single = e3ga::encodeRotor(rotor, precision);
+        check(e3ga::loadRotorCode(bytes, codeSize) == single && (decoded.at(0) - e3ga::decodeRotor<double>(single, precision)).norm() == 0.0,
+              "encodeRotor and decodeRotor agree with the batch functions, " + precisionName(precision));
+    }
+}
+
+
+int main() {
+    for(const RotorPrecision precision : precisions){
+        testIdentity(precision);
+        testErrorBounds(precision);
+        testCodes(precision);
+    }
+    return e3ga::test::testResult();
+}
@@ -0,0 +1,117 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Serialization.cpp
+// This file is part of the Garamon for e3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Serialization.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Test of the binary encoding of multivectors and arrays of multivectors (Serialization.hpp), for float and double:
+///  - the round trips of random multivectors of each set of grades, of 0, and of arrays of them,
+///  - an array of zeros keeps its size, and is encoded with the coefficients of its grade 0,
+///  - the malformed encodings are rejected, before any allocation, and leave the decoded value unchanged: a huge array
+///    without coefficients, sizes that wrap, truncated buffers, another type of coefficients, grades above the dimension.
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "e3ga/Mvec.hpp"
+#include "e3ga/MvecArray.hpp"
+#include "e3ga/MvecFile.hpp"
+#include "e3ga/Serialization.hpp"
+
+#include "RandomMvec.hpp"
+#include "Test.hpp"
+
+
+namespace {
+
+    using e3ga::test::check;
+    using e3ga::test::randomMvec;
+    using e3ga::test::sameMvec;
+    using e3ga::test::typeName;
+
+    /// \brief encoding of an array of double: coefficient size, count and grade bitmap, then size bytes of coefficients
+    std::string arrayEncoding(const std::uint64_t count, const std::uint32_t gradeBitmap, const std::size_t size) {
+        std::string buffer;
+        e3ga::appendBytes(buffer, (std::uint8_t)sizeof(double));
+        e3ga::appendBytes(buffer, count);
+        e3ga::appendBytes(buffer, gradeBitmap);
+        return buffer + std::string(size, '\0');
+    }
+
+    template<typename T>
+    void testRoundTrips(std::mt19937& randomEngine) {
+        bool multivectors = true, arrays = true;
+        for(std::uint32_t gradeBitmap=0; gradeBitmap<=e3ga::allGradesBitmap; ++gradeBitmap){
+            const e3ga::Mvec<T> mv = randomMvec<T>(randomEngine, gradeBitmap);
+            const std::string buffer = e3ga::serialize(mv);
+            e3ga::Mvec<T> decoded;
+            multivectors = multivectors && buffer.size() == 1 + sizeof(std::uint32_t) + e3ga::serializedCoefficientCount(gradeBitmap)*sizeof(T)
+                && e3ga::deserialize(buffer, decoded) && sameMvec(decoded, mv);
+
+            // an array whose multivectors have some of the grades of gradeBitmap
+            std::vector<e3ga::Mvec<T>> mvs;
+            for(std::uint32_t grades=0; grades<=gradeBitmap; ++grades)
+                if((grades & gradeBitmap) == grades) mvs.push_back(randomMvec<T>(randomEngine, grades));
+            e3ga::MvecArray<T> array;
+            arrays = arrays && e3ga::deserialize(e3ga::serialize(e3ga::MvecArray<T>(mvs)), array) && array.size() == mvs.size();
+            for(std::size_t i=0; arrays && i<mvs.size(); ++i)
+                arrays = sameMvec(array.at(i), mvs[i]);
+        }
+        check(multivectors, "round trip of multivectors of each set of grades, " + typeName<T>());
+        check(arrays, "round trip of arrays of multivectors, " + typeName<T>());
+
+        e3ga::MvecArray<T> empty(std::vector<e3ga::Mvec<T>>{}), decoded(3);
+        check(e3ga::deserialize(e3ga::serialize(empty), decoded) && decoded.size() == 0, "round trip of an empty array, " + typeName<T>());
+
+        const std::string zeros = e3ga::serialize(e3ga::MvecArray<T>(4));
+        check(zeros.size() == 1 + sizeof(std::uint64_t) + sizeof(std::uint32_t) + 4*sizeof(T)
+              && e3ga::deserialize(zeros, decoded) && decoded.size() == 4 && sameMvec(decoded.at(3), e3ga::Mvec<T>()),
+              "array of zeros encoded with its grade 0, " + typeName<T>());
+    }
+
+    void testMalformedArrays() {
+        e3ga::MvecArray<double> array(2);
+        array.set(1, e3ga::Mvec<double>() + 2.0);
+        const std::string truncated = e3ga::serialize(e3ga::MvecArray<double>(std::vector<e3ga::Mvec<double>>(3, e3ga::Mvec<double>() + 1.0)));
+        check(!e3ga::deserialize(arrayEncoding(std::uint64_t(1) << 59, 0, 0), array), "huge array without coefficients rejected");
+        check(!e3ga::deserialize(arrayEncoding(3, 0, 0), array), "array without coefficients rejected");
+        check(!e3ga::deserialize(arrayEncoding(std::uint64_t(1) << 62, 1, 0), array), "array whose size wraps rejected");
+        check(!e3ga::deserialize(arrayEncoding(~std::uint64_t(0), e3ga::allGradesBitmap, 8), array), "array of the largest count rejected");
+        check(!e3ga::deserialize(truncated.substr(0, truncated.size() - 1), array), "truncated array rejected");
+        check(!e3ga::deserialize(arrayEncoding(2, 1, 8), array), "array with too few coefficients rejected");
+        check(!e3ga::deserialize(arrayEncoding(1, e3ga::allGradesBitmap + 1, 0), array), "array of a grade above the dimension rejected");
+        check(!e3ga::deserialize(truncated.substr(0, 5), array), "truncated header rejected");
+
+        e3ga::MvecArray<float> floats;
+        check(!e3ga::deserialize(truncated, floats), "array of double rejected as float");
+        check(array.size() == 2 && sameMvec(array.at(1), e3ga::Mvec<double>() + 2.0), "array unchanged by the rejected encodings");
+
+        e3ga::Mvec<double> mv = e3ga::Mvec<double>() + 3.0;
+        const std::string encoded = e3ga::serialize(e3ga::Mvec<double>() + 1.0);
+        std::string aboveDimension = encoded;
+        const std::uint32_t gradeAboveDimension = 1u << (e3ga::algebraDimension+1);
+        std::memcpy(&aboveDimension[1], &gradeAboveDimension, sizeof(gradeAboveDimension));
+        check(!e3ga::deserialize(encoded.substr(0, encoded.size() - 1), mv) && !e3ga::deserialize(encoded + '\0', mv)
+              && !e3ga::deserialize(aboveDimension, mv) && sameMvec(mv, e3ga::Mvec<double>() + 3.0),
+              "malformed multivectors rejected, the multivector unchanged");
+    }
+}
+
+
+int main() {
+    std::mt19937 randomEngine(11);
+    testRoundTrips<float>(randomEngine);
+    testRoundTrips<double>(randomEngine);
+    testMalformedArrays();
+    return e3ga::test::testResult();
+}
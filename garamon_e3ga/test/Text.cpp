@@ -0,0 +1,124 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// Text.cpp
+// This file is part of the Garamon for e3ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file Text.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief Test of the text of the multivectors (Text.hpp), for float and double:
+///  - the round trips of random multivectors of each set of grades, of 0 and of extreme coefficients, through toText,
+///    and through operator<< with max_digits10 digits,
+///  - a sequence of multivectors, one per line, read by parseText,
+///  - the basis vectors of a blade in any order, the terms of a blade added,
+///  - the syntax errors are rejected and leave the multivector unchanged.
+
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "e3ga/Mvec.hpp"
+#include "e3ga/Text.hpp"
+
+#include "RandomMvec.hpp"
+#include "Test.hpp"
+
+
+namespace {
+
+    using e3ga::test::check;
+    using e3ga::test::randomMvec;
+    using e3ga::test::sameMvec;
+    using e3ga::test::typeName;
+
+    template<typename T>
+    void testRoundTrips(std::mt19937& randomEngine) {
+        bool texts = true, streams = true;
+        std::vector<e3ga::Mvec<T>> mvs;
+        for(std::uint32_t gradeBitmap=0; gradeBitmap<=e3ga::test::allGrades; ++gradeBitmap){
+            const e3ga::Mvec<T> mv = randomMvec<T>(randomEngine, gradeBitmap);
+            e3ga::Mvec<T> parsed;
+            texts = texts && e3ga::fromText(e3ga::toText(mv), parsed) && sameMvec(parsed, mv);
+
+            std::ostringstream stream;
+            stream.precision(std::numeric_limits<T>::max_digits10);
+            stream << mv;
+            parsed = e3ga::Mvec<T>();
+            streams = streams && e3ga::fromText(stream.str(), parsed) && sameMvec(parsed, mv);
+            mvs.push_back(mv);
+        }
+        check(texts, "round trip of multivectors of each set of grades by toText, " + typeName<T>());
+        check(streams, "round trip of multivectors of each set of grades by operator<<, " + typeName<T>());
+
+        e3ga::Mvec<T> parsed = e3ga::Mvec<T>() + T(1);
+        check(e3ga::toText(e3ga::Mvec<T>()) == "0" && e3ga::fromText("0", parsed) && sameMvec(parsed, e3ga::Mvec<T>()),
+              "text of the multivector 0, " + typeName<T>());
+
+        const T extremes[] = {std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest(), std::numeric_limits<T>::min(),
+                              std::numeric_limits<T>::denorm_min(), T(1) / T(3), T(-1e-30)};
+        bool extremeTexts = true;
+        for(const T value : extremes){
+            T dense[e3ga::multivectorSize] = {};
+            dense[0] = value;
+            dense[e3ga::multivectorSize-1] = -value;
+            e3ga::Mvec<T> mv;
+            mv.fromDense(dense);
+            extremeTexts = extremeTexts && e3ga::fromText(e3ga::toText(mv), parsed) && sameMvec(parsed, mv);
+        }
+        check(extremeTexts, "round trip of extreme coefficients, " + typeName<T>());
+
+        // a sequence of multivectors, one per line
+        std::string text;
+        for(const e3ga::Mvec<T>& mv : mvs){
+            e3ga::appendText(text, mv);
+            text += '\n';
+        }
+        bool sequence = true;
+        const char* it = text.data();
+        for(std::size_t i=0; i<mvs.size() && sequence; ++i){
+            it = e3ga::parseText(it, text.data() + text.size(), parsed);
+            sequence = it != nullptr && sameMvec(parsed, mvs[i]);
+        }
+        check(sequence, "sequence of multivectors read by parseText, " + typeName<T>());
+    }
+
+    void testSyntax() {
+        using Mvec = e3ga::Mvec<double>;
+        const std::string e0 = e3ga::basisVectors[0], e1 = e3ga::basisVectors[1];
+        double dense[e3ga::multivectorSize] = {};
+        dense[0] = 1.5;
+        dense[e3ga::basisBladeIndices[3]] = -2.0;
+        dense[e3ga::basisBladeIndices[1]] = 3.0;
+        Mvec expected;
+        expected.fromDense(dense);
+        Mvec parsed;
+        check(e3ga::fromText("  1.5 + 2*e" + e1 + e0 + " + 1*e" + e0 + " + 2 * e" + e0 + "\n", parsed) && sameMvec(parsed, expected),
+              "basis vectors of a blade in any order, terms of a blade added");
+
+        const Mvec unchanged = Mvec() + 7.0;
+        const std::string errors[] = {"", "1 +", "2*", "2*e", "2*x" + e0, "1 + * e" + e0, "2*e" + e0 + e0, "1 2", "e" + e0};
+        bool rejected = true;
+        for(const std::string& error : errors){
+            parsed = unchanged;
+            rejected = rejected && !e3ga::fromText(error, parsed) && sameMvec(parsed, unchanged);
+        }
+        check(rejected, "syntax errors rejected, the multivector unchanged");
+    }
+}
+
+
+int main() {
+    std::mt19937 randomEngine(13);
+    testRoundTrips<float>(randomEngine);
+    testRoundTrips<double>(randomEngine);
+    testSyntax();
+    return e3ga::test::testResult();
+}
@@ -0,0 +1,209 @@
+// Copyright (c) 2018 by University Paris-Est Marne-la-Vallee
+// CApi.cpp
+// This file is part of the Garamon for e4ga.
+// Authors: Stephane Breuils and Vincent Nozick
+// Contact: vincent.nozick@u-pem.fr
+//
+// Licence MIT
+// A a copy of the MIT License is given along with this program
+
+/// \file CApi.cpp
+/// \author Stephane Breuils, Vincent Nozick
+/// \brief C interface of the e4ga library, implemented on top of Mvec<double> and the batch functions.
+
+
+#include "e4ga/CApi.h"
+
+#include <new>
+
+#include "e4ga/Mvec.hpp"
+#include "e4ga/Batch.hpp"
+#include "e4ga/KernelDispatch.hpp"
+
+
+/// \brief the multivector behind an opaque handle
+struct e4ga_mvec {
+    e4ga::Mvec<double> mv;
+};
+
+
+/// \cond DEV
+// no exception may cross the C interface: the functions returning a status catch them all
+#define E4GA_CAPI_TRY(statements) \
+    try { statements; return 0; } \
+    catch(...) { return -1; }
+
+namespace {
+
+    /// \brief view on the operand of a batch function, stored as multivectors of multivectorSize coefficients
+    inline e4ga::BatchView<const double> operandBatch(const double* data, const ptrdiff_t itemStride) {
+        return {data, itemStride, 1};
+    }
+
+    /// \brief new handle on mv, NULL if the allocation fails
+    inline e4ga_mvec* newHandle(e4ga::Mvec<double>&& mv) {
+        return new (std::nothrow) e4ga_mvec{std::move(mv)};
+    }
+}
+/// \endcond
+
+
+extern "C" {
+
+int e4ga_api_version(void) {
+    return E4GA_CAPI_VERSION;
+}
+
+unsigned int e4ga_algebra_dimension(void) {
+    return e4ga::algebraDimension;
+}
+
+unsigned int e4ga_multivector_size(void) {
+    return e4ga::multivectorSize;
+}
+
+unsigned int e4ga_dense_index(const unsigned int xor_index) {
+    if(xor_index >= e4ga::multivectorSize) return e4ga::multivectorSize;
+    return e4ga::perGradeStartingIndex[e4ga::xorIndexToGrade[xor_index]] + e4ga::xorIndexToHomogeneousIndex[xor_index];
+}
+
+
+e4ga_mvec* e4ga_mvec_new(void) {
+    try { return newHandle(e4ga::Mvec<double>()); }
+    catch(...) { return nullptr; }
+}
+
+e4ga_mvec* e4ga_mvec_from_dense(const double* dense) {
+    try {
+        e4ga::Mvec<double> mv;
+        mv.fromDense(dense);
+        return newHandle(std::move(mv));
+    }
+    catch(...) { return nullptr; }
+}
+
+e4ga_mvec* e4ga_mvec_clone(const e4ga_mvec* mv) {
+    try { return newHandle(e4ga::Mvec<double>(mv->mv)); }
+    catch(...) { return nullptr; }
+}
+
+void e4ga_mvec_free(e4ga_mvec* mv) {
+    delete mv;
+}
+
+void e4ga_mvec_to_dense(const e4ga_mvec* mv, double* dense) {
+    mv->mv.toDense(dense);
+}
+
+double e4ga_mvec_get(const e4ga_mvec* mv, const unsigned int xor_index) {
+    if(xor_index >= e4ga::multivectorSize) return 0.0;
+    double dense[e4ga::multivectorSize];
+    mv->mv.toDense(dense);
+    return dense[e4ga_dense_index(xor_index)];
+}
+
+int e4ga_mvec_set(e4ga_mvec* mv, const unsigned int xor_index, const double value) {
+    if(xor_index >= e4ga::multivectorSize) return -1;
+    E4GA_CAPI_TRY(mv->mv[xor_index] = value)
+}
+
+
+int e4ga_mvec_add(const e4ga_mvec* a, const e4ga_mvec* b, e4ga_mvec* result) {
+    E4GA_CAPI_TRY(result->mv = a->mv + b->mv)
+}
+
+int e4ga_mvec_sub(const e4ga_mvec* a, const e4ga_mvec* b, e4ga_mvec* result) {
+    E4GA_CAPI_TRY(result->mv = a->mv - b->mv)
+}
+
+int e4ga_mvec_scale(const e4ga_mvec* a, const double value, e4ga_mvec* result) {
+    E4GA_CAPI_TRY(result->mv = a->mv * value)
+}
+
+int e4ga_mvec_geometric_product(const e4ga_mvec* a, const e4ga_mvec* b, e4ga_mvec* result) {
+    E4GA_CAPI_TRY(result->mv = a->mv * b->mv)
+}
+
+int e4ga_mvec_outer_product(const e4ga_mvec* a, const e4ga_mvec* b, e4ga_mvec* result) {
+    E4GA_CAPI_TRY(result->mv = a->mv ^ b->mv)
+}
+
+int e4ga_mvec_inner_product(const e4ga_mvec* a, const e4ga_mvec* b, e4ga_mvec* result) {
+    E4GA_CAPI_TRY(result->mv = a->mv | b->mv)
+}
+
+int e4ga_mvec_left_contraction(const e4ga_mvec* a, const e4ga_mvec* b, e4ga_mvec* result) {
+    E4GA_CAPI_TRY(result->mv = a->mv < b->mv)
+}
+
+int e4ga_mvec_right_contraction(const e4ga_mvec* a, const e4ga_mvec* b, e4ga_mvec* result) {
+    E4GA_CAPI_TRY(result->mv = a->mv > b->mv)
+}
+
+int e4ga_mvec_dual(const e4ga_mvec* a, e4ga_mvec* result) {
+    E4GA_CAPI_TRY(result->mv = a->mv.dual())
+}
+
+int e4ga_mvec_reverse(const e4ga_mvec* a, e4ga_mvec* result) {
+    E4GA_CAPI_TRY(result->mv = a->mv.reverse())
+}
+
+int e4ga_mvec_inverse(const e4ga_mvec* a, e4ga_mvec* result) {
+    E4GA_CAPI_TRY(result->mv = a->mv.inv())
+}
+
+double e4ga_mvec_norm(const e4ga_mvec* a) {
+    return a->mv.norm();
+}
+
+
+int e4ga_geometric_product_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    E4GA_CAPI_TRY(e4ga::geometricProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), e4ga::aosBatch(result), count))
+}
+
+int e4ga_outer_product_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    E4GA_CAPI_TRY(e4ga::outerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), e4ga::aosBatch(result), count))
+}
+
+int e4ga_inner_product_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    E4GA_CAPI_TRY(e4ga::innerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), e4ga::aosBatch(result), count, e4ga::InnerKind::inner))
+}
+
+int e4ga_left_contraction_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    E4GA_CAPI_TRY(e4ga::innerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), e4ga::aosBatch(result), count, e4ga::InnerKind::leftContraction))
+}
+
+int e4ga_right_contraction_batch(const double* a, const ptrdiff_t a_stride, const double* b, const ptrdiff_t b_stride, double* result, const size_t count) {
+    E4GA_CAPI_TRY(e4ga::innerProductBatch(operandBatch(a, a_stride), operandBatch(b, b_stride), e4ga::aosBatch(result), count, e4ga::InnerKind::rightContraction))
+}
+
+int e4ga_apply_versor_batch(const double* versor, const ptrdiff_t versor_stride, const double* mv, const ptrdiff_t mv_stride, double* result, const size_t count) {
+    E4GA_CAPI_TRY(e4ga::applyVersorBatch(operandBatch(versor, versor_stride), operandBatch(mv, mv_stride), e4ga::aosBatch(result), count))
+}
+
+int e4ga_dual_batch(const double* a, const ptrdiff_t a_stride, double* result, const size_t count) {
+    E4GA_CAPI_TRY(e4ga::dualBatch(operandBatch(a, a_stride), e4ga::aosBatch(result), count))
+}
+
+int e4ga_reverse_batch(const double* a, const ptrdiff_t a_stride, double* result, const size_t count) {
+    E4GA_CAPI_TRY(e4ga::reverseBatch(operandBatch(a, a_stride), e4ga::aosBatch(result), count))
+}
+
+int e4ga_norm_batch(const double* a, const ptrdiff_t a_stride, double* norms, const size_t count) {
+    E4GA_CAPI_TRY(e4ga::normBatch(operandBatch(a, a_stride), norms, count))
+}
+
+const char* e4ga_kernel_isa(void) {
+    return e4ga::kernelIsaName(e4ga::activeKernelIsa());
+}
+
+int e4ga_select_kernel_isa(const char* name) {
+    if(name == nullptr) return -1;
+    return e4ga::selectKernelIsa(name) ? 0 : -1;
+}
+
+int e4ga_autotune_kernels(const char* path) {
+    E4GA_CAPI_TRY(if(!e4ga::autotuneKernels(path)) return -1)
+}
+
+} // extern "C"
@@ -57,6 +57,8 @@ namespace e4ga{
 
     constexpr unsigned int algebraDimension = 4; /*!< dimension of the algebra (number of  basis vectors of grade 1) */
 
+    constexpr unsigned int multivectorSize = 16; /*!< number of coefficients of a full multivector (2^dimension) */
+
     constexpr unsigned int perGradeStartingIndex[5] = {0,1,5,11,15};  /*!< array specifying the index of each first element of grade k in the full multivector */
 
     constexpr unsigned int binomialArray[5] = {1,4,6,4,1};  /*!< array of the (dimension + 1) first binomial coefficients */
@@ -65,21 +67,23 @@ namespace e4ga{
 
     constexpr unsigned int xorIndexToHomogeneousIndex[] = {0,0,1,0,2,1,3,0,3,2,4,1,5,2,3,0}; /*!< given a Xor index in a multivector, this array indicates the corresponding index in the whole homogeneous vector*/
 
-    std::array<std::vector<unsigned int>, 5> dualPermutations = {{ { 0}, {{ 3, 2, 1, 0}}, {{ 5, 4, 3, 2, 1, 0}}, {{ 3, 2, 1, 0}}, {0} }};
+    constexpr unsigned int dualPermutations[5][6] = {{0}, {3,2,1,0}, {5,4,3,2,1,0}, {3,2,1,0}, {0}};
 
-    const std::array<Eigen::Matrix<double, Eigen::Dynamic,1>, 5> dualCoefficients = loadFastDualArray<double>(); /*!< array containing the coefficients needed to compute the dual */ 
+    constexpr double dualCoefficients[5][6] = {{1.000000}, {-1.000000,1.000000,-1.000000,1.000000}, {-1.000000,1.000000,-1.000000,-1.000000,1.000000,-1.000000}, {1.000000,-1.000000,1.000000,-1.000000}, {1.000000}}; /*!< array containing the coefficients needed to compute the dual */ 
     
     template<typename T>
-    std::array<T, 16> recursiveDualCoefficients = {{ 1.000000, -1.000000, 1.000000, -1.000000, -1.000000, 1.000000, -1.000000, 1.000000, 1.000000, -1.000000, 1.000000, -1.000000, -1.000000, 1.000000, -1.000000, 1.000000}}; /*!< array containing the coefficients needed to compute the recursive product like (primal^dual) */
+    constexpr std::array<T, 16> recursiveDualCoefficients = {{ 1.000000, -1.000000, 1.000000, -1.000000, -1.000000, 1.000000, -1.000000, 1.000000, 1.000000, -1.000000, 1.000000, -1.000000, -1.000000, 1.000000, -1.000000, 1.000000}}; /*!< array containing the coefficients needed to compute the recursive product like (primal^dual) */
     
 
     constexpr double pseudoScalarInverse = 1.000000; /*!< compute the inverse of the pseudo scalar */
 
-    const int signReversePerGrade[5] = {1,1,-1,-1,1}; /*!< array of signs to avoid the computation of (-1)^k*(k-1)/2 during the reverse operation */
+    constexpr int signReversePerGrade[5] = {1,1,-1,-1,1}; /*!< array of signs to avoid the computation of (-1)^k*(k-1)/2 during the reverse operation */
 
-    const std::vector<std::string> basisVectors = {"1", "2", "3", "4"}; /*!< name of the basis vectors (of grade 1) */
+    constexpr const char* basisVectors[] = {"1", "2", "3", "4"}; /*!< name of the basis vectors (of grade 1) */
+    constexpr const char* basisBladeNames[16] = {"", "1", "2", "3", "4", "12", "13", "14", "23", "24", "34", "123", "124", "134", "234", "1234"}; /*!< name of the basis blade of each coefficient of a dense multivector (see Mvec::toDense), written after "e" by operator<< */
+    constexpr unsigned int basisBladeIndices[16] = {0,1,2,5,3,6,8,11,4,7,9,12,10,13,14,15}; /*!< index in a dense multivector of the basis blade whose basis vectors are the bits of the index (bit i for basisVectors[i]) */
 
-    const std::string metric =
+    constexpr const char* metric =
 "\
 	e1	e2	e3	e4	\n\
 e1	1	0	0	0	\n\
@@ -90,30 +94,30 @@ e4	0	0	0	1	\n\
 
 
     template<class T>
-    const T zero = 0;
-
-    const unsigned int scalar = 0;
-    const unsigned int E1 = 1;
-    const unsigned int E2 = 2;
-    const unsigned int E3 = 4;
-    const unsigned int E4 = 8;
-    const unsigned int E12 = 3;
-    const unsigned int E13 = 5;
-    const unsigned int E14 = 9;
-    const unsigned int E23 = 6;
-    const unsigned int E24 = 10;
-    const unsigned int E34 = 12;
-    const unsigned int E123 = 7;
-    const unsigned int E124 = 11;
-    const unsigned int E134 = 13;
-    const unsigned int E234 = 14;
-    const unsigned int E1234 = 15;
+    constexpr T zero = 0;
+
+    constexpr unsigned int scalar = 0;
+    constexpr unsigned int E1 = 1;
+    constexpr unsigned int E2 = 2;
+    constexpr unsigned int E3 = 4;
+    constexpr unsigned int E4 = 8;
+    constexpr unsigned int E12 = 3;
+    constexpr unsigned int E13 = 5;
+    constexpr unsigned int E14 = 9;
+    constexpr unsigned int E23 = 6;
+    constexpr unsigned int E24 = 10;
+    constexpr unsigned int E34 = 12;
+    constexpr unsigned int E123 = 7;
+    constexpr unsigned int E124 = 11;
+    constexpr unsigned int E134 = 13;
+    constexpr unsigned int E234 = 14;
+    constexpr unsigned int E1234 = 15;
     /*!< defines the constants for the cga */
 
 
 
     template<typename T>
-    Eigen::Matrix<T, Eigen::Dynamic, 1> diagonalMetric = []()->Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic>{Eigen::Matrix<T, Eigen::Dynamic, 1> tmp(4);tmp<<1.000000,1.000000,1.000000,1.000000; return tmp;}();   /*!< defines the diagonal metric (stored as a vector) */
+    constexpr std::array<T, 4> diagonalMetric = {{1.000000,1.000000,1.000000,1.000000}};   /*!< defines the diagonal metric (stored as a vector) */
 
 
 }  // namespace